@@ -650,3 +650,44 @@ void CG_RegisterPlayerClasses(void)
 		}
 	}
 }
+
+/**
+ * @brief Checks the compiled animation scripts of all loaded models against
+ * their item by item evaluation
+ */
+void CG_AnimScriptTest_f(void)
+{
+	animModelInfo_t *modelInfo;
+	int             states = 10000, i, checks, mismatches, models = 0, failed = 0;
+
+	if (trap_Argc() > 1)
+	{
+		states = atoi(CG_Argv(1));
+	}
+
+	if (states <= 0)
+	{
+		CG_Printf("usage: animscripttest [states]\n");
+		return;
+	}
+
+	for (i = 0; i < MAX_ANIMSCRIPT_MODELS; i++)
+	{
+		modelInfo = &cgs.animScriptData.modelInfo[i];
+		if (!*modelInfo->animationGroup || !*modelInfo->animationScript)
+		{
+			continue;
+		}
+
+		mismatches = BG_AnimScriptTest(modelInfo, cg.clientNum, states, &checks);
+		CG_Printf("animscripttest: %s %s: %i checks, %i scripts with mismatches\n",
+		          modelInfo->animationGroup, modelInfo->animationScript, checks, mismatches);
+
+		models++;
+		failed += mismatches;
+	}
+
+	CG_Printf("animscripttest: %i models, %i of %i tests and %i of %i test bits used, %s\n", models,
+	          cgs.animScriptData.numScriptTests, MAX_ANIMSCRIPT_TESTS, cgs.animScriptData.numScriptTestBits, MAX_ANIMSCRIPT_TESTBITS,
+	          failed ? S_COLOR_RED "FAILED" : "passed");
+}
@@ -1340,6 +1340,11 @@ static consoleCommand_t commands[] =
 	{ "resetTimer",          CG_TimerReset_f         }, // keep ETPro compatibility
 	{ "class",               CG_Class_f              },
 	{ "readhuds",            CG_ReadHuds_f           },
+	{ "locationbench",       CG_LocationBenchmark_f  },
+	{ "particlebench",       CG_ParticleBenchmark_f  },
+	{ "localentstats",       CG_LocalEntityStats_f   },
+	{ "solidbench",          CG_SolidBenchmark_f     },
+	{ "animscripttest",      CG_AnimScriptTest_f     },
 };
 
 /*
@@ -2570,6 +2570,9 @@ void CG_AddPacketEntities(void)
 {
 	int num;
 
+	// entities move one by one from here on
+	CG_SuspendSolidIndex();
+
 	// set cg.frameInterpolation
 	if (cg.nextSnap)
 	{
@@ -2633,6 +2636,8 @@ void CG_AddPacketEntities(void)
 
 	// add the flamethrower sounds
 	CG_UpdateFlamethrowerSounds();
+
+	CG_ResumeSolidIndex();
 }
 
 void CGRefEntityToTag(refEntity_t *ent, tag_t *tag)
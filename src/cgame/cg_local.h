@@ -439,7 +439,8 @@ typedef enum
 	LE_BLOOD,
 	LE_FUSE_SPARK,
 	LE_MOVING_TRACER,
-	LE_EMITTER
+	LE_EMITTER,
+	LE_NUM_TYPES
 } leType_t;
 
 typedef enum
@@ -472,6 +473,7 @@ typedef enum
 typedef struct localEntity_s
 {
 	struct localEntity_s *prev, *next;
+	int allocNum;                       // tells a reused local entity from the one it was
 	leType_t leType;
 	int leFlags;
 
@@ -513,8 +515,21 @@ typedef struct localEntity_s
 	int breakCount;                     // break-up this many times before we can break no more
 	float sizeScale;
 
+	int nextRestCheck;                  // fragments resting on an entity look for the ground again at this time
+
 } localEntity_t;
 
+/**
+ * @struct batchTrace_t
+ * @brief A point trace of CG_TraceBatch
+ */
+typedef struct
+{
+	vec3_t start;
+	vec3_t end;
+	trace_t trace;
+} batchTrace_t;
+
 //======================================================================
 
 typedef struct
@@ -771,8 +786,6 @@ void CG_ParseMapEntityInfo(int axis_number, int allied_number);
 #define MAX_WEAP_BANKS_MP       10
 #define MAX_WEAPS_IN_BANK_MP    17
 
-#define MAX_BACKUP_STATES (CMD_BACKUP + 2)
-
 typedef struct
 {
 	int clientFrame;                // incremented each frame
@@ -784,6 +797,7 @@ typedef struct
 	qboolean demoPlayback;
 	demoPlayInfo_t *demoinfo;
 	int legacyClient;               // is either 0 (vanilla client) 1 (old legacy client) or a version integer from git_version.h
+	int syscallExtensions;          // SYSCALL_EXT_* the client has
 	qboolean loading;               // don't defer players at initial startup
 	qboolean intermissionStarted;   // don't play voice rewards, because game will end shortly
 
@@ -1124,12 +1138,6 @@ typedef struct
 
 	centity_t *satchelCharge;
 
-	playerState_t backupStates[MAX_BACKUP_STATES];
-	int backupStateTop;
-	int backupStateTail;
-	int lastPredictedCommand;
-	int lastPhysicsTime;
-
 	qboolean skyboxEnabled;
 	vec3_t skyboxViewOrg;
 	vec_t skyboxViewFov;
@@ -2070,6 +2078,7 @@ extern vmCvar_t cg_errorDecay;
 extern vmCvar_t cg_nopredict;
 extern vmCvar_t cg_noPlayerAnims;
 extern vmCvar_t cg_showmiss;
+extern vmCvar_t cg_optimizePrediction;
 extern vmCvar_t cg_markTime;
 extern vmCvar_t cg_brassTime;
 extern vmCvar_t cg_gun_frame;
@@ -2249,6 +2258,7 @@ qboolean CG_RegisterCharacter(const char *characterFile, bg_character_t *charact
 bg_character_t *CG_CharacterForClientinfo(clientInfo_t *ci, centity_t *cent);
 bg_character_t *CG_CharacterForPlayerstate(playerState_t *ps);
 void CG_RegisterPlayerClasses(void);
+void CG_AnimScriptTest_f(void);
 
 // cg_main.c
 const char *CG_ConfigString(int index);
@@ -2403,8 +2413,12 @@ int CG_NewParticleArea(int num);
 
 // cg_predict.c
 void CG_BuildSolidList(void);
+void CG_SuspendSolidIndex(void);
+void CG_ResumeSolidIndex(void);
+void CG_SolidBenchmark_f(void);
 int CG_PointContents(const vec3_t point, int passEntityNum);
 void CG_Trace(trace_t *result, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int skipNumber, int mask);
+void CG_TraceBatch(batchTrace_t *traces, int numTraces, int mask);
 void CG_PredictPlayerState(void);
 
 // cg_events.c
@@ -2477,6 +2491,7 @@ void CG_ImpactMark(qhandle_t markShader,
 // cg_particles.c
 void CG_ClearParticles(void);
 void CG_AddParticles(void);
+void CG_ParticleBenchmark_f(void);
 void CG_ParticleSnow(qhandle_t pshader, vec3_t origin, vec3_t origin2, int turb, float range, int snum);
 void CG_ParticleSmoke(qhandle_t pshader, centity_t *cent);
 void CG_ParticleSnowFlurry(qhandle_t pshader, centity_t *cent);
@@ -2543,6 +2558,8 @@ void CG_AddLocalEntities(void);
 char *CG_GetLocationMsg(int clientNum, vec3_t origin);
 char *CG_BuildLocationString(int clientNum, vec3_t origin, int flag);
 void CG_LoadLocations(void);
+void CG_LocationBenchmark_f(void);
+void CG_LocalEntityStats_f(void);
 
 // cg_effects.c
 int CG_GetOriginForTag(centity_t * cent, refEntity_t * parent, char *tagName, int startIndex, vec3_t org, vec3_t axis[3]);
@@ -2735,6 +2752,7 @@ int trap_RealTime(qtime_t *qtime);
 // console variable interaction
 void trap_Cvar_Register(vmCvar_t *vmCvar, const char *varName, const char *defaultValue, int flags);
 void trap_Cvar_Update(vmCvar_t *vmCvar);
+int trap_Cvar_Changes(int *sequence, int *handles, int maxHandles);
 void trap_Cvar_Set(const char *var_name, const char *value);
 void trap_Cvar_VariableStringBuffer(const char *var_name, char *buffer, int bufsize);
 void trap_Cvar_LatchedVariableStringBuffer(const char *var_name, char *buffer, int bufsize);
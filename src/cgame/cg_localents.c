@@ -48,7 +48,296 @@ localEntity_t *cg_freeLocalEntities;        // single linked list
 // debugging
 int localEntCount = 0;
 
-location_t *CG_GetLocation(int client, vec3_t origin)
+// Every frame the active local entities are sorted by type into dense lists,
+// so each type is run in one go and the traces of all moving fragments can be
+// done as one batch. Entities spawned while running are kept in a pending list
+// and run in the same frame.
+#define FRAGMENT_REST_CHECK_MSEC    100 // fragments resting on an entity look for the ground this often
+
+typedef struct
+{
+	localEntity_t *le;
+	int allocNum;
+} localEntityRef_t;
+
+typedef struct
+{
+	localEntityRef_t ref;
+	qboolean hasFlame;
+	float flameAlpha;
+	vec3_t flameDir;
+} fragmentMove_t;
+
+static localEntityRef_t cg_localEntsByType[LE_NUM_TYPES][MAX_LOCAL_ENTITIES];
+static int              cg_numLocalEntsByType[LE_NUM_TYPES];
+static localEntityRef_t cg_pendingLocalEnts[MAX_LOCAL_ENTITIES];
+static int              cg_numPendingLocalEnts;
+static qboolean         cg_collectPendingLocalEnts;
+static int              cg_localEntAllocNum;
+
+static fragmentMove_t cg_fragmentMoves[MAX_LOCAL_ENTITIES];
+static batchTrace_t   cg_fragmentTraces[MAX_LOCAL_ENTITIES];
+
+// profiling, see CG_LocalEntityStats_f
+static struct
+{
+	int frames;
+	int msec;
+	int count[LE_NUM_TYPES];
+	int fragmentTraces;
+	int restChecks;
+	int restSkips;
+} cg_localEntStats;
+
+static const char *leTypeNames[LE_NUM_TYPES] =
+{
+	"mark",
+	"explosion",
+	"sprite explosion",
+	"fragment",
+	"move scale fade",
+	"fall scale fade",
+	"fade rgb",
+	"const rgb",
+	"scale fade",
+	"spark",
+	"debris",
+	"blood",
+	"fuse spark",
+	"moving tracer",
+	"emitter"
+};
+
+// Locations are sorted into a 2D grid of cells on load. A lookup visits the
+// cells in rings around the origin and tests candidates by distance, so only
+// the few locations closer than the answer need a PVS check.
+#define LOCATION_CELL_SIZE  512
+#define LOCATION_GRID_MAX   64
+
+static struct
+{
+	vec2_t mins;
+	int cellSize;
+	int width, height;
+	int cellStart[LOCATION_GRID_MAX * LOCATION_GRID_MAX + 1];   // first entry of each cell in locations
+	short locations[MAX_C_LOCATIONS];
+} locationGrid;
+
+typedef struct
+{
+	float dist;
+	location_t *location;
+} locationCandidate_t;
+
+static int locationPVSChecks;   // for CG_LocationBenchmark_f
+
+/**
+ * @brief Gets the grid cell of a point, points outside the grid go to the closest cell
+ * @param[in] origin
+ * @param[out] cx may be NULL
+ * @param[out] cy may be NULL
+ * @return
+ */
+static int CG_LocationCell(const vec3_t origin, int *cx, int *cy)
+{
+	int x = (int)floor((origin[0] - locationGrid.mins[0]) / locationGrid.cellSize);
+	int y = (int)floor((origin[1] - locationGrid.mins[1]) / locationGrid.cellSize);
+
+	x = x < 0 ? 0 : (x >= locationGrid.width ? locationGrid.width - 1 : x);
+	y = y < 0 ? 0 : (y >= locationGrid.height ? locationGrid.height - 1 : y);
+
+	if (cx)
+	{
+		*cx = x;
+		*cy = y;
+	}
+
+	return y * locationGrid.width + x;
+}
+
+/**
+ * @brief Sorts the loaded locations into locationGrid
+ */
+static void CG_BuildLocationGrid(void)
+{
+	vec2_t maxs;
+	int    count[LOCATION_GRID_MAX * LOCATION_GRID_MAX];
+	int    i, cell;
+
+	Com_Memset(&locationGrid, 0, sizeof(locationGrid));
+	Com_Memset(count, 0, sizeof(count));
+
+	if (cgs.numLocations < 1)
+	{
+		return;
+	}
+
+	Vector2Copy(cgs.location[0].origin, locationGrid.mins);
+	Vector2Copy(cgs.location[0].origin, maxs);
+	for (i = 1; i < cgs.numLocations; i++)
+	{
+		locationGrid.mins[0] = MIN(locationGrid.mins[0], cgs.location[i].origin[0]);
+		locationGrid.mins[1] = MIN(locationGrid.mins[1], cgs.location[i].origin[1]);
+		maxs[0]              = MAX(maxs[0], cgs.location[i].origin[0]);
+		maxs[1]              = MAX(maxs[1], cgs.location[i].origin[1]);
+	}
+
+	// grow the cells on huge maps
+	locationGrid.cellSize = LOCATION_CELL_SIZE;
+	while ((maxs[0] - locationGrid.mins[0]) / locationGrid.cellSize >= LOCATION_GRID_MAX
+	       || (maxs[1] - locationGrid.mins[1]) / locationGrid.cellSize >= LOCATION_GRID_MAX)
+	{
+		locationGrid.cellSize *= 2;
+	}
+	locationGrid.width  = (int)((maxs[0] - locationGrid.mins[0]) / locationGrid.cellSize) + 1;
+	locationGrid.height = (int)((maxs[1] - locationGrid.mins[1]) / locationGrid.cellSize) + 1;
+
+	for (i = 0; i < cgs.numLocations; i++)
+	{
+		count[CG_LocationCell(cgs.location[i].origin, NULL, NULL)]++;
+	}
+
+	for (cell = 0; cell < locationGrid.width * locationGrid.height; cell++)
+	{
+		locationGrid.cellStart[cell + 1] = locationGrid.cellStart[cell] + count[cell];
+		count[cell]                      = locationGrid.cellStart[cell];
+	}
+
+	for (i = 0; i < cgs.numLocations; i++)
+	{
+		locationGrid.locations[count[CG_LocationCell(cgs.location[i].origin, NULL, NULL)]++] = i;
+	}
+}
+
+/**
+ * @brief Orders candidates by distance, on ties the later location wins like it did in the linear search
+ */
+static int QDECL CG_SortLocationCandidates(const void *a, const void *b)
+{
+	const locationCandidate_t *ca = (const locationCandidate_t *)a;
+	const locationCandidate_t *cb = (const locationCandidate_t *)b;
+
+	if (ca->dist != cb->dist)
+	{
+		return ca->dist < cb->dist ? -1 : 1;
+	}
+
+	return cb->location->index - ca->location->index;
+}
+
+/**
+ * @brief Lowers the distance bound of a ring search to the distance of one more grid side
+ * @param[in,out] bound
+ * @param[in,out] complete qfalse once any side is still open
+ * @param[in] dist
+ */
+static void CG_LocationBound(float *bound, qboolean *complete, float dist)
+{
+	if (*complete || dist < *bound)
+	{
+		*bound = dist;
+	}
+	*complete = qfalse;
+}
+
+/**
+ * @brief Finds the closest location in the PVS of origin using the grid
+ * @param[in] origin
+ * @return
+ */
+static location_t *CG_FindLocation(vec3_t origin)
+{
+	static locationCandidate_t candidates[MAX_C_LOCATIONS];
+	locationCandidate_t        *cand;
+	vec3_t                     lenVec;
+	float                      bound;
+	qboolean                   complete;
+	int                        cx, cy, r, x, y, i, cell;
+	int                        numCandidates = 0, next = 0;
+
+	if (cgs.numLocations < 1)
+	{
+		return NULL;
+	}
+
+	CG_LocationCell(origin, &cx, &cy);
+
+	for (r = 0; ; r++)
+	{
+		// add the locations of the cells in ring r
+		for (y = cy - r; y <= cy + r; y++)
+		{
+			if (y < 0 || y >= locationGrid.height)
+			{
+				continue;
+			}
+
+			for (x = cx - r; x <= cx + r; x += (y == cy - r || y == cy + r) ? 1 : 2 * r)
+			{
+				if (x >= 0 && x < locationGrid.width)
+				{
+					cell = y * locationGrid.width + x;
+					for (i = locationGrid.cellStart[cell]; i < locationGrid.cellStart[cell + 1]; i++)
+					{
+						cand           = &candidates[numCandidates++];
+						cand->location = &cgs.location[locationGrid.locations[i]];
+						VectorSubtract(origin, cand->location->origin, lenVec);
+						cand->dist = VectorLength(lenVec);
+					}
+				}
+
+				if (!r)
+				{
+					break;
+				}
+			}
+		}
+
+		// anything outside the rings so far is at least this far away
+		complete = qtrue;
+		bound    = 0;
+		if (cx - r > 0)
+		{
+			CG_LocationBound(&bound, &complete, origin[0] - (locationGrid.mins[0] + (cx - r) * locationGrid.cellSize));
+		}
+		if (cx + r < locationGrid.width - 1)
+		{
+			CG_LocationBound(&bound, &complete, locationGrid.mins[0] + (cx + r + 1) * locationGrid.cellSize - origin[0]);
+		}
+		if (cy - r > 0)
+		{
+			CG_LocationBound(&bound, &complete, origin[1] - (locationGrid.mins[1] + (cy - r) * locationGrid.cellSize));
+		}
+		if (cy + r < locationGrid.height - 1)
+		{
+			CG_LocationBound(&bound, &complete, locationGrid.mins[1] + (cy + r + 1) * locationGrid.cellSize - origin[1]);
+		}
+
+		qsort(candidates + next, numCandidates - next, sizeof(candidates[0]), CG_SortLocationCandidates);
+
+		// candidates closer than anything not added yet are final
+		for ( ; next < numCandidates && (complete || candidates[next].dist < bound); next++)
+		{
+			locationPVSChecks++;
+			if (trap_R_inPVS(origin, candidates[next].location->origin))
+			{
+				return candidates[next].location;
+			}
+		}
+
+		if (complete)
+		{
+			return NULL;
+		}
+	}
+}
+
+/**
+ * @brief Linear search CG_FindLocation replaces, kept to check and benchmark it
+ * @param[in] origin
+ * @return
+ */
+static location_t *CG_FindLocationLinear(vec3_t origin)
 {
 	location_t *curLoc;
 	location_t *bestLoc = NULL;
@@ -57,17 +346,6 @@ location_t *CG_GetLocation(int client, vec3_t origin)
 	vec3_t     lenVec;
 	int        i;
 
-	if (ISVALIDCLIENTNUM(client) && cgs.clientLocation[client].lastLocation)
-	{
-		if ((cgs.clientLocation[client].lastX == origin[0]
-		     && cgs.clientLocation[client].lastY == origin[1]
-		     && cgs.clientLocation[client].lastZ == origin[2])
-		    && &cgs.location[cgs.clientLocation[client].lastLocation])
-		{
-			return &cgs.location[cgs.clientLocation[client].lastLocation];
-		}
-	}
-
 	for (i = 0; i < cgs.numLocations; ++i)
 	{
 		curLoc = &cgs.location[i];
@@ -75,18 +353,41 @@ location_t *CG_GetLocation(int client, vec3_t origin)
 		VectorSubtract(origin, curLoc->origin, lenVec);
 		len = VectorLength(lenVec);
 
-		if (len > bestdist || !trap_R_inPVS(origin, curLoc->origin))
+		if (len > bestdist)
 		{
-			//CG_Printf("^6PVS %i \n", trap_R_inPVS(origin, curLoc->origin));
-			//CG_Printf("^6OR %i  %i   --  %i   %i\n", origin[0], origin[1], curLoc->origin[0], curLoc->origin[1]);
 			continue;
 		}
 
+		locationPVSChecks++;
+		if (!trap_R_inPVS(origin, curLoc->origin))
+		{
+			continue;
+		}
 
 		bestdist = len;
 		bestLoc  = curLoc;
 	}
 
+	return bestLoc;
+}
+
+location_t *CG_GetLocation(int client, vec3_t origin)
+{
+	location_t *bestLoc;
+
+	if (ISVALIDCLIENTNUM(client) && cgs.clientLocation[client].lastLocation)
+	{
+		if ((cgs.clientLocation[client].lastX == origin[0]
+		     && cgs.clientLocation[client].lastY == origin[1]
+		     && cgs.clientLocation[client].lastZ == origin[2])
+		    && &cgs.location[cgs.clientLocation[client].lastLocation])
+		{
+			return &cgs.location[cgs.clientLocation[client].lastLocation];
+		}
+	}
+
+	bestLoc = CG_FindLocation(origin);
+
 	// store new information
 	if (ISVALIDCLIENTNUM(client) && bestLoc != NULL)
 	{
@@ -99,6 +400,58 @@ location_t *CG_GetLocation(int client, vec3_t origin)
 	return bestLoc;
 }
 
+/**
+ * @brief Compares the grid and the linear location lookup at points around all locations
+ */
+void CG_LocationBenchmark_f(void)
+{
+	vec3_t     origin;
+	location_t *grid, *linear;
+	int        i, j, start, gridTime, linearTime, gridChecks, linearChecks, mismatches = 0, points = 0;
+	static int offsets[9][2] = { { 0, 0 }, { 300, 0 }, { -300, 0 }, { 0, 300 }, { 0, -300 }, { 700, 700 }, { -700, 700 }, { 700, -700 }, { -700, -700 } };
+
+	if (cgs.numLocations < 1)
+	{
+		CG_Printf("No locations loaded.\n");
+		return;
+	}
+
+	gridTime = linearTime = gridChecks = linearChecks = 0;
+
+	for (i = 0; i < cgs.numLocations; i++)
+	{
+		for (j = 0; j < 9; j++, points++)
+		{
+			VectorCopy(cgs.location[i].origin, origin);
+			origin[0] += offsets[j][0];
+			origin[1] += offsets[j][1];
+			origin[2] += 32;
+
+			locationPVSChecks = 0;
+			start             = trap_Milliseconds();
+			grid              = CG_FindLocation(origin);
+			gridTime         += trap_Milliseconds() - start;
+			gridChecks       += locationPVSChecks;
+
+			locationPVSChecks = 0;
+			start             = trap_Milliseconds();
+			linear            = CG_FindLocationLinear(origin);
+			linearTime       += trap_Milliseconds() - start;
+			linearChecks     += locationPVSChecks;
+
+			if (grid != linear)
+			{
+				mismatches++;
+			}
+		}
+	}
+
+	CG_Printf("%i locations, %ix%i grid of %i units, %i lookups\n", cgs.numLocations, locationGrid.width, locationGrid.height, locationGrid.cellSize, points);
+	CG_Printf("grid  : %5i msec %8i PVS checks\n", gridTime, gridChecks);
+	CG_Printf("linear: %5i msec %8i PVS checks\n", linearTime, linearChecks);
+	CG_Printf("%i mismatches\n", mismatches);
+}
+
 char *CG_GetLocationMsg(int clientNum, vec3_t origin)
 {
 	location_t *bestLoc = CG_GetLocation(clientNum, origin);
@@ -345,6 +698,8 @@ void CG_LoadLocations(void)
 			}
 		}
 	}
+	CG_BuildLocationGrid();
+
 	// ok we are succesfull
 	CG_Printf("^2%i ^9locations loaded.\n", cgs.numLocations);
 	cgs.locationsLoaded = qtrue;
@@ -372,6 +727,9 @@ void CG_InitLocalEntities(void)
 
 	// debugging
 	localEntCount = 0;
+
+	cg_numPendingLocalEnts     = 0;
+	cg_collectPendingLocalEnts = qfalse;
 }
 
 /*
@@ -395,6 +753,7 @@ void CG_FreeLocalEntity(localEntity_t *le)
 	le->next->prev = le->prev;
 
 	// the free list is only singly linked
+	le->prev             = NULL;
 	le->next             = cg_freeLocalEntities;
 	cg_freeLocalEntities = le;
 }
@@ -426,14 +785,35 @@ localEntity_t *CG_AllocLocalEntity(void)
 
 	memset(le, 0, sizeof(*le));
 
+	le->allocNum = ++cg_localEntAllocNum;
+
 	// link into the active list
 	le->next                          = cg_activeLocalEntities.next;
 	le->prev                          = &cg_activeLocalEntities;
 	cg_activeLocalEntities.next->prev = le;
 	cg_activeLocalEntities.next       = le;
+
+	// spawned by another local entity, run it this frame too
+	if (cg_collectPendingLocalEnts && cg_numPendingLocalEnts < MAX_LOCAL_ENTITIES)
+	{
+		cg_pendingLocalEnts[cg_numPendingLocalEnts].le       = le;
+		cg_pendingLocalEnts[cg_numPendingLocalEnts].allocNum = le->allocNum;
+		cg_numPendingLocalEnts++;
+	}
+
 	return le;
 }
 
+/**
+ * @brief Checks if a local entity is still the one it was when the reference was taken
+ * @param[in] ref
+ * @return
+ */
+static qboolean CG_LocalEntityRefValid(const localEntityRef_t *ref)
+{
+	return ref->le->prev && ref->le->allocNum == ref->allocNum;
+}
+
 /*
 ====================================================================================
 FRAGMENT PROCESSING
@@ -694,14 +1074,15 @@ void CG_AddEmitter(localEntity_t *le)
 
 void CG_Explodef(vec3_t origin, vec3_t dir, int mass, int type, qhandle_t sound, int forceLowGrav, qhandle_t shader);
 
-/*
-================
-CG_AddFragment
-================
-*/
-void CG_AddFragment(localEntity_t *le)
+/**
+ * @brief Runs a fragment up to its move for this frame
+ * @param[in,out] le
+ * @param[out] move state kept for CG_FinishFragment
+ * @param[out] newOrigin where the fragment wants to go
+ * @return qfalse if the fragment is at rest and done for this frame
+ */
+static qboolean CG_MoveFragment(localEntity_t *le, fragmentMove_t *move, vec3_t newOrigin)
 {
-	vec3_t      newOrigin;
 	trace_t     trace;
 	refEntity_t *re        = &le->refEntity;
 	float       flameAlpha = 0.0;
@@ -777,7 +1158,7 @@ void CG_AddFragment(localEntity_t *le)
 
 		trap_R_AddRefEntityToScene(&le->refEntity);
 
-		return;
+		return qfalse;
 	}
 	else if (le->pos.trType == TR_GRAVITY_PAUSED)
 	{
@@ -800,6 +1181,16 @@ void CG_AddFragment(localEntity_t *le)
 		}
 
 		trap_R_AddRefEntityToScene(&le->refEntity);
+
+		// resting on an entity doesn't change from frame to frame
+		if (cg.time < le->nextRestCheck)
+		{
+			cg_localEntStats.restSkips++;
+			return qfalse;
+		}
+		le->nextRestCheck = cg.time + FRAGMENT_REST_CHECK_MSEC;
+		cg_localEntStats.restChecks++;
+
 		// trace a line from previous position down, to see if I should start falling again
 
 		VectorCopy(le->refEntity.origin, newOrigin);
@@ -814,7 +1205,7 @@ void CG_AddFragment(localEntity_t *le)
 		}
 		else
 		{
-			return;
+			return qfalse;
 		}
 	}
 
@@ -839,9 +1230,29 @@ void CG_AddFragment(localEntity_t *le)
 		}
 	}
 
-	// trace a line from previous position to new position
-	CG_Trace(&trace, le->refEntity.origin, NULL, NULL, newOrigin, -1, CONTENTS_SOLID);
-	if (trace.fraction == 1.0)
+	move->hasFlame   = hasFlame;
+	move->flameAlpha = flameAlpha;
+	VectorCopy(flameDir, move->flameDir);
+
+	return qtrue;
+}
+
+/**
+ * @brief Finishes the move of a fragment with the trace of it
+ * @param[in,out] le
+ * @param[in] move
+ * @param[in] trace
+ * @param[in] newOrigin
+ */
+static void CG_FinishFragment(localEntity_t *le, const fragmentMove_t *move, trace_t *trace, const vec3_t newOrigin)
+{
+	qboolean hasFlame   = move->hasFlame;
+	float    flameAlpha = move->flameAlpha;
+	vec3_t   flameDir;
+
+	VectorCopy(move->flameDir, flameDir);
+
+	if (trace->fraction == 1.0)
 	{
 		int i;
 
@@ -905,17 +1316,17 @@ void CG_AddFragment(localEntity_t *le)
 	// if it is in a nodrop zone, remove it
 	// this keeps gibs from waiting at the bottom of pits of death
 	// and floating levels
-	if (CG_PointContents(trace.endpos, 0) & CONTENTS_NODROP)
+	if (CG_PointContents(trace->endpos, 0) & CONTENTS_NODROP)
 	{
 		CG_FreeLocalEntity(le);
 		return;
 	}
 
 	// do a bouncy sound
-	CG_FragmentBounceSound(le, &trace);
+	CG_FragmentBounceSound(le, trace);
 
 	// reflect the velocity on the trace plane
-	CG_ReflectVelocity(le, &trace);
+	CG_ReflectVelocity(le, trace);
 
 	if (le->leFlags & LEF_TUMBLE_SLOW)
 	{
@@ -938,7 +1349,7 @@ void CG_AddFragment(localEntity_t *le)
 
 			// move us a bit
 			VectorNormalize2(le->pos.trDelta, dir);
-			VectorMA(trace.endpos, 4.0 * sizeScale, dir, org);
+			VectorMA(trace->endpos, 4.0 * sizeScale, dir, org);
 
 			// randomize vel a bit
 			VectorMA(le->pos.trDelta, VectorLength(le->pos.trDelta) * 0.3, bytedirs[rand() % NUMVERTEXNORMALS], dir);
@@ -969,7 +1380,7 @@ void CG_AddFragment(localEntity_t *le)
 			for (i = 0; i <= le->breakCount; i++)
 			{
 				nle = CG_AllocLocalEntity();
-				memcpy(&(nle->leType), &(le->leType), sizeof(localEntity_t) - 2 * sizeof(localEntity_t *));
+				memcpy(&(nle->leType), &(le->leType), sizeof(localEntity_t) - ((byte *)&le->leType - (byte *)le));
 				if (nle->breakCount-- < 2)
 				{
 					nle->refEntity.hModel = character->gibModels[rand() % 2];
@@ -988,7 +1399,7 @@ void CG_AddFragment(localEntity_t *le)
 				}
 				// move us a bit
 				VectorNormalize2(nle->pos.trDelta, dir);
-				VectorMA(trace.endpos, 4.0 * le->sizeScale * i, dir, nle->pos.trBase);
+				VectorMA(trace->endpos, 4.0 * le->sizeScale * i, dir, nle->pos.trBase);
 				// randomize vel a bit
 				VectorMA(nle->pos.trDelta, VectorLength(nle->pos.trDelta) * 0.3, bytedirs[rand() % NUMVERTEXNORMALS], nle->pos.trDelta);
 			}
@@ -1005,7 +1416,7 @@ void CG_AddFragment(localEntity_t *le)
 		// leave a mark
 		if (le->leMarkType)
 		{
-			CG_FragmentBounceMark(le, &trace);
+			CG_FragmentBounceMark(le, trace);
 		}
 	}
 
@@ -1027,6 +1438,72 @@ void CG_AddFragment(localEntity_t *le)
 	trap_R_AddRefEntityToScene(&le->refEntity);
 }
 
+/*
+================
+CG_AddFragment
+================
+*/
+void CG_AddFragment(localEntity_t *le)
+{
+	fragmentMove_t move;
+	batchTrace_t   trace;
+
+	VectorCopy(le->refEntity.origin, trace.start);
+
+	if (!CG_MoveFragment(le, &move, trace.end))
+	{
+		return;
+	}
+
+	// trace a line from previous position to new position
+	CG_Trace(&trace.trace, trace.start, NULL, NULL, trace.end, -1, CONTENTS_SOLID);
+	cg_localEntStats.fragmentTraces++;
+
+	CG_FinishFragment(le, &move, &trace.trace, trace.end);
+}
+
+/**
+ * @brief Runs the fragments of this frame, tracing their moves as one batch
+ * @param[in] refs
+ * @param[in] count
+ */
+static void CG_AddFragments(const localEntityRef_t *refs, int count)
+{
+	localEntity_t *le;
+	int           i, numMoves = 0;
+
+	for (i = 0; i < count; i++)
+	{
+		le = refs[i].le;
+
+		if (!CG_LocalEntityRefValid(&refs[i]))
+		{
+			continue;
+		}
+
+		VectorCopy(le->refEntity.origin, cg_fragmentTraces[numMoves].start);
+
+		if (CG_MoveFragment(le, &cg_fragmentMoves[numMoves], cg_fragmentTraces[numMoves].end))
+		{
+			cg_fragmentMoves[numMoves].ref = refs[i];
+			numMoves++;
+		}
+	}
+
+	// trace lines from previous positions to new positions
+	CG_TraceBatch(cg_fragmentTraces, numMoves, CONTENTS_SOLID);
+	cg_localEntStats.fragmentTraces += numMoves;
+
+	for (i = 0; i < numMoves; i++)
+	{
+		// breaking fragments may have recycled others
+		if (CG_LocalEntityRefValid(&cg_fragmentMoves[i].ref))
+		{
+			CG_FinishFragment(cg_fragmentMoves[i].ref.le, &cg_fragmentMoves[i], &cg_fragmentTraces[i].trace, cg_fragmentTraces[i].end);
+		}
+	}
+}
+
 /*
 ================
 CG_AddMovingTracer
@@ -1647,6 +2124,72 @@ static void CG_AddSpriteExplosion(localEntity_t *le)
 
 //==============================================================================
 
+/**
+ * @brief Runs a local entity for this frame
+ * @param[in,out] le
+ */
+static void CG_AddLocalEntity(localEntity_t *le)
+{
+	cg_localEntStats.count[le->leType]++;
+
+	switch (le->leType)
+	{
+	default:
+		CG_Error("Bad leType: %i\n", le->leType);
+		break;
+	case LE_MOVING_TRACER:
+		CG_AddMovingTracer(le);
+		break;
+	case LE_SPARK:
+		CG_AddSparkElements(le);
+		break;
+	case LE_FUSE_SPARK:
+		CG_AddFuseSparkElements(le);
+		break;
+	case LE_DEBRIS:
+	{
+		CG_AddDebrisElements(le);
+
+		// reuses debris le for more debris - we don't allocate extra local ents for this
+		// setup is done in CG_AddDebris
+		CG_AddDebrisElementsExtended(le); // TODO merge with CG_AddDebrisElements
+	}
+	break;
+	case LE_BLOOD:
+		CG_AddBloodElements(le);
+		break;
+	case LE_MARK:
+		break;
+	case LE_SPRITE_EXPLOSION:
+		CG_AddSpriteExplosion(le);
+		break;
+	case LE_EXPLOSION:
+		CG_AddExplosion(le);
+		break;
+	case LE_FRAGMENT:               // gibs and brass
+		CG_AddFragment(le);
+		break;
+	case LE_MOVE_SCALE_FADE:        // water bubbles
+		CG_AddMoveScaleFade(le);
+		break;
+	case LE_FADE_RGB:               // teleporters, railtrails
+		CG_AddFadeRGB(le);
+		break;
+	case LE_CONST_RGB:
+		CG_AddConstRGB(le);         // debug lines
+		break;
+	case LE_FALL_SCALE_FADE:        // gib blood trails
+		CG_AddFallScaleFade(le);
+		break;
+	case LE_SCALE_FADE:             // rocket trails
+		CG_AddScaleFade(le);
+		break;
+	case LE_EMITTER:
+		CG_AddEmitter(le);
+		break;
+	}
+}
+
 /*
 ===================
 CG_AddLocalEntities
@@ -1655,10 +2198,16 @@ CG_AddLocalEntities
 */
 void CG_AddLocalEntities(void)
 {
-	localEntity_t *le, *next;
+	localEntity_t    *le, *next;
+	localEntityRef_t *ref;
+	int              type, i, startTime = trap_Milliseconds();
+
+	for (type = 0; type < LE_NUM_TYPES; type++)
+	{
+		cg_numLocalEntsByType[type] = 0;
+	}
 
-	// walk the list backwards, so any new local entities generated
-	// (trails, marks, etc) will be present this frame
+	// walk the list backwards, so the oldest local entities of each type run first
 	le = cg_activeLocalEntities.prev;
 
 	for ( ; le != &cg_activeLocalEntities ; le = next)
@@ -1672,61 +2221,88 @@ void CG_AddLocalEntities(void)
 			CG_FreeLocalEntity(le);
 			continue;
 		}
-		switch (le->leType)
+
+		if ((unsigned)le->leType >= LE_NUM_TYPES)
 		{
-		default:
 			CG_Error("Bad leType: %i\n", le->leType);
-			break;
-		case LE_MOVING_TRACER:
-			CG_AddMovingTracer(le);
-			break;
-		case LE_SPARK:
-			CG_AddSparkElements(le);
-			break;
-		case LE_FUSE_SPARK:
-			CG_AddFuseSparkElements(le);
-			break;
-		case LE_DEBRIS:
-		{
-			CG_AddDebrisElements(le);
-
-			// reuses debris le for more debris - we don't allocate extra local ents for this
-			// setup is done in CG_AddDebris
-			CG_AddDebrisElementsExtended(le); // TODO merge with CG_AddDebrisElements
 		}
-		break;
-		case LE_BLOOD:
-			CG_AddBloodElements(le);
-			break;
-		case LE_MARK:
-			break;
-		case LE_SPRITE_EXPLOSION:
-			CG_AddSpriteExplosion(le);
-			break;
-		case LE_EXPLOSION:
-			CG_AddExplosion(le);
-			break;
-		case LE_FRAGMENT:               // gibs and brass
-			CG_AddFragment(le);
-			break;
-		case LE_MOVE_SCALE_FADE:        // water bubbles
-			CG_AddMoveScaleFade(le);
-			break;
-		case LE_FADE_RGB:               // teleporters, railtrails
-			CG_AddFadeRGB(le);
-			break;
-		case LE_CONST_RGB:
-			CG_AddConstRGB(le);         // debug lines
-			break;
-		case LE_FALL_SCALE_FADE:        // gib blood trails
-			CG_AddFallScaleFade(le);
-			break;
-		case LE_SCALE_FADE:             // rocket trails
-			CG_AddScaleFade(le);
-			break;
-		case LE_EMITTER:
-			CG_AddEmitter(le);
-			break;
+
+		ref           = &cg_localEntsByType[le->leType][cg_numLocalEntsByType[le->leType]++];
+		ref->le       = le;
+		ref->allocNum = le->allocNum;
+	}
+
+	// any new local entities generated (trails, marks, etc) will be present this frame
+	cg_numPendingLocalEnts     = 0;
+	cg_collectPendingLocalEnts = qtrue;
+
+	for (type = 0; type < LE_NUM_TYPES; type++)
+	{
+		if (type == LE_FRAGMENT)
+		{
+			cg_localEntStats.count[type] += cg_numLocalEntsByType[type];
+			CG_AddFragments(cg_localEntsByType[type], cg_numLocalEntsByType[type]);
+			continue;
+		}
+
+		for (i = 0, ref = cg_localEntsByType[type]; i < cg_numLocalEntsByType[type]; i++, ref++)
+		{
+			// an entity spawned by another one may have recycled it
+			if (CG_LocalEntityRefValid(ref))
+			{
+				CG_AddLocalEntity(ref->le);
+			}
+		}
+	}
+
+	// the pending list grows while it's run
+	for (i = 0, ref = cg_pendingLocalEnts; i < cg_numPendingLocalEnts; i++, ref++)
+	{
+		if (!CG_LocalEntityRefValid(ref))
+		{
+			continue;
 		}
+
+		if (cg.time >= ref->le->endTime)
+		{
+			CG_FreeLocalEntity(ref->le);
+			continue;
+		}
+
+		CG_AddLocalEntity(ref->le);
 	}
+
+	cg_collectPendingLocalEnts = qfalse;
+
+	cg_localEntStats.frames++;
+	cg_localEntStats.msec += trap_Milliseconds() - startTime;
+}
+
+/**
+ * @brief Prints how many local entities of each type were run per frame since the last call
+ */
+void CG_LocalEntityStats_f(void)
+{
+	int i, frames = cg_localEntStats.frames;
+
+	if (!frames)
+	{
+		CG_Printf("localentstats: no frames\n");
+		return;
+	}
+
+	CG_Printf("localentstats: %i frames, %.3f msec per frame, %i local entities in use\n", frames, cg_localEntStats.msec / (float)frames, localEntCount);
+
+	for (i = 0; i < LE_NUM_TYPES; i++)
+	{
+		if (cg_localEntStats.count[i])
+		{
+			CG_Printf("  %-16s %8.2f per frame\n", leTypeNames[i], cg_localEntStats.count[i] / (float)frames);
+		}
+	}
+
+	CG_Printf("  fragment traces  %8.2f per frame\n", cg_localEntStats.fragmentTraces / (float)frames);
+	CG_Printf("  rest checks      %8.2f per frame, %.2f skipped\n", cg_localEntStats.restChecks / (float)frames, cg_localEntStats.restSkips / (float)frames);
+
+	Com_Memset(&cg_localEntStats, 0, sizeof(cg_localEntStats));
 }
@@ -145,6 +145,7 @@ vmCvar_t cg_errorDecay;
 vmCvar_t cg_nopredict;
 vmCvar_t cg_noPlayerAnims;
 vmCvar_t cg_showmiss;
+vmCvar_t cg_optimizePrediction;
 vmCvar_t cg_markTime;
 vmCvar_t cg_brassTime;
 vmCvar_t cg_letterbox;
@@ -386,6 +387,7 @@ cvarTable_t cvarTable[] =
 	{ &cg_nopredict,             "cg_nopredict",             "0",     CVAR_CHEAT                   },
 	{ &cg_noPlayerAnims,         "cg_noplayeranims",         "0",     CVAR_CHEAT                   },
 	{ &cg_showmiss,              "cg_showmiss",              "0",     0                            },
+	{ &cg_optimizePrediction,    "cg_optimizePrediction",    "1",     CVAR_ARCHIVE                 },
 	{ &cg_tracerChance,          "cg_tracerchance",          "0.4",   CVAR_CHEAT                   },
 	{ &cg_tracerWidth,           "cg_tracerwidth",           "0.8",   CVAR_CHEAT                   },
 	{ &cg_tracerSpeed,           "cg_tracerSpeed",           "4500",  CVAR_CHEAT                   },
@@ -528,8 +530,9 @@ cvarTable_t cvarTable[] =
 	{ &cg_fontScaleCN,           "cg_fontScaleCN",           "0.25",  CVAR_ARCHIVE                 }, // CrossName
 };
 
-int      cvarTableSize = sizeof(cvarTable) / sizeof(cvarTable[0]);
-qboolean cvarsLoaded   = qfalse;
+int        cvarTableSize = sizeof(cvarTable) / sizeof(cvarTable[0]);
+qboolean   cvarsLoaded   = qfalse;
+static int cvarSequence  = -1;      // for trap_Cvar_Changes
 void CG_setClientFlags(void);
 
 /*
@@ -545,6 +548,9 @@ void CG_RegisterCvars(void)
 
 	CG_Printf("%d client cvars in use.\n", cvarTableSize);
 
+	// check all cvars on the next update
+	cvarSequence = -1;
+
 	trap_Cvar_Set("cg_letterbox", "0");   // force this for people who might have it in their cfg
 
 	for (i = 0, cv = cvarTable ; i < cvarTableSize ; i++, cv++)
@@ -586,15 +592,23 @@ void CG_UpdateCvars(void)
 	int         i;
 	qboolean    fSetFlags = qfalse;
 	cvarTable_t *cv;
+	int         handles[MAX_CVAR_CHANGES];
+	int         numChanges;
 
 	if (!cvarsLoaded)
 	{
 		return;
 	}
 
+	numChanges = Com_GetCvarChanges((cg.syscallExtensions & SYSCALL_EXT_CVAR_CHANGES) ? trap_Cvar_Changes : NULL, &cvarSequence, handles);
+	if (!numChanges)
+	{
+		return;
+	}
+
 	for (i = 0, cv = cvarTable ; i < cvarTableSize ; i++, cv++)
 	{
-		if (cv->vmCvar)
+		if (cv->vmCvar && Com_CvarChanged(cv->vmCvar, handles, numChanges))
 		{
 			trap_Cvar_Update(cv->vmCvar);
 			if (cv->modificationCount != cv->vmCvar->modificationCount)
@@ -2472,6 +2486,7 @@ void CG_Init(int serverMessageNum, int serverCommandSequence, int clientNum, qbo
 	cg.demoPlayback = demoPlayback;
 
 	MOD_CHECK_LEGACY(legacyClient, clientVersion, cg.legacyClient);
+	cg.syscallExtensions = (int)CG_Cvar_Get(SYSCALL_EXTENSIONS_CVAR);
 
 	// get the rendering configuration from the client system
 	trap_GetGlconfig(&cgs.glconfig);
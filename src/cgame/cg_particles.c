@@ -30,10 +30,20 @@
  */
 /**
  * @file cg_particles.c
+ *
+ * Particles in use are packed at the start of particles[], the motion of
+ * each particle is mirrored into the arrays of particleMotion, so all
+ * particles can be moved 4 at a time before they are added to the scene.
+ * Dead particles are removed by compacting the arrays.
  */
 
 #include "cg_local.h"
 
+#if idx64 || defined(__SSE2__)
+#include <emmintrin.h>
+#define CG_SSE2_PARTICLES
+#endif
+
 #define MUSTARD     1
 #define BLOODRED    2
 #define EMISIVEFADE 3
@@ -42,8 +52,6 @@
 
 typedef struct particle_s
 {
-	struct particle_s *next;
-
 	float time;
 	float endtime;
 
@@ -140,9 +148,32 @@ static float shaderAnimSTRatio[MAX_SHADER_ANIMS] =
 
 #define     MAX_PARTICLES   1024 * 8
 
-cparticle_t *active_particles, *free_particles;
-cparticle_t particles[MAX_PARTICLES];
-int         cl_numparticles = MAX_PARTICLES;
+/**
+ * @struct particleMotion_t
+ * @brief Copy of the motion fields of the particles, see CG_SetParticleMotion
+ */
+typedef struct
+{
+	float time[MAX_PARTICLES];
+	float alpha[MAX_PARTICLES];
+	float alphavel[MAX_PARTICLES];
+	float org[3][MAX_PARTICLES];
+	float vel[3][MAX_PARTICLES];
+	float accel[3][MAX_PARTICLES];
+
+	// state at cg.time, filled by CG_MoveParticles
+	float curAlpha[MAX_PARTICLES];
+	float curOrg[3][MAX_PARTICLES];
+} particleMotion_t;
+
+static cparticle_t      particles[MAX_PARTICLES];
+static particleMotion_t particleMotion;
+static qboolean         particleDead[MAX_PARTICLES];
+static int              numParticles;           // particles in use
+static int              numMovingParticles;     // particles with their motion in particleMotion
+
+static polyBuffer_t *particlePolyBuffer;        // poly buffer of the last particle shader
+static qboolean     particleHeadless;           // particlebench doesn't add anything to the scene
 
 qboolean initparticles = qfalse;
 vec3_t   vforward, vright, vup;
@@ -159,17 +190,8 @@ void CG_ClearParticles(void)
 {
 	int i;
 
-	memset(particles, 0, sizeof(particles));
-
-	free_particles   = &particles[0];
-	active_particles = NULL;
-
-	for (i = 0 ; i < cl_numparticles ; i++)
-	{
-		particles[i].next = &particles[i + 1];
-		particles[i].type = 0;
-	}
-	particles[cl_numparticles - 1].next = NULL;
+	numParticles       = 0;
+	numMovingParticles = 0;
 
 	oldtime = cg.time;
 
@@ -191,6 +213,152 @@ void CG_ClearParticles(void)
 	}
 }
 
+/**
+ * @brief Gets a new particle, cleared
+ * @return NULL if all particles are in use
+ *
+ * @note The motion fields set by the caller are picked up by the next CG_AddParticles.
+ */
+static cparticle_t *CG_AllocParticle(void)
+{
+	cparticle_t *p;
+
+	if (numParticles >= MAX_PARTICLES)
+	{
+		return NULL;
+	}
+
+	p = &particles[numParticles++];
+	Com_Memset(p, 0, sizeof(*p));
+
+	return p;
+}
+
+/**
+ * @brief Copies the motion fields of a particle into particleMotion
+ * @param[in] p
+ *
+ * @note Needed whenever the motion fields of a particle change after it was spawned.
+ */
+static void CG_SetParticleMotion(const cparticle_t *p)
+{
+	particleMotion_t *m = &particleMotion;
+	int              i  = p - particles;
+	int              j;
+
+	m->time[i]     = p->time;
+	m->alpha[i]    = p->alpha;
+	m->alphavel[i] = p->alphavel;
+
+	for (j = 0; j < 3; j++)
+	{
+		m->org[j][i]   = p->org[j];
+		m->vel[j][i]   = p->vel[j];
+		m->accel[j][i] = p->accel[j];
+	}
+}
+
+/**
+ * @brief Computes the alpha and origin of all particles at cg.time
+ */
+static void CG_MoveParticles(void)
+{
+	particleMotion_t *m = &particleMotion;
+	float            time, time2;
+	int              i = 0, j;
+
+#ifdef CG_SSE2_PARTICLES
+	{
+		__m128 now   = _mm_set1_ps(cg.time);
+		__m128 scale = _mm_set1_ps(0.001f);
+		__m128 t, t2;
+
+		for ( ; i + 4 <= numParticles; i += 4)
+		{
+			t  = _mm_mul_ps(_mm_sub_ps(now, _mm_loadu_ps(&m->time[i])), scale);
+			t2 = _mm_mul_ps(t, t);
+
+			_mm_storeu_ps(&m->curAlpha[i], _mm_add_ps(_mm_loadu_ps(&m->alpha[i]), _mm_mul_ps(t, _mm_loadu_ps(&m->alphavel[i]))));
+
+			for (j = 0; j < 3; j++)
+			{
+				_mm_storeu_ps(&m->curOrg[j][i], _mm_add_ps(_mm_add_ps(_mm_loadu_ps(&m->org[j][i]), _mm_mul_ps(_mm_loadu_ps(&m->vel[j][i]), t)),
+				                                           _mm_mul_ps(_mm_loadu_ps(&m->accel[j][i]), t2)));
+			}
+		}
+	}
+#endif
+
+	for ( ; i < numParticles; i++)
+	{
+		time  = (cg.time - m->time[i]) * 0.001f;
+		time2 = time * time;
+
+		m->curAlpha[i] = m->alpha[i] + time * m->alphavel[i];
+
+		for (j = 0; j < 3; j++)
+		{
+			m->curOrg[j][i] = m->org[j][i] + m->vel[j][i] * time + m->accel[j][i] * time2;
+		}
+	}
+}
+
+/**
+ * @brief Adds a particle poly to the poly buffer of its shader
+ * @param[in] shader
+ * @param[in] numVerts
+ * @param[in] verts
+ */
+static void CG_AddParticlePoly(qhandle_t shader, int numVerts, const polyVert_t *verts)
+{
+	polyBuffer_t *pb = particlePolyBuffer;
+	int          firstVertex, firstIndex, i;
+
+	// other multiview windows are rendered before the poly buffers
+	if (cg.refdef_current != &cg.refdef)
+	{
+		trap_R_AddPolyToScene(shader, numVerts, verts);
+		return;
+	}
+
+	// particles of a shader usually come in a row
+	if (!pb || pb->shader != shader || pb->numVerts + numVerts >= MAX_PB_VERTS || pb->numIndicies + (numVerts - 2) * 3 >= MAX_PB_INDICIES)
+	{
+		pb = particlePolyBuffer = CG_PB_FindFreePolyBuffer(shader, numVerts, (numVerts - 2) * 3);
+		if (!pb)
+		{
+			trap_R_AddPolyToScene(shader, numVerts, verts);
+			return;
+		}
+	}
+
+	firstVertex = pb->numVerts;
+	firstIndex  = pb->numIndicies;
+
+	for (i = 0; i < numVerts; i++)
+	{
+		VectorCopy(verts[i].xyz, pb->xyz[firstVertex + i]);
+
+		pb->st[firstVertex + i][0]    = verts[i].st[0];
+		pb->st[firstVertex + i][1]    = verts[i].st[1];
+		pb->color[firstVertex + i][0] = verts[i].modulate[0];
+		pb->color[firstVertex + i][1] = verts[i].modulate[1];
+		pb->color[firstVertex + i][2] = verts[i].modulate[2];
+		pb->color[firstVertex + i][3] = verts[i].modulate[3];
+	}
+
+	// triangle fan, as polys are drawn
+	for (i = 2; i < numVerts; i++)
+	{
+		pb->indicies[firstIndex++] = firstVertex;
+		pb->indicies[firstIndex++] = firstVertex + i - 1;
+		pb->indicies[firstIndex++] = firstVertex + i;
+	}
+
+	pb->numVerts   += numVerts;
+	pb->numIndicies = firstIndex;
+}
+
 /*
 =====================
 CG_AddParticleToScene
@@ -225,6 +393,7 @@ void CG_AddParticleToScene(cparticle_t *p, vec3_t org, float alpha)
 						p->vel[0] = crandom() * 4;
 						p->vel[1] = crandom() * 4;
 					}
+					CG_SetParticleMotion(p);
 				}
 			}
 			else
@@ -244,6 +413,7 @@ void CG_AddParticleToScene(cparticle_t *p, vec3_t org, float alpha)
 						p->vel[0] = crandom() * 16;
 						p->vel[1] = crandom() * 16;
 					}
+					CG_SetParticleMotion(p);
 				}
 			}
 
@@ -253,7 +423,11 @@ void CG_AddParticleToScene(cparticle_t *p, vec3_t org, float alpha)
 				return;
 			}
 
-			p->alpha = 1;
+			if (p->alpha != 1.f)
+			{
+				p->alpha = 1;
+				CG_SetParticleMotion(p);
+			}
 		}
 
 		// had to do this or MAX_POLYS is being exceeded in village1.bsp
@@ -796,7 +970,7 @@ void CG_AddParticleToScene(cparticle_t *p, vec3_t org, float alpha)
 		height = p->height + (ratio * (p->endheight - p->height));
 
 		// add dlight if necessary
-		if (p->type == P_DLIGHT_ANIM)
+		if (p->type == P_DLIGHT_ANIM && !particleHeadless)
 		{
 			// fixme: support arbitrary color
 			trap_R_AddLightToScene(org, 320,        //%	1.5 * (width > height ? width : height),
@@ -891,7 +1065,7 @@ void CG_AddParticleToScene(cparticle_t *p, vec3_t org, float alpha)
 		break;
 	}
 
-	if (!cg_wolfparticles.integer)
+	if (!cg_wolfparticles.integer || particleHeadless)
 	{
 		return;
 	}
@@ -904,11 +1078,11 @@ void CG_AddParticleToScene(cparticle_t *p, vec3_t org, float alpha)
 
 	if (p->type == P_WEATHER || p->type == P_WEATHER_TURBULENT || p->type == P_WEATHER_FLURRY)
 	{
-		trap_R_AddPolyToScene(p->pshader, 3, TRIverts);
+		CG_AddParticlePoly(p->pshader, 3, TRIverts);
 	}
 	else
 	{
-		trap_R_AddPolyToScene(p->pshader, 4, verts);
+		CG_AddParticlePoly(p->pshader, 4, verts);
 	}
 }
 
@@ -922,12 +1096,12 @@ CG_AddParticles
 */
 void CG_AddParticles(void)
 {
-	cparticle_t *p, *next;
-	float       alpha;
-	float       time, time2;
-	vec3_t      org;
-	cparticle_t *active = NULL, *tail = NULL;
-	vec3_t      rotate_ang;
+	particleMotion_t *m = &particleMotion;
+	cparticle_t      *p;
+	float            alpha;
+	vec3_t           org;
+	vec3_t           rotate_ang;
+	int              i, j;
 
 	if (!initparticles)
 	{
@@ -945,20 +1119,25 @@ void CG_AddParticles(void)
 
 	oldtime = cg.time;
 
-	for (p = active_particles ; p ; p = next)
+	// pick up the particles spawned since the last frame
+	for ( ; numMovingParticles < numParticles; numMovingParticles++)
 	{
-		next = p->next;
+		CG_SetParticleMotion(&particles[numMovingParticles]);
+	}
+
+	CG_MoveParticles();
 
-		time = (cg.time - p->time) * 0.001;
+	particlePolyBuffer = NULL;
+
+	// newest particles first, as they always were
+	for (i = numParticles - 1; i >= 0; i--)
+	{
+		p               = &particles[i];
+		alpha           = m->curAlpha[i];
+		particleDead[i] = qtrue;
 
-		alpha = p->alpha + time * p->alphavel;
 		if (alpha <= 0)     // faded out
 		{
-			p->next        = free_particles;
-			free_particles = p;
-			p->type        = 0;
-			p->color       = 0;
-			p->alpha       = 0;
 			continue;
 		}
 
@@ -973,11 +1152,6 @@ void CG_AddParticles(void)
 		case P_FLAT_SCALEUP_FADE:
 			if (cg.time > p->endtime)
 			{
-				p->next        = free_particles;
-				free_particles = p;
-				p->type        = 0;
-				p->color       = 0;
-				p->alpha       = 0;
 				continue;
 			}
 			break;
@@ -986,11 +1160,6 @@ void CG_AddParticles(void)
 			{
 				// temporary sprite
 				CG_AddParticleToScene(p, p->org, alpha);
-				p->next        = free_particles;
-				free_particles = p;
-				p->type        = 0;
-				p->color       = 0;
-				p->alpha       = 0;
 				continue;
 			}
 			break;
@@ -1006,32 +1175,104 @@ void CG_AddParticles(void)
 			break;
 		}
 
-		p->next = NULL;
-		if (!tail)
+		particleDead[i] = qfalse;
+
+		if (alpha > 1.0f)
 		{
-			active = tail = p;
+			alpha = 1;
 		}
-		else
+
+		org[0] = m->curOrg[0][i];
+		org[1] = m->curOrg[1][i];
+		org[2] = m->curOrg[2][i];
+
+		CG_AddParticleToScene(p, org, alpha);
+	}
+
+	// compact the particles left
+	for (i = 0, j = 0; i < numParticles; i++)
+	{
+		if (particleDead[i])
 		{
-			tail->next = p;
-			tail       = p;
+			continue;
 		}
 
-		if (alpha > 1.0)
+		if (i != j)
 		{
-			alpha = 1;
+			particles[j] = particles[i];
+			CG_SetParticleMotion(&particles[j]);
 		}
+		j++;
+	}
 
-		time2 = time * time;
+	numParticles       = j;
+	numMovingParticles = j;
+}
 
-		org[0] = p->org[0] + p->vel[0] * time + p->accel[0] * time2;
-		org[1] = p->org[1] + p->vel[1] * time + p->accel[1] * time2;
-		org[2] = p->org[2] + p->vel[2] * time + p->accel[2] * time2;
+/**
+ * @brief Times the particle update with emitters spawning smoke and debris around the player
+ *
+ * @details Nothing is added to the scene, the particles in use are cleared when done.
+ */
+void CG_ParticleBenchmark_f(void)
+{
+	int    emitters = 64, frames = 200;
+	int    i, j, start, total, peak = 0;
+	int    oldTime = cg.time;
+	vec3_t origin, vel;
 
-		CG_AddParticleToScene(p, org, alpha);
+	if (!cg.snap)
+	{
+		return;
 	}
 
-	active_particles = active;
+	if (trap_Argc() > 1)
+	{
+		emitters = atoi(CG_Argv(1));
+	}
+	if (trap_Argc() > 2)
+	{
+		frames = atoi(CG_Argv(2));
+	}
+
+	if (emitters <= 0 || frames <= 0)
+	{
+		CG_Printf("usage: particlebench [emitters] [frames]\n");
+		return;
+	}
+
+	CG_ClearParticles();
+	particleHeadless = qtrue;
+	total            = 0;
+
+	for (i = 0; i < frames; i++)
+	{
+		cg.time = oldTime + i * 16;
+
+		for (j = 0; j < emitters; j++)
+		{
+			VectorSet(origin, cg.snap->ps.origin[0] + (j % 8) * 64, cg.snap->ps.origin[1] + (j / 8) * 64, cg.snap->ps.origin[2]);
+			VectorSet(vel, crandom() * 64, crandom() * 64, 64 + random() * 64);
+
+			CG_ParticleImpactSmokePuff(cgs.media.smokeParticleShader, origin);
+			CG_ParticleBulletDebris(origin, vel, 300 + rand() % 300);
+		}
+
+		start  = trap_Milliseconds();
+		CG_AddParticles();
+		total += trap_Milliseconds() - start;
+
+		if (numParticles > peak)
+		{
+			peak = numParticles;
+		}
+	}
+
+	particleHeadless = qfalse;
+	cg.time          = oldTime;
+	CG_ClearParticles();
+
+	CG_Printf("particlebench: %i emitters, %i frames, %i particles at most, %.3f msec per frame\n", emitters, frames, peak, total / (float)frames);
 }
 
 /*
@@ -1048,19 +1289,16 @@ void CG_ParticleSnowFlurry(qhandle_t pshader, centity_t *cent)
 		CG_Printf("CG_ParticleSnowFlurry pshader == ZERO!\n");
 	}
 
-	if (!free_particles)
+	p = CG_AllocParticle();
+	if (!p)
 	{
 		return;
 	}
 
-	p                = free_particles;
-	free_particles   = p->next;
-	p->next          = active_particles;
-	active_particles = p;
-	p->time          = cg.time;
-	p->color         = 0;
-	p->alpha         = 0.9f;
-	p->alphavel      = 0;
+	p->time     = cg.time;
+	p->color    = 0;
+	p->alpha    = 0.9f;
+	p->alphavel = 0;
 
 	p->start = cent->currentState.origin2[0];
 	p->end   = cent->currentState.origin2[1];
@@ -1109,24 +1347,21 @@ void CG_ParticleSnow(qhandle_t pshader, vec3_t origin, vec3_t origin2, int turb,
 		CG_Printf("CG_ParticleSnow pshader == ZERO!\n");
 	}
 
-	if (!free_particles)
+	p = CG_AllocParticle();
+	if (!p)
 	{
 		return;
 	}
 
-	p                = free_particles;
-	free_particles   = p->next;
-	p->next          = active_particles;
-	active_particles = p;
-	p->time          = cg.time;
-	p->color         = 0;
-	p->alpha         = 0.4f;
-	p->alphavel      = 0;
-	p->start         = origin[2];
-	p->end           = origin2[2];
-	p->pshader       = pshader;
-	p->height        = 1;
-	p->width         = 1;
+	p->time     = cg.time;
+	p->color    = 0;
+	p->alpha    = 0.4f;
+	p->alphavel = 0;
+	p->start    = origin[2];
+	p->end      = origin2[2];
+	p->pshader  = pshader;
+	p->height   = 1;
+	p->width    = 1;
 
 	p->vel[2] = -50;
 
@@ -1171,22 +1406,19 @@ void CG_ParticleBubble(qhandle_t pshader, vec3_t origin, vec3_t origin2, int tur
 		CG_Printf("CG_ParticleSnow pshader == ZERO!\n");
 	}
 
-	if (!free_particles)
+	p = CG_AllocParticle();
+	if (!p)
 	{
 		return;
 	}
 
-	p                = free_particles;
-	free_particles   = p->next;
-	p->next          = active_particles;
-	active_particles = p;
-	p->time          = cg.time;
-	p->color         = 0;
-	p->alpha         = 0.4f;
-	p->alphavel      = 0;
-	p->start         = origin[2];
-	p->end           = origin2[2];
-	p->pshader       = pshader;
+	p->time     = cg.time;
+	p->color    = 0;
+	p->alpha    = 0.4f;
+	p->alphavel = 0;
+	p->start    = origin[2];
+	p->end      = origin2[2];
+	p->pshader  = pshader;
 
 	randsize = 1 + (crandom() * 0.5);
 
@@ -1238,16 +1470,13 @@ void CG_ParticleSmoke(qhandle_t pshader, centity_t *cent)
 		CG_Printf("CG_ParticleSmoke == ZERO!\n");
 	}
 
-	if (!free_particles)
+	p = CG_AllocParticle();
+	if (!p)
 	{
 		return;
 	}
 
-	p                = free_particles;
-	free_particles   = p->next;
-	p->next          = active_particles;
-	active_particles = p;
-	p->time          = cg.time;
+	p->time = cg.time;
 
 	p->endtime   = cg.time + cent->currentState.time;
 	p->startfade = cg.time + cent->currentState.time2;
@@ -1383,16 +1612,13 @@ void CG_ParticleBulletDebris(vec3_t org, vec3_t vel, int duration)
 {
 	cparticle_t *p;
 
-	if (!free_particles)
+	p = CG_AllocParticle();
+	if (!p)
 	{
 		return;
 	}
 
-	p                = free_particles;
-	free_particles   = p->next;
-	p->next          = active_particles;
-	active_particles = p;
-	p->time          = cg.time;
+	p->time = cg.time;
 
 	p->endtime   = cg.time + duration;
 	p->startfade = cg.time + duration / 2;
@@ -1428,16 +1654,13 @@ void CG_ParticleDirtBulletDebris(vec3_t org, vec3_t vel, int duration)
 	int         r = rand() % 3;
 	cparticle_t *p;
 
-	if (!free_particles)
+	p = CG_AllocParticle();
+	if (!p)
 	{
 		return;
 	}
 
-	p                = free_particles;
-	free_particles   = p->next;
-	p->next          = active_particles;
-	active_particles = p;
-	p->time          = cg.time;
+	p->time = cg.time;
 
 	p->endtime   = cg.time + duration;
 	p->startfade = cg.time + duration / 2;
@@ -1482,16 +1705,12 @@ void CG_ParticleDirtBulletDebris_Core(vec3_t org, vec3_t vel, int duration, floa
 {
 	cparticle_t *p;
 
-	if (!free_particles)
+	p = CG_AllocParticle();
+	if (!p)
 	{
 		return;
 	}
 
-	p                = free_particles;
-	free_particles   = p->next;
-	p->next          = active_particles;
-	active_particles = p;
-
 	p->time      = cg.time;
 	p->endtime   = cg.time + duration;
 	p->startfade = cg.time + duration / 2;
@@ -1540,18 +1759,15 @@ void CG_ParticleExplosion(char *animStr, vec3_t origin, vec3_t vel, int duration
 		return;
 	}
 
-	if (!free_particles)
+	p = CG_AllocParticle();
+	if (!p)
 	{
 		return;
 	}
 
-	p                = free_particles;
-	free_particles   = p->next;
-	p->next          = active_particles;
-	active_particles = p;
-	p->time          = cg.time;
-	p->alpha         = 1.0f;
-	p->alphavel      = 0;
+	p->time     = cg.time;
+	p->alpha    = 1.0f;
+	p->alphavel = 0;
 
 	if (duration < 0)
 	{
@@ -1681,18 +1897,15 @@ void CG_ParticleImpactSmokePuffExtended(qhandle_t pshader, vec3_t origin, int li
 		CG_Printf("CG_ParticleImpactSmokePuff pshader == ZERO!\n");
 	}
 
-	if (!free_particles)
+	p = CG_AllocParticle();
+	if (!p)
 	{
 		return;
 	}
 
-	p                = free_particles;
-	free_particles   = p->next;
-	p->next          = active_particles;
-	active_particles = p;
-	p->time          = cg.time;
-	p->alpha         = alpha;
-	p->alphavel      = 0;
+	p->time     = cg.time;
+	p->alpha    = alpha;
+	p->alphavel = 0;
 
 	// roll either direction
 	p->roll  = rand() % (2 * maxroll);
@@ -1733,19 +1946,16 @@ void CG_Particle_Bleed(qhandle_t pshader, vec3_t start, vec3_t dir, int fleshEnt
 		CG_Printf("CG_Particle_Bleed pshader == ZERO!\n");
 	}
 
-	if (!free_particles)
+	p = CG_AllocParticle();
+	if (!p)
 	{
 		return;
 	}
 
-	p                = free_particles;
-	free_particles   = p->next;
-	p->next          = active_particles;
-	active_particles = p;
-	p->time          = cg.time;
-	p->alpha         = 1.0f;
-	p->alphavel      = 0;
-	p->roll          = 0;
+	p->time     = cg.time;
+	p->alpha    = 1.0f;
+	p->alphavel = 0;
+	p->roll     = 0;
 
 	p->pshader = pshader;
 
@@ -1801,18 +2011,15 @@ void CG_Particle_OilParticle(qhandle_t pshader, vec3_t origin, vec3_t dir, int p
 		CG_Printf("CG_Particle_OilParticle == ZERO!\n");
 	}
 
-	if (!free_particles)
+	p = CG_AllocParticle();
+	if (!p)
 	{
 		return;
 	}
 
-	p                = free_particles;
-	free_particles   = p->next;
-	p->next          = active_particles;
-	active_particles = p;
-	p->time          = cg.time;
-	p->alphavel      = 0;
-	p->roll          = 0;
+	p->time     = cg.time;
+	p->alphavel = 0;
+	p->roll     = 0;
 
 	p->pshader = pshader;
 
@@ -1858,16 +2065,13 @@ void CG_Particle_OilSlick(qhandle_t pshader, centity_t *cent)
 		CG_Printf("CG_Particle_OilSlick == ZERO!\n");
 	}
 
-	if (!free_particles)
+	p = CG_AllocParticle();
+	if (!p)
 	{
 		return;
 	}
 
-	p                = free_particles;
-	free_particles   = p->next;
-	p->next          = active_particles;
-	active_particles = p;
-	p->time          = cg.time;
+	p->time = cg.time;
 
 	if (cent->currentState.angles2[2])
 	{
@@ -1925,7 +2129,8 @@ void CG_Particle_OilSlick(qhandle_t pshader, centity_t *cent)
 
 void CG_OilSlickRemove(centity_t *cent)
 {
-	cparticle_t *p, *next;
+	cparticle_t *p;
+	int         i;
 	int         id = cent->currentState.density;
 
 	if (!id)
@@ -1933,10 +2138,8 @@ void CG_OilSlickRemove(centity_t *cent)
 		CG_Printf("CG_OilSlickRevove NULL id\n");
 	}
 
-	for (p = active_particles ; p ; p = next)
+	for (i = 0, p = particles; i < numParticles; i++, p++)
 	{
-		next = p->next;
-
 		if (p->type == P_FLAT_SCALEUP)
 		{
 			if (p->snum == id)
@@ -1992,16 +2195,12 @@ void CG_ParticleBloodCloud(centity_t *cent, vec3_t origin, vec3_t dir)
 	{
 		VectorMA(point, crittersize, forward, point);
 
-		if (!free_particles)
+		p = CG_AllocParticle();
+		if (!p)
 		{
 			return;
 		}
 
-		p                = free_particles;
-		free_particles   = p->next;
-		p->next          = active_particles;
-		active_particles = p;
-
 		p->time     = cg.time;
 		p->alpha    = 1.0;
 		p->alphavel = 0;
@@ -2051,16 +2250,13 @@ void CG_ParticleSparks(vec3_t org, vec3_t vel, int duration, float x, float y, f
 {
 	cparticle_t *p;
 
-	if (!free_particles)
+	p = CG_AllocParticle();
+	if (!p)
 	{
 		return;
 	}
 
-	p                = free_particles;
-	free_particles   = p->next;
-	p->next          = active_particles;
-	active_particles = p;
-	p->time          = cg.time;
+	p->time = cg.time;
 
 	p->endtime   = cg.time + duration;
 	p->startfade = cg.time + duration / 2;
@@ -2139,16 +2335,12 @@ void CG_ParticleDust(centity_t *cent, vec3_t origin, vec3_t dir)
 	{
 		VectorMA(point, crittersize, forward, point);
 
-		if (!free_particles)
+		p = CG_AllocParticle();
+		if (!p)
 		{
 			return;
 		}
 
-		p                = free_particles;
-		free_particles   = p->next;
-		p->next          = active_particles;
-		active_particles = p;
-
 		p->time     = cg.time;
 		p->alpha    = 5.0f;
 		p->alphavel = 0;
@@ -2237,19 +2429,16 @@ void CG_ParticleMisc(qhandle_t pshader, vec3_t origin, int size, int duration, f
 		CG_Printf("CG_ParticleImpactSmokePuff pshader == ZERO!\n");
 	}
 
-	if (!free_particles)
+	p = CG_AllocParticle();
+	if (!p)
 	{
 		return;
 	}
 
-	p                = free_particles;
-	free_particles   = p->next;
-	p->next          = active_particles;
-	active_particles = p;
-	p->time          = cg.time;
-	p->alpha         = 1.0f;
-	p->alphavel      = 0;
-	p->roll          = rand() % 179;
+	p->time     = cg.time;
+	p->alpha    = 1.0f;
+	p->alphavel = 0;
+	p->roll     = rand() % 179;
 
 	p->pshader = pshader;
 
@@ -47,6 +47,36 @@ static centity_t *cg_solidFTEntities[MAX_ENTITIES_IN_SNAPSHOT];
 static int       cg_numTriggerEntities;
 static centity_t *cg_triggerEntities[MAX_ENTITIES_IN_SNAPSHOT];
 
+// The solid entities are indexed by their bounds along x, so a trace only
+// clips against the entities it can touch. Entities too wide for the sweep
+// are tested one by one. The index is rebuilt lazily when entities moved.
+#define SOLID_INDEX_MAX_WIDTH   512
+
+typedef struct
+{
+	float absmin0;
+	int index;
+} solidSweep_t;
+
+static struct
+{
+	qboolean dirty;
+	qboolean suspended;                 // positions are being updated
+	int physicsTime;
+
+	vec3_t absmin[MAX_ENTITIES_IN_SNAPSHOT];    // by index in cg_solidEntities
+	vec3_t absmax[MAX_ENTITIES_IN_SNAPSHOT];
+
+	solidSweep_t sweep[MAX_ENTITIES_IN_SNAPSHOT];
+	int numSweep;
+	float maxWidth;
+
+	int wide[MAX_ENTITIES_IN_SNAPSHOT];
+	int numWide;
+} cg_solidIndex;
+
+static qboolean cg_solidIndexDisabled;  // for solidbench
+
 /*
 ====================
 CG_BuildSolidList
@@ -124,6 +154,270 @@ void CG_BuildSolidList(void)
 			continue;
 		}
 	}
+
+	cg_solidIndex.dirty = qtrue;
+}
+
+/**
+ * @brief Stops using the solid entity index while the entity positions are updated
+ *
+ * @note CG_AddPacketEntities lerps entities one by one and traces in between.
+ */
+void CG_SuspendSolidIndex(void)
+{
+	cg_solidIndex.suspended = qtrue;
+}
+
+/**
+ * @brief Uses the solid entity index again, it's rebuilt for the new positions at the next trace
+ */
+void CG_ResumeSolidIndex(void)
+{
+	cg_solidIndex.suspended = qfalse;
+	cg_solidIndex.dirty     = qtrue;
+}
+
+/**
+ * @brief Sorts solid entities by the start of their bounds along x
+ * @param[in] a
+ * @param[in] b
+ * @return
+ */
+static int QDECL CG_SortSolidSweep(const void *a, const void *b)
+{
+	const solidSweep_t *sa = (const solidSweep_t *)a;
+	const solidSweep_t *sb = (const solidSweep_t *)b;
+
+	if (sa->absmin0 < sb->absmin0)
+	{
+		return -1;
+	}
+	if (sa->absmin0 > sb->absmin0)
+	{
+		return 1;
+	}
+	return sa->index - sb->index;
+}
+
+/**
+ * @brief Computes the bounds of the solid entities where traces clip against them
+ *
+ * @details The bounds cover what CG_ClipMoveToEntities uses, with a unit of slack
+ * for the epsilons of the collision code.
+ */
+static void CG_BuildSolidIndex(void)
+{
+	int           i, x, zd, zu;
+	centity_t     *cent;
+	entityState_t *ent;
+	vec3_t        mins, maxs, origin, angles;
+	float         *absmin, *absmax, radius, width;
+
+	cg_solidIndex.dirty       = qfalse;
+	cg_solidIndex.physicsTime = cg.physicsTime;
+	cg_solidIndex.numSweep    = 0;
+	cg_solidIndex.numWide     = 0;
+	cg_solidIndex.maxWidth    = 0;
+
+	for (i = 0 ; i < cg_numSolidEntities ; i++)
+	{
+		cent   = cg_solidEntities[i];
+		ent    = &cent->currentState;
+		absmin = cg_solidIndex.absmin[i];
+		absmax = cg_solidIndex.absmax[i];
+
+		if (ent->solid == SOLID_BMODEL)
+		{
+			BG_EvaluateTrajectory(&ent->apos, cg.physicsTime, angles, qtrue, ent->effect2Time);
+			BG_EvaluateTrajectory(&ent->pos, cg.physicsTime, origin, qfalse, ent->effect2Time);
+
+			// the draw model has the bounds of the brush model
+			trap_R_ModelBounds(cgs.inlineDrawModel[ent->modelindex], mins, maxs);
+
+			if (VectorCompare(mins, maxs))
+			{
+				// no bounds, always clip against it
+				VectorSet(absmin, -MAX_MAP_SIZE, -MAX_MAP_SIZE, -MAX_MAP_SIZE);
+				VectorSet(absmax, MAX_MAP_SIZE, MAX_MAP_SIZE, MAX_MAP_SIZE);
+				cg_solidIndex.wide[cg_solidIndex.numWide++] = i;
+				continue;
+			}
+
+			if (angles[0] || angles[1] || angles[2])
+			{
+				radius = RadiusFromBounds(mins, maxs);
+				VectorSet(mins, -radius, -radius, -radius);
+				VectorSet(maxs, radius, radius, radius);
+			}
+
+			// collision bounds are spread by a unit
+			VectorSet(absmin, origin[0] + mins[0] - 2, origin[1] + mins[1] - 2, origin[2] + mins[2] - 2);
+			VectorSet(absmax, origin[0] + maxs[0] + 2, origin[1] + maxs[1] + 2, origin[2] + maxs[2] + 2);
+		}
+		else
+		{
+			// encoded bbox, see CG_SolidEntityClipModel
+			x  = (ent->solid & 255);
+			zd = ((ent->solid >> 8) & 255);
+			zu = ((ent->solid >> 16) & 255) - 32;
+
+			// bullet traces use the hitbox height
+			if (ent->eType == ET_PLAYER && zu < 36)
+			{
+				zu = 36;
+			}
+
+			VectorSet(absmin, cent->lerpOrigin[0] - x - 1, cent->lerpOrigin[1] - x - 1, cent->lerpOrigin[2] - zd - 1);
+			VectorSet(absmax, cent->lerpOrigin[0] + x + 1, cent->lerpOrigin[1] + x + 1, cent->lerpOrigin[2] + zu + 1);
+		}
+
+		width = absmax[0] - absmin[0];
+
+		if (width > SOLID_INDEX_MAX_WIDTH)
+		{
+			cg_solidIndex.wide[cg_solidIndex.numWide++] = i;
+			continue;
+		}
+
+		if (width > cg_solidIndex.maxWidth)
+		{
+			cg_solidIndex.maxWidth = width;
+		}
+
+		cg_solidIndex.sweep[cg_solidIndex.numSweep].absmin0 = absmin[0];
+		cg_solidIndex.sweep[cg_solidIndex.numSweep].index   = i;
+		cg_solidIndex.numSweep++;
+	}
+
+	qsort(cg_solidIndex.sweep, cg_solidIndex.numSweep, sizeof(cg_solidIndex.sweep[0]), CG_SortSolidSweep);
+}
+
+/**
+ * @brief Finds the solid entities a move can touch
+ * @param[in] absmin bounds of the move
+ * @param[in] absmax
+ * @param[out] list indexes in cg_solidEntities, in the order of the solid list
+ * @return number of entities in the list
+ */
+static int CG_SolidEntitiesInBounds(const vec3_t absmin, const vec3_t absmax, int *list)
+{
+	unsigned int bits[(MAX_ENTITIES_IN_SNAPSHOT + 31) / 32];
+	int          i, lo, hi, mid, num = 0;
+	float        *emin, *emax;
+
+	if (cg_solidIndexDisabled || cg_solidIndex.suspended)
+	{
+		for (i = 0 ; i < cg_numSolidEntities ; i++)
+		{
+			list[i] = i;
+		}
+		return cg_numSolidEntities;
+	}
+
+	if (cg_solidIndex.dirty || cg_solidIndex.physicsTime != cg.physicsTime)
+	{
+		CG_BuildSolidIndex();
+	}
+
+	Com_Memset(bits, 0, sizeof(bits));
+
+	// the first entity which may reach absmin along x
+	lo = 0;
+	hi = cg_solidIndex.numSweep;
+	while (lo < hi)
+	{
+		mid = (lo + hi) >> 1;
+		if (cg_solidIndex.sweep[mid].absmin0 < absmin[0] - cg_solidIndex.maxWidth)
+		{
+			lo = mid + 1;
+		}
+		else
+		{
+			hi = mid;
+		}
+	}
+
+	for ( ; lo < cg_solidIndex.numSweep && cg_solidIndex.sweep[lo].absmin0 <= absmax[0]; lo++)
+	{
+		i    = cg_solidIndex.sweep[lo].index;
+		emin = cg_solidIndex.absmin[i];
+		emax = cg_solidIndex.absmax[i];
+
+		if (emax[0] < absmin[0] || emin[1] > absmax[1] || emax[1] < absmin[1] || emin[2] > absmax[2] || emax[2] < absmin[2])
+		{
+			continue;
+		}
+
+		bits[i >> 5] |= 1u << (i & 31);
+	}
+
+	for (mid = 0; mid < cg_solidIndex.numWide; mid++)
+	{
+		i    = cg_solidIndex.wide[mid];
+		emin = cg_solidIndex.absmin[i];
+		emax = cg_solidIndex.absmax[i];
+
+		if (emin[0] > absmax[0] || emax[0] < absmin[0] || emin[1] > absmax[1] || emax[1] < absmin[1] || emin[2] > absmax[2] || emax[2] < absmin[2])
+		{
+			continue;
+		}
+
+		bits[i >> 5] |= 1u << (i & 31);
+	}
+
+	// keep the order of the solid list, so results are the same as testing all entities
+	for (i = 0 ; i < cg_numSolidEntities ; i++)
+	{
+		if (!bits[i >> 5])
+		{
+			i |= 31;
+			continue;
+		}
+
+		if (bits[i >> 5] & (1u << (i & 31)))
+		{
+			list[num++] = i;
+		}
+	}
+
+	return num;
+}
+
+/**
+ * @brief Gets the bounds of a move
+ * @param[in] start
+ * @param[in] mins may be NULL
+ * @param[in] maxs may be NULL
+ * @param[in] end
+ * @param[out] absmin
+ * @param[out] absmax
+ */
+static void CG_MoveBounds(const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, vec3_t absmin, vec3_t absmax)
+{
+	int i;
+
+	for (i = 0; i < 3; i++)
+	{
+		if (start[i] < end[i])
+		{
+			absmin[i] = start[i];
+			absmax[i] = end[i];
+		}
+		else
+		{
+			absmin[i] = end[i];
+			absmax[i] = start[i];
+		}
+
+		if (mins)
+		{
+			absmin[i] += mins[i];
+		}
+		if (maxs)
+		{
+			absmax[i] += maxs[i];
+		}
+	}
 }
 
 // client-side hitbox prediction code modified for cgame
@@ -153,6 +447,58 @@ float CG_ClientHitboxMaxZ(entityState_t *hitEnt, float def)
 }
 
 
+/**
+ * @brief Gets the clip model of a solid entity and where it is
+ * @param[in] cent
+ * @param[out] origin
+ * @param[out] angles
+ * @param[out] bmins bounds of a box entity, untouched for bmodels
+ * @param[out] bmaxs
+ * @return
+ *
+ * @note The temporary box model of box entities is only valid until the next one is made.
+ */
+static clipHandle_t CG_SolidEntityClipModel(centity_t *cent, vec3_t origin, vec3_t angles, vec3_t bmins, vec3_t bmaxs)
+{
+	entityState_t *ent = &cent->currentState;
+	int           x, zd, zu;
+
+	if (ent->solid == SOLID_BMODEL)
+	{
+		// special value for bmodel
+		//VectorCopy( cent->lerpAngles, angles );
+		//VectorCopy( cent->lerpOrigin, origin );
+		BG_EvaluateTrajectory(&cent->currentState.apos, cg.physicsTime, angles, qtrue, cent->currentState.effect2Time);
+		BG_EvaluateTrajectory(&cent->currentState.pos, cg.physicsTime, origin, qfalse, cent->currentState.effect2Time);
+		return trap_CM_InlineModel(ent->modelindex);
+	}
+
+	// encoded bbox
+	x  = (ent->solid & 255);
+	zd = ((ent->solid >> 8) & 255);
+	zu = ((ent->solid >> 16) & 255) - 32;
+
+	bmins[0] = bmins[1] = -x;
+	bmaxs[0] = bmaxs[1] = x;
+	bmins[2] = -zd;
+
+	// client-side hitbox prediction code
+	if (ent->eType == ET_PLAYER && cg.bulletTrace)
+	{
+		bmaxs[2] = CG_ClientHitboxMaxZ(ent, zu);
+	}
+	else
+	{
+		bmaxs[2] = zu;
+	}
+
+	VectorCopy(vec3_origin, angles);
+	VectorCopy(cent->lerpOrigin, origin);
+
+	//return trap_CM_TempCapsuleModel( bmins, bmaxs );
+	return trap_CM_TempBoxModel(bmins, bmaxs);
+}
+
 /*
 ====================
 CG_ClipMoveToEntities
@@ -161,7 +507,8 @@ CG_ClipMoveToEntities
 static void CG_ClipMoveToEntities(const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end,
                                   int skipNumber, int mask, int capsule, trace_t *tr)
 {
-	int           i, x, zd, zu;
+	int           i, j, num, first;
+	int           list[MAX_ENTITIES_IN_SNAPSHOT];
 	trace_t       trace;
 	entityState_t *ent;
 	clipHandle_t  cmodel;
@@ -169,8 +516,20 @@ static void CG_ClipMoveToEntities(const vec3_t start, const vec3_t mins, const v
 	vec3_t        origin, angles;
 	centity_t     *cent;
 
-	for (i = 0 ; i < cg_numSolidEntities ; i++)
+	if (!cg_numSolidEntities)
+	{
+		return;
+	}
+
+	CG_MoveBounds(start, mins, maxs, end, bmins, bmaxs);
+	num = CG_SolidEntitiesInBounds(bmins, bmaxs, list);
+
+	// the first entity clipped against when testing them all
+	first = cg_solidEntities[0]->currentState.number == skipNumber ? 1 : 0;
+
+	for (j = 0 ; j < num ; j++)
 	{
+		i    = list[j];
 		cent = cg_solidEntities[i];
 		ent  = &cent->currentState;
 
@@ -179,42 +538,14 @@ static void CG_ClipMoveToEntities(const vec3_t start, const vec3_t mins, const v
 			continue;
 		}
 
-		if (ent->solid == SOLID_BMODEL)
+		// an allsolid world trace still gets the first entity
+		if (tr->allsolid && i > first)
 		{
-			// special value for bmodel
-			cmodel = trap_CM_InlineModel(ent->modelindex);
-			//VectorCopy( cent->lerpAngles, angles );
-			//VectorCopy( cent->lerpOrigin, origin );
-			BG_EvaluateTrajectory(&cent->currentState.apos, cg.physicsTime, angles, qtrue, cent->currentState.effect2Time);
-			BG_EvaluateTrajectory(&cent->currentState.pos, cg.physicsTime, origin, qfalse, cent->currentState.effect2Time);
+			return;
 		}
-		else
-		{
-			// encoded bbox
-			x  = (ent->solid & 255);
-			zd = ((ent->solid >> 8) & 255);
-			zu = ((ent->solid >> 16) & 255) - 32;
-
-			bmins[0] = bmins[1] = -x;
-			bmaxs[0] = bmaxs[1] = x;
-			bmins[2] = -zd;
-
-			// client-side hitbox prediction code
-			if (ent->eType == ET_PLAYER && cg.bulletTrace)
-			{
-				bmaxs[2] = CG_ClientHitboxMaxZ(ent, zu);
-			}
-			else
-			{
-				bmaxs[2] = zu;
-			}
 
-			//cmodel = trap_CM_TempCapsuleModel( bmins, bmaxs );
-			cmodel = trap_CM_TempBoxModel(bmins, bmaxs);
+		cmodel = CG_SolidEntityClipModel(cent, origin, angles, bmins, bmaxs);
 
-			VectorCopy(vec3_origin, angles);
-			VectorCopy(cent->lerpOrigin, origin);
-		}
 		// use bbox of capsule
 		if (capsule)
 		{
@@ -346,6 +677,195 @@ void CG_Trace(trace_t *result, const vec3_t start, const vec3_t mins, const vec3
 	*result = t;
 }
 
+#define SOLIDBENCH_PLAYERS  64
+#define SOLIDBENCH_MOVES    1024
+
+/**
+ * @brief Times traces against a snapshot of 64 players with and without the solid entity index
+ *
+ * @details The players are spread around the view origin, next to the solid bmodels
+ * of the current snapshot. Both ways must give the same results.
+ */
+void CG_SolidBenchmark_f(void)
+{
+	static centity_t players[SOLIDBENCH_PLAYERS];
+	static vec3_t    starts[SOLIDBENCH_MOVES], ends[SOLIDBENCH_MOVES];
+	static trace_t   results[SOLIDBENCH_MOVES];
+	centity_t        *savedSolid[MAX_ENTITIES_IN_SNAPSHOT];
+	int              savedNum = cg_numSolidEntities;
+	int              rounds   = 20, pass, round, i, start, msec[2], mismatches = 0;
+	vec3_t           mins     = { -18, -18, -24 }, maxs = { 18, 18, 48 };
+	vec3_t           dir;
+	trace_t          tr;
+
+	if (!cg.snap)
+	{
+		return;
+	}
+
+	if (trap_Argc() > 1)
+	{
+		rounds = atoi(CG_Argv(1));
+	}
+
+	if (rounds <= 0)
+	{
+		CG_Printf("usage: solidbench [rounds]\n");
+		return;
+	}
+
+	Com_Memcpy(savedSolid, cg_solidEntities, sizeof(savedSolid));
+
+	// players around the view, then the bmodels of the snapshot
+	cg_numSolidEntities = 0;
+	for (i = 0; i < SOLIDBENCH_PLAYERS; i++)
+	{
+		Com_Memset(&players[i], 0, sizeof(players[i]));
+		players[i].currentState.number = i;
+		players[i].currentState.eType  = ET_PLAYER;
+		players[i].currentState.solid  = 18 | (24 << 8) | ((48 + 32) << 16);
+		VectorSet(players[i].lerpOrigin, cg.refdef.vieworg[0] + crandom() * 1024, cg.refdef.vieworg[1] + crandom() * 1024, cg.refdef.vieworg[2] + crandom() * 64);
+
+		cg_solidEntities[cg_numSolidEntities++] = &players[i];
+	}
+	for (i = 0; i < savedNum && cg_numSolidEntities < MAX_ENTITIES_IN_SNAPSHOT; i++)
+	{
+		if (savedSolid[i]->currentState.solid == SOLID_BMODEL)
+		{
+			cg_solidEntities[cg_numSolidEntities++] = savedSolid[i];
+		}
+	}
+
+	// short moves like bullets, fragments and player moves
+	for (i = 0; i < SOLIDBENCH_MOVES; i++)
+	{
+		VectorSet(starts[i], cg.refdef.vieworg[0] + crandom() * 1024, cg.refdef.vieworg[1] + crandom() * 1024, cg.refdef.vieworg[2] + crandom() * 64);
+		VectorSet(dir, crandom(), crandom(), crandom() * 0.25f);
+		VectorNormalize(dir);
+		VectorMA(starts[i], 32 + random() * 256, dir, ends[i]);
+	}
+
+	for (pass = 0; pass < 2; pass++)
+	{
+		cg_solidIndexDisabled = pass;
+		cg_solidIndex.dirty   = qtrue;
+
+		start = trap_Milliseconds();
+		for (round = 0; round < rounds; round++)
+		{
+			for (i = 0; i < SOLIDBENCH_MOVES; i++)
+			{
+				CG_Trace(&tr, starts[i], (i & 1) ? mins : NULL, (i & 1) ? maxs : NULL, ends[i], -1, MASK_PLAYERSOLID);
+
+				if (!round)
+				{
+					if (!pass)
+					{
+						results[i] = tr;
+					}
+					else if (tr.fraction != results[i].fraction || tr.entityNum != results[i].entityNum || tr.allsolid != results[i].allsolid)
+					{
+						mismatches++;
+					}
+				}
+			}
+		}
+		msec[pass] = trap_Milliseconds() - start;
+	}
+
+	CG_Printf("solidbench: %i solid entities, %i traces: %i msec indexed, %i msec linear, %i mismatches\n",
+	          cg_numSolidEntities, rounds * SOLIDBENCH_MOVES, msec[0], msec[1], mismatches);
+
+	cg_solidIndexDisabled = qfalse;
+	cg_numSolidEntities   = savedNum;
+	Com_Memcpy(cg_solidEntities, savedSolid, sizeof(savedSolid));
+	cg_solidIndex.dirty = qtrue;
+}
+
+/**
+ * @brief Traces a batch of point moves against the world and the solid entities
+ * @param[in,out] traces
+ * @param[in] numTraces
+ * @param[in] mask
+ *
+ * @details Gives each move the same result as CG_Trace without bounds and skip entity.
+ * The solid entities near the batch are looked up once, and the clip model of each
+ * is set up once for the whole batch.
+ */
+void CG_TraceBatch(batchTrace_t *traces, int numTraces, int mask)
+{
+	int           i, j, k, num;
+	int           list[MAX_ENTITIES_IN_SNAPSHOT];
+	trace_t       trace;
+	batchTrace_t  *t;
+	entityState_t *ent;
+	clipHandle_t  cmodel;
+	vec3_t        mins, maxs;
+	vec3_t        bmins, bmaxs;
+	vec3_t        origin, angles;
+	vec3_t        absmin, absmax;
+	centity_t     *cent;
+
+	if (numTraces <= 0)
+	{
+		return;
+	}
+
+	ClearBounds(mins, maxs);
+
+	for (i = 0, t = traces; i < numTraces; i++, t++)
+	{
+		trap_CM_BoxTrace(&t->trace, t->start, t->end, NULL, NULL, 0, mask);
+		t->trace.entityNum = t->trace.fraction != 1.0f ? ENTITYNUM_WORLD : ENTITYNUM_NONE;
+
+		AddPointToBounds(t->start, mins, maxs);
+		AddPointToBounds(t->end, mins, maxs);
+	}
+
+	num = CG_SolidEntitiesInBounds(mins, maxs, list);
+
+	for (k = 0 ; k < num ; k++)
+	{
+		i      = list[k];
+		cent   = cg_solidEntities[i];
+		ent    = &cent->currentState;
+		cmodel = CG_SolidEntityClipModel(cent, origin, angles, bmins, bmaxs);
+
+		for (j = 0, t = traces; j < numTraces; j++, t++)
+		{
+			// CG_ClipMoveToEntities stops at allsolid
+			if (i > 0 && t->trace.allsolid)
+			{
+				continue;
+			}
+
+			if (!cg_solidIndexDisabled && !cg_solidIndex.suspended)
+			{
+				CG_MoveBounds(t->start, NULL, NULL, t->end, absmin, absmax);
+
+				if (cg_solidIndex.absmin[i][0] > absmax[0] || cg_solidIndex.absmax[i][0] < absmin[0] ||
+				    cg_solidIndex.absmin[i][1] > absmax[1] || cg_solidIndex.absmax[i][1] < absmin[1] ||
+				    cg_solidIndex.absmin[i][2] > absmax[2] || cg_solidIndex.absmax[i][2] < absmin[2])
+				{
+					continue;
+				}
+			}
+
+			trap_CM_TransformedBoxTrace(&trace, t->start, t->end, NULL, NULL, cmodel, mask, origin, angles);
+
+			if (trace.allsolid || trace.fraction < t->trace.fraction)
+			{
+				trace.entityNum = ent->number;
+				t->trace        = trace;
+			}
+			else if (trace.startsolid)
+			{
+				t->trace.startsolid = qtrue;
+			}
+		}
+	}
+}
+
 /* unused
 void CG_Trace_World(trace_t *result, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end,
                     int skipNumber, int mask)
@@ -801,11 +1321,6 @@ qboolean CG_PredictionOk(playerState_t *ps1, playerState_t *ps2)
 	return qtrue;
 }
 
-#define RESET_PREDICTION                        \
-	cg.lastPredictedCommand = 0;                \
-	cg.backupStateTail      = cg.backupStateTop;     \
-	useCommand              = current - CMD_BACKUP + 1;
-
 
 /*
 =================
@@ -820,15 +1335,11 @@ playerState_t.
 For normal gameplay, it will be the result of predicted usercmd_t on
 top of the most recent playerState_t received from the server.
 
-Each new snapshot will usually have one or more new usercmd over the last,
-but we simulate all unacknowledged commands each time, not just the new ones.
-This means that on an internet connection, quite a few pmoves may be issued
-each frame.
-
-OPTIMIZE: don't re-simulate unless the newly arrived snapshot playerState_t
-differs from the predicted one.  Would require saving all intermediate
-playerState_t during prediction. (this is "dead reckoning" and would definately
-be nice to have in there
+Each new snapshot will usually have one or more new usercmd over the last.
+The state after each predicted command is kept, so as long as the snapshot
+playerState_t matches what was predicted for the command it acknowledges,
+only the commands issued since the last frame are simulated. Otherwise all
+unacknowledged commands are simulated again from the snapshot.
 
 We detect prediction errors and allow them to be decayed off over several frames
 to ease the jerk.
@@ -844,10 +1355,156 @@ to ease the jerk.
 
 pmoveExt_t oldpmext[CMD_BACKUP];
 
+/**
+ * @struct predictedState_t
+ * @brief State after a predicted command, see CG_ResumePrediction
+ */
+typedef struct
+{
+	int commandNum;
+	int prevCommandNum;                 // command predicted before this one, -1 if it started from a snapshot
+	playerState_t ps;
+	pmoveExt_t pmext;
+} predictedState_t;
+
+static predictedState_t cg_predictedStates[CMD_BACKUP];
+static int              cg_lastPredictedCommand = -1;   // end of the chain of predicted states, -1 if none
+static int              cg_predictedSnapTime;           // server time of the snapshot the chain started from
+static int              cg_predictedPmoveFixed;
+static int              cg_predictedPmoveMsec;
+
+/**
+ * @brief Gets a predicted state if it is still the one of its command
+ * @param[in] commandNum
+ * @return
+ */
+static predictedState_t *CG_PredictedState(int commandNum)
+{
+	predictedState_t *state = &cg_predictedStates[commandNum & CMD_MASK];
+
+	if (commandNum < 0 || state->commandNum != commandNum)
+	{
+		return NULL;
+	}
+
+	return state;
+}
+
+/**
+ * @brief Carries the server owned fields CG_PredictionOk doesn't compare over to
+ * the states predicted after the snapshot
+ * @param[in] commandNum command acknowledged by the snapshot
+ *
+ * @details Ammo given or picked up, charge bar changes and new weapons only show
+ * up in the snapshot. The changes against the predicted state of the acknowledged
+ * command are added to it and every later state, so the next frames start from
+ * the refreshed states too.
+ */
+static void CG_RefreshPredictedStates(int commandNum)
+{
+	playerState_t    *ps = &CG_PredictedState(commandNum)->ps;
+	predictedState_t *state;
+	int              ammo[MAX_WEAPONS], ammoclip[MAX_WEAPONS], classWeaponTime, i;
+
+	for (i = 0; i < MAX_WEAPONS; i++)
+	{
+		ammo[i]     = cg.snap->ps.ammo[i] - ps->ammo[i];
+		ammoclip[i] = cg.snap->ps.ammoclip[i] - ps->ammoclip[i];
+	}
+	classWeaponTime = cg.snap->ps.classWeaponTime - ps->classWeaponTime;
+
+	for (state = CG_PredictedState(cg_lastPredictedCommand); state; state = CG_PredictedState(state->prevCommandNum))
+	{
+		for (i = 0; i < MAX_WEAPONS; i++)
+		{
+			state->ps.ammo[i]     += ammo[i];
+			state->ps.ammoclip[i] += ammoclip[i];
+		}
+		state->ps.classWeaponTime += classWeaponTime;
+		memcpy(state->ps.weapons, cg.snap->ps.weapons, sizeof(state->ps.weapons));
+
+		if (state->commandNum == commandNum)
+		{
+			break;
+		}
+	}
+}
+
+/**
+ * @brief Checks if the prediction of the last frame can be carried on
+ * @param[in] current current command number
+ * @return the last predicted command, -1 if all commands have to be predicted again
+ *
+ * @details Walks the chain of predicted states back to the command acknowledged
+ * by the snapshot. If the snapshot state matches what was predicted for that
+ * command, or the snapshot is still the one the chain started from, all the
+ * states predicted after it are still good.
+ *
+ * The yaw of prone players and set mortars follows rotating movers. It is
+ * added to the state rebuilt from the snapshot each frame, so the chain isn't
+ * carried on while standing on a mover then.
+ */
+static int CG_ResumePrediction(int current)
+{
+	predictedState_t *state;
+	int              commandNum = cg_lastPredictedCommand;
+
+	if (!cg_optimizePrediction.integer || commandNum < 0 || commandNum > current || commandNum <= current - CMD_BACKUP)
+	{
+		return -1;
+	}
+
+	if (cg.thisFrameTeleport || cg.serverRespawning || cg_predictedPmoveFixed != pmove_fixed.integer || cg_predictedPmoveMsec != pmove_msec.integer)
+	{
+		return -1;
+	}
+
+	state = CG_PredictedState(commandNum);
+	if (state && ((state->ps.eFlags & EF_PRONE) || IS_MORTAR_WEAPON_SET(cg.weaponSelect))
+	    && state->ps.groundEntityNum > 0 && state->ps.groundEntityNum < ENTITYNUM_MAX_NORMAL
+	    && cg_entities[state->ps.groundEntityNum].currentState.eType == ET_MOVER)
+	{
+		return -1;
+	}
+
+	while ((state = CG_PredictedState(commandNum)) != NULL)
+	{
+		if (state->ps.commandTime == cg.snap->ps.commandTime)
+		{
+			if (!CG_PredictionOk(&cg.snap->ps, &state->ps))
+			{
+				if (cg_showmiss.integer)
+				{
+					CG_Printf("prediction diverged at command %i\n", commandNum);
+				}
+				return -1;
+			}
+			CG_RefreshPredictedStates(commandNum);
+			return cg_lastPredictedCommand;
+		}
+
+		// the snapshot is past the chain or didn't reach it
+		if (state->ps.commandTime < cg.snap->ps.commandTime)
+		{
+			return -1;
+		}
+
+		// still the snapshot the chain started from
+		if (state->prevCommandNum < 0)
+		{
+			return cg.snap->serverTime == cg_predictedSnapTime ? cg_lastPredictedCommand : -1;
+		}
+
+		commandNum = state->prevCommandNum;
+	}
+
+	return -1;
+}
+
 void CG_PredictPlayerState(void)
 {
-	int           cmdNum, current;
-	playerState_t oldPlayerState;
+	int           cmdNum, current, resumeCmd, prevCmd, verifyCmd = -1;
+	playerState_t oldPlayerState, verifyState;
 	qboolean      moved;
 	usercmd_t     oldestCmd;
 	usercmd_t     latestCmd;
@@ -863,11 +1520,13 @@ void CG_PredictPlayerState(void)
 	{
 		cg.validPPS             = qtrue;
 		cg.predictedPlayerState = cg.snap->ps;
+		cg_lastPredictedCommand = -1;
 	}
 
 	// demo playback just copies the moves
 	if (cg.demoPlayback || (cg.snap->ps.pm_flags & PMF_FOLLOW))
 	{
+		cg_lastPredictedCommand = -1;
 		CG_InterpolatePlayerState(qfalse);
 		return;
 	}
@@ -879,7 +1538,8 @@ void CG_PredictPlayerState(void)
 #endif // ALLOW_GSYNC
 	    )
 	{
-		cg_pmove.ps    = &cg.predictedPlayerState;
+		cg_lastPredictedCommand = -1;
+		cg_pmove.ps             = &cg.predictedPlayerState;
 		cg_pmove.pmext = &cg.pmext;
 
 		cg.pmext.airleft = (cg.waterundertime - cg.time);
@@ -1021,10 +1681,46 @@ void CG_PredictPlayerState(void)
 	cg_pmove.pmove_fixed = pmove_fixed.integer;     // | cg_pmove_fixed.integer;
 	cg_pmove.pmove_msec  = pmove_msec.integer;
 
+	// carry on from the last frame if the snapshot agrees with it
+	moved     = qfalse;
+	prevCmd   = -1;
+	resumeCmd = CG_ResumePrediction(current);
+
+	if (resumeCmd >= 0 && cg_optimizePrediction.integer > 1)
+	{
+		// predict everything again and check it ends up the same
+		verifyCmd   = resumeCmd;
+		verifyState = CG_PredictedState(resumeCmd)->ps;
+		resumeCmd   = -1;
+	}
+
+	if (resumeCmd >= 0)
+	{
+		predictedState_t *state = CG_PredictedState(resumeCmd);
+
+		cg.predictedPlayerState = state->ps;
+		memcpy(&pmext, &state->pmext, sizeof(pmoveExt_t));
+
+		moved   = qtrue;
+		prevCmd = resumeCmd;
+	}
+	else
+	{
+		cg_lastPredictedCommand = -1;
+		cg_predictedSnapTime    = cg.snap->serverTime;
+		cg_predictedPmoveFixed  = pmove_fixed.integer;
+		cg_predictedPmoveMsec   = pmove_msec.integer;
+	}
+
 	// run cmds
-	moved = qfalse;
 	for (cmdNum = current - CMD_BACKUP + 1 ; cmdNum <= current ; cmdNum++)
 	{
+		// already predicted
+		if (cmdNum <= resumeCmd)
+		{
+			continue;
+		}
+
 		// get the command
 		trap_GetUserCmd(cmdNum, &cg_pmove.cmd);
 		// get the previous command
@@ -1082,8 +1778,9 @@ void CG_PredictPlayerState(void)
 
 				CG_AdjustPositionForMover(cg.predictedPlayerState.origin, cg.predictedPlayerState.groundEntityNum, cg.physicsTime, cg.oldTime, adjusted, deltaAngles);
 				// add the deltaAngles (fixes jittery view while riding trains)
-				// only do this if player is prone or using set mortar
-				if ((cg.predictedPlayerState.eFlags & EF_PRONE) || IS_MORTAR_WEAPON_SET(cg.weaponSelect))
+				// only do this if player is prone or using set mortar, and only
+				// once on the state rebuilt from the snapshot, a resumed one has it
+				if (resumeCmd < 0 && ((cg.predictedPlayerState.eFlags & EF_PRONE) || IS_MORTAR_WEAPON_SET(cg.weaponSelect)))
 				{
 					cg.predictedPlayerState.delta_angles[YAW] += ANGLE2SHORT(deltaAngles[YAW]);
 				}
@@ -1163,10 +1860,34 @@ void CG_PredictPlayerState(void)
 
 		moved = qtrue;
 
+		// keep the state for the next frames
+		{
+			predictedState_t *state = &cg_predictedStates[cmdNum & CMD_MASK];
+
+			state->commandNum     = cmdNum;
+			state->prevCommandNum = prevCmd;
+			state->ps             = cg.predictedPlayerState;
+			memcpy(&state->pmext, &pmext, sizeof(pmoveExt_t));
+
+			prevCmd                 = cmdNum;
+			cg_lastPredictedCommand = cmdNum;
+		}
+
+		if (cmdNum == verifyCmd && !CG_PredictionOk(&verifyState, &cg.predictedPlayerState))
+		{
+			CG_Printf("^3prediction cache mismatch at command %i\n", cmdNum);
+		}
+
 		// add push trigger movement effects
 		CG_TouchTriggerPrediction();
 	}
 
+	// nothing new was predicted, but triggers are touched every frame
+	if (resumeCmd >= 0 && prevCmd == resumeCmd)
+	{
+		CG_TouchTriggerPrediction();
+	}
+
 	if (cg_showmiss.integer > 1)
 	{
 		CG_Printf("[%i : %i] ", cg_pmove.cmd.serverTime, cg.time);
@@ -265,6 +265,8 @@ typedef enum
 
 	CG_R_FINISH,               // 179
 
+	CG_CVAR_CHANGES,           // ( int *sequence, int *handles, int maxHandles ); added after 274 release
+
 } cgameImport_t;
 
 /*
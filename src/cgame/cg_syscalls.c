@@ -80,6 +80,11 @@ void trap_Cvar_Update(vmCvar_t *vmCvar)
 	syscall(CG_CVAR_UPDATE, vmCvar);
 }
 
+int trap_Cvar_Changes(int *sequence, int *handles, int maxHandles)
+{
+	return syscall(CG_CVAR_CHANGES, sequence, handles, maxHandles);
+}
+
 void trap_Cvar_Set(const char *var_name, const char *value)
 {
 	syscall(CG_CVAR_SET, var_name, value);
@@ -305,6 +305,11 @@ void CL_ConfigstringModified(void)
 		// parse serverId and other cvars
 		CL_SystemInfoChanged();
 	}
+	else if (index == CS_SERVERINFO)
+	{
+		// the next map is published at the intermission
+		CL_CheckPreload();
+	}
 }
 
 /*
@@ -628,6 +633,8 @@ intptr_t CL_CgameSystemCalls(intptr_t *args)
 	case CG_CVAR_UPDATE:
 		Cvar_Update(VMA(1));
 		return 0;
+	case CG_CVAR_CHANGES:
+		return Cvar_Changes(VMA(1), VMA(2), args[3]);
 	case CG_CVAR_SET:
 		Cvar_SetSafe(VMA(1), VMA(2));
 		return 0;
@@ -1169,6 +1176,9 @@ void CL_InitCGame(void)
 	mapname = Info_ValueForKey(info, "mapname");
 	Com_sprintf(cl.mapname, sizeof(cl.mapname), "maps/%s.bsp", mapname);
 
+	// keep what was preloaded of this map for the load
+	CL_FinishPreload(mapname);
+
 	// load the dll
 	cgvm = VM_Create("cgame", qtrue, CL_CgameSystemCalls, VMI_NATIVE);
 	if (!cgvm)
@@ -1201,6 +1211,10 @@ void CL_InitCGame(void)
 	// on the card even if the driver does deferred loading
 	re.EndRegistration();
 
+	// the preloaded files are read now, look out for the next map
+	CL_ClearPreload();
+	CL_CheckPreload();
+
 	// make sure everything is paged in
 	if (!Sys_LowPhysicalMemory())
 	{
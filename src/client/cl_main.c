@@ -616,6 +616,8 @@ void CL_Disconnect(qboolean showMainMenu)
 
 	CL_DemoCleanUp();
 
+	CL_ClearPreload();
+
 	if (uivm && showMainMenu)
 	{
 		VM_Call(uivm, UI_SET_ACTIVE_MENU, UIMENU_NONE);
@@ -2247,6 +2249,9 @@ void CL_Frame(int msec)
 	// request motd and update data from the master server
 	CL_RequestMasterData(qfalse);
 
+	// hand over the files of the next map read in the background
+	CL_PreloadFrame();
+
 	// decide on the serverTime to render
 	CL_SetCGameTime();
 
@@ -2666,13 +2671,14 @@ void CL_InitRef(void)
 	ri.CM_PointContents    = CM_PointContents;
 	ri.CM_DrawDebugSurface = CM_DrawDebugSurface;
 
-	ri.FS_ReadFile     = FS_ReadFile;
-	ri.FS_FreeFile     = FS_FreeFile;
-	ri.FS_WriteFile    = FS_WriteFile;
-	ri.FS_FreeFileList = FS_FreeFileList;
-	ri.FS_ListFiles    = FS_ListFiles;
-	ri.FS_FileIsInPAK  = FS_FileIsInPAK;
-	ri.FS_FileExists   = FS_FileExists;
+	ri.FS_ReadFile        = FS_ReadFile;
+	ri.FS_FreeFile        = FS_FreeFile;
+	ri.FS_WriteFile       = FS_WriteFile;
+	ri.FS_FreeFileList    = FS_FreeFileList;
+	ri.FS_ListFiles       = FS_ListFiles;
+	ri.FS_FileIsInPAK     = FS_FileIsInPAK;
+	ri.FS_FileExists      = FS_FileExists;
+	ri.FS_FilePakChecksum = FS_FilePakChecksum;
 
 	ri.FS_FOpenFileRead = FS_FOpenFileRead;
 	ri.FS_Read          = FS_Read;
@@ -2924,6 +2930,8 @@ void CL_Init(void)
 
 	CL_DemoInit();
 
+	CL_PreloadInit();
+
 	CL_InitRef();
 
 	SCR_Init();
@@ -2971,6 +2979,8 @@ void CL_Shutdown(void)
 
 	CL_Disconnect(qtrue);
 
+	CL_PreloadShutdown();
+
 	S_Shutdown();
 	DL_Shutdown();
 	CL_ShutdownRef();
@@ -0,0 +1,481 @@
+/*
+ * Wolfenstein: Enemy Territory GPL Source Code
+ * Copyright (C) 1999-2010 id Software LLC, a ZeniMax Media company.
+ *
+ * ET: Legacy
+ * Copyright (C) 2012 Jan Simek <mail@etlegacy.com>
+ * Copyright (C) 2013 Jere "Jacker" S
+ * This file is part of ET: Legacy - http://www.etlegacy.com
+ *
+ * ET: Legacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ET: Legacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ET: Legacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * In addition, Wolfenstein: Enemy Territory GPL Source Code is also
+ * subject to certain additional terms. You should have received a copy
+ * of these additional terms immediately following the terms and conditions
+ * of the GNU General Public License which accompanied the source code.
+ * If not, please request a copy in writing from id Software at the address below.
+ *
+ * id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+ */
+/**
+ * @file cl_preload.c
+ * @brief Background preload of the next map
+ *
+ * During the intermission the server publishes the next map of its rotation
+ * in the g_nextMapName serverinfo key. With cl_preloadNextMap a thread then
+ * reads the BSP of that map from its pk3, followed by the images and models
+ * the BSP refers to and the rest of the map pk3. The contents are handed
+ * to the file system, so FS_ReadFile copies them from memory when the map
+ * is loaded instead of inflating them again. Nothing but the pk3 files is
+ * touched by the thread, parsing the BSP and looking up the files is done
+ * on the main thread in between.
+ */
+
+#include "client.h"
+#include "../sdl/sdl_defs.h"
+
+#define MAX_PRELOAD_FILES       2048
+#define PRELOAD_HASH_SIZE       1024
+#define PRELOAD_MAX_MEMORY      (256 * 1024 * 1024)
+
+typedef struct preloadFile_s
+{
+	char name[MAX_QPATH];
+	fsPakEntry_t entry;
+	void *buffer;                   // read by the thread, owned by the file system once handed
+	struct preloadFile_s *hashNext;
+} preloadFile_t;
+
+static struct
+{
+	char mapname[MAX_QPATH];
+	int startTime;
+
+	preloadFile_t files[MAX_PRELOAD_FILES];
+	int numFiles;                   // don't change while the thread runs
+	preloadFile_t *hashTable[PRELOAD_HASH_SIZE];
+	int memory;
+	qboolean listed;                // files the BSP refers to are listed
+
+	int numHanded;                  // files handed to the file system
+	SDL_atomic_t numRead;           // files done by the thread
+	SDL_atomic_t cancel;
+	SDL_Thread *thread;
+} preload;
+
+cvar_t *cl_preloadNextMap;
+
+/**
+ * @brief Reads the listed files which aren't read yet
+ * @param data unused
+ * @return
+ */
+static int CL_PreloadThread(void *data)
+{
+	fsPakReader_t *reader = NULL;
+	preloadFile_t *file;
+	int           i;
+
+	for (i = SDL_AtomicGet(&preload.numRead); i < preload.numFiles; i++)
+	{
+		if (SDL_AtomicGet(&preload.cancel))
+		{
+			break;
+		}
+
+		file         = &preload.files[i];
+		file->buffer = malloc(file->entry.len + 1);
+
+		if (file->buffer && !FS_ReadPakEntry(&reader, &file->entry, file->buffer))
+		{
+			free(file->buffer);
+			file->buffer = NULL;
+		}
+
+		SDL_AtomicSet(&preload.numRead, i + 1);
+	}
+
+	FS_ClosePakReader(&reader);
+	return 0;
+}
+
+/**
+ * @brief Starts the thread on the files which aren't read yet
+ */
+static void CL_StartPreloadThread(void)
+{
+	SDL_AtomicSet(&preload.cancel, 0);
+
+	preload.thread = SDL_CreateThread(CL_PreloadThread, "preload", NULL);
+	if (!preload.thread)
+	{
+		Com_Printf(S_COLOR_YELLOW "WARNING: CL_StartPreloadThread: %s\n", SDL_GetError());
+		preload.numFiles = SDL_AtomicGet(&preload.numRead);
+	}
+}
+
+/**
+ * @brief Waits for the thread to stop
+ * @param[in] cancel don't read the remaining files
+ */
+static void CL_WaitPreloadThread(qboolean cancel)
+{
+	if (!preload.thread)
+	{
+		return;
+	}
+
+	if (cancel)
+	{
+		SDL_AtomicSet(&preload.cancel, 1);
+	}
+
+	SDL_WaitThread(preload.thread, NULL);
+	preload.thread = NULL;
+}
+
+/**
+ * @brief Lists a file for the thread if it's read from a pk3 and fits the budget
+ * @param[in] name
+ */
+static void CL_AddPreloadFile(const char *name)
+{
+	preloadFile_t *file;
+	long          hash;
+
+	if (preload.numFiles == MAX_PRELOAD_FILES || strlen(name) >= MAX_QPATH)
+	{
+		return;
+	}
+
+	hash = Q_GenerateHashValue(name, PRELOAD_HASH_SIZE, qfalse, qtrue);
+
+	for (file = preload.hashTable[hash]; file; file = file->hashNext)
+	{
+		if (!Q_stricmp(file->name, name))
+		{
+			return;
+		}
+	}
+
+	file = &preload.files[preload.numFiles];
+
+	if (!FS_FindPakEntry(name, &file->entry) || preload.memory + file->entry.len > PRELOAD_MAX_MEMORY)
+	{
+		return;
+	}
+
+	Q_strncpyz(file->name, name, sizeof(file->name));
+	file->buffer   = NULL;
+	file->hashNext = preload.hashTable[hash];
+
+	preload.hashTable[hash] = file;
+	preload.memory         += file->entry.len;
+	preload.numFiles++;
+}
+
+/**
+ * @brief Lists an image of a BSP shader, the renderer looks for .jpg files if there is no .tga
+ * @param[in] shader
+ */
+static void CL_AddPreloadImage(const char *shader)
+{
+	char         name[MAX_QPATH];
+	fsPakEntry_t entry;
+
+	COM_StripExtension(shader, name, sizeof(name));
+	Q_strcat(name, sizeof(name), ".tga");
+
+	if (!FS_FindPakEntry(name, &entry))
+	{
+		COM_StripExtension(shader, name, sizeof(name));
+		Q_strcat(name, sizeof(name), ".jpg");
+	}
+
+	CL_AddPreloadFile(name);
+}
+
+/**
+ * @brief Lists the files a BSP refers to and the other files of its pk3
+ * @param[in] bsp
+ */
+static void CL_ListPreloadMapFiles(preloadFile_t *bsp)
+{
+	dheader_t       *header = (dheader_t *)bsp->buffer;
+	const dshader_t *shaders;
+	lump_t          *lump;
+	char            *entities, *p, *token;
+	char            key[MAX_TOKEN_CHARS];
+	char            name[MAX_QPATH];
+	char            **pakFiles;
+	int             i, numShaders, numPakFiles;
+
+	if (!bsp->buffer || bsp->entry.len < (int)sizeof(*header))
+	{
+		return;
+	}
+
+	for (i = 0; i < HEADER_LUMPS; i++)
+	{
+		lump = &header->lumps[i];
+		if (LittleLong(lump->fileofs) < 0 || LittleLong(lump->filelen) < 0 || LittleLong(lump->fileofs) + LittleLong(lump->filelen) > bsp->entry.len)
+		{
+			return;
+		}
+	}
+
+	if (LittleLong(header->ident) != BSP_IDENT || LittleLong(header->version) != BSP_VERSION)
+	{
+		return;
+	}
+
+	// images of the map shaders
+	lump       = &header->lumps[LUMP_SHADERS];
+	shaders    = (const dshader_t *)((byte *)bsp->buffer + LittleLong(lump->fileofs));
+	numShaders = LittleLong(lump->filelen) / sizeof(dshader_t);
+
+	for (i = 0; i < numShaders; i++)
+	{
+		// the buffer is handed to the file system as it is, don't terminate the name in it
+		Q_strncpyz(name, shaders[i].shader, sizeof(name));
+		CL_AddPreloadImage(name);
+	}
+
+	// models of the entities
+	lump     = &header->lumps[LUMP_ENTITIES];
+	entities = Z_Malloc(LittleLong(lump->filelen) + 1);
+	Com_Memcpy(entities, (byte *)bsp->buffer + LittleLong(lump->fileofs), LittleLong(lump->filelen));
+	entities[LittleLong(lump->filelen)] = '\0';
+
+	p = entities;
+	while (1)
+	{
+		token = COM_Parse(&p);
+		if (!p || !token[0])
+		{
+			break;
+		}
+
+		if (token[0] == '{' || token[0] == '}')
+		{
+			continue;
+		}
+
+		Q_strncpyz(key, token, sizeof(key));
+		token = COM_Parse(&p);
+
+		if ((!Q_stricmp(key, "model") || !Q_stricmp(key, "model2")) && token[0] && token[0] != '*')
+		{
+			CL_AddPreloadFile(token);
+		}
+	}
+
+	Z_Free(entities);
+
+	// whatever else comes with the map, sounds are streamed from the pk3
+	pakFiles = FS_ListPakEntries(&bsp->entry, &numPakFiles);
+
+	for (i = 0; i < numPakFiles; i++)
+	{
+		if (!COM_CompareExtension(pakFiles[i], ".wav") && !COM_CompareExtension(pakFiles[i], ".ogg"))
+		{
+			CL_AddPreloadFile(pakFiles[i]);
+		}
+	}
+
+	FS_FreeFileList(pakFiles);
+}
+
+/**
+ * @brief Hands the files read by the thread to the file system
+ */
+static void CL_HandPreloadedFiles(void)
+{
+	preloadFile_t *file;
+	int           numRead = SDL_AtomicGet(&preload.numRead);
+
+	for ( ; preload.numHanded < numRead; preload.numHanded++)
+	{
+		file = &preload.files[preload.numHanded];
+
+		if (file->buffer)
+		{
+			FS_AddPreloadedFile(&file->entry, file->buffer);
+		}
+	}
+}
+
+/**
+ * @brief Stops the preload and frees all preloaded files
+ */
+void CL_ClearPreload(void)
+{
+	int i;
+
+	CL_WaitPreloadThread(qtrue);
+
+	// the handed files are freed by the file system
+	for (i = preload.numHanded; i < SDL_AtomicGet(&preload.numRead); i++)
+	{
+		free(preload.files[i].buffer);
+	}
+
+	FS_ClearPreloadedFiles();
+
+	Com_Memset(&preload, 0, sizeof(preload));
+}
+
+/**
+ * @brief Starts to preload a map
+ * @param[in] mapname
+ */
+static void CL_StartPreload(const char *mapname)
+{
+	CL_ClearPreload();
+
+	Q_strncpyz(preload.mapname, mapname, sizeof(preload.mapname));
+	preload.startTime = Sys_Milliseconds();
+
+	// the BSP goes first, the other files are listed from it
+	CL_AddPreloadFile(va("maps/%s.bsp", mapname));
+
+	if (!preload.numFiles)
+	{
+		Com_DPrintf("CL_StartPreload: maps/%s.bsp isn't in a pk3\n", mapname);
+		return;
+	}
+
+	Com_DPrintf("Preloading %s\n", mapname);
+
+	CL_StartPreloadThread();
+}
+
+/**
+ * @brief Starts to preload the next map when the server publishes it
+ *
+ * @note Called when the serverinfo changes.
+ */
+void CL_CheckPreload(void)
+{
+	char info[MAX_INFO_STRING];
+	char nextMap[MAX_QPATH];
+
+	if (!cl_preloadNextMap->integer || clc.demoplaying || cls.state < CA_PRIMED)
+	{
+		return;
+	}
+
+	Q_strncpyz(info, cl.gameState.stringData + cl.gameState.stringOffsets[CS_SERVERINFO], sizeof(info));
+	Q_strncpyz(nextMap, Info_ValueForKey(info, "g_nextMapName"), sizeof(nextMap));
+
+	if (!nextMap[0] || !Q_stricmp(nextMap, preload.mapname) || !Q_stricmp(nextMap, Info_ValueForKey(info, "mapname")))
+	{
+		return;
+	}
+
+	CL_StartPreload(nextMap);
+}
+
+/**
+ * @brief Hands the files read in the background to the file system and lists
+ * the files of the map once the BSP is read
+ *
+ * @note Called every client frame.
+ */
+void CL_PreloadFrame(void)
+{
+	if (!preload.thread)
+	{
+		return;
+	}
+
+	if (SDL_AtomicGet(&preload.numRead) < preload.numFiles)
+	{
+		CL_HandPreloadedFiles();
+		return;
+	}
+
+	CL_WaitPreloadThread(qfalse);
+
+	if (!preload.listed)
+	{
+		preload.listed = qtrue;
+		CL_ListPreloadMapFiles(&preload.files[0]);
+	}
+
+	CL_HandPreloadedFiles();
+
+	if (SDL_AtomicGet(&preload.numRead) < preload.numFiles)
+	{
+		CL_StartPreloadThread();
+		return;
+	}
+
+	Com_DPrintf("Preloaded %i files of %s, %i KB in %i msec\n", preload.numFiles, preload.mapname,
+	            preload.memory / 1024, Sys_Milliseconds() - preload.startTime);
+}
+
+/**
+ * @brief Stops the preload when a map is loaded, the files read so far stay
+ * with the file system if it's the preloaded map
+ * @param[in] mapname
+ *
+ * @note Call CL_ClearPreload once the map is loaded.
+ */
+void CL_FinishPreload(const char *mapname)
+{
+	if (Q_stricmp(mapname, preload.mapname))
+	{
+		CL_ClearPreload();
+		return;
+	}
+
+	// the load reads whatever is left itself
+	CL_WaitPreloadThread(qtrue);
+	CL_HandPreloadedFiles();
+}
+
+/**
+ * @brief Preloads a map like it was published as the next map
+ */
+static void CL_PreloadMap_f(void)
+{
+	if (Cmd_Argc() != 2)
+	{
+		Com_Printf("usage: preloadmap <mapname>\n");
+		return;
+	}
+
+	CL_StartPreload(Cmd_Argv(1));
+}
+
+/**
+ * @brief Registers the preload cvar and command
+ */
+void CL_PreloadInit(void)
+{
+	cl_preloadNextMap = Cvar_Get("cl_preloadNextMap", "0", CVAR_ARCHIVE);
+
+	Cmd_AddCommand("preloadmap", CL_PreloadMap_f);
+}
+
+/**
+ * @brief Stops the preload and removes its command
+ */
+void CL_PreloadShutdown(void)
+{
+	CL_ClearPreload();
+
+	Cmd_RemoveCommand("preloadmap");
+}
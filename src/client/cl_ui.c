@@ -959,6 +959,8 @@ intptr_t CL_UISystemCalls(intptr_t *args)
 	case UI_CVAR_UPDATE:
 		Cvar_Update(VMA(1));
 		return 0;
+	case UI_CVAR_CHANGES:
+		return Cvar_Changes(VMA(1), VMA(2), args[3]);
 	case UI_CVAR_SET:
 		Cvar_SetSafe(VMA(1), VMA(2));
 		return 0;
@@ -477,6 +477,16 @@ void CL_StopRecord_f(void);
 void CL_DemoRun(void);
 void CL_DemoInit(void);
 
+// cl_preload
+extern cvar_t *cl_preloadNextMap;
+
+void CL_PreloadInit(void);
+void CL_PreloadShutdown(void);
+void CL_PreloadFrame(void);
+void CL_CheckPreload(void);
+void CL_FinishPreload(const char *mapname);
+void CL_ClearPreload(void);
+
 // cl_input
 
 typedef struct
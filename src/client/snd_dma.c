@@ -91,6 +91,8 @@ cvar_t *s_show;
 cvar_t *s_mixahead;
 cvar_t *s_mixPreStep;
 cvar_t *s_debugStreams;
+cvar_t *s_mixSIMD;
+cvar_t *s_mixThread;
 
 static loopSound_t loopSounds[MAX_LOOP_SOUNDS];
 static vec3_t      entityPositions[MAX_GENTITIES];
@@ -100,6 +102,17 @@ static int         numLoopSounds;
 int                   s_rawend[MAX_RAW_STREAMS];
 portable_samplepair_t s_rawsamples[MAX_RAW_STREAMS][MAX_RAW_SAMPLES];
 
+// with s_mixThread the channels are handed to the mixer thread through a
+// triple buffer, the third buffer is the one shared by SNDDMA_ExchangeMixFrame
+#define MIXFRAME_NEW 4
+
+static mixFrame_t        s_mixFrames[3];
+static int               s_mixFrameBack;        // filled by the main thread
+static int               s_mixFrameFront;       // mixed by the mixer thread
+static qboolean          s_mixThreadStarted;
+static volatile qboolean s_mixThreadPaused;     // the main thread mixes while recording videos
+static volatile qboolean s_mixThreadReset;      // the mixer thread wrapped the sample counters
+
 // ====================================================================
 // User-setable variables
 // ====================================================================
@@ -444,7 +457,17 @@ void S_Base_BeginRegistration(void)
 
 	if (numSfx == 0)
 	{
-		SND_setup();
+		if (s_mixThreadStarted)
+		{
+			SNDDMA_BeginPainting();
+			Com_Memset(s_mixFrames, 0, sizeof(s_mixFrames));
+			SND_setup();
+			SNDDMA_Submit();
+		}
+		else
+		{
+			SND_setup();
+		}
 
 		numSfx = 0;
 		Com_Memset(knownSfx, 0, sizeof(knownSfx));
@@ -700,6 +723,14 @@ void S_Base_ClearSounds(qboolean clearStreaming, qboolean clearMusic)
 		return;
 	}
 
+	// don't let the mixer thread play the old channels until the next update
+	if (s_mixThreadStarted)
+	{
+		SNDDMA_BeginPainting();
+		Com_Memset(s_mixFrames, 0, sizeof(s_mixFrames));
+		SNDDMA_Submit();
+	}
+
 	// stop looping sounds
 	Com_Memset(loopSounds, 0, MAX_LOOP_SOUNDS * sizeof(loopSound_t));
 	Com_Memset(loop_channels, 0, MAX_CHANNELS * sizeof(channel_t));
@@ -1314,9 +1345,10 @@ void S_Base_Respatialize(int entnum, const vec3_t head, vec3_t axis[3], int inwa
 }
 
 /**
+ * @param[in] paintedtime first sample which will be mixed
  * @return qtrue if any new sounds were started since the last mix
  */
-static qboolean S_ScanChannelStarts(void)
+static qboolean S_ScanChannelStarts(int paintedtime)
 {
 	channel_t *ch = s_channels;
 	int       i;
@@ -1333,13 +1365,13 @@ static qboolean S_ScanChannelStarts(void)
 		// into the very first sample
 		if (ch->startSample == START_SAMPLE_IMMEDIATE)
 		{
-			ch->startSample = s_paintedtime;
+			ch->startSample = paintedtime;
 			newSamples      = qtrue;
 			continue;
 		}
 
 		// if it is completely finished by now, clear it
-		if (ch->startSample + (ch->thesfx->soundLength) <= s_paintedtime)
+		if (ch->startSample + (ch->thesfx->soundLength) <= paintedtime)
 		{
 			S_ChannelFree(ch);
 		}
@@ -1348,6 +1380,64 @@ static qboolean S_ScanChannelStarts(void)
 	return newSamples;
 }
 
+/**
+ * @brief Gets the first sample mixed by an update at a sound time
+ * @param[in] soundtime
+ * @return
+ */
+static int S_PaintStart(int soundtime)
+{
+	if (dma.submission_chunk < 256)
+	{
+		return soundtime + s_mixPreStep->value * dma.speed;
+	}
+
+	return soundtime + dma.submission_chunk;
+}
+
+/**
+ * @brief Copies the channels to mix into a mix frame
+ * @param[out] frame
+ */
+static void S_BuildMixFrame(mixFrame_t *frame)
+{
+	Com_Memcpy(frame->channels, s_channels, sizeof(frame->channels));
+	Com_Memcpy(frame->loops, loop_channels, numLoopChannels * sizeof(channel_t));
+	Com_Memcpy(frame->rawend, s_rawend, sizeof(frame->rawend));
+	frame->numLoops = numLoopChannels;
+}
+
+/**
+ * @brief Hands the current channels to the mixer thread
+ *
+ * @details The frame is filled in the back buffer and swapped with the shared
+ * buffer, so neither thread ever waits for the other. The raw stream samples
+ * written before are visible to the mixer once it picks up the frame, as the
+ * exchange is a full memory barrier.
+ */
+static void S_PublishMixFrame(void)
+{
+	S_BuildMixFrame(&s_mixFrames[s_mixFrameBack]);
+	s_mixFrameBack = SNDDMA_ExchangeMixFrame(s_mixFrameBack | MIXFRAME_NEW) & ~MIXFRAME_NEW;
+}
+
+/**
+ * @brief Gets the latest frame published by S_PublishMixFrame
+ * @return
+ *
+ * @note Called by the mixer thread.
+ */
+static mixFrame_t *S_LatestMixFrame(void)
+{
+	// only the main thread changes the shared buffer, and it only ever makes it newer
+	if (SNDDMA_PeekMixFrame() & MIXFRAME_NEW)
+	{
+		s_mixFrameFront = SNDDMA_ExchangeMixFrame(s_mixFrameFront) & ~MIXFRAME_NEW;
+	}
+
+	return &s_mixFrames[s_mixFrameFront];
+}
+
 /**
  * @brief Called once each time through the main loop
  */
@@ -1380,6 +1470,31 @@ void S_Base_Update(void)
 	// add raw data from streamed samples
 	S_UpdateStreamingSounds();
 
+	if (s_mixThreadStarted)
+	{
+		if (s_mixThreadReset)
+		{
+			s_mixThreadReset = qfalse;
+			S_Base_StopAllSounds();
+		}
+
+		if (s_stopSounds && s_soundtime >= s_volTime2)
+		{
+			// stop playing any sounds if they are all faded out
+			S_StopAllSounds();
+			s_stopSounds = qfalse;
+		}
+
+		// video recording steps the sound time with the client frames
+		s_mixThreadPaused = CL_VideoRecording();
+		if (!s_mixThreadPaused)
+		{
+			S_ScanChannelStarts(S_PaintStart(s_soundtime));
+			S_PublishMixFrame();
+			return;
+		}
+	}
+
 	// mix some sound
 	S_Update_();
 }
@@ -1414,7 +1529,16 @@ void S_GetSoundtime(void)
 		{
 			buffers       = 0;
 			s_paintedtime = fullsamples;
-			S_Base_StopAllSounds();
+
+			// the channels belong to the main thread
+			if (s_mixThreadStarted)
+			{
+				s_mixThreadReset = qtrue;
+			}
+			else
+			{
+				S_Base_StopAllSounds();
+			}
 		}
 	}
 	oldsamplepos = samplepos;
@@ -1430,45 +1554,48 @@ void S_GetSoundtime(void)
 	}
 #endif
 
-	if (dma.submission_chunk < 256)
-	{
-		s_paintedtime = s_soundtime + s_mixPreStep->value * dma.speed;
-	}
-	else
+	s_paintedtime = S_PaintStart(s_soundtime);
+}
+
+/**
+ * @brief Global volume fading
+ * @return qtrue if the fade is done
+ */
+static qboolean S_UpdateVolumeFade(void)
+{
+	// endtime or s_paintedtime or s_soundtime...
+	if (s_soundtime < s_volTime2)     // still has fading to do
 	{
-		s_paintedtime = s_soundtime + dma.submission_chunk;
+		if (s_soundtime > s_volTime1)     // has started fading
+		{
+			s_volFadeFrac = ((float)(s_soundtime - s_volTime1) / (float)(s_volTime2 - s_volTime1));
+			s_volCurrent  = ((1.0f - s_volFadeFrac) * s_volStart + s_volFadeFrac * s_volTarget);
+		}
+		else
+		{
+			s_volCurrent = s_volStart;
+		}
+		return qfalse;
 	}
+
+	s_volCurrent = s_volTarget;
+	return qtrue;
 }
 
-void S_Update_(void)
+/**
+ * @brief Mixes a frame ahead of the current sound time
+ * @param[in] frame
+ */
+static void S_MixAhead(mixFrame_t *frame)
 {
 	unsigned     endtime;
 	int          samps;
 	static float lastTime = 0.0f;
 	float        ma, op;
 	float        thisTime, sane;
-	static int   ot = -1;
-
-	if (!s_soundStarted || s_soundMuted)
-	{
-		return;
-	}
 
 	thisTime = Sys_Milliseconds();
 
-	// Updates s_soundtime
-	S_GetSoundtime();
-
-	if (s_soundtime == ot)
-	{
-		return;
-	}
-	ot = s_soundtime;
-
-	// clear any sound effects that end before the current time,
-	// and start any new sounds
-	S_ScanChannelStarts();
-
 	sane = thisTime - lastTime;
 	if (sane < 11)
 	{
@@ -1497,39 +1624,81 @@ void S_Update_(void)
 		endtime = s_soundtime + samps;
 	}
 
-	// global volume fading
+	S_PaintChannels(frame, endtime);
 
-	// endtime or s_paintedtime or s_soundtime...
-	if (s_soundtime < s_volTime2)     // still has fading to do
+	lastTime = thisTime;
+}
+
+/**
+ * @brief Mixes on the main thread
+ */
+void S_Update_(void)
+{
+	static int ot = -1;
+	mixFrame_t *frame;
+
+	if (!s_soundStarted || s_soundMuted)
 	{
-		if (s_soundtime > s_volTime1)     // has started fading
-		{
-			s_volFadeFrac = ((float)(s_soundtime - s_volTime1) / (float)(s_volTime2 - s_volTime1));
-			s_volCurrent  = ((1.0f - s_volFadeFrac) * s_volStart + s_volFadeFrac * s_volTarget);
-		}
-		else
-		{
-			s_volCurrent = s_volStart;
-		}
+		return;
 	}
-	else
+
+	// the whole update is locked, the mixer thread may be mixing as well
+	SNDDMA_BeginPainting();
+
+	// Updates s_soundtime
+	S_GetSoundtime();
+
+	if (s_soundtime != ot)
 	{
-		s_volCurrent = s_volTarget;
-		if (s_stopSounds)
+		ot = s_soundtime;
+
+		if (S_UpdateVolumeFade() && s_stopSounds)
 		{
 			// stop playing any sounds if they are all faded out
 			S_StopAllSounds();
 			s_stopSounds = qfalse;
 		}
+
+		// clear any sound effects that end before the current time,
+		// and start any new sounds
+		S_ScanChannelStarts(s_paintedtime);
+
+		frame = &s_mixFrames[s_mixFrameFront];
+		S_BuildMixFrame(frame);
+
+		S_MixAhead(frame);
 	}
 
+	SNDDMA_Submit();
+}
+
+/**
+ * @brief Mixes the latest channels published by the main thread
+ *
+ * @note Called by the mixer thread of the backend on its own cadence,
+ * the channels are only ever touched by the main thread.
+ */
+void S_MixThreadUpdate(void)
+{
+	static int ot = -1;
+
 	SNDDMA_BeginPainting();
 
-	S_PaintChannels(endtime);
+	if (s_soundStarted && !s_soundMuted && !s_mixThreadPaused)
+	{
+		S_GetSoundtime();
 
-	SNDDMA_Submit();
+		if (s_soundtime != ot)
+		{
+			ot = s_soundtime;
 
-	lastTime = thisTime;
+			// S_Base_Update stops the sounds once they are faded out
+			S_UpdateVolumeFade();
+			S_MixAhead(S_LatestMixFrame());
+		}
+	}
+
+	SNDDMA_Submit();
 }
 
 /*
@@ -2045,6 +2214,12 @@ void S_FreeOldestSound(void)
 
 	Com_DPrintf("S_FreeOldestSound: freeing sound %s\n", sfx->soundName);
 
+	// the mixer thread skips sounds without data
+	if (s_mixThreadStarted)
+	{
+		SNDDMA_BeginPainting();
+	}
+
 	buffer = sfx->soundData;
 	while (buffer != NULL)
 	{
@@ -2054,6 +2229,11 @@ void S_FreeOldestSound(void)
 	}
 	sfx->inMemory  = qfalse;
 	sfx->soundData = NULL;
+
+	if (s_mixThreadStarted)
+	{
+		SNDDMA_Submit();
+	}
 }
 
 // =======================================================================
@@ -2067,6 +2247,12 @@ void S_Base_Shutdown(void)
 		return;
 	}
 
+	if (s_mixThreadStarted)
+	{
+		SNDDMA_StopMixThread();
+		s_mixThreadStarted = qfalse;
+	}
+
 	SNDDMA_Shutdown();
 	SND_shutdown();
 
@@ -2074,6 +2260,7 @@ void S_Base_Shutdown(void)
 	numSfx         = 0;
 
 	Cmd_RemoveCommand("s_info");
+	Cmd_RemoveCommand("s_mixtest");
 }
 
 qboolean S_Base_Init(soundInterface_t *si)
@@ -2091,6 +2278,8 @@ qboolean S_Base_Init(soundInterface_t *si)
 	s_show         = Cvar_Get("s_show", "0", CVAR_CHEAT);
 	s_testsound    = Cvar_Get("s_testsound", "0", CVAR_CHEAT);
 	s_debugStreams = Cvar_Get("s_debugStreams", "0", CVAR_TEMP);
+	s_mixSIMD      = Cvar_Get("s_mixSIMD", "1", CVAR_ARCHIVE);
+	s_mixThread    = Cvar_Get("s_mixThread", "0", CVAR_ARCHIVE | CVAR_LATCH);
 
 	r = SNDDMA_Init();
 
@@ -2106,6 +2295,18 @@ qboolean S_Base_Init(soundInterface_t *si)
 		s_paintedtime = 0;
 
 		S_Base_StopAllSounds();
+
+		Cmd_AddCommand("s_mixtest", S_MixTest_f);
+
+		if (s_mixThread->integer)
+		{
+			Com_Memset(s_mixFrames, 0, sizeof(s_mixFrames));
+			s_mixFrameBack     = 0;
+			s_mixFrameFront    = 2;
+			s_mixThreadPaused  = qfalse;
+			s_mixThreadReset   = qfalse;
+			s_mixThreadStarted = SNDDMA_StartMixThread();
+		}
 	}
 	else
 	{
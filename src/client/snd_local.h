@@ -204,6 +204,16 @@ void SNDDMA_BeginPainting(void);
 
 void SNDDMA_Submit(void);
 
+// starts a thread calling S_MixThreadUpdate, returns qfalse if the backend can't
+qboolean SNDDMA_StartMixThread(void);
+
+void SNDDMA_StopMixThread(void);
+
+// atomically replaces the mix frame shared with the mixer thread and returns the old one
+int SNDDMA_ExchangeMixFrame(int frame);
+
+int SNDDMA_PeekMixFrame(void);
+
 //====================================================================
 
 #define MAX_CHANNELS            96
@@ -247,6 +257,15 @@ typedef struct
 extern portable_samplepair_t s_rawsamples[MAX_RAW_STREAMS][MAX_RAW_SAMPLES];
 extern int                   s_rawend[MAX_RAW_STREAMS];
 
+// copy of the channel state handed to the mixer, see S_PublishMixFrame
+typedef struct
+{
+	channel_t channels[MAX_CHANNELS];
+	channel_t loops[MAX_CHANNELS];
+	int numLoops;
+	int rawend[MAX_RAW_STREAMS];
+} mixFrame_t;
+
 #define     MAX_LOOP_SOUNDS 1024
 
 extern cvar_t *s_volume;
@@ -255,6 +274,8 @@ extern cvar_t *s_muted;
 extern cvar_t *s_doppler;
 
 extern cvar_t *s_testsound;
+extern cvar_t *s_mixSIMD;
+extern cvar_t *s_mixThread;
 
 extern float s_volCurrent;
 
@@ -265,7 +286,10 @@ sndBuffer *SND_malloc(void);
 void SND_setup(void);
 void SND_shutdown(void);
 
-void S_PaintChannels(int endtime);
+void S_PaintChannels(mixFrame_t *frame, int endtime);
+void S_MixTest_f(void);
+
+void S_MixThreadUpdate(void);
 
 void S_memoryLoad(sfx_t *sfx);
 
@@ -39,6 +39,11 @@
 #include <altivec.h>
 #endif
 
+#if idx64 || defined(__SSE2__)
+#include <emmintrin.h>
+#define SND_SSE2_MIX
+#endif
+
 static portable_samplepair_t paintbuffer[PAINTBUFFER_SIZE];
 static int                   snd_vol;
 
@@ -48,42 +53,69 @@ short *snd_out;
 
 // #if !id386                                        // if configured not to use asm
 
-void S_WriteLinearBlastStereo16(void)
+/**
+ * @brief Clamps mixed samples to 16 bits
+ * @param[in] in
+ * @param[out] out
+ * @param[in] count number of samples, a multiple of 2
+ * @param[in] simd
+ */
+static void S_WriteLinearBlast(const int *in, short *out, int count, qboolean simd)
 {
-	int i;
+	int i = 0;
 	int val;
 
-	for (i = 0 ; i < snd_linear_count ; i += 2)
+#ifdef SND_SSE2_MIX
+	if (simd)
+	{
+		__m128i a, b;
+
+		// the signed pack saturates to the 16 bit range, no need to clamp
+		for ( ; i + 8 <= count ; i += 8)
+		{
+			a = _mm_srai_epi32(_mm_loadu_si128((const __m128i *)&in[i]), 8);
+			b = _mm_srai_epi32(_mm_loadu_si128((const __m128i *)&in[i + 4]), 8);
+			_mm_storeu_si128((__m128i *)&out[i], _mm_packs_epi32(a, b));
+		}
+	}
+#endif
+
+	for ( ; i < count ; i += 2)
 	{
-		val = snd_p[i] >> 8;
+		val = in[i] >> 8;
 		if (val > 0x7fff)
 		{
-			snd_out[i] = 0x7fff;
+			out[i] = 0x7fff;
 		}
 		else if (val < -32768)
 		{
-			snd_out[i] = -32768;
+			out[i] = -32768;
 		}
 		else
 		{
-			snd_out[i] = val;
+			out[i] = val;
 		}
 
-		val = snd_p[i + 1] >> 8;
+		val = in[i + 1] >> 8;
 		if (val > 0x7fff)
 		{
-			snd_out[i + 1] = 0x7fff;
+			out[i + 1] = 0x7fff;
 		}
 		else if (val < -32768)
 		{
-			snd_out[i + 1] = -32768;
+			out[i + 1] = -32768;
 		}
 		else
 		{
-			snd_out[i + 1] = val;
+			out[i + 1] = val;
 		}
 	}
 }
+
+void S_WriteLinearBlastStereo16(void)
+{
+	S_WriteLinearBlast(snd_p, snd_out, snd_linear_count, s_mixSIMD->integer);
+}
 // #elif defined( __GNUC__ )
 // // uses snd_mixa.s
 // void S_WriteLinearBlastStereo16( void );
@@ -464,15 +496,14 @@ static void S_PaintChannelFrom16_altivec(channel_t *ch, const sfx_t *sc, int cou
 }
 #endif
 
-static void S_PaintChannelFrom16_scalar(channel_t *ch, const sfx_t *sc, int count, int sampleOffset, int bufferOffset)
+static void S_PaintChannelFrom16_scalar(channel_t *ch, const sfx_t *sc, int count, int sampleOffset, portable_samplepair_t *samp, int vol)
 {
-	int                   data, aoff, boff;
-	int                   leftvol, rightvol;
-	int                   i, j;
-	portable_samplepair_t *samp  = &paintbuffer[bufferOffset];
-	sndBuffer             *chunk = sc->soundData;
-	short                 *samples;
-	float                 ooff, fdata[2], fdiv, fleftvol, frightvol;
+	int       data, aoff, boff;
+	int       leftvol, rightvol;
+	int       i, j;
+	sndBuffer *chunk = sc->soundData;
+	short     *samples;
+	float     ooff, fdata[2], fdiv, fleftvol, frightvol;
 
 	if (sc->soundChannels <= 0)
 	{
@@ -506,8 +537,8 @@ static void S_PaintChannelFrom16_scalar(channel_t *ch, const sfx_t *sc, int coun
 
 	if (!ch->doppler || ch->dopplerScale == 1.0f)
 	{
-		leftvol  = ch->leftvol * snd_vol;
-		rightvol = ch->rightvol * snd_vol;
+		leftvol  = ch->leftvol * vol;
+		rightvol = ch->rightvol * vol;
 		samples  = chunk->sndChunk;
 		for (i = 0 ; i < count ; i++)
 		{
@@ -529,8 +560,8 @@ static void S_PaintChannelFrom16_scalar(channel_t *ch, const sfx_t *sc, int coun
 	}
 	else
 	{
-		fleftvol  = ch->leftvol * snd_vol;
-		frightvol = ch->rightvol * snd_vol;
+		fleftvol  = ch->leftvol * vol;
+		frightvol = ch->rightvol * vol;
 
 		ooff    = sampleOffset;
 		samples = chunk->sndChunk;
@@ -571,6 +602,136 @@ static void S_PaintChannelFrom16_scalar(channel_t *ch, const sfx_t *sc, int coun
 	}
 }
 
+#ifdef SND_SSE2_MIX
+/**
+ * @brief Adds 4 stereo sample pairs scaled by the channel volumes to the paint buffer
+ * @param[in,out] samp
+ * @param[in] data left and right samples
+ * @param[in] volHi high bytes of the left and right volumes
+ * @param[in] volLo low bytes of the left and right volumes
+ *
+ * @note SSE2 has no 32 bit multiply, the 16 bit multiplies with both volume
+ * bytes give the exact 32 bit product of the scalar code.
+ */
+static ID_INLINE void S_MixSamplePairs_sse2(portable_samplepair_t *samp, __m128i data, __m128i volHi, __m128i volLo)
+{
+	__m128i hiLow  = _mm_mullo_epi16(data, volHi);
+	__m128i hiHigh = _mm_mulhi_epi16(data, volHi);
+	__m128i loLow  = _mm_mullo_epi16(data, volLo);
+	__m128i loHigh = _mm_mulhi_epi16(data, volLo);
+	__m128i a, b;
+
+	a = _mm_add_epi32(_mm_slli_epi32(_mm_unpacklo_epi16(hiLow, hiHigh), 8), _mm_unpacklo_epi16(loLow, loHigh));
+	b = _mm_add_epi32(_mm_slli_epi32(_mm_unpackhi_epi16(hiLow, hiHigh), 8), _mm_unpackhi_epi16(loLow, loHigh));
+
+	_mm_storeu_si128((__m128i *)&samp[0], _mm_add_epi32(_mm_loadu_si128((const __m128i *)&samp[0]), _mm_srai_epi32(a, 8)));
+	_mm_storeu_si128((__m128i *)&samp[2], _mm_add_epi32(_mm_loadu_si128((const __m128i *)&samp[2]), _mm_srai_epi32(b, 8)));
+}
+
+/**
+ * @brief SSE2 version of S_PaintChannelFrom16_scalar for channels without doppler
+ * @param[in,out] ch
+ * @param[in] sc
+ * @param[in] count
+ * @param[in] sampleOffset
+ * @param[in,out] samp
+ * @param[in] vol
+ */
+static void S_PaintChannelFrom16_sse2(channel_t *ch, const sfx_t *sc, int count, int sampleOffset, portable_samplepair_t *samp, int vol)
+{
+	int       data, leftvol, rightvol;
+	int       i, j, run;
+	sndBuffer *chunk = sc->soundData;
+	short     *samples;
+	__m128i   volHi, volLo, pairs;
+
+	leftvol  = ch->leftvol * vol;
+	rightvol = ch->rightvol * vol;
+
+	// the high volume bytes have to fit a signed 16 bit multiply
+	if ((unsigned)leftvol >= (1 << 23) || (unsigned)rightvol >= (1 << 23))
+	{
+		S_PaintChannelFrom16_scalar(ch, sc, count, sampleOffset, samp, vol);
+		return;
+	}
+
+	if (ch->doppler)
+	{
+		sampleOffset = sampleOffset * ch->oldDopplerScale;
+	}
+
+	if (sc->soundChannels == 2)
+	{
+		sampleOffset *= sc->soundChannels;
+
+		if (sampleOffset & 1)
+		{
+			sampleOffset &= ~1;
+		}
+	}
+
+	while (sampleOffset >= SND_CHUNK_SIZE)
+	{
+		chunk         = chunk->next;
+		sampleOffset -= SND_CHUNK_SIZE;
+		if (!chunk)
+		{
+			chunk = sc->soundData;
+		}
+	}
+
+	volHi = _mm_set_epi16(rightvol >> 8, leftvol >> 8, rightvol >> 8, leftvol >> 8, rightvol >> 8, leftvol >> 8, rightvol >> 8, leftvol >> 8);
+	volLo = _mm_set_epi16(rightvol & 255, leftvol & 255, rightvol & 255, leftvol & 255, rightvol & 255, leftvol & 255, rightvol & 255, leftvol & 255);
+
+	for (i = 0; i < count; i += run, samp += run)
+	{
+		if (sampleOffset == SND_CHUNK_SIZE)
+		{
+			chunk        = chunk->next;
+			sampleOffset = 0;
+		}
+
+		// mix up to the end of the chunk
+		samples = chunk->sndChunk + sampleOffset;
+		run     = (SND_CHUNK_SIZE - sampleOffset) / sc->soundChannels;
+		if (run > count - i)
+		{
+			run = count - i;
+		}
+		sampleOffset += run * sc->soundChannels;
+
+		j = 0;
+		if (sc->soundChannels == 2)
+		{
+			for ( ; j + 4 <= run ; j += 4)
+			{
+				pairs = _mm_loadu_si128((const __m128i *)&samples[j * 2]);
+				S_MixSamplePairs_sse2(&samp[j], pairs, volHi, volLo);
+			}
+			for ( ; j < run ; j++)
+			{
+				samp[j].left  += (samples[j * 2] * leftvol) >> 8;
+				samp[j].right += (samples[j * 2 + 1] * rightvol) >> 8;
+			}
+		}
+		else
+		{
+			for ( ; j + 4 <= run ; j += 4)
+			{
+				pairs = _mm_loadl_epi64((const __m128i *)&samples[j]);
+				S_MixSamplePairs_sse2(&samp[j], _mm_unpacklo_epi16(pairs, pairs), volHi, volLo);
+			}
+			for ( ; j < run ; j++)
+			{
+				data           = samples[j];
+				samp[j].left  += (data * leftvol) >> 8;
+				samp[j].right += (data * rightvol) >> 8;
+			}
+		}
+	}
+}
+#endif
+
 static void S_PaintChannelFrom16(channel_t *ch, const sfx_t *sc, int count, int sampleOffset, int bufferOffset)
 {
 #if idppc_altivec
@@ -581,7 +742,14 @@ static void S_PaintChannelFrom16(channel_t *ch, const sfx_t *sc, int count, int
 		return;
 	}
 #endif
-	S_PaintChannelFrom16_scalar(ch, sc, count, sampleOffset, bufferOffset);
+#ifdef SND_SSE2_MIX
+	if (s_mixSIMD->integer && sc->soundChannels > 0 && (!ch->doppler || ch->dopplerScale == 1.0f))
+	{
+		S_PaintChannelFrom16_sse2(ch, sc, count, sampleOffset, &paintbuffer[bufferOffset], snd_vol);
+		return;
+	}
+#endif
+	S_PaintChannelFrom16_scalar(ch, sc, count, sampleOffset, &paintbuffer[bufferOffset], snd_vol);
 }
 
 void S_PaintChannelFromWavelet(channel_t *ch, sfx_t *sc, int count, int sampleOffset, int bufferOffset)
@@ -734,12 +902,45 @@ void S_PaintChannelFromMuLaw(channel_t *ch, sfx_t *sc, int count, int sampleOffs
 	}
 }
 
+/**
+ * @brief Adds a run of sample pairs to the paint buffer
+ * @param[in,out] samp
+ * @param[in] src
+ * @param[in] count
+ * @param[in] simd
+ */
+static void S_AddSamplePairs(portable_samplepair_t *samp, const portable_samplepair_t *src, int count, qboolean simd)
+{
+	int i = 0;
+
+#ifdef SND_SSE2_MIX
+	if (simd)
+	{
+		__m128i a, b;
+
+		for ( ; i + 4 <= count ; i += 4)
+		{
+			a = _mm_add_epi32(_mm_loadu_si128((const __m128i *)&samp[i]), _mm_loadu_si128((const __m128i *)&src[i]));
+			b = _mm_add_epi32(_mm_loadu_si128((const __m128i *)&samp[i + 2]), _mm_loadu_si128((const __m128i *)&src[i + 2]));
+			_mm_storeu_si128((__m128i *)&samp[i], a);
+			_mm_storeu_si128((__m128i *)&samp[i + 2], b);
+		}
+	}
+#endif
+
+	for ( ; i < count ; i++)
+	{
+		samp[i].left  += src[i].left;
+		samp[i].right += src[i].right;
+	}
+}
+
 /*
 ===================
 S_PaintChannels
 ===================
 */
-void S_PaintChannels(int endtime)
+void S_PaintChannels(mixFrame_t *frame, int endtime)
 {
 	int       i;
 	int       end;
@@ -773,24 +974,25 @@ void S_PaintChannels(int endtime)
 		Com_Memset(paintbuffer, 0, sizeof(paintbuffer));
 		for (stream = 0; stream < MAX_RAW_STREAMS; stream++)
 		{
-			if (s_rawend[stream] >= s_paintedtime)
+			if (frame->rawend[stream] >= s_paintedtime)
 			{
 				// copy from the streaming sound source
 				const portable_samplepair_t *rawsamples = s_rawsamples[stream];
-				const int                   stop        = (end < s_rawend[stream]) ? end : s_rawend[stream];
+				const int                   stop        = (end < frame->rawend[stream]) ? end : frame->rawend[stream];
 
-				for (i = s_paintedtime ; i < stop ; i++)
+				// in runs up to the wrap of the raw buffer
+				for (i = s_paintedtime ; i < stop ; i += count)
 				{
 					const int s = i & (MAX_RAW_SAMPLES - 1);
 
-					paintbuffer[i - s_paintedtime].left  += rawsamples[s].left;
-					paintbuffer[i - s_paintedtime].right += rawsamples[s].right;
+					count = MIN(stop - i, MAX_RAW_SAMPLES - s);
+					S_AddSamplePairs(&paintbuffer[i - s_paintedtime], &rawsamples[s], count, s_mixSIMD->integer);
 				}
 			}
 		}
 
 		// paint in the channels.
-		ch = s_channels;
+		ch = frame->channels;
 		for (i = 0; i < MAX_CHANNELS ; i++, ch++)
 		{
 			if (!ch->thesfx || (ch->leftvol < 0.25 && ch->rightvol < 0.25))
@@ -835,8 +1037,8 @@ void S_PaintChannels(int endtime)
 		}
 
 		// paint in the looped channels.
-		ch = loop_channels;
-		for (i = 0; i < numLoopChannels ; i++, ch++)
+		ch = frame->loops;
+		for (i = 0; i < frame->numLoops ; i++, ch++)
 		{
 			if (!ch->thesfx || (!ch->leftvol && !ch->rightvol))
 			{
@@ -892,3 +1094,164 @@ void S_PaintChannels(int endtime)
 		s_paintedtime = end;
 	}
 }
+
+#define MIXTEST_CHUNKS  8
+
+/**
+ * @brief Random number in [0, range) for S_MixTest_f
+ * @param[in,out] seed
+ * @param[in] range
+ * @return
+ */
+static int S_MixTestRand(int *seed, int range)
+{
+	return (int)(((unsigned int)Q_rand(seed) >> 8) % range);
+}
+
+/**
+ * @brief Checks that the SSE2 mixer gives bit exact results of the scalar
+ * mixer and times both
+ *
+ * @note Mixes into buffers of its own, so it doesn't disturb the mixer thread.
+ */
+void S_MixTest_f(void)
+{
+#ifdef SND_SSE2_MIX
+	static sndBuffer             chunks[MIXTEST_CHUNKS];
+	static portable_samplepair_t scalar[PAINTBUFFER_SIZE], sse2[PAINTBUFFER_SIZE], src[PAINTBUFFER_SIZE];
+	static short                 scalarOut[PAINTBUFFER_SIZE * 2], sse2Out[PAINTBUFFER_SIZE * 2];
+	sfx_t                        sc;
+	channel_t                    ch;
+	int                          rounds = 20000, seed = 1, mismatches = 0, round, i, count, offset, bufferOffset, vol, start, scalarMsec, sse2Msec;
+
+	if (Cmd_Argc() > 1)
+	{
+		rounds = atoi(Cmd_Argv(1));
+	}
+
+	if (rounds <= 0)
+	{
+		Com_Printf("usage: s_mixtest [rounds]\n");
+		return;
+	}
+
+	for (i = 0; i < MIXTEST_CHUNKS; i++)
+	{
+		for (count = 0; count < SND_CHUNK_SIZE; count++)
+		{
+			chunks[i].sndChunk[count] = (short)(S_MixTestRand(&seed, 0x10000) - 0x8000);
+		}
+		chunks[i].next = i < MIXTEST_CHUNKS - 1 ? &chunks[i + 1] : NULL;
+	}
+
+	Com_Memset(&sc, 0, sizeof(sc));
+	Com_Memset(&ch, 0, sizeof(ch));
+	sc.soundData = chunks;
+
+	for (round = 0; round < rounds; round++)
+	{
+		sc.soundChannels = 1 + S_MixTestRand(&seed, 2);
+		sc.soundLength   = MIXTEST_CHUNKS * SND_CHUNK_SIZE / sc.soundChannels;
+
+		ch.leftvol         = S_MixTestRand(&seed, 256);
+		ch.rightvol        = S_MixTestRand(&seed, 256);
+		ch.doppler         = S_MixTestRand(&seed, 2);
+		ch.dopplerScale    = 1.0f;
+		ch.oldDopplerScale = ch.doppler ? S_MixTestRand(&seed, 3) * 0.5f + 0.5f : 1.0f;
+
+		// now and then too loud for the 16 bit multiplies
+		vol = (round % 50) ? S_MixTestRand(&seed, 256) : 70000;
+
+		bufferOffset = S_MixTestRand(&seed, 100);
+		offset       = S_MixTestRand(&seed, sc.soundLength / 2);
+		count        = S_MixTestRand(&seed, PAINTBUFFER_SIZE - bufferOffset);
+
+		// stay within the sound, the end of it isn't looped
+		if ((int)(offset * ch.oldDopplerScale) + count >= sc.soundLength)
+		{
+			count = sc.soundLength - (int)(offset * ch.oldDopplerScale) - 1;
+		}
+		if (count < 0)
+		{
+			count = 0;
+		}
+
+		// channel painting
+		for (i = 0; i < PAINTBUFFER_SIZE; i++)
+		{
+			scalar[i].left  = S_MixTestRand(&seed, 1 << 24) - (1 << 23);
+			scalar[i].right = S_MixTestRand(&seed, 1 << 24) - (1 << 23);
+		}
+		Com_Memcpy(sse2, scalar, sizeof(sse2));
+
+		S_PaintChannelFrom16_scalar(&ch, &sc, count, offset, &scalar[bufferOffset], vol);
+		S_PaintChannelFrom16_sse2(&ch, &sc, count, offset, &sse2[bufferOffset], vol);
+
+		if (memcmp(scalar, sse2, sizeof(sse2)))
+		{
+			mismatches++;
+			Com_Printf("s_mixtest: paint mismatch, %i channels, %i samples at %i, volume %i\n", sc.soundChannels, count, offset, vol);
+		}
+
+		// raw samples
+		for (i = 0; i < PAINTBUFFER_SIZE; i++)
+		{
+			src[i].left  = S_MixTestRand(&seed, 1 << 24);
+			src[i].right = -S_MixTestRand(&seed, 1 << 24);
+		}
+		Com_Memcpy(scalar, sse2, sizeof(scalar));
+
+		S_AddSamplePairs(&scalar[bufferOffset], src, count, qfalse);
+		S_AddSamplePairs(&sse2[bufferOffset], src, count, qtrue);
+
+		if (memcmp(scalar, sse2, sizeof(sse2)))
+		{
+			mismatches++;
+			Com_Printf("s_mixtest: raw samples mismatch, %i samples\n", count);
+		}
+
+		// clamping, with values beyond the 16 bit range
+		for (i = 0; i < PAINTBUFFER_SIZE; i++)
+		{
+			scalar[i].left  = S_MixTestRand(&seed, 1 << 26) - (1 << 25);
+			scalar[i].right = S_MixTestRand(&seed, 1 << 26) - (1 << 25);
+		}
+		scalar[0].left  = 0x7fffffff;
+		scalar[0].right = (int)0x80000000;
+
+		S_WriteLinearBlast(&scalar[0].left, scalarOut, count * 2, qfalse);
+		S_WriteLinearBlast(&scalar[0].left, sse2Out, count * 2, qtrue);
+
+		if (memcmp(scalarOut, sse2Out, count * 2 * sizeof(short)))
+		{
+			mismatches++;
+			Com_Printf("s_mixtest: clamp mismatch, %i samples\n", count);
+		}
+	}
+
+	// mono sound without doppler, the common case
+	sc.soundChannels = 1;
+	sc.soundLength   = MIXTEST_CHUNKS * SND_CHUNK_SIZE;
+	ch.leftvol       = 180;
+	ch.rightvol      = 90;
+	ch.doppler       = qfalse;
+
+	start = Sys_Milliseconds();
+	for (round = 0; round < rounds; round++)
+	{
+		S_PaintChannelFrom16_scalar(&ch, &sc, PAINTBUFFER_SIZE, round & (SND_CHUNK_SIZE - 1), scalar, 200);
+	}
+	scalarMsec = Sys_Milliseconds() - start;
+
+	start = Sys_Milliseconds();
+	for (round = 0; round < rounds; round++)
+	{
+		S_PaintChannelFrom16_sse2(&ch, &sc, PAINTBUFFER_SIZE, round & (SND_CHUNK_SIZE - 1), sse2, 200);
+	}
+	sse2Msec = Sys_Milliseconds() - start;
+
+	Com_Printf("s_mixtest: %i rounds, %i mismatches, painting %i msec scalar, %i msec SSE2\n", rounds, mismatches, scalarMsec, sse2Msec);
+#else
+	Com_Printf("s_mixtest: the mixer has no SSE2 code on this platform\n");
+#endif
+}
@@ -890,6 +890,210 @@ static animStringItem_t animParseModesStr[] =
 
 #define MAX_INDENT_LEVELS   3
 
+/**
+ * @brief Gets the condition bits an item condition tests
+ * @param[in] cond
+ * @param[out] bits
+ * @return qfalse if the condition can't be compiled
+ */
+static qboolean BG_AnimConditionBits(animScriptCondition_t *cond, unsigned int bits[2])
+{
+	switch (animConditionsTable[cond->index].type)
+	{
+	case ANIM_CONDTYPE_BITFLAGS:
+		bits[0] = (unsigned int)cond->value[0];
+		bits[1] = (unsigned int)cond->value[1];
+		return qtrue;
+	case ANIM_CONDTYPE_VALUE:
+		// a value is tested as a single bit, they are all small enums
+		if (cond->value[0] < 0 || cond->value[0] >= 64)
+		{
+			return qfalse;
+		}
+		bits[0] = cond->value[0] < 32 ? 1u << cond->value[0] : 0;
+		bits[1] = cond->value[0] >= 32 ? 1u << (cond->value[0] - 32) : 0;
+		return qtrue;
+	default:
+		return qfalse;
+	}
+}
+
+/**
+ * @brief Builds the tests of a script, see BG_CompileAnimScript
+ * @param[in,out] scriptData
+ * @param[in,out] script
+ * @return qfalse if the script can't be compiled or the test pools are full
+ */
+static qboolean BG_CompileAnimScriptTests(animScriptData_t *scriptData, animScript_t *script)
+{
+	animScriptItem_t      *item;
+	animScriptCondition_t *cond;
+	animScriptTest_t      *test;
+	animScriptTestBit_t   *testBit;
+	unsigned int          bits[2];
+	int                   i, j, k, t, occurrence;
+
+	// find the tests and the bits they use
+	for (i = 0; i < script->numItems; i++)
+	{
+		item = script->items[i];
+
+		for (j = 0, cond = item->conditions; j < item->numConditions; j++, cond++)
+		{
+			if (!BG_AnimConditionBits(cond, bits))
+			{
+				return qfalse;
+			}
+
+			for (k = 0, occurrence = 0; k < j; k++)
+			{
+				if (item->conditions[k].index == cond->index && item->conditions[k].negative == cond->negative)
+				{
+					occurrence++;
+				}
+			}
+
+			for (t = 0, test = script->tests; t < script->numTests; t++, test++)
+			{
+				if (test->condition == cond->index && test->negative == cond->negative && test->occurrence == occurrence)
+				{
+					break;
+				}
+			}
+
+			if (t == script->numTests)
+			{
+				if (scriptData->numScriptTests >= MAX_ANIMSCRIPT_TESTS)
+				{
+					return qfalse;
+				}
+				scriptData->numScriptTests++;
+				script->numTests++;
+
+				Com_Memset(test, 0, sizeof(*test));
+				test->condition  = cond->index;
+				test->negative   = cond->negative;
+				test->occurrence = occurrence;
+			}
+
+			test->items[i >> 5] |= 1u << (i & 31);
+			test->usedBits[0]   |= bits[0];
+			test->usedBits[1]   |= bits[1];
+		}
+	}
+
+	// give each used bit of a test the items passing it
+	for (t = 0, test = script->tests; t < script->numTests; t++, test++)
+	{
+		test->bits = &scriptData->scriptTestBits[scriptData->numScriptTestBits];
+
+		for (k = 0; k < 64; k++)
+		{
+			test->bitIndex[k] = -1;
+
+			if (!(test->usedBits[k >> 5] & (1u << (k & 31))))
+			{
+				continue;
+			}
+
+			if (scriptData->numScriptTestBits >= MAX_ANIMSCRIPT_TESTBITS)
+			{
+				return qfalse;
+			}
+			test->bitIndex[k] = (signed char)test->numBits;
+			testBit           = &test->bits[test->numBits++];
+			scriptData->numScriptTestBits++;
+
+			Com_Memset(testBit, 0, sizeof(*testBit));
+			testBit->bit = k;
+
+			for (i = 0; i < script->numItems; i++)
+			{
+				item = script->items[i];
+
+				for (j = 0, occurrence = 0, cond = item->conditions; j < item->numConditions; j++, cond++)
+				{
+					if (cond->index != test->condition || cond->negative != test->negative)
+					{
+						continue;
+					}
+
+					if (occurrence++ != test->occurrence)
+					{
+						continue;
+					}
+
+					BG_AnimConditionBits(cond, bits);
+					if (bits[k >> 5] & (1u << (k & 31)))
+					{
+						testBit->items[i >> 5] |= 1u << (i & 31);
+					}
+				}
+			}
+		}
+	}
+
+	return qtrue;
+}
+
+/**
+ * @brief Compiles the conditions of the items of a script into tests of the condition bits
+ * @param[in,out] scriptData
+ * @param[in,out] script
+ *
+ * @details Each distinct condition tested by the items becomes one test, which lists
+ * for every bit of the condition the items passing it when the bit is set.
+ * BG_FirstValidItem then finds all valid items at once by and-ing the result of
+ * each test into a bit set of the items. Scripts which can't be compiled are
+ * still evaluated item by item, the pool slots they took are given back.
+ */
+static void BG_CompileAnimScript(animScriptData_t *scriptData, animScript_t *script)
+{
+	int numScriptTests    = scriptData->numScriptTests;
+	int numScriptTestBits = scriptData->numScriptTestBits;
+
+	script->tests    = &scriptData->scriptTests[numScriptTests];
+	script->numTests = 0;
+	script->compiled = BG_CompileAnimScriptTests(scriptData, script);
+
+	if (!script->compiled)
+	{
+		scriptData->numScriptTests    = numScriptTests;
+		scriptData->numScriptTestBits = numScriptTestBits;
+
+		script->tests    = NULL;
+		script->numTests = 0;
+	}
+}
+
+/**
+ * @brief Compiles all scripts of a model, see BG_CompileAnimScript
+ * @param[in,out] scriptData
+ * @param[in,out] animModelInfo
+ */
+static void BG_CompileAnimScripts(animScriptData_t *scriptData, animModelInfo_t *animModelInfo)
+{
+	int i, j;
+
+	for (i = 0; i < MAX_AISTATES; i++)
+	{
+		for (j = 0; j < NUM_ANIM_MOVETYPES; j++)
+		{
+			BG_CompileAnimScript(scriptData, &animModelInfo->scriptAnims[i][j]);
+		}
+	}
+
+	for (i = 0; i < NUM_ANIM_MOVETYPES; i++)
+	{
+		BG_CompileAnimScript(scriptData, &animModelInfo->scriptCannedAnims[i]);
+	}
+
+	for (i = 0; i < NUM_ANIM_EVENTTYPES; i++)
+	{
+		BG_CompileAnimScript(scriptData, &animModelInfo->scriptEvents[i]);
+	}
+}
+
 /**
  * @brief Parse the animation script for this model, converting it into run-time structures
  */
@@ -1208,6 +1412,8 @@ void BG_AnimParseAnimScript(animModelInfo_t *animModelInfo, animScriptData_t *sc
 		}
 	}
 
+	BG_CompileAnimScripts(scriptData, animModelInfo);
+
 	globalFilename = NULL;
 }
 
@@ -1269,8 +1475,10 @@ qboolean BG_EvaluateConditions(int client, animScriptItem_t *scriptItem)
  * @brief scroll through the script items, returning the first script found to pass all conditions
  *
  * @return NULL if no match found
+ *
+ * @note Used for scripts which couldn't be compiled.
  */
-animScriptItem_t *BG_FirstValidItem(int client, animScript_t *script)
+static animScriptItem_t *BG_FirstValidItemSlow(int client, animScript_t *script)
 {
 	animScriptItem_t **ppScriptItem;
 	int              i;
@@ -1286,6 +1494,210 @@ animScriptItem_t *BG_FirstValidItem(int client, animScript_t *script)
 	return NULL;
 }
 
+/**
+ * @brief returns the first script item to pass all conditions, running the compiled
+ * tests of the script for all items at once
+ *
+ * @return NULL if no match found
+ */
+animScriptItem_t *BG_FirstValidItem(int client, animScript_t *script)
+{
+	animScriptTest_t    *test;
+	animScriptTestBit_t *testBit;
+	animScriptItem_t    *found = NULL;
+	unsigned int        valid[ANIMSCRIPT_ITEM_WORDS], passed[ANIMSCRIPT_ITEM_WORDS], any, bits;
+	int                 *state;
+	int                 i, t, w, bit;
+
+	if (!script->compiled)
+	{
+		return BG_FirstValidItemSlow(client, script);
+	}
+
+	for (w = 0; w < ANIMSCRIPT_ITEM_WORDS; w++)
+	{
+		i        = script->numItems - w * 32;
+		valid[w] = i >= 32 ? ~0u : i > 0 ? (1u << i) - 1 : 0;
+	}
+
+	for (t = 0, test = script->tests; t < script->numTests; t++, test++)
+	{
+		state = globalScriptData->clientConditions[client][test->condition];
+		Com_Memset(passed, 0, sizeof(passed));
+
+		if (animConditionsTable[test->condition].type == ANIM_CONDTYPE_VALUE)
+		{
+			if (state[0] >= 0 && state[0] < 64 && test->bitIndex[state[0]] >= 0)
+			{
+				Com_Memcpy(passed, test->bits[test->bitIndex[state[0]]].items, sizeof(passed));
+			}
+		}
+		else
+		{
+			// usually a single bit is set
+			for (i = 0; i < 2; i++)
+			{
+				for (bits = (unsigned int)state[i] & test->usedBits[i], bit = i * 32; bits; bits >>= 1, bit++)
+				{
+					if (!(bits & 1))
+					{
+						continue;
+					}
+
+					testBit = &test->bits[test->bitIndex[bit]];
+					for (w = 0; w < ANIMSCRIPT_ITEM_WORDS; w++)
+					{
+						passed[w] |= testBit->items[w];
+					}
+				}
+			}
+		}
+
+		// items not doing this test aren't affected
+		for (w = 0, any = 0; w < ANIMSCRIPT_ITEM_WORDS; w++)
+		{
+			valid[w] &= ~test->items[w] | (test->negative ? ~passed[w] : passed[w]);
+			any      |= valid[w];
+		}
+
+		if (!any)
+		{
+			break;
+		}
+	}
+
+	for (w = 0; w < ANIMSCRIPT_ITEM_WORDS && !found; w++)
+	{
+		for (i = 0; valid[w]; i++, valid[w] >>= 1)
+		{
+			if (valid[w] & 1)
+			{
+				found = script->items[w * 32 + i];
+				break;
+			}
+		}
+	}
+
+#ifdef LEGACY_DEBUG
+	if (found != BG_FirstValidItemSlow(client, script))
+	{
+		Com_Printf("^1BG_FirstValidItem: compiled script gives a different item than its conditions\n");
+	}
+#endif
+
+	return found;
+}
+
+/**
+ * @brief Sets random condition states, half of the time with the conditions of
+ * an item of the script on top, so the items get a chance to pass
+ * @param[out] state
+ * @param[in] script
+ */
+static void BG_AnimScriptTestState(int state[NUM_ANIM_CONDITIONS][2], animScript_t *script)
+{
+	animScriptItem_t      *item;
+	animScriptCondition_t *cond;
+	int                   i, bit;
+
+	for (i = 0; i < NUM_ANIM_CONDITIONS; i++)
+	{
+		switch (rand() % 4)
+		{
+		case 0:
+			state[i][0] = rand() % 8;
+			state[i][1] = 0;
+			break;
+		case 1:
+			bit         = rand() % 64;
+			state[i][0] = bit < 32 ? (int)(1u << bit) : 0;
+			state[i][1] = bit >= 32 ? (int)(1u << (bit - 32)) : 0;
+			break;
+		case 2:
+			state[i][0] = rand();
+			state[i][1] = rand();
+			break;
+		default:
+			state[i][0] = 0;
+			state[i][1] = 0;
+			break;
+		}
+	}
+
+	if (!script->numItems || (rand() & 1))
+	{
+		return;
+	}
+
+	item = script->items[rand() % script->numItems];
+	for (i = 0, cond = item->conditions; i < item->numConditions; i++, cond++)
+	{
+		if (!cond->negative)
+		{
+			state[cond->index][0] = cond->value[0];
+			state[cond->index][1] = animConditionsTable[cond->index].type == ANIM_CONDTYPE_VALUE ? 0 : cond->value[1];
+		}
+	}
+}
+
+/**
+ * @brief Compares the compiled scripts of a model with their item by item evaluation
+ * @param[in] animModelInfo
+ * @param[in] client condition states to use, they are restored afterwards
+ * @param[in] states number of random condition states to try on each script
+ * @param[out] checks number of compared results
+ * @return number of scripts giving a different item than their conditions
+ */
+int BG_AnimScriptTest(animModelInfo_t *animModelInfo, int client, int states, int *checks)
+{
+	animScript_t *scripts[MAX_AISTATES * NUM_ANIM_MOVETYPES + NUM_ANIM_MOVETYPES + NUM_ANIM_EVENTTYPES];
+	int          saved[NUM_ANIM_CONDITIONS][2];
+	int          numScripts = 0, mismatches = 0, i, j, n;
+
+	for (i = 0; i < MAX_AISTATES; i++)
+	{
+		for (j = 0; j < NUM_ANIM_MOVETYPES; j++)
+		{
+			scripts[numScripts++] = &animModelInfo->scriptAnims[i][j];
+		}
+	}
+	for (i = 0; i < NUM_ANIM_MOVETYPES; i++)
+	{
+		scripts[numScripts++] = &animModelInfo->scriptCannedAnims[i];
+	}
+	for (i = 0; i < NUM_ANIM_EVENTTYPES; i++)
+	{
+		scripts[numScripts++] = &animModelInfo->scriptEvents[i];
+	}
+
+	Com_Memcpy(saved, globalScriptData->clientConditions[client], sizeof(saved));
+
+	*checks = 0;
+	for (i = 0; i < numScripts; i++)
+	{
+		if (!scripts[i]->compiled)
+		{
+			continue;
+		}
+
+		for (n = 0; n < states; n++)
+		{
+			BG_AnimScriptTestState(globalScriptData->clientConditions[client], scripts[i]);
+
+			if (BG_FirstValidItem(client, scripts[i]) != BG_FirstValidItemSlow(client, scripts[i]))
+			{
+				mismatches++;
+				break;
+			}
+		}
+		(*checks) += n;
+	}
+
+	Com_Memcpy(globalScriptData->clientConditions[client], saved, sizeof(saved));
+
+	return mismatches;
+}
+
 /**
  * @brief clears the animation timer. this is useful when we want to break a animscriptevent
  */
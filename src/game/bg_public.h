@@ -1734,6 +1734,9 @@ typedef enum
 #define MAX_MODEL_ANIMATIONS                512     // animations per model
 #define MAX_ANIMSCRIPT_ANIMCOMMANDS         8
 #define MAX_ANIMSCRIPT_ITEMS                128
+#define MAX_ANIMSCRIPT_TESTS                512     // compiled tests of all models
+#define MAX_ANIMSCRIPT_TESTBITS             8192
+#define ANIMSCRIPT_ITEM_WORDS               (MAX_ANIMSCRIPT_ITEMS / 32)
 // NOTE: these must all be in sync with string tables in bg_animation.c
 
 typedef enum
@@ -1879,10 +1882,36 @@ typedef struct
 	animScriptCommand_t commands[MAX_ANIMSCRIPT_ANIMCOMMANDS];
 } animScriptItem_t;
 
+// items of a compiled script testing a condition against one bit
+typedef struct
+{
+	int bit;                                            // value for ANIM_CONDTYPE_VALUE conditions
+	unsigned int items[ANIMSCRIPT_ITEM_WORDS];
+} animScriptTestBit_t;
+
+// a condition test shared by all items of a compiled script, see BG_CompileAnimScript
+typedef struct
+{
+	int condition;
+	qboolean negative;
+	int occurrence;                                     // for items testing a condition more than once
+	unsigned int items[ANIMSCRIPT_ITEM_WORDS];          // items doing this test
+	unsigned int usedBits[2];
+	animScriptTestBit_t *bits;
+	int numBits;
+	signed char bitIndex[64];                           // into bits, -1 for unused bits
+} animScriptTest_t;
+
 typedef struct
 {
 	int numItems;
 	animScriptItem_t *items[MAX_ANIMSCRIPT_ITEMS];      // pointers into a global list of items
+
+	// item conditions compiled into tests on the condition bits, so
+	// BG_FirstValidItem doesn't have to evaluate the items one by one
+	qboolean compiled;
+	animScriptTest_t *tests;                            // pointer into the list of tests of the animScriptData_t
+	int numTests;
 } animScript_t;
 
 typedef struct
@@ -1919,6 +1948,12 @@ typedef struct
 	animModelInfo_t modelInfo[MAX_ANIMSCRIPT_MODELS];
 	int clientConditions[MAX_CLIENTS][NUM_ANIM_CONDITIONS][2];
 
+	// compiled script tests of all models, models are only added during a level
+	animScriptTest_t scriptTests[MAX_ANIMSCRIPT_TESTS];
+	int numScriptTests;
+	animScriptTestBit_t scriptTestBits[MAX_ANIMSCRIPT_TESTBITS];
+	int numScriptTestBits;
+
 	// pointers to functions from the owning module
 	// constify the arg
 	int (*soundIndex)(const char *name);
@@ -2056,6 +2091,7 @@ typedef struct bg_character_s
 
 void BG_InitWeaponStrings(void);
 void BG_AnimParseAnimScript(animModelInfo_t *modelInfo, animScriptData_t *scriptData, const char *filename, char *input);
+int BG_AnimScriptTest(animModelInfo_t *animModelInfo, int client, int states, int *checks);
 int BG_AnimScriptAnimation(playerState_t *ps, animModelInfo_t *modelInfo, scriptAnimMoveTypes_t movetype, qboolean isContinue);
 int BG_AnimScriptCannedAnimation(playerState_t *ps, animModelInfo_t *modelInfo);
 int BG_AnimScriptEvent(playerState_t *ps, animModelInfo_t *modelInfo, scriptAnimEventTypes_t event, qboolean isContinue, qboolean force);
@@ -248,7 +248,7 @@ void SP_alarm_box(gentity_t *ent)
 	ent->die        = alarmbox_die;
 	ent->use        = alarmbox_use;
 	ent->think      = alarmbox_finishspawning;
-	ent->nextthink  = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	trap_LinkEntity(ent);
 }
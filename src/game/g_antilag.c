@@ -749,11 +749,13 @@ void G_Trace(gentity_t *ent, trace_t *results, const vec3_t start, const vec3_t
 		}
 		else
 		{
-			for (i = 0; i < level.num_entities; i++)  // // slower way, improve by time
+			gentity_t *body;
+
+			for (body = level.entityGroups[ENTGROUP_CORPSE]; body; body = body->groupNext)
 			{
-				if (g_entities[i].s.eType == ET_CORPSE)
+				if (body->s.eType == ET_CORPSE)
 				{
-					G_TempTraceIgnoreEntity(&g_entities[i]);
+					G_TempTraceIgnoreEntity(body);
 				}
 			}
 		}
@@ -342,8 +342,8 @@ After sitting around for five seconds, fall into the ground and dissapear
 void BodySink2(gentity_t *ent)
 {
 	ent->physicsObject = qfalse;
-	ent->nextthink     = level.time + 1800; // BODY_TIME(BODY_TEAM(ent)) + 1500; // FIXME: remove
-	ent->think         = BodyUnlink;
+	G_SetNextThink(ent, level.time + 1800); // BODY_TIME(BODY_TEAM(ent)) + 1500; // FIXME: remove
+	ent->think = BodyUnlink;
 
 	if (g_corpses.integer == 0)
 	{
@@ -375,7 +375,7 @@ void BodySink(gentity_t *ent)
 		// see if parent is still disguised
 		if (ent->activator->client->ps.powerups[PW_OPS_DISGUISED])
 		{
-			ent->nextthink = level.time + 100;
+			G_SetNextThink(ent, level.time + 100);
 			return;
 		}
 		else
@@ -529,6 +529,7 @@ void CopyToBodyQue(gentity_t *ent)
 	else
 	{
 		body = G_Spawn();
+		G_AddEntityToGroup(body, ENTGROUP_CORPSE);
 	}
 
 	body->s        = ent->s;
@@ -648,9 +649,9 @@ void CopyToBodyQue(gentity_t *ent)
 	//}
 
 	body->activator = NULL;
-	body->nextthink = level.time + BODY_TIME(ent->client->sess.sessionTeam);
-	body->think     = BodySink;
-	body->die       = body_die;
+	G_SetNextThink(body, level.time + BODY_TIME(ent->client->sess.sessionTeam));
+	body->think = BodySink;
+	body->die   = body_die;
 
 	// don't take more damage if already gibbed
 	if (ent->health <= GIB_HEALTH)
@@ -3377,7 +3378,7 @@ void ClientDisconnect(int clientNum)
 		{
 			teamList = &mapEntityData[i];
 
-			if ((mEnt = G_FindMapEntityData(&mapEntityData[0], ent - g_entities)) != NULL)
+			if ((mEnt = G_FindMapEntityData(teamList, ent - g_entities)) != NULL)
 			{
 				G_FreeMapEntityData(teamList, mEnt);
 			}
@@ -1224,7 +1224,7 @@ qboolean SetTeam(gentity_t *ent, char *s, qboolean force, weapon_t w1, weapon_t
 		{
 			teamList = &mapEntityData[i];
 
-			if ((mEnt = G_FindMapEntityData(&mapEntityData[0], ent - g_entities)) != NULL)
+			if ((mEnt = G_FindMapEntityData(teamList, ent - g_entities)) != NULL)
 			{
 				G_FreeMapEntityData(teamList, mEnt);
 			}
@@ -3583,7 +3583,7 @@ qboolean Do_Activate2_f(gentity_t *ent, gentity_t *traceEnt)
 
 					if (BODY_VALUE(traceEnt) >= 250)
 					{
-						traceEnt->nextthink = traceEnt->timestamp + BODY_TIME(BODY_TEAM(traceEnt));
+						G_SetNextThink(traceEnt, traceEnt->timestamp + BODY_TIME(BODY_TEAM(traceEnt)));
 
 						//BG_AnimScriptEvent( &ent->client->ps, ent->client->pers.character->animModelInfo, ANIM_ET_PICKUPGRENADE, qfalse, qtrue );
 						//ent->client->ps.pm_flags |= PMF_TIME_LOCKPLAYER;
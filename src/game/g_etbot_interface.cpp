@@ -1618,6 +1618,214 @@ gentity_t *Bot_EntInvisibleBySmokeBomb(vec3_t start, vec3_t end)
 	return 0;
 }
 
+/**
+ * @brief Sets up a TraceLine of the library as a ray of a batch, without the PVS flag
+ */
+static void Bot_SetupTrace(traceBatch_t &_tb, const float _start[3], const float _end[3],
+                           const AABB *_pBBox, int _mask, int _user)
+{
+	int iMask = 0;
+
+	// Set up the collision masks
+	if (_mask & TR_MASK_ALL)
+	{
+		iMask = MASK_ALL;
+	}
+	else
+	{
+		if (_mask & TR_MASK_SOLID)
+		{
+			iMask |= MASK_SOLID;
+		}
+		if (_mask & TR_MASK_PLAYER)
+		{
+			iMask |= MASK_PLAYERSOLID;
+		}
+		if (_mask & TR_MASK_SHOT)
+		{
+			iMask |= MASK_SHOT;
+		}
+		if (_mask & TR_MASK_OPAQUE)
+		{
+			iMask |= MASK_OPAQUE;
+		}
+		if (_mask & TR_MASK_WATER)
+		{
+			iMask |= MASK_WATER;
+		}
+		if (_mask & TR_MASK_PLAYERCLIP)
+		{
+			iMask |= CONTENTS_PLAYERCLIP;
+		}
+		if (_mask & (TR_MASK_FLOODFILL | TR_MASK_FLOODFILLENT))
+		{
+			iMask |= CONTENTS_PLAYERCLIP | CONTENTS_SOLID;
+		}
+	}
+
+	VectorCopy(_start, _tb.start);
+	VectorCopy(_end, _tb.end);
+	if (_pBBox)
+	{
+		VectorCopy(_pBBox->m_Mins, _tb.mins);
+		VectorCopy(_pBBox->m_Maxs, _tb.maxs);
+	}
+	else
+	{
+		VectorClear(_tb.mins);
+		VectorClear(_tb.maxs);
+	}
+	_tb.passEntityNum = _user;
+	_tb.contentmask   = iMask;
+	_tb.flags         = 0;
+	if (_mask & TR_MASK_FLOODFILL)
+	{
+		_tb.flags |= TRACEBATCH_NOENTS;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Line of sight prefetch
+//
+// The library checks the line of sight of its bots with one TraceLine at a
+// time from pfnUpdate, during which nothing in the world moves. The lines
+// from the eyes of a client to the eyes or origin of another one asked for
+// in the last frame are traced up front in one G_TraceBatch, and TraceLine
+// answers them from there. Any other trace is done on the spot.
+
+#define MAX_LOS_RAYS 1024
+
+enum { LOS_EYE, LOS_ORIGIN, LOS_POINTS };
+
+typedef struct
+{
+	short user;
+	short target;
+	short point;                // LOS_*
+	int mask;                   // TR_MASK_*
+	bool usePVS;
+} losRequest_t;
+
+static struct
+{
+	bool active;                // pfnUpdate is running
+	bool valid[MAX_CLIENTS];
+	vec3_t points[MAX_CLIENTS][LOS_POINTS];
+
+	traceBatch_t rays[MAX_LOS_RAYS];
+	losRequest_t batched[MAX_LOS_RAYS];
+	int numRays;
+	short index[MAX_CLIENTS][MAX_CLIENTS][LOS_POINTS];  // into rays, -1 if not prefetched
+
+	// asked for in this frame, prefetched in the next one
+	losRequest_t wanted[MAX_LOS_RAYS];
+	int numWanted;
+	byte isWanted[MAX_CLIENTS][MAX_CLIENTS][LOS_POINTS];
+} botLos;
+
+/**
+ * @brief Traces the lines of sight asked for in the last frame, before pfnUpdate
+ */
+static void Bot_PrefetchLineOfSight()
+{
+	int i;
+
+	for (i = 0; i < MAX_CLIENTS; i++)
+	{
+		gentity_t *ent = &g_entities[i];
+
+		botLos.valid[i] = ent->inuse && ent->client
+		                  && g_InterfaceFunctions->GetEntityPosition(HandleFromEntity(ent), botLos.points[i][LOS_ORIGIN]) == Success
+		                  && g_InterfaceFunctions->GetEntityEyePosition(HandleFromEntity(ent), botLos.points[i][LOS_EYE]) == Success;
+	}
+
+	memset(botLos.index, -1, sizeof(botLos.index));
+	botLos.numRays = 0;
+
+	for (i = 0; i < botLos.numWanted; i++)
+	{
+		const losRequest_t &req = botLos.wanted[i];
+
+		if (!botLos.valid[req.user] || !botLos.valid[req.target])
+		{
+			continue;
+		}
+
+		traceBatch_t &tb = botLos.rays[botLos.numRays];
+		Bot_SetupTrace(tb, botLos.points[req.user][LOS_EYE], botLos.points[req.target][req.point], NULL, req.mask, req.user);
+		if (req.usePVS)
+		{
+			tb.flags |= TRACEBATCH_PVS;
+		}
+
+		botLos.batched[botLos.numRays]                = req;
+		botLos.index[req.user][req.target][req.point] = botLos.numRays++;
+	}
+
+	botLos.numWanted = 0;
+	memset(botLos.isWanted, 0, sizeof(botLos.isWanted));
+
+	if (botLos.numRays)
+	{
+		G_TraceBatch(botLos.rays, botLos.numRays);
+	}
+
+	botLos.active = true;
+}
+
+/**
+ * @brief Looks a TraceLine up in the prefetched lines of sight
+ * @return the ray, or NULL if it has to be traced
+ */
+static const traceBatch_t *Bot_FindLineOfSight(const float _start[3], const float _end[3],
+                                               const AABB *_pBBox, int _mask, int _user, bool _usePVS)
+{
+	int target, point, i;
+
+	if (!botLos.active || _pBBox || _user < 0 || _user >= MAX_CLIENTS || !botLos.valid[_user]
+	    || !VectorCompare(_start, botLos.points[_user][LOS_EYE]))
+	{
+		return NULL;
+	}
+
+	for (target = 0; target < MAX_CLIENTS; target++)
+	{
+		if (target == _user || !botLos.valid[target])
+		{
+			continue;
+		}
+
+		for (point = 0; point < LOS_POINTS; point++)
+		{
+			if (!VectorCompare(_end, botLos.points[target][point]))
+			{
+				continue;
+			}
+
+			if (!botLos.isWanted[_user][target][point] && botLos.numWanted < MAX_LOS_RAYS)
+			{
+				losRequest_t &req = botLos.wanted[botLos.numWanted++];
+
+				req.user   = _user;
+				req.target = target;
+				req.point  = point;
+				req.mask   = _mask;
+				req.usePVS = _usePVS;
+				botLos.isWanted[_user][target][point] = 1;
+			}
+
+			i = botLos.index[_user][target][point];
+			if (i >= 0 && botLos.batched[i].mask == _mask && botLos.batched[i].usePVS == _usePVS)
+			{
+				return &botLos.rays[i];
+			}
+			return NULL;
+		}
+	}
+
+	return NULL;
+}
+
 void Bot_Util_AddGoal(const char *_type, gentity_t *_ent, int _team, const char *_tag, const char *_extrakey = 0, obUserData *_extraval = 0)
 {
 	if (IsOmnibotLoaded())
@@ -2833,106 +3041,79 @@ public:
 	obResult TraceLine(obTraceResult &_result, const float _start[3], const float _end[3],
 	                   const AABB *_pBBox, int _mask, int _user, obBool _bUsePVS)
 	{
-		qboolean bInPVS = _bUsePVS ? trap_InPVS(_start, _end) : qtrue;
-		if (bInPVS)
+		traceBatch_t       tb;
+		const traceBatch_t *ray = Bot_FindLineOfSight(_start, _end, _pBBox, _mask, _user, _bUsePVS ? true : false);
+
+		if (!ray)
 		{
-			int iMask = 0;
+			Bot_SetupTrace(tb, _start, _end, _pBBox, _mask, _user);
+		}
 
-			// Set up the collision masks
-			if (_mask & TR_MASK_ALL)
-			{
-				iMask = MASK_ALL;
-			}
-			else
+		if (!(_mask & TR_MASK_ALL) && (_mask & TR_MASK_SMOKEBOMB))
+		{
+			// the smoke check goes between the PVS check and the trace, it may save the trace
+			if (_bUsePVS && !(ray ? ray->inPVS : trap_InPVS(_start, _end)))
 			{
-				if (_mask & TR_MASK_SOLID)
-				{
-					iMask |= MASK_SOLID;
-				}
-				if (_mask & TR_MASK_PLAYER)
-				{
-					iMask |= MASK_PLAYERSOLID;
-				}
-				if (_mask & TR_MASK_SHOT)
-				{
-					iMask |= MASK_SHOT;
-				}
-				if (_mask & TR_MASK_OPAQUE)
-				{
-					iMask |= MASK_OPAQUE;
-				}
-				if (_mask & TR_MASK_WATER)
-				{
-					iMask |= MASK_WATER;
-				}
-				if (_mask & TR_MASK_PLAYERCLIP)
-				{
-					iMask |= CONTENTS_PLAYERCLIP;
-				}
-				if (_mask & (TR_MASK_FLOODFILL | TR_MASK_FLOODFILLENT))
-				{
-					iMask |= CONTENTS_PLAYERCLIP | CONTENTS_SOLID;
-				}
-
-				if (_mask & TR_MASK_SMOKEBOMB)
-				{
-					gentity_t *pSmokeBlocker = Bot_EntInvisibleBySmokeBomb((float *)_start, (float *)_end);
-					if (pSmokeBlocker)
-					{
-						_result.m_Fraction  = 0.0f;
-						_result.m_HitEntity = HandleFromEntity(pSmokeBlocker);
-						return Success;
-					}
-				}
+				// Not in PVS
+				_result.m_Fraction = 0.0f;
+				_result.m_HitEntity.Reset();
+				return OutOfPVS;
 			}
 
-			trace_t tr;
-
-			if (_mask & TR_MASK_FLOODFILL)
+			gentity_t *pSmokeBlocker = Bot_EntInvisibleBySmokeBomb((float *)_start, (float *)_end);
+			if (pSmokeBlocker)
 			{
-				trap_TraceNoEnts(&tr, _start,
-				                 _pBBox ? _pBBox->m_Mins : NULL,
-				                 _pBBox ? _pBBox->m_Maxs : NULL,
-				                 _end, _user, iMask);
-			}
-			else
-			{
-				trap_Trace(&tr, _start,
-				           _pBBox ? _pBBox->m_Mins : NULL,
-				           _pBBox ? _pBBox->m_Maxs : NULL,
-				           _end, _user, iMask);
+				_result.m_Fraction  = 0.0f;
+				_result.m_HitEntity = HandleFromEntity(pSmokeBlocker);
+				return Success;
 			}
+		}
+		else if (_bUsePVS && !ray)
+		{
+			// PVS check and trace go to the server in one syscall
+			tb.flags |= TRACEBATCH_PVS;
+		}
 
-			if ((tr.entityNum != ENTITYNUM_WORLD) && (tr.entityNum != ENTITYNUM_NONE))
-			{
-				_result.m_HitEntity = HandleFromEntity(&g_entities[tr.entityNum]);
-			}
-			else
-			{
-				_result.m_HitEntity.Reset();
-			}
+		if (!ray)
+		{
+			G_TraceBatch(&tb, 1);
+			ray = &tb;
+		}
 
-			//_result.m_iUser1 = tr.surfaceFlags;
+		if (!ray->inPVS)
+		{
+			// Not in PVS
+			_result.m_Fraction = 0.0f;
+			_result.m_HitEntity.Reset();
+			return OutOfPVS;
+		}
+
+		const trace_t &tr = ray->trace;
 
-			// Fill in the bot traceflag.
-			_result.m_Fraction   = tr.fraction;
-			_result.m_StartSolid = tr.startsolid;
-			_result.m_Endpos[0]  = tr.endpos[0];
-			_result.m_Endpos[1]  = tr.endpos[1];
-			_result.m_Endpos[2]  = tr.endpos[2];
-			_result.m_Normal[0]  = tr.plane.normal[0];
-			_result.m_Normal[1]  = tr.plane.normal[1];
-			_result.m_Normal[2]  = tr.plane.normal[2];
-			_result.m_Contents   = obUtilBotContentsFromGameContents(tr.contents);
-			_result.m_Surface    = obUtilBotSurfaceFromGameSurface(tr.surfaceFlags);
+		if ((tr.entityNum != ENTITYNUM_WORLD) && (tr.entityNum != ENTITYNUM_NONE))
+		{
+			_result.m_HitEntity = HandleFromEntity(&g_entities[tr.entityNum]);
 		}
 		else
 		{
-			// Not in PVS
-			_result.m_Fraction = 0.0f;
 			_result.m_HitEntity.Reset();
 		}
-		return bInPVS ? Success : OutOfPVS;
+
+		//_result.m_iUser1 = tr.surfaceFlags;
+
+		// Fill in the bot traceflag.
+		_result.m_Fraction   = tr.fraction;
+		_result.m_StartSolid = tr.startsolid;
+		_result.m_Endpos[0]  = tr.endpos[0];
+		_result.m_Endpos[1]  = tr.endpos[1];
+		_result.m_Endpos[2]  = tr.endpos[2];
+		_result.m_Normal[0]  = tr.plane.normal[0];
+		_result.m_Normal[1]  = tr.plane.normal[1];
+		_result.m_Normal[2]  = tr.plane.normal[2];
+		_result.m_Contents   = obUtilBotContentsFromGameContents(tr.contents);
+		_result.m_Surface    = obUtilBotSurfaceFromGameSurface(tr.surfaceFlags);
+
+		return Success;
 	}
 
 	int GetPointContents(const float _pos[3])
@@ -6444,7 +6625,9 @@ void Bot_Interface_Update()
 		//SendDeferredGoals();
 		//////////////////////////////////////////////////////////////////////////
 		// Call the libraries update.
+		Bot_PrefetchLineOfSight();
 		g_BotFunctions.pfnUpdate();
+		botLos.active = false;
 		//////////////////////////////////////////////////////////////////////////
 	}
 }
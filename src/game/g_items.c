@@ -761,7 +761,7 @@ void RespawnItem(gentity_t *ent)
 	ent->r.svFlags &= ~SVF_NOCLIENT;
 	trap_LinkEntity(ent);
 
-	ent->nextthink = 0;
+	G_SetNextThink(ent, 0);
 }
 
 /**
@@ -918,13 +918,13 @@ void Touch_Item(gentity_t *ent, gentity_t *other, trace_t *trace)
 	// events such as ctf flags
 	if (respawn <= 0)
 	{
-		ent->nextthink = 0;
-		ent->think     = 0;
+		G_SetNextThink(ent, 0);
+		ent->think = 0;
 	}
 	else
 	{
-		ent->nextthink = level.time + respawn * 1000;
-		ent->think     = RespawnItem;
+		G_SetNextThink(ent, level.time + respawn * 1000);
+		ent->think = RespawnItem;
 	}
 	trap_LinkEntity(ent);
 }
@@ -993,7 +993,7 @@ gentity_t *LaunchItem(gitem_t *item, vec3_t origin, vec3_t velocity, int ownerNu
 		dropped->s.otherEntityNum = g_entities[ownerNum].client->flagParent;    // store the entitynum of our original flag spawner
 		dropped->s.density        = 1;
 		dropped->think            = Team_DroppedFlagThink;
-		dropped->nextthink        = level.time + 30000;
+		G_SetNextThink(dropped, level.time + 30000);
 
 		if (level.gameManager)
 		{
@@ -1003,8 +1003,8 @@ gentity_t *LaunchItem(gitem_t *item, vec3_t origin, vec3_t velocity, int ownerNu
 	}
 	else     // auto-remove after 30 seconds
 	{
-		dropped->think     = G_FreeEntity;
-		dropped->nextthink = level.time + 30000;
+		dropped->think = G_FreeEntity;
+		G_SetNextThink(dropped, level.time + 30000);
 	}
 
 	dropped->flags = FL_DROPPED_ITEM;
@@ -1170,8 +1170,8 @@ void G_SpawnItem(gentity_t *ent, gitem_t *item)
 	ent->item = item;
 	// some movers spawn on the second frame, so delay item
 	// spawns until the third frame so they can ride trains
-	ent->nextthink = level.time + FRAMETIME * 2;
-	ent->think     = FinishSpawningItem;
+	G_SetNextThink(ent, level.time + FRAMETIME * 2);
+	ent->think = FinishSpawningItem;
 
 	if (G_SpawnString("noise", 0, &noise))
 	{
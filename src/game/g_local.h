@@ -113,6 +113,16 @@ typedef enum
 typedef struct gentity_s gentity_t;
 typedef struct gclient_s gclient_t;
 
+// entity groups kept in their own intrusive list (level.entityGroups)
+// so code looking for one kind of entity doesn't have to scan g_entities
+typedef enum
+{
+	ENTGROUP_NONE = 0,
+	ENTGROUP_LANDMINE,
+	ENTGROUP_CORPSE,
+	ENTGROUP_MAX
+} entityGroup_t;
+
 //====================================================================
 
 // Scripting (parsed at each start)
@@ -485,6 +495,19 @@ struct gentity_s
 
 	qboolean runthisframe;
 
+	// intrusive entity lists, see G_LinkActiveEntity and G_AddEntityToGroup
+	gentity_t *activeNext;              // next in-use non-client entity, sorted by entity number
+	gentity_t *activePrev;
+	gentity_t *groupNext;               // next entity of the same entityGroup
+	gentity_t *groupPrev;
+	entityGroup_t entityGroup;
+
+	// think wheel, see g_think.c
+	qboolean asleep;                    // parked by G_EntitySleep, not in level.activeEntities
+	int sleepThinkTime;                 // nextthink the entity was parked with
+	gentity_t *sleepNext;
+	gentity_t **sleepLink;              // the pointer in the think wheel that points at us
+
 	g_constructible_stats_t constructibleStats;
 
 	int etpro_misc_1; // bit 0 = it's a planted/ticking dynamite
@@ -972,6 +995,20 @@ typedef struct config_s
 	qboolean publicConfig;
 } config_t;
 
+#define THINKWHEEL_BITS     6
+#define THINKWHEEL_SLOTS    (1 << THINKWHEEL_BITS)
+#define THINKWHEEL_MASK     (THINKWHEEL_SLOTS - 1)
+#define THINKWHEEL_LEVELS   4
+
+// hierarchical timer wheel of sleeping entities, keyed by nextthink (msec)
+typedef struct thinkWheel_s
+{
+	int time;                                               // last msec the wheel was advanced to
+	gentity_t *slots[THINKWHEEL_LEVELS][THINKWHEEL_SLOTS];
+	gentity_t *overflow;                                    // scheduled beyond the outermost level
+	gentity_t *idle;                                        // asleep without a pending think
+} thinkWheel_t;
+
 typedef struct level_locals_s
 {
 	struct gclient_s *clients;          // [maxclients]
@@ -985,6 +1022,7 @@ typedef struct level_locals_s
 	fileHandle_t logFile;
 
 	qboolean legacyServer;
+	int syscallExtensions;                  // SYSCALL_EXT_* the server has
 
 	char rawmapname[MAX_QPATH];
 
@@ -1040,6 +1078,12 @@ typedef struct level_locals_s
 	vec3_t intermission_angle;
 	qboolean lmsDoNextMap;              // should LMS do a map_restart or a vstr nextmap
 
+	gentity_t *activeEntities;          // in-use non-client entities, sorted by entity number
+	gentity_t *activeIterCur;           // entity G_RunFrame is currently running
+	gentity_t *activeIterNext;          // next entity of the G_RunFrame walk, kept valid on link/unlink
+	gentity_t *entityGroups[ENTGROUP_MAX];
+	thinkWheel_t thinkWheel;
+
 	int bodyQueIndex;                   // dead bodies
 	gentity_t *bodyQue[BODY_QUEUE_SIZE];
 
@@ -1296,6 +1340,9 @@ gentity_t *G_PopupMessage(popupMessageType_t type);
 void G_Sound(gentity_t *ent, int soundIndex);
 void G_AnimScriptSound(int soundIndex, vec3_t org, int client);
 void G_FreeEntity(gentity_t *e);
+void G_AddEntityToGroup(gentity_t *ent, entityGroup_t group);
+void G_LinkActiveEntity(gentity_t *e);
+void G_UnlinkActiveEntity(gentity_t *e);
 //qboolean  G_EntitiesFree( void );
 void G_ClientSound(gentity_t *ent, int soundIndex);
 
@@ -1308,6 +1355,7 @@ char *vtos(const vec3_t v);
 void G_AddPredictableEvent(gentity_t *ent, int event, int eventParm);
 void G_AddEvent(gentity_t *ent, int event, int eventParm);
 void G_SetOrigin(gentity_t *ent, vec3_t origin);
+int G_TraceBatch(traceBatch_t *batch, int count);
 void AddRemap(const char *oldShader, const char *newShader, float timeOffset);
 void G_ResetRemappedShaders(void);
 const char *BuildShaderStateConfig(void);
@@ -1515,6 +1563,16 @@ void QDECL G_Printf(const char *fmt, ...) _attribute((format(printf, 1, 2)));
 void QDECL G_DPrintf(const char *fmt, ...) _attribute((format(printf, 1, 2)));
 void QDECL G_Error(const char *fmt, ...) __attribute__ ((noreturn, format(printf, 1, 2)));
 
+// g_think.c
+void G_SetNextThink(gentity_t *ent, int time);
+void G_WakeEntity(gentity_t *ent);
+void G_EntitySleep(gentity_t *ent);
+void G_ThinkWheelUnlink(gentity_t *ent);
+void G_RunThinkWheel(void);
+#ifdef LEGACY_DEBUG
+void G_ValidateSleepingEntities(void);
+#endif
+
 // g_client.c
 char *ClientConnect(int clientNum, qboolean firstTime, qboolean isBot);
 void ClientUserinfoChanged(int clientNum);
@@ -1770,6 +1828,7 @@ extern vmCvar_t g_maxWarp;
 #ifdef FEATURE_LUA
 extern vmCvar_t lua_modules;
 extern vmCvar_t lua_allowedModules;
+extern vmCvar_t lua_maxInstructions;
 #endif
 
 extern vmCvar_t g_protect;
@@ -1871,6 +1930,7 @@ int trap_FS_GetFileList(const char *path, const char *extension, char *listbuf,
 void trap_SendConsoleCommand(int exec_when, const char *text);
 void trap_Cvar_Register(vmCvar_t *cvar, const char *var_name, const char *value, int flags);
 void trap_Cvar_Update(vmCvar_t *cvar);
+int trap_Cvar_Changes(int *sequence, int *handles, int maxHandles);
 void trap_Cvar_Set(const char *var_name, const char *value);
 int trap_Cvar_VariableIntegerValue(const char *var_name);
 float trap_Cvar_VariableValue(const char *var_name);
@@ -1889,6 +1949,7 @@ void trap_Trace(trace_t *results, const vec3_t start, const vec3_t mins, const v
 void trap_TraceCapsule(trace_t *results, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int passEntityNum, int contentmask);
 void trap_TraceCapsuleNoEnts(trace_t *results, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int passEntityNum, int contentmask);
 void trap_TraceNoEnts(trace_t *results, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int passEntityNum, int contentmask);
+int trap_TraceBatch(traceBatch_t *batch, int count);
 int trap_PointContents(const vec3_t point, int passEntityNum);
 qboolean trap_InPVS(const vec3_t p1, const vec3_t p2);
 qboolean trap_InPVSIgnorePortals(const vec3_t p1, const vec3_t p2);
@@ -1980,6 +2041,7 @@ typedef struct mapEntityData_s
 	int status;
 	int entNum;
 	struct mapEntityData_s *next, *prev;
+	struct mapEntityData_s *entNext;                    // next one of the same entNum
 } mapEntityData_t;
 
 typedef struct mapEntityData_Team_s
@@ -1987,13 +2049,14 @@ typedef struct mapEntityData_Team_s
 	mapEntityData_t mapEntityData_Team[MAX_GENTITIES];
 	mapEntityData_t *freeMapEntityData;                 // single linked list
 	mapEntityData_t activeMapEntityData;                // double linked list
+	mapEntityData_t *entityMapEntityData[MAX_GENTITIES];    // single linked lists by entNum, newest first
 } mapEntityData_Team_t;
 
 extern mapEntityData_Team_t mapEntityData[2];
 
 void G_InitMapEntityData(mapEntityData_Team_t *teamList);
 mapEntityData_t *G_FreeMapEntityData(mapEntityData_Team_t *teamList, mapEntityData_t *mEnt);
-mapEntityData_t *G_AllocMapEntityData(mapEntityData_Team_t *teamList);
+mapEntityData_t *G_AllocMapEntityData(mapEntityData_Team_t *teamList, int entNum);
 mapEntityData_t *G_FindMapEntityData(mapEntityData_Team_t *teamList, int entNum);
 mapEntityData_t *G_FindMapEntityDataSingleClient(mapEntityData_Team_t *teamList, mapEntityData_t *start, int entNum, int clientNum);
 
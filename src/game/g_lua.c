@@ -15,6 +15,14 @@
 
 #include "g_lua.h"
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#define LUA_PROFILE_TOP 10 // callbacks listed by lua_profile
+
 extern field_t fields[];
 
 lua_vm_t *lVM[LUA_NUM_VM];
@@ -956,32 +964,115 @@ static const gentity_field_t gentity_fields[] =
 	{ NULL },
 };
 
+// field names of both tables, a handle is an index into this
+typedef struct
+{
+	const char *name;
+	const gentity_field_t *clientField;     // used first for client entities
+	const gentity_field_t *entityField;
+} gentity_fieldhandle_t;
+
+#define FIELD_HANDLES_MAX   ((sizeof(gclient_fields) + sizeof(gentity_fields)) / sizeof(gentity_field_t))
+#define FIELD_HASH_SIZE     512             // power of two, at least twice FIELD_HANDLES_MAX
+
+static gentity_fieldhandle_t gentity_fieldhandles[FIELD_HANDLES_MAX];
+static int                   gentity_numfieldhandles;
+static int                   gentity_fieldhash[FIELD_HASH_SIZE];    // handle + 1, 0 if empty
+
 // gentity fields helper functions
-static gentity_field_t *_et_gentity_getfield(gentity_t *ent, char *fieldname)
+static int _et_gentity_hashfield(const char *fieldname)
 {
 	int i;
 
-	// search through client fields first
-	if (ent->client)
+	// linear probing, the table is never full
+	for (i = Q_GenerateHashValue(fieldname, FIELD_HASH_SIZE, qtrue, qtrue); gentity_fieldhash[i]; i = (i + 1) & (FIELD_HASH_SIZE - 1))
 	{
-		for (i = 0; gclient_fields[i].name; i++)
+		if (!Q_stricmp(fieldname, gentity_fieldhandles[gentity_fieldhash[i] - 1].name))
 		{
-			if (Q_stricmp(fieldname, gclient_fields[i].name) == 0)
-			{
-				return (gentity_field_t *)&gclient_fields[i];
-			}
+			break;
 		}
 	}
 
-	for (i = 0; gentity_fields[i].name; i++)
+	return i;
+}
+
+static void _et_gentity_addfieldhandles(const gentity_field_t *fields, qboolean client)
+{
+	int i, h;
+
+	for (i = 0; fields[i].name; i++)
 	{
-		if (Q_stricmp(fieldname, gentity_fields[i].name) == 0)
+		h = _et_gentity_hashfield(fields[i].name);
+		if (!gentity_fieldhash[h])
+		{
+			gentity_fieldhandles[gentity_numfieldhandles].name = fields[i].name;
+			gentity_fieldhash[h]                               = ++gentity_numfieldhandles;
+		}
+
+		if (client)
 		{
-			return (gentity_field_t *)&gentity_fields[i];
+			gentity_fieldhandles[gentity_fieldhash[h] - 1].clientField = &fields[i];
+		}
+		else
+		{
+			gentity_fieldhandles[gentity_fieldhash[h] - 1].entityField = &fields[i];
 		}
 	}
+}
 
-	return 0;
+// builds the field name hash, replaces the linear searches through the field tables
+static void _et_gentity_initfieldhandles(void)
+{
+	if (gentity_numfieldhandles)
+	{
+		return;
+	}
+
+	_et_gentity_addfieldhandles(gclient_fields, qtrue);
+	_et_gentity_addfieldhandles(gentity_fields, qfalse);
+}
+
+// returns the handle of a field name, -1 if there is no such field
+static int _et_gentity_getfieldhandle(const char *fieldname)
+{
+	return gentity_fieldhash[_et_gentity_hashfield(fieldname)] - 1;
+}
+
+// gets the field of the field name or handle at stack index idx
+static gentity_field_t *_et_gentity_getfield(lua_State *L, gentity_t *ent, int idx, const char **fieldname)
+{
+	const gentity_fieldhandle_t *handle;
+	int                         h;
+
+	if (lua_type(L, idx) == LUA_TNUMBER)
+	{
+		h = (int)lua_tointeger(L, idx);
+		if (h < 0 || h >= gentity_numfieldhandles)
+		{
+			*fieldname = lua_tostring(L, idx);
+			return NULL;
+		}
+	}
+	else
+	{
+		*fieldname = luaL_checkstring(L, idx);
+		h          = _et_gentity_getfieldhandle(*fieldname);
+		if (h < 0)
+		{
+			return NULL;
+		}
+	}
+
+	handle     = &gentity_fieldhandles[h];
+	*fieldname = handle->name;
+
+	// client fields first
+	if (ent->client && handle->clientField)
+	{
+		return (gentity_field_t *)handle->clientField;
+	}
+
+	return (gentity_field_t *)handle->entityField;
 }
 
 static void _et_gentity_getvec3(lua_State *L, vec3_t vec3)
@@ -1313,12 +1404,28 @@ static int _et_trap_UnlinkEntity(lua_State *L)
 	return 0;
 }
 
-// (variable) = et.gentity_get( entnum, fieldname, arrayindex )
+// fieldhandle = et.gentity_fieldhandle( fieldname )
+static int _et_gentity_fieldhandle(lua_State *L)
+{
+	const char *fieldname = luaL_checkstring(L, 1);
+	int        handle     = _et_gentity_getfieldhandle(fieldname);
+
+	if (handle < 0)
+	{
+		luaL_error(L, "tried to get handle of invalid gentity field \"%s\"", fieldname);
+		return 0;
+	}
+
+	lua_pushinteger(L, handle);
+	return 1;
+}
+
+// (variable) = et.gentity_get( entnum, fieldname or fieldhandle, arrayindex )
 static int _et_gentity_get(lua_State *L)
 {
-	gentity_t       *ent       = g_entities + (int)luaL_checkinteger(L, 1);
-	const char      *fieldname = luaL_checkstring(L, 2);
-	gentity_field_t *field     = _et_gentity_getfield(ent, (char *)fieldname);
+	gentity_t       *ent = g_entities + (int)luaL_checkinteger(L, 1);
+	const char      *fieldname;
+	gentity_field_t *field = _et_gentity_getfield(L, ent, 2, &fieldname);
 	unsigned long   addr;
 
 	// break on invalid gentity field
@@ -1399,12 +1506,12 @@ static int _et_gentity_get(lua_State *L)
 	return 0;
 }
 
-// et.gentity_set( entnum, fieldname, arrayindex, (value) )
+// et.gentity_set( entnum, fieldname or fieldhandle, arrayindex, (value) )
 static int _et_gentity_set(lua_State *L)
 {
-	gentity_t       *ent       = g_entities + (int)luaL_checkinteger(L, 1);
-	const char      *fieldname = luaL_checkstring(L, 2);
-	gentity_field_t *field     = _et_gentity_getfield(ent, (char *)fieldname);
+	gentity_t       *ent = g_entities + (int)luaL_checkinteger(L, 1);
+	const char      *fieldname;
+	gentity_field_t *field = _et_gentity_getfield(L, ent, 2, &fieldname);
 	unsigned long   addr;
 	const char      *buffer;
 
@@ -1440,6 +1547,9 @@ static int _et_gentity_set(lua_State *L)
 
 	addr += (unsigned long)field->mapping;
 
+	// the mod may change anything, let G_RunEntity have a look again
+	G_WakeEntity(ent);
+
 	switch (field->type)
 	{
 	case FIELD_INT:
@@ -1655,6 +1765,7 @@ static const luaL_Reg etlib[] =
 	{ "trap_UnlinkEntity",       _et_trap_UnlinkEntity       },
 	{ "gentity_get",             _et_gentity_get             },
 	{ "gentity_set",             _et_gentity_set             },
+	{ "gentity_fieldhandle",     _et_gentity_fieldhandle     },
 	{ "G_AddEvent",              _et_G_AddEvent              },
 
 	// XP functions
@@ -1685,6 +1796,8 @@ qboolean G_LuaInit(void)
 		return qtrue;
 	}
 
+	_et_gentity_initfieldhandles();
+
 	Q_strncpyz(allowedModules, Q_strupr(lua_allowedModules.string), sizeof(allowedModules));
 
 	Q_strncpyz(buff, lua_modules.string, sizeof(buff));
@@ -1738,7 +1851,7 @@ qboolean G_LuaInit(void)
 				else
 				{
 					// Init lua_vm_t struct
-					vm = (lua_vm_t *) malloc(sizeof(lua_vm_t));
+					vm = (lua_vm_t *) calloc(1, sizeof(lua_vm_t));
 
 					if (vm == NULL)
 					{
@@ -1787,13 +1900,185 @@ qboolean G_LuaInit(void)
 	return qtrue;
 }
 
+/**
+ * @brief Clock for timing callbacks, trap_Milliseconds is too coarse for most of them
+ * @return microseconds
+ */
+static int64_t G_LuaMicroseconds(void)
+{
+#ifdef _WIN32
+	static LARGE_INTEGER frequency;
+	LARGE_INTEGER        counter;
+
+	if (!frequency.QuadPart)
+	{
+		QueryPerformanceFrequency(&frequency);
+	}
+	QueryPerformanceCounter(&counter);
+
+	return (counter.QuadPart / frequency.QuadPart) * 1000000 + (counter.QuadPart % frequency.QuadPart) * 1000000 / frequency.QuadPart;
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#endif
+}
+
+/**
+ * @brief lua_Alloc of the VMs, counts the memory used by each of them
+ * @param[in,out] ud the lua_vm_t
+ * @param[in] ptr
+ * @param[in] osize
+ * @param[in] nsize
+ * @return
+ */
+static void *G_LuaAlloc(void *ud, void *ptr, size_t osize, size_t nsize)
+{
+	lua_vm_t *vm = (lua_vm_t *)ud;
+	void     *mem;
+
+	// osize is the type of the object for new blocks
+	if (!ptr)
+	{
+		osize = 0;
+	}
+
+	if (!nsize)
+	{
+		free(ptr);
+		vm->memUsed -= osize;
+		return NULL;
+	}
+
+	mem = realloc(ptr, nsize);
+	if (!mem)
+	{
+		return NULL;
+	}
+
+	if (!ptr)
+	{
+		vm->memAllocs++;
+	}
+
+	vm->memUsed += nsize - osize;
+	if (vm->memUsed > vm->memPeak)
+	{
+		vm->memPeak = vm->memUsed;
+	}
+
+	return mem;
+}
+
+/**
+ * @brief Errors outside of lua_pcall, Lua would abort() otherwise
+ * @param[in] L
+ * @return
+ */
+static int G_LuaPanic(lua_State *L)
+{
+	G_Error("Lua API: unprotected error in call to Lua API: %s\n", lua_tostring(L, -1));
+	return 0;
+}
+
+/**
+ * @brief Count hook, stops a callback once it ran lua_maxInstructions instructions
+ * @param[in] L
+ * @param ar - unused
+ */
+static void G_LuaBudgetHook(lua_State *L, lua_Debug *ar)
+{
+	void *ud;
+
+	// coroutines have a lua_State of their own, the allocator is shared
+	lua_getallocf(L, &ud);
+	((lua_vm_t *)ud)->budgetExceeded = qtrue;
+
+	luaL_error(L, "callback exceeded lua_maxInstructions (%d)", lua_maxInstructions.integer);
+}
+
+/**
+ * @brief Gets the stats of a callback, adding them if it wasn't called before
+ * @param[in,out] vm
+ * @param[in] func
+ * @return NULL if too many different functions were called
+ */
+static lua_hookstats_t *G_LuaHookStats(lua_vm_t *vm, const char *func)
+{
+	int i;
+
+	for (i = 0; i < LUA_HOOK_STATS; i++)
+	{
+		if (!vm->hookStats[i].func)
+		{
+			vm->hookStats[i].func = func;
+			return &vm->hookStats[i];
+		}
+
+		if (!strcmp(vm->hookStats[i].func, func))
+		{
+			return &vm->hookStats[i];
+		}
+	}
+
+	return NULL;
+}
+
 /*
  * G_LuaCall( func, vm, nargs, nresults )
  * Calls a function already on the stack.
  */
 qboolean G_LuaCall(lua_vm_t *vm, const char *func, int nargs, int nresults)
 {
-	switch (lua_pcall(vm->L, nargs, nresults, 0))
+	lua_hookstats_t *stats = G_LuaHookStats(vm, func);
+	int             allocs = vm->memAllocs;
+	int             res, time, bucket;
+	int64_t         start;
+
+	// nested calls run on the budget of the outermost one
+	if (!vm->callDepth && lua_maxInstructions.integer > 0)
+	{
+		lua_sethook(vm->L, G_LuaBudgetHook, LUA_MASKCOUNT, lua_maxInstructions.integer);
+	}
+	vm->callDepth++;
+
+	start = G_LuaMicroseconds();
+	res   = lua_pcall(vm->L, nargs, nresults, 0);
+	time  = (int)(G_LuaMicroseconds() - start);
+
+	vm->callDepth--;
+	if (!vm->callDepth)
+	{
+		lua_sethook(vm->L, NULL, 0, 0);
+	}
+
+	if (stats)
+	{
+		stats->calls++;
+		stats->allocs    += vm->memAllocs - allocs;
+		stats->totalTime += time;
+		if (time > stats->maxTime)
+		{
+			stats->maxTime = time;
+		}
+
+		bucket = 0;
+		while (bucket < LUA_HOOK_BUCKETS - 1 && (time >> (bucket + 5)))
+		{
+			bucket++;
+		}
+		stats->histogram[bucket]++;
+
+		if (vm->budgetExceeded)
+		{
+			stats->aborts++;
+		}
+	}
+	vm->budgetExceeded = qfalse;
+
+	switch (res)
 	{
 	case LUA_ERRRUN:
 		// made output more ETPro compatible
@@ -1844,7 +2129,7 @@ qboolean G_LuaGetNamedFunction(lua_vm_t *vm, const char *name)
  */
 void G_LuaStackDump()
 {
-	lua_vm_t *vm = (lua_vm_t *) malloc(sizeof(lua_vm_t));
+	lua_vm_t *vm = (lua_vm_t *) calloc(1, sizeof(lua_vm_t));
 
 	if (vm == NULL)
 	{
@@ -2201,12 +2486,13 @@ qboolean G_LuaStartVM(lua_vm_t *vm)
 	const char *luaPath, *luaCPath;
 
 	// Open a new lua state
-	vm->L = luaL_newstate();
+	vm->L = lua_newstate(G_LuaAlloc, vm);
 	if (!vm->L)
 	{
 		G_Printf("%s API: Lua failed to initialise.\n", LUA_VERSION);
 		return qfalse;
 	}
+	lua_atpanic(vm->L, G_LuaPanic);
 
 	// Initialise the lua state
 	luaL_openlibs(vm->L);
@@ -2385,6 +2671,281 @@ void G_LuaStatus(gentity_t *ent)
 	G_refPrintf(ent, "-- ------------------------ ---------------------------------------- ------------------------");
 }
 
+typedef struct
+{
+	lua_vm_t *vm;
+	lua_hookstats_t *stats;
+} luaProfileEntry_t;
+
+/**
+ * @brief Sorts callbacks by total time, most expensive first
+ */
+static int QDECL G_LuaSortProfile(const void *a, const void *b)
+{
+	int64_t ta = ((const luaProfileEntry_t *)a)->stats->totalTime;
+	int64_t tb = ((const luaProfileEntry_t *)b)->stats->totalTime;
+
+	return (ta < tb) - (ta > tb);
+}
+
+/**
+ * @brief Estimates a percentile of the call times of a callback from its histogram
+ * @param[in] stats
+ * @param[in] fraction
+ * @return upper bound of the bucket in usec
+ */
+static int G_LuaHookPercentile(const lua_hookstats_t *stats, float fraction)
+{
+	int bucket, count = 0;
+
+	for (bucket = 0; bucket < LUA_HOOK_BUCKETS - 1; bucket++)
+	{
+		count += stats->histogram[bucket];
+		if (count >= fraction * stats->calls)
+		{
+			break;
+		}
+	}
+
+	return MIN(1 << (bucket + 5), stats->maxTime);
+}
+
+/*
+ * G_LuaProfile( ent, reset )
+ * Prints the most expensive callbacks and the memory used by each VM.
+ */
+void G_LuaProfile(gentity_t *ent, qboolean reset)
+{
+	luaProfileEntry_t entries[LUA_NUM_VM * LUA_HOOK_STATS];
+	lua_hookstats_t   *stats;
+	lua_vm_t          *vm;
+	int               i, j, numEntries = 0;
+
+	if (reset)
+	{
+		for (i = 0; i < LUA_NUM_VM; i++)
+		{
+			if (lVM[i])
+			{
+				Com_Memset(lVM[i]->hookStats, 0, sizeof(lVM[i]->hookStats));
+				lVM[i]->memPeak = lVM[i]->memUsed;
+			}
+		}
+		G_refPrintf(ent, "%s API: profile reset.", LUA_VERSION);
+		return;
+	}
+
+	for (i = 0; i < LUA_NUM_VM; i++)
+	{
+		if (!lVM[i])
+		{
+			continue;
+		}
+
+		for (j = 0; j < LUA_HOOK_STATS && lVM[i]->hookStats[j].func; j++)
+		{
+			entries[numEntries].vm    = lVM[i];
+			entries[numEntries].stats = &lVM[i]->hookStats[j];
+			numEntries++;
+		}
+	}
+
+	if (!numEntries)
+	{
+		G_refPrintf(ent, "%s API: no callbacks called.", LUA_VERSION);
+		return;
+	}
+
+	qsort(entries, numEntries, sizeof(entries[0]), G_LuaSortProfile);
+
+	G_refPrintf(ent, "%s API: most expensive callbacks (times in usec)", LUA_VERSION);
+	G_refPrintf(ent, "%-2s %-16s %-24s %8s %10s %6s %6s %8s %6s %8s", "VM", "Modname", "Callback", "Calls", "Total", "Avg", "p99", "Max", "Aborts", "Allocs");
+	G_refPrintf(ent, "-- ---------------- ------------------------ -------- ---------- ------ ------ -------- ------ --------");
+	for (i = 0; i < numEntries && i < LUA_PROFILE_TOP; i++)
+	{
+		vm    = entries[i].vm;
+		stats = entries[i].stats;
+
+		G_refPrintf(ent, "%2d %-16.16s %-24.24s %8d %10lld %6d %6d %8d %6d %8d", vm->id, vm->mod_name, stats->func, stats->calls,
+		            (long long)stats->totalTime, (int)(stats->totalTime / MAX(stats->calls, 1)), G_LuaHookPercentile(stats, 0.99f),
+		            stats->maxTime, stats->aborts, stats->allocs);
+	}
+	G_refPrintf(ent, "-- ---------------- ------------------------ -------- ---------- ------ ------ -------- ------ --------");
+
+	for (i = 0; i < LUA_NUM_VM; i++)
+	{
+		if (lVM[i])
+		{
+			G_refPrintf(ent, "%2d %-16.16s memory %6d KB, peak %6d KB, %d allocations", lVM[i]->id, lVM[i]->mod_name,
+			            (int)(lVM[i]->memUsed >> 10), (int)(lVM[i]->memPeak >> 10), lVM[i]->memAllocs);
+		}
+	}
+}
+
+// field lookups of the client loop of a typical stats script
+static const char *luaBenchScript =
+	"local fields = { 'pers.connected', 'pers.netname', 'sess.sessionTeam', 'sess.playerType', 'sess.kills',\n"
+	"                 'sess.deaths', 'sess.damage_given', 'sess.damage_received', 'sess.team_damage_given',\n"
+	"                 'sess.team_kills', 'sess.rounds', 'health', 'ps.ping' }\n"
+	"local handles = {}\n"
+	"for i = 1, #fields do handles[i] = et.gentity_fieldhandle(fields[i]) end\n"
+	"function bench(rounds, maxclients, usehandles)\n"
+	"  local f, sum = usehandles and handles or fields, 0\n"
+	"  for r = 1, rounds do\n"
+	"    for cno = 0, maxclients - 1 do\n"
+	"      for i = 1, #f do\n"
+	"        local v = et.gentity_get(cno, f[i])\n"
+	"        if type(v) == 'number' then sum = sum + v end\n"
+	"      end\n"
+	"    end\n"
+	"  end\n"
+	"  return sum\n"
+	"end\n";
+
+/**
+ * @brief Field lookup before the field hash, reference for G_LuaBenchmark
+ * @param[in] client
+ * @param[in] fieldname
+ * @return
+ */
+static const gentity_field_t *G_LuaBenchFindField(qboolean client, const char *fieldname)
+{
+	int i;
+
+	if (client)
+	{
+		for (i = 0; gclient_fields[i].name; i++)
+		{
+			if (!Q_stricmp(fieldname, gclient_fields[i].name))
+			{
+				return &gclient_fields[i];
+			}
+		}
+	}
+
+	for (i = 0; gentity_fields[i].name; i++)
+	{
+		if (!Q_stricmp(fieldname, gentity_fields[i].name))
+		{
+			return &gentity_fields[i];
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Runs a stats script reading the fields of all clients by name and by handle
+ * @param[in] rounds
+ *
+ * @details Also times the field lookups of both field tables through the hash
+ * against the linear search it replaced, and counts the names they resolve
+ * differently.
+ */
+void G_LuaBenchmark(int rounds)
+{
+	const gentity_field_t       *tables[2] = { gclient_fields, gentity_fields };
+	const gentity_fieldhandle_t *handle;
+	const gentity_field_t       *field, *expected;
+	lua_State                   *L;
+	lua_Number                  sums[2];
+	int64_t                     start, usec[4];
+	int                         round, i, t, h, client, found[2] = { 0, 0 }, mismatches = 0;
+
+	_et_gentity_initfieldhandles();
+
+	// lookups through the hash and linear
+	start = G_LuaMicroseconds();
+	for (round = 0; round < rounds; round++)
+	{
+		for (t = 0; t < 2; t++)
+		{
+			for (i = 0; tables[t][i].name; i++)
+			{
+				for (client = 0; client < 2; client++)
+				{
+					h     = _et_gentity_getfieldhandle(tables[t][i].name);
+					field = NULL;
+					if (h >= 0)
+					{
+						handle = &gentity_fieldhandles[h];
+						field  = (client && handle->clientField) ? handle->clientField : handle->entityField;
+					}
+					found[0] += field ? 1 : 0;
+
+					if (!round && field != G_LuaBenchFindField(client, tables[t][i].name))
+					{
+						mismatches++;
+					}
+				}
+			}
+		}
+	}
+	usec[0] = G_LuaMicroseconds() - start;
+
+	start = G_LuaMicroseconds();
+	for (round = 0; round < rounds; round++)
+	{
+		for (t = 0; t < 2; t++)
+		{
+			for (i = 0; tables[t][i].name; i++)
+			{
+				for (client = 0; client < 2; client++)
+				{
+					expected  = G_LuaBenchFindField(client, tables[t][i].name);
+					found[1] += expected ? 1 : 0;
+				}
+			}
+		}
+	}
+	usec[1] = G_LuaMicroseconds() - start;
+
+	// the script through et.gentity_get
+	L = luaL_newstate();
+	if (!L)
+	{
+		G_Printf("%s API: Lua failed to initialise.\n", LUA_VERSION);
+		return;
+	}
+	luaL_openlibs(L);
+	luaL_newlib(L, etlib);
+	lua_setglobal(L, "et");
+
+	if (luaL_dostring(L, luaBenchScript))
+	{
+		G_Printf("lua_bench: %s\n", lua_tostring(L, -1));
+		lua_close(L);
+		return;
+	}
+
+	for (i = 0; i < 2; i++)
+	{
+		lua_getglobal(L, "bench");
+		lua_pushinteger(L, rounds);
+		lua_pushinteger(L, level.maxclients);
+		lua_pushboolean(L, i);
+
+		start = G_LuaMicroseconds();
+		if (lua_pcall(L, 3, 1, 0))
+		{
+			G_Printf("lua_bench: %s\n", lua_tostring(L, -1));
+			lua_close(L);
+			return;
+		}
+		usec[2 + i] = G_LuaMicroseconds() - start;
+
+		sums[i] = lua_tonumber(L, -1);
+		lua_pop(L, 1);
+	}
+
+	lua_close(L);
+
+	G_Printf("lua_bench: %i field lookups: %lld usec hashed, %lld usec linear, %i mismatches\n",
+	         found[1], (long long)usec[0], (long long)usec[1], mismatches + (found[0] != found[1]));
+	G_Printf("lua_bench: stats script over %i clients, %i rounds: %lld usec by name, %lld usec by handle, results %s\n",
+	         level.maxclients, rounds, (long long)usec[2], (long long)usec[3], sums[0] == sums[1] ? "match" : "differ");
+}
+
 /*
  * G_LuaGetVM
  * Retrieves the VM for a given lua_State
@@ -78,6 +78,21 @@
 #define _et_gclient_addfield(n, t, f) { #n, t, offsetof(struct gclient_s, n), FIELD_FLAG_GCLIENT + f }
 #define _et_gclient_addfieldalias(n, a, t, f) { #n, t, offsetof(struct gclient_s, a), FIELD_FLAG_GCLIENT + f }
 
+#define LUA_HOOK_STATS   24 // callbacks timed per VM
+#define LUA_HOOK_BUCKETS 16 // call time histogram, bucket n counts calls below 2^(n+5) usec
+
+// cost of one callback of a VM, reported by lua_profile
+typedef struct
+{
+	const char *func;
+	int calls;
+	int aborts;                         // calls stopped by lua_maxInstructions
+	int allocs;
+	int maxTime;                        // usec
+	int64_t totalTime;                  // usec
+	int histogram[LUA_HOOK_BUCKETS];
+} lua_hookstats_t;
+
 typedef struct
 {
 	int id;
@@ -88,6 +103,15 @@ typedef struct
 	int code_size;
 	int err;
 	lua_State *L;
+
+	// allocations done through G_LuaAlloc
+	size_t memUsed;
+	size_t memPeak;
+	int memAllocs;
+
+	int callDepth;
+	qboolean budgetExceeded;            // set by the lua_maxInstructions hook
+	lua_hookstats_t hookStats[LUA_HOOK_STATS];
 } lua_vm_t;
 
 typedef struct
@@ -121,6 +145,8 @@ qboolean G_LuaStartVM(lua_vm_t *vm);
 void G_LuaStopVM(lua_vm_t *vm);
 void G_LuaShutdown(void);
 void G_LuaStatus(gentity_t *ent);
+void G_LuaProfile(gentity_t *ent, qboolean reset);
+void G_LuaBenchmark(int rounds);
 void G_LuaStackDump();
 lua_vm_t *G_LuaGetVM(lua_State *L);
 
@@ -243,6 +243,7 @@ vmCvar_t g_maxWarp;
 #ifdef FEATURE_LUA
 vmCvar_t lua_modules;
 vmCvar_t lua_allowedModules;
+vmCvar_t lua_maxInstructions;
 #endif
 
 vmCvar_t g_protect; // similar to sv_protect game cvar
@@ -344,6 +345,7 @@ cvarTable_t gameCvarTable[] =
 	{ NULL,                                 "gamedate",                            __DATE__,                     CVAR_ROM,                                        0, qfalse},
 	{ &g_restarted,                         "g_restarted",                         "0",                          CVAR_ROM,                                        0, qfalse},
 	{ NULL,                                 "sv_mapname",                          "",                           CVAR_SERVERINFO | CVAR_ROM,                      0, qfalse},
+	{ NULL,                                 "g_nextMapName",                       "",                           CVAR_SERVERINFO | CVAR_ROM,                      0, qfalse},
 
 	// latched vars
 	{ &g_gametype,                          "g_gametype",                          "4",                          CVAR_SERVERINFO | CVAR_LATCH,                    0, qfalse}, // default to GT_WOLF_CAMPAIGN
@@ -544,6 +546,7 @@ cvarTable_t gameCvarTable[] =
 #ifdef FEATURE_LUA
 	{ &lua_modules,                         "lua_modules",                         "",                           0 },
 	{ &lua_allowedModules,                  "lua_allowedModules",                  "",                           0 },
+	{ &lua_maxInstructions,                 "lua_maxInstructions",                 "0",                          0 },
 #endif
 
 	{ &g_protect,                           "g_protect",                           "0",                          CVAR_ARCHIVE },
@@ -609,6 +612,7 @@ cvarTable_t gameCvarTable[] =
 
 // made static to avoid aliasing
 static int gameCvarTableSize = sizeof(gameCvarTable) / sizeof(gameCvarTable[0]);
+static int gameCvarSequence  = -1;            // for trap_Cvar_Changes
 
 void G_InitGame(int levelTime, int randomSeed, int restart, int legacyServer, int serverVersion);
 void G_RunFrame(int levelTime);
@@ -1658,6 +1662,9 @@ void G_RegisterCvars(void)
 
 	G_Printf("%d cvars in use.\n", gameCvarTableSize);
 
+	// check all cvars on the next update
+	gameCvarSequence = -1;
+
 	for (i = 0, cv = gameCvarTable; i < gameCvarTableSize; i++, cv++)
 	{
 		trap_Cvar_Register(cv->vmCvar, cv->cvarName, cv->defaultString, cv->cvarFlags);
@@ -1709,10 +1716,18 @@ void G_UpdateCvars(void)
 	qboolean    chargetimechanged  = qfalse;
 	qboolean    clsweaprestriction = qfalse;
 	qboolean    skillLevelPoints   = qfalse;
+	int         handles[MAX_CVAR_CHANGES];
+	int         numChanges;
+
+	numChanges = Com_GetCvarChanges((level.syscallExtensions & SYSCALL_EXT_CVAR_CHANGES) ? trap_Cvar_Changes : NULL, &gameCvarSequence, handles);
+	if (!numChanges)
+	{
+		return;
+	}
 
 	for (i = 0, cv = gameCvarTable ; i < gameCvarTableSize ; i++, cv++)
 	{
-		if (cv->vmCvar)
+		if (cv->vmCvar && Com_CvarChanged(cv->vmCvar, handles, numChanges))
 		{
 			trap_Cvar_Update(cv->vmCvar);
 
@@ -2125,6 +2140,9 @@ void G_InitGame(int levelTime, int randomSeed, int restart, int legacyServer, in
 
 	G_RegisterCvars();
 
+	// published at intermission only
+	trap_Cvar_Set("g_nextMapName", "");
+
 	// enforcemaxlives stuff
 
 	// we need to clear the list even if enforce maxlives is not active
@@ -2173,6 +2191,8 @@ void G_InitGame(int levelTime, int randomSeed, int restart, int legacyServer, in
 	level.startTime       = levelTime;
 	level.server_settings = i;
 
+	level.syscallExtensions = trap_Cvar_VariableIntegerValue(SYSCALL_EXTENSIONS_CVAR);
+
 	for (i = 0; i < level.numConnectedClients; i++)
 	{
 		level.clients[level.sortedClients[i]].sess.spawnObjectiveIndex = 0;
@@ -3453,6 +3473,106 @@ void QDECL G_LogPrintf(const char *fmt, ...)
 
 void QDECL G_LogPrintf(const char *fmt, ...) _attribute((format(printf, 1, 2)));
 
+/**
+ * @brief Finds the map loaded by a map rotation command
+ * @param[in] command such as "map oasis" or "vstr m2"
+ * @param[out] mapName
+ * @param[in] size
+ * @param[in] depth vstr nesting
+ * @return qfalse if the command doesn't load a map or it can't be told which one
+ */
+static qboolean G_RotationCommandMap(const char *command, char *mapName, int size, int depth)
+{
+	char buffer[MAX_STRING_CHARS];
+	char *cmd, *next, *token;
+
+	Q_strncpyz(buffer, command, sizeof(buffer));
+
+	for (cmd = buffer; cmd; cmd = next)
+	{
+		next = strchr(cmd, ';');
+		if (next)
+		{
+			*next++ = '\0';
+		}
+
+		token = COM_Parse(&cmd);
+
+		if (!Q_stricmp(token, "map") || !Q_stricmp(token, "devmap"))
+		{
+			token = COM_Parse(&cmd);
+			if (!token[0])
+			{
+				return qfalse;
+			}
+
+			Q_strncpyz(mapName, token, size);
+			return qtrue;
+		}
+
+		if (!Q_stricmp(token, "vstr"))
+		{
+			token = COM_Parse(&cmd);
+			if (!token[0] || depth >= 4)
+			{
+				return qfalse;
+			}
+
+			trap_Cvar_VariableStringBuffer(token, buffer, sizeof(buffer));
+			return G_RotationCommandMap(buffer, mapName, size, depth + 1);
+		}
+	}
+
+	return qfalse;
+}
+
+/**
+ * @brief Publishes the map ExitLevel will load in the serverinfo, so clients can preload it
+ *
+ * @note Map votes are only decided when the intermission ends, nothing is published for them.
+ */
+static void G_PublishNextMap(void)
+{
+	char command[MAX_STRING_CHARS];
+	char mapName[MAX_QPATH];
+	char currentMap[MAX_QPATH];
+
+	mapName[0] = '\0';
+
+	if (g_gametype.integer == GT_WOLF_CAMPAIGN)
+	{
+		g_campaignInfo_t *campaign = &g_campaigns[level.currentCampaign];
+
+		if (campaign->current + 1 < campaign->mapCount)
+		{
+			Q_strncpyz(mapName, campaign->mapnames[campaign->current + 1], sizeof(mapName));
+		}
+		else
+		{
+			trap_Cvar_VariableStringBuffer("nextcampaign", command, sizeof(command));
+
+			if (!command[0])
+			{
+				Q_strncpyz(mapName, campaign->mapnames[0], sizeof(mapName));
+			}
+		}
+	}
+	else if (g_gametype.integer != GT_WOLF_MAPVOTE && (g_gametype.integer != GT_WOLF_LMS || level.lmsDoNextMap))
+	{
+		if (!G_RotationCommandMap("vstr nextmap", mapName, sizeof(mapName), 0))
+		{
+			mapName[0] = '\0';
+		}
+	}
+
+	trap_Cvar_VariableStringBuffer("mapname", currentMap, sizeof(currentMap));
+
+	if (mapName[0] && Q_stricmp(mapName, currentMap))
+	{
+		trap_Cvar_Set("g_nextMapName", mapName);
+	}
+}
+
 /**
  * @brief Append information about this game to the log file
  */
@@ -3476,6 +3596,8 @@ void G_LogExit(const char *string)
 	// that will get cut off when the queued intermission starts
 	trap_SetConfigstring(CS_INTERMISSION, "1");
 
+	G_PublishNextMap();
+
 	for (i = 0; i < level.numConnectedClients; i++)
 	{
 		int ping;
@@ -4661,6 +4783,9 @@ void G_RunEntity(gentity_t *ent, int msec)
 	// hack for instantaneous velocity
 	VectorSubtract(ent->r.currentOrigin, ent->oldOrigin, ent->instantVelocity);
 	VectorScale(ent->instantVelocity, 1000.0f / msec, ent->instantVelocity);
+
+	// nothing left to do until the next think
+	G_EntitySleep(ent);
 }
 
 /*
@@ -4672,7 +4797,8 @@ Advances the non-player objects in the world
 */
 void G_RunFrame(int levelTime)
 {
-	int i, msec;
+	int       i, msec;
+	gentity_t *ent;
 
 	// if we are waiting for the level to restart, do nothing
 	if (level.restarted)
@@ -4741,17 +4867,38 @@ void G_RunFrame(int levelTime)
 
 	G_ConfigCheckLocked();
 
-	for (i = 0; i < level.num_entities; i++)
+	// wake up entities whose think is due
+	G_RunThinkWheel();
+
+	for (i = 0; i < MAX_CLIENTS; i++)
 	{
 		g_entities[i].runthisframe = qfalse;
 	}
 
-	// go through all allocated objects
-	for (i = 0; i < level.num_entities; i++)
+	for (ent = level.activeEntities; ent; ent = ent->activeNext)
+	{
+		ent->runthisframe = qfalse;
+	}
+
+	// clients first, then all allocated objects in entity number order
+	for (i = 0; i < MAX_CLIENTS; i++)
 	{
 		G_RunEntity(&g_entities[i], msec);
 	}
 
+	for (ent = level.activeEntities; ent; ent = level.activeIterNext)
+	{
+		level.activeIterCur  = ent;
+		level.activeIterNext = ent->activeNext;
+		G_RunEntity(ent, msec);
+	}
+	level.activeIterCur  = NULL;
+	level.activeIterNext = NULL;
+
+#ifdef LEGACY_DEBUG
+	G_ValidateSleepingEntities();
+#endif
+
 	for (i = 0; i < level.numConnectedClients; i++)
 	{
 		ClientEndFrame(&g_entities[level.sortedClients[i]]);
@@ -198,7 +198,7 @@ void G_delayPrint(gentity_t *dpent)
 		break;
 	}
 
-	dpent->nextthink = think_next;
+	G_SetNextThink(dpent, think_next);
 	if (fFree)
 	{
 		dpent->think = 0;
@@ -233,8 +233,8 @@ void G_spawnPrintf(int print_type, int print_time, gentity_t *owner)
 	ent->spawnflags = print_type;       // Tunnel in DP enum
 	ent->timestamp  = level.time;       // Time entity was created
 
-	ent->nextthink = print_time;
-	ent->think     = G_delayPrint;
+	G_SetNextThink(ent, print_time);
+	ent->think = G_delayPrint;
 }
 
 // Records accuracy, damage, and kill/death stats.
@@ -62,8 +62,8 @@ void SP_info_null(gentity_t *self)
 		G_FreeEntity(self);
 	}
 
-	self->think     = G_FreeEntity;
-	self->nextthink = level.time + (FRAMETIME * 2);
+	self->think = G_FreeEntity;
+	G_SetNextThink(self, level.time + (FRAMETIME * 2));
 }
 
 /*
@@ -322,8 +322,8 @@ void SP_misc_vis_dummy(gentity_t *ent)
 	G_SetOrigin(ent, ent->s.origin);
 	trap_LinkEntity(ent);
 
-	ent->think     = locateMaster;
-	ent->nextthink = level.time + 1000;
+	ent->think = locateMaster;
+	G_SetNextThink(ent, level.time + 1000);
 }
 
 /*
@@ -424,8 +424,8 @@ void SP_misc_portal_surface(gentity_t *ent)
 	}
 	else
 	{
-		ent->think     = locateCamera;
-		ent->nextthink = level.time + 100;
+		ent->think = locateCamera;
+		G_SetNextThink(ent, level.time + 100);
 	}
 }
 
@@ -514,9 +514,9 @@ void Use_Shooter(gentity_t *ent, gentity_t *other, gentity_t *activator)
 
 static void InitShooter_Finish(gentity_t *ent)
 {
-	ent->enemy     = G_PickTarget(ent->target);
-	ent->think     = 0;
-	ent->nextthink = 0;
+	ent->enemy = G_PickTarget(ent->target);
+	ent->think = 0;
+	G_SetNextThink(ent, 0);
 }
 
 void InitShooter(gentity_t *ent, int weapon)
@@ -536,8 +536,8 @@ void InitShooter(gentity_t *ent, int weapon)
 	// target might be a moving object, so we can't set movedir for it
 	if (ent->target)
 	{
-		ent->think     = InitShooter_Finish;
-		ent->nextthink = level.time + 500;
+		ent->think = InitShooter_Finish;
+		G_SetNextThink(ent, level.time + 500);
 	}
 	trap_LinkEntity(ent);
 }
@@ -738,8 +738,8 @@ void shutoff_dlight(gentity_t *ent)
 	}
 
 	trap_UnlinkEntity(ent);
-	ent->think     = 0;
-	ent->nextthink = 0;
+	ent->think = 0;
+	G_SetNextThink(ent, 0);
 }
 
 /*
@@ -760,8 +760,8 @@ void use_dlight(gentity_t *ent, gentity_t *other, gentity_t *activator)
 
 		if (ent->spawnflags & 4)       // ONETIME
 		{
-			ent->think     = shutoff_dlight;
-			ent->nextthink = level.time + (strlen(ent->dl_stylestring)  * 100) - 100;
+			ent->think = shutoff_dlight;
+			G_SetNextThink(ent, level.time + (strlen(ent->dl_stylestring)  * 100) - 100);
 		}
 	}
 }
@@ -819,7 +819,7 @@ void SP_dlight(gentity_t *ent)
 	{
 		dlightstarttime = level.time + 100;
 	}
-	ent->nextthink = dlightstarttime;
+	G_SetNextThink(ent, dlightstarttime);
 
 	if (ent->dl_color[0] <= 0 &&                 // if it's black or has no color assigned, make it white
 	    ent->dl_color[1] <= 0 &&
@@ -1102,7 +1102,7 @@ void aagun_think(gentity_t *self)
 			self->active                                   = qtrue;
 			owner->client->ps.persistant[PERS_HWEAPON_USE] = 2;
 			aagun_track(self, owner);
-			self->nextthink = level.time + 50;
+			G_SetNextThink(self, level.time + 50);
 			self->timestamp = level.time + 1000;
 
 			for (i = 0; i < 3; i++)
@@ -1145,7 +1145,7 @@ void aagun_think(gentity_t *self)
 		self->s.apos.trTime     = level.time;
 		self->s.apos.trDuration = 50;
 	}
-	self->nextthink = level.time + 50;
+	G_SetNextThink(self, level.time + 50);
 
 	SnapVector(self->s.apos.trDelta);
 }
@@ -1235,7 +1235,7 @@ void aagun_spawn(gentity_t *gun)
 	gun->use   = aagun_use;
 	gun->die   = aagun_die;
 
-	gun->nextthink    = level.time + FRAMETIME;
+	G_SetNextThink(gun, level.time + FRAMETIME);
 	gun->timestamp    = level.time + 1000;
 	gun->s.number     = gun - g_entities;
 	gun->s.origin2[0] = gun->harc;
@@ -1402,7 +1402,7 @@ void mg42_think(gentity_t *self)
 			self->active                                   = qtrue;
 			owner->client->ps.persistant[PERS_HWEAPON_USE] = 1;
 			mg42_track(self, owner);
-			self->nextthink = level.time + 50;
+			G_SetNextThink(self, level.time + 50);
 			self->timestamp = level.time + 1000;
 
 			//owner->client->ps.weapHeat[WP_DUMMY_MG42] = self->mg42weapHeat;
@@ -1464,7 +1464,7 @@ void mg42_think(gentity_t *self)
 		self->s.apos.trTime     = level.time;
 		self->s.apos.trDuration = 50;
 	}
-	self->nextthink = level.time + 50;
+	G_SetNextThink(self, level.time + 50);
 
 	SnapVector(self->s.apos.trDelta);
 }
@@ -1669,7 +1669,7 @@ void mg42_spawn(gentity_t *ent)
 		gun->use   = mg42_use;
 		gun->die   = mg42_die;
 
-		gun->nextthink    = level.time + FRAMETIME;
+		G_SetNextThink(gun, level.time + FRAMETIME);
 		gun->timestamp    = level.time + 1000;
 		gun->s.number     = gun - g_entities;
 		gun->harc         = ent->harc;
@@ -1751,8 +1751,8 @@ void SP_mg42(gentity_t *self)
 		self->health = MG42_MULTIPLAYER_HEALTH;
 	}
 
-	self->think     = mg42_spawn;
-	self->nextthink = level.time + FRAMETIME;
+	self->think = mg42_spawn;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	if (G_SpawnString("damage", "0", &damage))
 	{
@@ -1868,8 +1868,8 @@ void flak_spawn(gentity_t *ent)
 	VectorCopy(ent->s.angles, gun->s.angles);
 	VectorCopy(gun->s.angles, gun->s.apos.trBase);
 	VectorCopy(gun->s.angles, gun->s.apos.trDelta);
-	gun->think         = mg42_think;
-	gun->nextthink     = level.time + FRAMETIME;
+	gun->think = mg42_think;
+	G_SetNextThink(gun, level.time + FRAMETIME);
 	gun->s.number      = gun - g_entities;
 	gun->harc          = ent->harc;
 	gun->varc          = ent->varc;
@@ -1908,8 +1908,8 @@ void SP_misc_flak(gentity_t *self)
 		self->health = 100;
 	}
 
-	self->think     = flak_spawn;
-	self->nextthink = level.time + FRAMETIME;
+	self->think = flak_spawn;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 /*QUAKED misc_spawner (.3 .7 .8) (-8 -8 -8) (8 8 8)
@@ -1943,8 +1943,8 @@ void misc_spawner_think(gentity_t *ent)
 
 void misc_spawner_use(gentity_t *ent, gentity_t *other, gentity_t *activator)
 {
-	ent->think     = misc_spawner_think;
-	ent->nextthink = level.time + FRAMETIME;
+	ent->think = misc_spawner_think;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	//VectorCopy (other->r.currentOrigin, ent->r.currentOrigin);
 	//VectorCopy (ent->r.currentOrigin, ent->s.pos.trBase);
@@ -2040,8 +2040,8 @@ void misc_firetrails_think(gentity_t *ent)
 
 void SP_misc_firetrails(gentity_t *ent)
 {
-	ent->think     = misc_firetrails_think;
-	ent->nextthink = level.time + 100;
+	ent->think = misc_firetrails_think;
+	G_SetNextThink(ent, level.time + 100);
 }
 
 /*QUAKED misc_constructiblemarker (1 0.85 0) ?
@@ -2097,8 +2097,8 @@ void SP_misc_constructiblemarker(gentity_t *ent)
 	VectorCopy(ent->s.origin, ent->s.pos.trBase);
 	VectorCopy(ent->s.origin, ent->r.currentOrigin);
 
-	ent->think     = constructiblemarker_setup;
-	ent->nextthink = level.time + FRAMETIME;
+	ent->think = constructiblemarker_setup;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 /*QUAKED misc_landmine (.35 0.85 .35) (-16 -16 0) (16 16 16) AXIS ALLIED
@@ -2157,6 +2157,7 @@ void landmine_setup(gentity_t *ent)
 	ent->splashRadius        = 225; // was: 400
 	ent->methodOfDeath       = MOD_LANDMINE;
 	ent->splashMethodOfDeath = MOD_LANDMINE;
+	G_AddEntityToGroup(ent, ENTGROUP_LANDMINE);
 	ent->s.eFlags            = (EF_BOUNCE | EF_BOUNCE_HALF);
 	ent->health              = 5;
 	ent->takedamage          = qtrue;
@@ -2167,8 +2168,8 @@ void landmine_setup(gentity_t *ent)
 	ent->health        = 0;
 	ent->s.modelindex2 = 0;
 
-	ent->nextthink = level.time + FRAMETIME;
-	ent->think     = G_LandmineThink;
+	G_SetNextThink(ent, level.time + FRAMETIME);
+	ent->think = G_LandmineThink;
 
 	ent->damage = 0;
 
@@ -2199,8 +2200,8 @@ void SP_misc_landmine(gentity_t *ent)
 		G_Error("ERROR: misc_landmine without a team\n");
 	}
 
-	ent->nextthink = level.time + FRAMETIME * 5;
-	ent->think     = landmine_setup;
+	G_SetNextThink(ent, level.time + FRAMETIME * 5);
+	ent->think = landmine_setup;
 }
 
 /*QUAKED misc_commandmap_marker (0 0.85 .85) (-16 -16 0) (16 16 16) ONLY_AXIS ONLY_ALLIED ISOBJECTIVE ISHEALTHAMMOCABINET ISCOMMANDPOST
@@ -2269,12 +2270,13 @@ void G_TempTraceIgnorePlayersAndBodies(void)
 	}
 	else
 	{
-		// slower way - improve by time
-		for (i = 0; i < MAX_GENTITIES; i++)
+		gentity_t *body;
+
+		for (body = level.entityGroups[ENTGROUP_CORPSE]; body; body = body->groupNext)
 		{
-			if (g_entities[i].s.eType == ET_CORPSE)
+			if (body->s.eType == ET_CORPSE)
 			{
-				G_TempTraceIgnoreEntity(&g_entities[i]);
+				G_TempTraceIgnoreEntity(body);
 			}
 		}
 	}
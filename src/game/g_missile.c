@@ -139,7 +139,7 @@ void G_BounceMissile(gentity_t *ent, trace_t *trace)
 			if (ent->s.weapon == WP_M7 || ent->s.weapon == WP_GPG40)
 			{
 				// explode one 750msecs after launchtime
-				ent->nextthink = level.time + (750 - (level.time + 4000 - ent->nextthink));
+				G_SetNextThink(ent, level.time + (750 - (level.time + 4000 - ent->nextthink)));
 			}
 			return;
 		}
@@ -313,7 +313,7 @@ void M_think(gentity_t *ent)
 	tent->s.angles2[1] = 96;
 	tent->s.angles2[2] = 50;
 
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 /*
@@ -464,8 +464,8 @@ void G_ExplodeMissile(gentity_t *ent)
 					}
 
 					G_UseTargets(hit, ent);
-					hit->think     = G_FreeEntity;
-					hit->nextthink = level.time + FRAMETIME;
+					hit->think = G_FreeEntity;
+					G_SetNextThink(hit, level.time + FRAMETIME);
 
 					G_Script_ScriptEvent(hit, "destroyed", "");
 				}
@@ -1209,13 +1209,13 @@ void DynaSink(gentity_t *self)
 
 	if (self->timestamp < level.time)
 	{
-		self->think     = G_FreeEntity;
-		self->nextthink = level.time + FRAMETIME;
+		self->think = G_FreeEntity;
+		G_SetNextThink(self, level.time + FRAMETIME);
 		return;
 	}
 
 	self->s.pos.trBase[2] -= 0.5f;
-	self->nextthink        = level.time + 50;
+	G_SetNextThink(self, level.time + 50);
 }
 
 void DynaFree(gentity_t *self)
@@ -1310,17 +1310,11 @@ void G_FadeItems(gentity_t *ent, int modType)
 
 int G_CountTeamLandmines(team_t team)
 {
-	gentity_t *e = &g_entities[MAX_CLIENTS];
-	int       i;
+	gentity_t *e;
 	int       cnt = 0;
 
-	for (i = MAX_CLIENTS ; i < level.num_entities ; i++, e++)
+	for (e = level.entityGroups[ENTGROUP_LANDMINE]; e; e = e->groupNext)
 	{
-		if (!e->inuse)
-		{
-			continue;
-		}
-
 		if (e->s.eType != ET_MISSILE)
 		{
 			continue;
@@ -1342,19 +1336,13 @@ int G_CountTeamLandmines(team_t team)
 
 qboolean G_SweepForLandmines(vec3_t origin, float radius, int team)
 {
-	gentity_t *e = &g_entities[MAX_CLIENTS];
-	int       i;
+	gentity_t *e;
 	vec3_t    dist;
 
 	radius *= radius;
 
-	for (i = MAX_CLIENTS; i < level.num_entities; i++, e++)
+	for (e = level.entityGroups[ENTGROUP_LANDMINE]; e; e = e->groupNext)
 	{
-		if (!e->inuse)
-		{
-			continue;
-		}
-
 		if (e->s.eType != ET_MISSILE)
 		{
 			continue;
@@ -1514,8 +1502,8 @@ void LandMineTrigger(gentity_t *self)
 {
 	self->r.contents = CONTENTS_CORPSE;
 	trap_LinkEntity(self);
-	self->nextthink  = level.time + FRAMETIME;
-	self->think      = LandminePostThink;
+	G_SetNextThink(self, level.time + FRAMETIME);
+	self->think     = LandminePostThink;
 	self->s.teamNum += 8;
 	// communicate trigger time to client
 	self->s.time = level.time;
@@ -1523,8 +1511,8 @@ void LandMineTrigger(gentity_t *self)
 
 void LandMinePostTrigger(gentity_t *self)
 {
-	self->nextthink = level.time + 300;
-	self->think     = G_ExplodeMissile;
+	G_SetNextThink(self, level.time + 300);
+	self->think = G_ExplodeMissile;
 }
 
 /*107     11      20      0       0       0       0       //fire gren
@@ -1566,7 +1554,7 @@ void G_LandmineThink(gentity_t *self)
 	qboolean  trigger = qfalse;
 	gentity_t *ent;
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	if (level.time - self->missionLevel > 200)
 	{
@@ -1631,7 +1619,7 @@ void LandminePostThink(gentity_t *self)
 	qboolean  trigger = qfalse;
 	gentity_t *ent;
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	if (level.time - self->missionLevel > 5000)
 	{
@@ -1671,8 +1659,8 @@ G_LandminePrime
 */
 void G_LandminePrime(gentity_t *self)
 {
-	self->nextthink = level.time + FRAMETIME;
-	self->think     = G_LandmineThink;
+	G_SetNextThink(self, level.time + FRAMETIME);
+	self->think = G_LandmineThink;
 }
 
 qboolean G_LandmineSnapshotCallback(int entityNum, int clientNum)
@@ -1729,38 +1717,38 @@ gentity_t *fire_grenade(gentity_t *self, vec3_t start, vec3_t dir, int grenadeWP
 	// no self->client for shooter_grenade's
 	if (self->client && self->client->ps.grenadeTimeLeft)
 	{
-		bolt->nextthink = level.time + self->client->ps.grenadeTimeLeft;
+		G_SetNextThink(bolt, level.time + self->client->ps.grenadeTimeLeft);
 	}
 	else
 	{
-		bolt->nextthink = level.time + 2500;
+		G_SetNextThink(bolt, level.time + 2500);
 	}
 
 	switch (grenadeWPID)
 	{
 	case WP_DYNAMITE:
-		noExplode       = qtrue;
-		bolt->nextthink = level.time + 15000;
+		noExplode = qtrue;
+		G_SetNextThink(bolt, level.time + 15000);
 		bolt->think     = DynaSink;
 		bolt->timestamp = level.time + 16500;
 		bolt->free      = DynaFree;
 		break;
 	case WP_LANDMINE:
-		noExplode       = qtrue;
-		bolt->nextthink = level.time + 15000;
+		noExplode = qtrue;
+		G_SetNextThink(bolt, level.time + 15000);
 		bolt->think     = DynaSink;
 		bolt->timestamp = level.time + 16500;
 		break;
 	case WP_SATCHEL:
-		noExplode         = qtrue;
-		bolt->nextthink   = 0;
+		noExplode = qtrue;
+		G_SetNextThink(bolt, 0);
 		bolt->s.clientNum = self->s.clientNum;
 		bolt->free        = G_FreeSatchel;
 		break;
 	case WP_MORTAR_SET: // only on impact
 	case WP_MORTAR2_SET:
-		noExplode       = qtrue;
-		bolt->nextthink = 0;
+		noExplode = qtrue;
+		G_SetNextThink(bolt, 0);
 		break;
 	default:
 		break;
@@ -1797,7 +1785,7 @@ gentity_t *fire_grenade(gentity_t *self, vec3_t start, vec3_t dir, int grenadeWP
 		bolt->methodOfDeath       = MOD_GPG40;
 		bolt->splashMethodOfDeath = MOD_GPG40;
 		bolt->s.eFlags            = EF_BOUNCE_HALF | EF_BOUNCE;
-		bolt->nextthink           = level.time + 4000;
+		G_SetNextThink(bolt, level.time + 4000);
 		break;
 	case WP_M7:
 		bolt->classname           = "m7_grenade";
@@ -1805,7 +1793,7 @@ gentity_t *fire_grenade(gentity_t *self, vec3_t start, vec3_t dir, int grenadeWP
 		bolt->methodOfDeath       = MOD_M7;
 		bolt->splashMethodOfDeath = MOD_M7;
 		bolt->s.eFlags            = EF_BOUNCE_HALF | EF_BOUNCE;
-		bolt->nextthink           = level.time + 4000;
+		G_SetNextThink(bolt, level.time + 4000);
 		break;
 	case WP_SMOKE_BOMB:
 		bolt->classname     = "smoke_bomb";
@@ -1855,6 +1843,7 @@ gentity_t *fire_grenade(gentity_t *self, vec3_t start, vec3_t dir, int grenadeWP
 		bolt->splashRadius        = 225;
 		bolt->methodOfDeath       = MOD_LANDMINE;
 		bolt->splashMethodOfDeath = MOD_LANDMINE;
+		G_AddEntityToGroup(bolt, ENTGROUP_LANDMINE);
 		bolt->s.eFlags            = (EF_BOUNCE | EF_BOUNCE_HALF);
 		bolt->health              = 5;
 		bolt->takedamage          = qtrue;
@@ -1954,7 +1943,7 @@ gentity_t *fire_rocket(gentity_t *self, vec3_t start, vec3_t dir, int rocketType
 	VectorNormalize(dir);
 
 	bolt->classname = "rocket";
-	bolt->nextthink = level.time + 20000;   // push it out a little
+	G_SetNextThink(bolt, level.time + 20000);   // push it out a little
 	bolt->think     = G_ExplodeMissile;
 	bolt->accuracy  = 4;
 	bolt->s.eType   = ET_MISSILE;
@@ -2003,8 +1992,8 @@ gentity_t *fire_flamebarrel(gentity_t *self, vec3_t start, vec3_t dir)
 	// for explosion type
 	bolt->accuracy = 3;
 
-	bolt->classname    = "flamebarrel";
-	bolt->nextthink    = level.time + 3000;
+	bolt->classname = "flamebarrel";
+	G_SetNextThink(bolt, level.time + 3000);
 	bolt->think        = G_ExplodeMissile;
 	bolt->s.eType      = ET_FLAMEBARREL;
 	bolt->s.eFlags     = EF_BOUNCE_HALF;
@@ -2054,8 +2043,8 @@ gentity_t *fire_mortar(gentity_t *self, vec3_t start, vec3_t dir)
 	}
 
 	bolt->classname = "mortar";
-	bolt->nextthink = level.time + 20000;   // push it out a little
-	bolt->think     = G_ExplodeMissile;
+	G_SetNextThink(bolt, level.time + 20000);   // push it out a little
+	bolt->think = G_ExplodeMissile;
 
 	// for explosion type
 	bolt->accuracy = 4;
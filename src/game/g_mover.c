@@ -1161,16 +1161,16 @@ void Reached_BinaryMover(gentity_t *ent)
 
 		if (ent->flags & FL_TOGGLE)
 		{
-			ent->think     = ReturnToPos1;
-			ent->nextthink = 0;
+			ent->think = ReturnToPos1;
+			G_SetNextThink(ent, 0);
 			return;
 		}
 
 		// return to pos1 after a delay
 		if (ent->wait != -1000)
 		{
-			ent->think     = ReturnToPos1;
-			ent->nextthink = level.time + ent->wait;
+			ent->think = ReturnToPos1;
+			G_SetNextThink(ent, level.time + ent->wait);
 		}
 		break;
 	case MOVER_2TO1:
@@ -1216,14 +1216,14 @@ void Reached_BinaryMover(gentity_t *ent)
 
 		if (ent->flags & FL_TOGGLE)
 		{
-			ent->think     = ReturnToPos1Rotate;
-			ent->nextthink = 0;
+			ent->think = ReturnToPos1Rotate;
+			G_SetNextThink(ent, 0);
 			return;
 		}
 
 		// return to pos1 after a delay
-		ent->think     = ReturnToPos1Rotate;
-		ent->nextthink = level.time + ent->wait;
+		ent->think = ReturnToPos1Rotate;
+		G_SetNextThink(ent, level.time + ent->wait);
 		break;
 	case MOVER_2TO1ROTATE:
 		// reached pos1
@@ -1356,8 +1356,8 @@ void Reached_TrinaryMover(gentity_t *ent)
 		SetMoverState(ent, MOVER_POS2, level.time);
 
 		// goto pos 3
-		ent->think     = GotoPos3;
-		ent->nextthink = level.time + 1000; //FRAMETIME;
+		ent->think = GotoPos3;
+		G_SetNextThink(ent, level.time + 1000); //FRAMETIME;
 
 		// play sound
 		G_AddEvent(ent, EV_GENERAL_SOUND, ent->soundPos2);
@@ -1385,8 +1385,8 @@ void Reached_TrinaryMover(gentity_t *ent)
 		// return to pos2 after a delay
 		if (ent->wait != -1000)
 		{
-			ent->think     = ReturnToPos2;
-			ent->nextthink = level.time + ent->wait;
+			ent->think = ReturnToPos2;
+			G_SetNextThink(ent, level.time + ent->wait);
 		}
 
 		// fire targets
@@ -1401,8 +1401,8 @@ void Reached_TrinaryMover(gentity_t *ent)
 		SetMoverState(ent, MOVER_POS2, level.time);
 
 		// return to pos1
-		ent->think     = ReturnToPos1;
-		ent->nextthink = level.time + 1000; //FRAMETIME;
+		ent->think = ReturnToPos1;
+		G_SetNextThink(ent, level.time + 1000); //FRAMETIME;
 
 		// play sound
 		G_AddEvent(ent, EV_GENERAL_SOUND, ent->soundPos3);
@@ -1485,7 +1485,7 @@ void Use_TrinaryMover(gentity_t *ent, gentity_t *other, gentity_t *activator)
 	case MOVER_POS3: // if all the way up, just delay before coming down
 		if (ent->wait != -1000)
 		{
-			ent->nextthink = level.time + ent->wait;
+			G_SetNextThink(ent, level.time + ent->wait);
 		}
 		return;
 
@@ -1713,23 +1713,23 @@ void Use_BinaryMover(gentity_t *ent, gentity_t *other, gentity_t *activator)
 	case MOVER_POS2: // if all the way up, just delay before coming down
 		if (ent->flags & FL_TOGGLE)
 		{
-			ent->nextthink = level.time + 50;
+			G_SetNextThink(ent, level.time + 50);
 			return;
 		}
 
 		if (ent->wait != -1000)
 		{
-			ent->nextthink = level.time + ent->wait;
+			G_SetNextThink(ent, level.time + ent->wait);
 		}
 		return;
 	case MOVER_POS2ROTATE: // if all the way up, just delay before coming down
 		if (ent->flags & FL_TOGGLE)
 		{
-			ent->nextthink = level.time + 50;   // do it *now* for toggles
+			G_SetNextThink(ent, level.time + 50);   // do it *now* for toggles
 		}
 		else
 		{
-			ent->nextthink = level.time + ent->wait;
+			G_SetNextThink(ent, level.time + ent->wait);
 		}
 		return;
 	case MOVER_2TO1: // only partway down before reversing
@@ -2222,7 +2222,7 @@ void finishSpawningKeyedMover(gentity_t *ent)
 		}
 	}
 
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	if (!(ent->flags & FL_TEAMSLAVE))
 	{
@@ -2519,8 +2519,8 @@ void SP_func_door(gentity_t *ent)
 		}
 	}
 
-	ent->nextthink = level.time + FRAMETIME;
-	ent->think     = finishSpawningKeyedMover;
+	G_SetNextThink(ent, level.time + FRAMETIME);
+	ent->think = finishSpawningKeyedMover;
 }
 
 /*
@@ -2646,8 +2646,8 @@ void SP_func_secret(gentity_t *ent)
 		}
 	}
 
-	ent->nextthink = level.time + FRAMETIME;
-	ent->think     = finishSpawningKeyedMover;
+	G_SetNextThink(ent, level.time + FRAMETIME);
+	ent->think = finishSpawningKeyedMover;
 }
 
 /*
@@ -2673,7 +2673,7 @@ void Touch_Plat(gentity_t *ent, gentity_t *other, trace_t *trace)
 	// delay return-to-pos1 by one second
 	if (ent->moverState == MOVER_POS2)
 	{
-		ent->nextthink = level.time + 1000;
+		G_SetNextThink(ent, level.time + 1000);
 	}
 }
 
@@ -2979,7 +2979,7 @@ void Reached_Train(gentity_t *ent)
 	// if there is a "wait" value on the target, don't start moving yet
 	if (next->wait)
 	{
-		ent->nextthink    = level.time + next->wait * 1000;
+		G_SetNextThink(ent, level.time + next->wait * 1000);
 		ent->think        = Think_BeginMoving;
 		ent->s.pos.trType = TR_STATIONARY;
 	}
@@ -3235,8 +3235,8 @@ void SP_info_limbo_camera(gentity_t *self)
 		}
 	}
 
-	self->think     = info_limbo_camera_setup;
-	self->nextthink = level.time + FRAMETIME;
+	self->think = info_limbo_camera_setup;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	G_SpawnInt("objective", "-1", &self->count);
 }
@@ -3290,8 +3290,8 @@ void SP_func_train(gentity_t *self)
 
 	// start trains on the second frame, to make sure their targets have had
 	// a chance to spawn
-	self->nextthink = level.time + FRAMETIME;
-	self->think     = Think_SetupTrainTargets;
+	G_SetNextThink(self, level.time + FRAMETIME);
+	self->think = Think_SetupTrainTargets;
 
 	self->blocked = Blocked_Door;
 }
@@ -3435,7 +3435,7 @@ void Reached_Train_rotating(gentity_t *ent)
 	// if there is a "wait" value on the target, don't start moving yet
 	if (next->wait)
 	{
-		ent->nextthink    = level.time + next->wait * 1000;
+		G_SetNextThink(ent, level.time + next->wait * 1000);
 		ent->think        = Think_BeginMoving_rotating;
 		ent->s.pos.trType = TR_STATIONARY;
 	}
@@ -3557,8 +3557,8 @@ void SP_func_train_rotating(gentity_t *self)
 
 	// start trains on the second frame, to make sure their targets have had
 	// a chance to spawn
-	self->nextthink = level.time + FRAMETIME;
-	self->think     = Think_SetupTrainTargets_rotating;
+	G_SetNextThink(self, level.time + FRAMETIME);
+	self->think = Think_SetupTrainTargets_rotating;
 }
 
 /*
@@ -3626,7 +3626,7 @@ void Static_Pain(gentity_t *ent, gentity_t *attacker, int damage, vec3_t point)
 
 void G_BlockThink(gentity_t *ent)
 {
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 /*
@@ -4070,8 +4070,8 @@ void SP_func_door_rotating(gentity_t *ent)
 		}
 	}
 
-	ent->nextthink = level.time + FRAMETIME;
-	ent->think     = finishSpawningKeyedMover;
+	G_SetNextThink(ent, level.time + FRAMETIME);
+	ent->think = finishSpawningKeyedMover;
 
 	VectorCopy(ent->s.origin, ent->s.pos.trBase);
 	VectorCopy(ent->s.pos.trBase, ent->r.currentOrigin);
@@ -4206,12 +4206,12 @@ BecomeExplosion
 */
 void BecomeExplosion(gentity_t *self)
 {
-	self->die       = NULL;
-	self->pain      = NULL;
-	self->touch     = NULL;
-	self->use       = NULL;
-	self->nextthink = level.time + FRAMETIME;
-	self->think     = G_FreeEntity;
+	self->die   = NULL;
+	self->pain  = NULL;
+	self->touch = NULL;
+	self->use   = NULL;
+	G_SetNextThink(self, level.time + FRAMETIME);
+	self->think = G_FreeEntity;
 
 	G_FreeEntity(self);
 }
@@ -4231,8 +4231,8 @@ void func_explosive_explode(gentity_t *self, gentity_t *inflictor, gentity_t *at
 
 	self->takedamage = qfalse;          // don't allow anything try to hurt me now that i'm exploding
 
-	self->think     = BecomeExplosion;
-	self->nextthink = level.time + FRAMETIME;
+	self->think = BecomeExplosion;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	VectorSubtract(self->r.absmax, self->r.absmin, size);
 	VectorScale(size, 0.5, size);
@@ -4392,8 +4392,8 @@ void InitExplosive(gentity_t *ent)
 	ent->parent  = NULL;
 	trap_LinkEntity(ent);
 
-	ent->think     = G_BlockThink;
-	ent->nextthink = level.time + FRAMETIME;
+	ent->think = G_BlockThink;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 /*
@@ -5309,8 +5309,8 @@ void func_constructible_underconstructionthink(gentity_t *ent)
 				}
 			}
 
-			ent->think        = NULL;
-			ent->nextthink    = 0;
+			ent->think = NULL;
+			G_SetNextThink(ent, 0);
 			ent->s.angles2[0] = 0;
 
 			ent->lastHintCheckTime = level.time;    // don't allow building again for a lil while
@@ -5318,7 +5318,7 @@ void func_constructible_underconstructionthink(gentity_t *ent)
 		}
 	}
 
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 extern void explosive_indicator_think(gentity_t *ent);
@@ -5534,7 +5534,7 @@ void func_constructiblespawn(gentity_t *ent)
 				e->s.modelindex2 = ent->parent->s.teamNum;
 				e->r.ownerNum    = ent->s.number;
 				e->think         = explosive_indicator_think;
-				e->nextthink     = level.time + FRAMETIME;
+				G_SetNextThink(e, level.time + FRAMETIME);
 
 				e->s.effect1Time = ent->constructibleStats.weaponclass;
 
@@ -5631,8 +5631,8 @@ void SP_func_constructible(gentity_t *ent)
 
 	ent->s.dmgFlags = 0;
 
-	ent->think     = func_constructiblespawn;
-	ent->nextthink = level.time + (2 * FRAMETIME);
+	ent->think = func_constructiblespawn;
+	G_SetNextThink(ent, level.time + (2 * FRAMETIME));
 }
 
 /*
@@ -5659,8 +5659,8 @@ void SP_func_brushmodel(gentity_t *ent)
 		level.numBrushModels++;
 	}
 
-	ent->think     = func_brushmodel_delete;
-	ent->nextthink = level.time + (3 * FRAMETIME);
+	ent->think = func_brushmodel_delete;
+	G_SetNextThink(ent, level.time + (3 * FRAMETIME));
 }
 
 // debris test
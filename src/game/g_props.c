@@ -49,7 +49,7 @@ void DropToFloorG(gentity_t *ent)
 
 	ent->s.groundEntityNum = tr.entityNum;
 	G_SetOrigin(ent, tr.endpos);
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 void DropToFloor(gentity_t *ent)
@@ -74,8 +74,8 @@ void DropToFloor(gentity_t *ent)
 
 	G_SetOrigin(ent, tr.endpos);
 
-	ent->think     = DropToFloorG;
-	ent->nextthink = level.time + FRAMETIME;
+	ent->think = DropToFloorG;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 void moveit(gentity_t *ent, float yaw, float dist)
@@ -153,8 +153,8 @@ void SP_props_box_32(gentity_t *self)
 
 	trap_LinkEntity(self);
 
-	self->think     = DropToFloor;
-	self->nextthink = level.time + FRAMETIME;
+	self->think = DropToFloor;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void touch_props_box_48(gentity_t *self, gentity_t *other, trace_t *trace)
@@ -190,8 +190,8 @@ void SP_props_box_48(gentity_t *self)
 
 	trap_LinkEntity(self);
 
-	self->think     = DropToFloor;
-	self->nextthink = level.time + FRAMETIME;
+	self->think = DropToFloor;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void touch_props_box_64(gentity_t *self, gentity_t *other, trace_t *trace)
@@ -227,8 +227,8 @@ void SP_props_box_64(gentity_t *self)
 
 	trap_LinkEntity(self);
 
-	self->think     = DropToFloor;
-	self->nextthink = level.time + FRAMETIME;
+	self->think = DropToFloor;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void Psmoke_think(gentity_t *ent)
@@ -251,7 +251,7 @@ void Psmoke_think(gentity_t *ent)
 	tent->s.angles2[1] = 32;
 	tent->s.angles2[2] = 50;
 
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 void prop_smoke(gentity_t *ent)
@@ -261,8 +261,8 @@ void prop_smoke(gentity_t *ent)
 	Psmoke = G_Spawn();
 
 	VectorCopy(ent->r.currentOrigin, Psmoke->s.origin);
-	Psmoke->think     = Psmoke_think;
-	Psmoke->nextthink = level.time + FRAMETIME;
+	Psmoke->think = Psmoke_think;
+	G_SetNextThink(Psmoke, level.time + FRAMETIME);
 }
 
 /*
@@ -317,7 +317,7 @@ void Psparks_think(gentity_t *ent)
 	tent->s.angles2[1] = ent->end_size;
 	tent->s.angles2[2] = ent->speed;
 
-	ent->nextthink = level.time + FRAMETIME + ent->delay + (rand() % 600);
+	G_SetNextThink(ent, level.time + FRAMETIME + ent->delay + (rand() % 600));
 	*/
 }
 
@@ -345,7 +345,7 @@ void sparks_angles_think(gentity_t *ent)
 
 	trap_LinkEntity(ent);
 
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 	if (!Q_stricmp(ent->classname, "props_sparks"))
 	{
 		ent->think = Psparks_think;
@@ -367,8 +367,8 @@ void SP_props_sparks(gentity_t *ent)
 	ent->r.svFlags = 0;
 	ent->s.eType   = ET_GENERAL;
 
-	ent->think     = sparks_angles_think;
-	ent->nextthink = level.time + FRAMETIME;
+	ent->think = sparks_angles_think;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	if (!ent->health)
 	{
@@ -419,8 +419,8 @@ void SP_props_gunsparks(gentity_t *ent)
 	ent->r.svFlags = 0;
 	ent->s.eType   = ET_GENERAL;
 
-	ent->think     = sparks_angles_think;
-	ent->nextthink = level.time + FRAMETIME;
+	ent->think = sparks_angles_think;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	if (!ent->speed)
 	{
@@ -536,8 +536,8 @@ void SP_Dust(gentity_t *ent)
 
 	if (ent->target)
 	{
-		ent->think     = dust_angles_think;
-		ent->nextthink = level.time + FRAMETIME;
+		ent->think = dust_angles_think;
+		G_SetNextThink(ent, level.time + FRAMETIME);
 	}
 
 	trap_LinkEntity(ent);
@@ -557,7 +557,7 @@ void propExplosionLarge(gentity_t *ent)
     bolt->accuracy = 2;
 
     bolt->classname = "props_explosion_large";
-    bolt->nextthink = level.time + FRAMETIME;
+    G_SetNextThink(bolt, level.time + FRAMETIME);
     bolt->think     = G_ExplodeMissile;
     bolt->s.eType   = ET_MISSILE;
     bolt->r.svFlags = 0;
@@ -588,7 +588,7 @@ void propExplosion(gentity_t *ent)
 	bolt = G_Spawn();
 
 	bolt->classname = "props_explosion";
-	bolt->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(bolt, level.time + FRAMETIME);
 	bolt->think     = G_ExplodeMissile;
 	bolt->s.eType   = ET_MISSILE;
 	bolt->r.svFlags = 0;
@@ -706,7 +706,7 @@ void props_bench_think(gentity_t *ent)
 
 	if (ent->s.frame < 28)
 	{
-		ent->nextthink = level.time + (FRAMETIME / 2);
+		G_SetNextThink(ent, level.time + (FRAMETIME / 2));
 	}
 	else
 	{
@@ -720,8 +720,8 @@ void props_bench_think(gentity_t *ent)
 
 void props_bench_die(gentity_t *ent, gentity_t *inflictor, gentity_t *attacker, int damage, int mod)
 {
-	ent->think     = props_bench_think;
-	ent->nextthink = level.time + FRAMETIME;
+	ent->think = props_bench_think;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 /*
@@ -862,14 +862,14 @@ void locker_tall_think(gentity_t *ent)
 	else
 	{
 		ent->s.frame++;
-		ent->nextthink = level.time + (FRAMETIME / 2);
+		G_SetNextThink(ent, level.time + (FRAMETIME / 2));
 	}
 }
 
 void props_locker_tall_die(gentity_t *ent, gentity_t *inflictor, gentity_t *attacker, int damage, int mod)
 {
-	ent->think     = locker_tall_think;
-	ent->nextthink = level.time + FRAMETIME;
+	ent->think = locker_tall_think;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	ent->takedamage = qfalse;
 
@@ -980,7 +980,7 @@ void Just_Got_Thrown(gentity_t *self)
 
 	if (self->s.groundEntityNum == -1)
 	{
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 
 		if (self->enemy)
 		{
@@ -1023,7 +1023,7 @@ void Just_Got_Thrown(gentity_t *self)
 	self->s.eType    = ET_MOVER;
 	self->s.dmgFlags = HINT_CHAIR;  // so client knows what kind of mover it is for cursorhints
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	self->r.ownerNum = self->s.number;
 
@@ -1053,7 +1053,7 @@ void Props_Activated(gentity_t *self)
 
 	gentity_t *owner = &g_entities[self->r.ownerNum];;
 
-	self->nextthink = level.time + 50;
+	G_SetNextThink(self, level.time + 50);
 
 	if (!owner->client)
 	{
@@ -1084,8 +1084,8 @@ void Props_Activated(gentity_t *self)
 		velocity[2] += 100 + crandom() * 25;
 		VectorCopy(velocity, self->s.pos.trDelta);
 
-		self->think     = NULL;
-		self->nextthink = 0;
+		self->think = NULL;
+		G_SetNextThink(self, 0);
 
 		prop               = G_Spawn();
 		prop->s.modelindex = self->s.modelindex;
@@ -1122,8 +1122,8 @@ void Props_Activated(gentity_t *self)
 
 		prop->count = self->count;
 
-		prop->think     = Just_Got_Thrown;
-		prop->nextthink = level.time + FRAMETIME;
+		prop->think = Just_Got_Thrown;
+		G_SetNextThink(prop, level.time + FRAMETIME);
 
 		prop->takedamage = qtrue;
 
@@ -1253,7 +1253,7 @@ void Props_Chair_Think(gentity_t *self)
 	// we assume groundentity will never change from under a stationary object.
 	//Prop_Check_Ground (self);
 
-	self->nextthink = level.time + 50;
+	G_SetNextThink(self, level.time + 50);
 
 	// prevent unneeded links
 	if (!VectorCompare(self->r.currentOrigin, self->gDelta))
@@ -1388,15 +1388,15 @@ void Props_Chair_Animate(gentity_t *ent)
 		{
 			ent->s.frame = 27;
 			G_UseTargets(ent, NULL);
-			ent->think     = G_FreeEntity;
-			ent->nextthink = level.time + 2000;
-			ent->s.time    = level.time;
-			ent->s.time2   = level.time + 2000;
+			ent->think = G_FreeEntity;
+			G_SetNextThink(ent, level.time + 2000);
+			ent->s.time  = level.time;
+			ent->s.time2 = level.time + 2000;
 			return;
 		}
 		else
 		{
-			ent->nextthink = level.time + (FRAMETIME / 2);
+			G_SetNextThink(ent, level.time + (FRAMETIME / 2));
 		}
 	}
 	else if (
@@ -1410,15 +1410,15 @@ void Props_Chair_Animate(gentity_t *ent)
 		{
 			ent->s.frame = 20;
 			G_UseTargets(ent, NULL);
-			ent->think     = G_FreeEntity;
-			ent->nextthink = level.time + 2000;
-			ent->s.time    = level.time;
-			ent->s.time2   = level.time + 2000;
+			ent->think = G_FreeEntity;
+			G_SetNextThink(ent, level.time + 2000);
+			ent->s.time  = level.time;
+			ent->s.time2 = level.time + 2000;
 			return;
 		}
 		else
 		{
-			ent->nextthink = level.time + (FRAMETIME / 2);
+			G_SetNextThink(ent, level.time + (FRAMETIME / 2));
 		}
 	}
 	else if (!Q_stricmp(ent->classname, "props_desklamp"))
@@ -1431,15 +1431,15 @@ void Props_Chair_Animate(gentity_t *ent)
 				G_UseTargets(ent, NULL);
 			}
 
-			ent->think     = G_FreeEntity;
-			ent->nextthink = level.time + 2000;
-			ent->s.time    = level.time;
-			ent->s.time2   = level.time + 2000;
+			ent->think = G_FreeEntity;
+			G_SetNextThink(ent, level.time + 2000);
+			ent->s.time  = level.time;
+			ent->s.time2 = level.time + 2000;
 			return;
 		}
 		else
 		{
-			ent->nextthink = level.time + (FRAMETIME / 2);
+			G_SetNextThink(ent, level.time + (FRAMETIME / 2));
 		}
 	}
 
@@ -1496,7 +1496,7 @@ void Spawn_Shard(gentity_t *ent, gentity_t *inflictor, int quantity, int type)
 
 	sfx->think = G_FreeEntity;
 
-	sfx->nextthink = level.time + 1000;
+	G_SetNextThink(sfx, level.time + 1000);
 
 	sfx->s.frame = quantity;
 
@@ -1522,8 +1522,8 @@ void Props_Chair_Die(gentity_t *ent, gentity_t *inflictor, gentity_t *attacker,
 	int quantity;
 	int type;
 
-	ent->think     = Props_Chair_Animate;
-	ent->nextthink = level.time + FRAMETIME;
+	ent->think = Props_Chair_Animate;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	ent->health     = ent->duration;
 	ent->delay      = damage;
@@ -1594,8 +1594,8 @@ void SP_Props_Chair(gentity_t *ent)
 		ent->count = FXTYPE_WOOD;
 	}
 
-	ent->think     = Props_Chair_Think;
-	ent->nextthink = level.time + FRAMETIME;
+	ent->think = Props_Chair_Think;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	ent->touch      = Props_Chair_Touch;
 	ent->die        = Props_Chair_Die;
@@ -1646,8 +1646,8 @@ void SP_Props_ChairHiback(gentity_t *ent)
 		ent->count = FXTYPE_WOOD;
 	}
 
-	ent->think     = Props_Chair_Think;
-	ent->nextthink = level.time + FRAMETIME;
+	ent->think = Props_Chair_Think;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	ent->touch      = Props_Chair_Touch;
 	ent->die        = Props_Chair_Die;
@@ -1698,8 +1698,8 @@ void SP_Props_ChairSide(gentity_t *ent)
 		ent->count = FXTYPE_WOOD;
 	}
 
-	ent->think     = Props_Chair_Think;
-	ent->nextthink = level.time + FRAMETIME;
+	ent->think = Props_Chair_Think;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	ent->touch      = Props_Chair_Touch;
 	ent->die        = Props_Chair_Die;
@@ -1754,8 +1754,8 @@ void SP_Props_ChateauChair(gentity_t *ent)
 		ent->count = FXTYPE_WOOD;
 	}
 
-	ent->think     = Props_Chair_Think;
-	ent->nextthink = level.time + FRAMETIME;
+	ent->think = Props_Chair_Think;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	ent->touch      = Props_Chair_Touch;
 	ent->die        = Props_Chair_Die;
@@ -1924,8 +1924,8 @@ void SP_Props_Desklamp(gentity_t *ent)
 		ent->count = FXTYPE_METAL;
 	}
 
-	ent->think     = Props_Chair_Think;
-	ent->nextthink = level.time + FRAMETIME;
+	ent->think = Props_Chair_Think;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	ent->touch      = Props_Chair_Touch;
 	ent->die        = Props_Chair_Die;
@@ -1956,23 +1956,23 @@ void Props_Barrel_Animate(gentity_t *ent)
 		if (ent->spawnflags & 1)
 		{
 			//  G_UseTargets (ent, NULL);
-			ent->think     = G_FreeEntity;
-			ent->nextthink = level.time + 25000;
+			ent->think = G_FreeEntity;
+			G_SetNextThink(ent, level.time + 25000);
 			return;
 		}
 		else
 		{
 			//G_UseTargets (ent, NULL);
-			ent->think     = G_FreeEntity;
-			ent->nextthink = level.time + 25000;
-			//ent->s.time = level.time;
+			ent->think = G_FreeEntity;
+			G_SetNextThink(ent, level.time + 25000);
+			//ent->s.time  = level.time;
 			//ent->s.time2 = level.time + 2000;
 			return;
 		}
 	}
 	else
 	{
-		ent->nextthink = level.time + (FRAMETIME / 2);
+		G_SetNextThink(ent, level.time + (FRAMETIME / 2));
 	}
 
 	ent->s.frame++;
@@ -2013,7 +2013,7 @@ void smoker_think(gentity_t *ent)
 	else
 	{
 		barrel_smoke(ent);
-		ent->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(ent, level.time + FRAMETIME);
 	}
 }
 
@@ -2036,7 +2036,7 @@ void OilParticles_think(gentity_t *ent)
 
 	if (owner && owner->takedamage && ent->count2 > level.time - 5000)
 	{
-		ent->nextthink = (level.time + FRAMETIME / 2);
+		G_SetNextThink(ent, (level.time + FRAMETIME / 2));
 
 		tent = G_TempEntity(ent->r.currentOrigin, EV_OILPARTICLES);
 		VectorCopy(ent->r.currentOrigin, tent->s.origin);
@@ -2124,8 +2124,8 @@ void SP_OilParticles(gentity_t *ent)
 
 	VectorCopy(forward, OilLeak->rotate);
 
-	OilLeak->think     = OilParticles_think;
-	OilLeak->nextthink = level.time + FRAMETIME;
+	OilLeak->think = OilParticles_think;
+	G_SetNextThink(OilLeak, level.time + FRAMETIME);
 
 	OilLeak->s.density = ent->s.number;
 	OilLeak->count2    = level.time;
@@ -2172,7 +2172,7 @@ void OilSlick_remove(gentity_t *ent)
 
 	remove->s.density = ent->s.number;
 	remove->think     = OilSlick_remove_think;
-	remove->nextthink = level.time + 1000;
+	G_SetNextThink(remove, level.time + 1000);
 	VectorCopy(ent->r.currentOrigin, remove->r.currentOrigin);
 	trap_LinkEntity(remove);
 }
@@ -2211,8 +2211,8 @@ void Props_Barrel_Die(gentity_t *ent, gentity_t *inflictor, gentity_t *attacker,
 
 	ent->touch = NULL;
 
-	ent->think     = Props_Barrel_Animate;
-	ent->nextthink = level.time + FRAMETIME;
+	ent->think = Props_Barrel_Animate;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	ent->health = ent->duration;
 	ent->delay  = damage;
@@ -2293,8 +2293,8 @@ void SP_Props_Flamebarrel(gentity_t *ent)
 
 	ent->count = FXTYPE_METAL; // metal shards
 
-	ent->think     = Props_Barrel_Think;
-	ent->nextthink = level.time + FRAMETIME;
+	ent->think = Props_Barrel_Think;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	ent->touch = Props_Barrel_Touch;
 
@@ -2372,15 +2372,15 @@ void crate_animate(gentity_t *ent)
 	if (ent->s.frame == 17)
 	{
 		G_UseTargets(ent, NULL);
-		ent->think     = G_FreeEntity;
-		ent->nextthink = level.time + 2000;
-		ent->s.time    = level.time;
-		ent->s.time2   = level.time + 2000;
+		ent->think = G_FreeEntity;
+		G_SetNextThink(ent, level.time + 2000);
+		ent->s.time  = level.time;
+		ent->s.time2 = level.time + 2000;
 		return;
 	}
 
 	ent->s.frame++;
-	ent->nextthink = level.time + (FRAMETIME / 2);
+	G_SetNextThink(ent, level.time + (FRAMETIME / 2));
 }
 
 void crate_die(gentity_t *ent, gentity_t *inflictor, gentity_t *attacker, int damage, int mod)
@@ -2392,8 +2392,8 @@ void crate_die(gentity_t *ent, gentity_t *inflictor, gentity_t *attacker, int da
 
 	ent->takedamage = qfalse;
 	ent->think      = crate_animate;
-	ent->nextthink  = level.time + FRAMETIME;
-	ent->touch      = NULL;
+	G_SetNextThink(ent, level.time + FRAMETIME);
+	ent->touch = NULL;
 
 	trap_UnlinkEntity(ent);
 
@@ -2445,8 +2445,8 @@ void SP_crate_64(gentity_t *self)
 
 	trap_LinkEntity(self);
 
-	self->think     = DropToFloor;
-	self->nextthink = level.time + FRAMETIME;
+	self->think = DropToFloor;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void SP_crate_32(gentity_t *self)
@@ -2490,8 +2490,8 @@ void SP_crate_32(gentity_t *self)
 
 	trap_LinkEntity(self);
 
-	self->think     = DropToFloor;
-	self->nextthink = level.time + FRAMETIME;
+	self->think = DropToFloor;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 //////////////////////////////////////////////
@@ -2502,7 +2502,7 @@ void props_crate32x64_think(gentity_t *ent)
 
 	if (ent->s.frame < 17)
 	{
-		ent->nextthink = level.time + (FRAMETIME / 2);
+		G_SetNextThink(ent, level.time + (FRAMETIME / 2));
 	}
 	else
 	{
@@ -2516,8 +2516,8 @@ void props_crate32x64_think(gentity_t *ent)
 
 void props_crate32x64_die(gentity_t *ent, gentity_t *inflictor, gentity_t *attacker, int damage, int mod)
 {
-	ent->think     = props_crate32x64_think;
-	ent->nextthink = level.time + FRAMETIME;
+	ent->think = props_crate32x64_think;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 void SP_Props_Crate32x64(gentity_t *ent)
@@ -2587,8 +2587,8 @@ void flippy_table_use(gentity_t *ent, gentity_t *other, gentity_t *activator)
 			VectorCopy(ent->s.apos.trBase, slave->s.apos.trBase);
 			VectorCopy(ent->s.apos.trDelta, slave->s.apos.trDelta);
 
-			slave->think     = ent->think;
-			slave->nextthink = ent->nextthink;
+			slave->think = ent->think;
+			G_SetNextThink(slave, ent->nextthink);
 
 			VectorCopy(ent->pos1, slave->pos1);
 			VectorCopy(ent->pos2, slave->pos2);
@@ -2619,20 +2619,20 @@ void flippy_table_animate(gentity_t *ent)
 	{
 	    G_UseTargets(ent, NULL);
 	    ent->think     = G_FreeEntity;
-	    ent->nextthink = level.time + 2000;
+	    G_SetNextThink(ent, level.time + 2000);
 	}
 	else
 	{
 	    ent->s.frame++;
-	    ent->nextthink = level.time + (FRAMETIME / 2);
+	    G_SetNextThink(ent, level.time + (FRAMETIME / 2));
 	}
 	*/
 }
 
 void props_flippy_table_die(gentity_t *ent, gentity_t *inflictor, gentity_t *attacker, int damage, int mod)
 {
-	ent->think      = flippy_table_animate;
-	ent->nextthink  = level.time + FRAMETIME;
+	ent->think = flippy_table_animate;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 	ent->takedamage = qfalse;
 
 	G_UseTargets(ent, NULL);
@@ -2770,7 +2770,7 @@ void props_58x112tablew_think(gentity_t *ent)
 
 	if (ent->s.frame < 16)
 	{
-		ent->nextthink = level.time + (FRAMETIME / 2);
+		G_SetNextThink(ent, level.time + (FRAMETIME / 2));
 	}
 	else
 	{
@@ -2783,8 +2783,8 @@ void props_58x112tablew_think(gentity_t *ent)
 
 void props_58x112tablew_die(gentity_t *ent, gentity_t *inflictor, gentity_t *attacker, int damage, int mod)
 {
-	ent->think      = props_58x112tablew_think;
-	ent->nextthink  = level.time + FRAMETIME;
+	ent->think = props_58x112tablew_think;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 	ent->takedamage = qfalse;
 }
 
@@ -2856,7 +2856,7 @@ void props_castlebed_animate(gentity_t *ent)
 
 	if (ent->s.frame < 8)
 	{
-		ent->nextthink = level.time + (FRAMETIME / 2);
+		G_SetNextThink(ent, level.time + (FRAMETIME / 2));
 	}
 	else
 	{
@@ -2868,8 +2868,8 @@ void props_castlebed_animate(gentity_t *ent)
 
 void props_castlebed_die(gentity_t *ent, gentity_t *inflictor, gentity_t *attacker, int damage, int mod)
 {
-	ent->think      = props_castlebed_animate;
-	ent->nextthink  = level.time + FRAMETIME;
+	ent->think = props_castlebed_animate;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 	ent->touch      = NULL;
 	ent->takedamage = qfalse;
 
@@ -2947,11 +2947,11 @@ void props_snowGenerator_think(gentity_t *ent)
 
 	if (ent->spawnflags & 2)
 	{
-		ent->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(ent, level.time + FRAMETIME);
 	}
 	else if (ent->wait < level.time)
 	{
-		ent->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(ent, level.time + FRAMETIME);
 	}
 }
 
@@ -2960,9 +2960,9 @@ void props_snowGenerator_use(gentity_t *ent, gentity_t *other, gentity_t *activa
 	if (!(ent->spawnflags & 1))
 	{
 		ent->spawnflags |= 1;
-		ent->think       = props_snowGenerator_think;
-		ent->nextthink   = level.time + FRAMETIME;
-		ent->wait        = level.time + ent->duration;
+		ent->think      = props_snowGenerator_think;
+		G_SetNextThink(ent, level.time + FRAMETIME);
+		ent->wait = level.time + ent->duration;
 	}
 	else
 	{
@@ -3006,8 +3006,8 @@ void SP_props_snowGenerator(gentity_t *ent)
 
 	if ((ent->spawnflags & 1) || (ent->spawnflags & 2))
 	{
-		ent->think     = props_snowGenerator_think;
-		ent->nextthink = level.time + FRAMETIME;
+		ent->think = props_snowGenerator_think;
+		G_SetNextThink(ent, level.time + FRAMETIME);
 
 		if (ent->spawnflags & 2)
 		{
@@ -3088,7 +3088,7 @@ void props_decoration_animate(gentity_t *ent)
 		}
 	}
 
-	ent->nextthink = level.time + 50;
+	G_SetNextThink(ent, level.time + 50);
 }
 
 void props_decoration_death(gentity_t *ent, gentity_t *inflictor, gentity_t *attacker, int damage, int mod)
@@ -3112,8 +3112,8 @@ void props_decoration_death(gentity_t *ent, gentity_t *inflictor, gentity_t *att
 
 	if (ent->spawnflags & 4)
 	{
-		ent->nextthink = level.time + 50;
-		ent->think     = props_decoration_animate;
+		G_SetNextThink(ent, level.time + 50);
+		ent->think = props_decoration_animate;
 		return;
 	}
 
@@ -3129,8 +3129,8 @@ void Use_props_decoration(gentity_t *ent, gentity_t *self, gentity_t *activator)
 	}
 	else if (ent->spawnflags & 4)
 	{
-		ent->nextthink = level.time + 50;
-		ent->think     = props_decoration_animate;
+		G_SetNextThink(ent, level.time + 50);
+		ent->think = props_decoration_animate;
 	}
 	else
 	{
@@ -3291,8 +3291,8 @@ void SP_props_decoration(gentity_t *ent)
 
 	if (ent->spawnflags & 64)
 	{
-		ent->nextthink = level.time + 50;
-		ent->think     = props_decoration_animate;
+		G_SetNextThink(ent, level.time + 50);
+		ent->think = props_decoration_animate;
 	}
 
 	ent->r.svFlags = 0;
@@ -3539,7 +3539,7 @@ void props_statue_animate(gentity_t *ent)
 
 	if (ent->s.frame < ent->count2)
 	{
-		ent->nextthink = level.time + 50;
+		G_SetNextThink(ent, level.time + 50);
 	}
 }
 
@@ -3568,8 +3568,8 @@ void props_statue_death(gentity_t *ent, gentity_t *inflictor, gentity_t *attacke
 
 	if (ent->spawnflags & 4)
 	{
-		ent->nextthink = level.time + 50;
-		ent->think     = props_statue_animate;
+		G_SetNextThink(ent, level.time + 50);
+		ent->think = props_statue_animate;
 		return;
 	}
 
@@ -3778,7 +3778,7 @@ void Spawn_Junk(gentity_t *ent)
 
 	sfx->think = G_FreeEntity;
 
-	sfx->nextthink = level.time + 1000;
+	G_SetNextThink(sfx, level.time + 1000);
 
 	trap_LinkEntity(sfx);
 }
@@ -3790,10 +3790,10 @@ props_locker_endrattle
 */
 void props_locker_endrattle(gentity_t *ent)
 {
-	ent->s.frame   = 0; // idle
-	ent->think     = 0;
-	ent->nextthink = 0;
-	ent->delay     = 0;
+	ent->s.frame = 0; // idle
+	ent->think   = 0;
+	G_SetNextThink(ent, 0);
+	ent->delay = 0;
 }
 
 void props_locker_use(gentity_t *ent, gentity_t *other, gentity_t *activator)
@@ -3802,9 +3802,9 @@ void props_locker_use(gentity_t *ent, gentity_t *other, gentity_t *activator)
 	{
 		ent->s.frame = 1;   // rattle when pain starts
 	}
-	ent->delay     = 1;
-	ent->think     = props_locker_endrattle;
-	ent->nextthink = level.time + 1000; // rattle a sec
+	ent->delay = 1;
+	ent->think = props_locker_endrattle;
+	G_SetNextThink(ent, level.time + 1000); // rattle a sec
 }
 
 void props_locker_pain(gentity_t *ent, gentity_t *attacker, int damage, vec3_t point)
@@ -3937,7 +3937,7 @@ void props_locker_death(gentity_t *ent, gentity_t *inflictor, gentity_t *attacke
 	ent->takedamage = qfalse;
 	ent->s.frame    = 2; // opening animation
 	ent->think      = 0;
-	ent->nextthink  = 0;
+	G_SetNextThink(ent, 0);
 
 	trap_UnlinkEntity(ent);
 	ent->r.maxs[2] = 11;    // make the dead bb half height so the item can look like it's sitting inside
@@ -4106,7 +4106,7 @@ void props_flamethrower_think(gentity_t *ent)
 	{
 		G_AddEvent(ent, EV_FLAMETHROWER_EFFECT, 0);
 
-		ent->nextthink = level.time + 50;
+		G_SetNextThink(ent, level.time + 50);
 
 		//      The flamethrower effect above is purely visual
 		//      we actual need to create an entity that is the fire and will do damage
@@ -4127,7 +4127,7 @@ void props_flamethrower_think(gentity_t *ent)
 			}
 
 			ent->timestamp = level.time + rnd;
-			ent->nextthink = ent->timestamp + 50;
+			G_SetNextThink(ent, ent->timestamp + 50);
 		}
 	}
 }
@@ -4139,8 +4139,8 @@ void props_flamethrower_use(gentity_t *ent, gentity_t *other, gentity_t *activat
 	if (ent->spawnflags & 2)
 	{
 		ent->spawnflags &= ~2;
-		ent->think       = NULL; // wasn't working
-		ent->nextthink   = 0;
+		ent->think      = NULL; // wasn't working
+		G_SetNextThink(ent, 0);
 		return;
 	}
 	else
@@ -4160,8 +4160,8 @@ void props_flamethrower_use(gentity_t *ent, gentity_t *other, gentity_t *activat
 
 	ent->timestamp = level.time + rnd;
 
-	ent->think     = props_flamethrower_think;
-	ent->nextthink = level.time + 50;
+	ent->think = props_flamethrower_think;
+	G_SetNextThink(ent, level.time + 50);
 }
 
 void props_flamethrower_init(gentity_t *ent)
@@ -4199,9 +4199,9 @@ void SP_props_flamethrower(gentity_t *ent)
 	char  *size;
 	float dsize;
 
-	ent->think     = props_flamethrower_init;
-	ent->nextthink = level.time + 50;
-	ent->use       = props_flamethrower_use;
+	ent->think = props_flamethrower_init;
+	G_SetNextThink(ent, level.time + 50);
+	ent->use = props_flamethrower_use;
 
 	G_SetOrigin(ent, ent->s.origin);
 
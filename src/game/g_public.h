@@ -279,8 +279,30 @@ typedef enum
 
 	G_SENDMESSAGE = 585,
 	G_MESSAGESTATUS,
+
+	G_TRACEBATCH,       // ( traceBatch_t *batch, int count ); added after 274 release
+	G_CVAR_CHANGES,     // ( int *sequence, int *handles, int maxHandles ); added after 274 release
 } gameImport_t;
 
+#define TRACEBATCH_PVS      1   // skip the trace if end isn't in the PVS of start
+#define TRACEBATCH_NOENTS   2   // clip to the world only
+#define TRACEBATCH_CAPSULE  4   // capsule instead of box trace
+
+// one ray of a G_TRACEBATCH call
+typedef struct
+{
+	vec3_t start;
+	vec3_t end;
+	vec3_t mins;                // relative, zero for a line trace
+	vec3_t maxs;
+	int passEntityNum;
+	int contentmask;
+	int flags;                  // TRACEBATCH_*
+
+	qboolean inPVS;             // set by the server
+	trace_t trace;              // set by the server, fraction 0 if not in PVS
+} traceBatch_t;
+
 
 // functions exported by the game subsystem
 typedef enum
@@ -1069,7 +1069,7 @@ void script_mover_think(gentity_t *ent)
 		}
 	}
 
-	ent->nextthink = level.time + 100;
+	G_SetNextThink(ent, level.time + 100);
 }
 
 void script_mover_spawn(gentity_t *ent)
@@ -1110,8 +1110,8 @@ void script_mover_spawn(gentity_t *ent)
 	}
 
 	script_linkentity(ent);
-	ent->think     = script_mover_think;
-	ent->nextthink = level.time + 200;
+	ent->think = script_mover_think;
+	G_SetNextThink(ent, level.time + 200);
 }
 
 void script_mover_use(gentity_t *ent, gentity_t *other, gentity_t *activator)
@@ -1127,8 +1127,8 @@ void script_mover_use(gentity_t *ent, gentity_t *other, gentity_t *activator)
 
 			ent->die = script_mover_die;
 
-			ent->think     = script_mover_think;
-			ent->nextthink = level.time + 200;
+			ent->think = script_mover_think;
+			G_SetNextThink(ent, level.time + 200);
 		}
 	}
 	else
@@ -1333,8 +1333,8 @@ void SP_script_mover(gentity_t *ent)
 		ent->s.powerups = -1;
 	}
 
-	ent->think     = script_mover_spawn;
-	ent->nextthink = level.time + FRAMETIME;
+	ent->think = script_mover_spawn;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 //..............................................................................
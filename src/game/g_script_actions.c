@@ -3783,8 +3783,8 @@ G_ScriptAction_RemoveEntity
 */
 qboolean G_ScriptAction_RemoveEntity(gentity_t *ent, char *params)
 {
-	ent->think     = G_FreeEntity;
-	ent->nextthink = level.time + FRAMETIME;
+	ent->think = G_FreeEntity;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	return qtrue;
 }
@@ -4659,8 +4659,8 @@ void G_ModifyTOI(gentity_t *ent)
 	else
 	{
 		// finalize spawing on fourth frame to allow for proper linking with targets
-		ent->nextthink = level.time + (3 * FRAMETIME);
-		ent->think     = Think_SetupObjectiveInfo;
+		G_SetNextThink(ent, level.time + (3 * FRAMETIME));
+		ent->think = Think_SetupObjectiveInfo;
 	}
 }
 
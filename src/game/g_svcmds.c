@@ -1983,6 +1983,146 @@ void Svcmd_CSInfo_f(void)
 	G_Printf("--------------------------------------------\nTotal CONFIGSTRING Length: %i\n", total);
 }
 
+#define TRACEBENCH_BOTS     32
+
+/**
+ * @brief Compares the line of sight checks of bots done one by one and in batches
+ *
+ * @details Every bot at a spawn point checks its line of sight to all other
+ * bots with a PVS check first, like Omni-bot does. The serial pass makes one
+ * trap_InPVS and one trap_Trace syscall per ray, the batched pass one
+ * trap_TraceBatch call for all of them.
+ */
+static void Svcmd_TraceBench_f(void)
+{
+	static traceBatch_t batch[TRACEBENCH_BOTS * TRACEBENCH_BOTS];
+	static trace_t      results[TRACEBENCH_BOTS][TRACEBENCH_BOTS];
+	static qboolean     visible[TRACEBENCH_BOTS][TRACEBENCH_BOTS];
+	vec3_t              eyes[TRACEBENCH_BOTS];
+	char                arg[MAX_TOKEN_CHARS];
+	gentity_t           *ent;
+	trace_t             tr;
+	int                 rounds = 100, numSpots = 0, round, i, j, n, start, msec[2], mismatches = 0;
+
+	trap_Argv(1, arg, sizeof(arg));
+	if (arg[0])
+	{
+		rounds = atoi(arg);
+	}
+
+	if (rounds <= 0)
+	{
+		G_Printf("usage: tracebench [rounds]\n");
+		return;
+	}
+
+	for (i = MAX_CLIENTS, ent = &g_entities[MAX_CLIENTS]; i < level.num_entities && numSpots < TRACEBENCH_BOTS; i++, ent++)
+	{
+		if (ent->inuse && ent->classname
+		    && (!Q_stricmp(ent->classname, "team_CTF_redspawn") || !Q_stricmp(ent->classname, "team_CTF_bluespawn")
+		        || !Q_stricmp(ent->classname, "info_player_deathmatch")))
+		{
+			VectorCopy(ent->s.origin, eyes[numSpots]);
+			eyes[numSpots][2] += DEFAULT_VIEWHEIGHT;
+			numSpots++;
+		}
+	}
+
+	if (!numSpots)
+	{
+		G_Printf("tracebench: no spawn points\n");
+		return;
+	}
+
+	// more bots than spawn points stand around them
+	for (i = numSpots; i < TRACEBENCH_BOTS; i++)
+	{
+		VectorCopy(eyes[i % numSpots], eyes[i]);
+		eyes[i][0] += crandom() * 64;
+		eyes[i][1] += crandom() * 64;
+	}
+
+	// serial
+	start = trap_Milliseconds();
+	for (round = 0; round < rounds; round++)
+	{
+		for (i = 0; i < TRACEBENCH_BOTS; i++)
+		{
+			for (j = 0; j < TRACEBENCH_BOTS; j++)
+			{
+				if (i == j)
+				{
+					continue;
+				}
+
+				visible[i][j] = trap_InPVS(eyes[i], eyes[j]);
+				if (visible[i][j])
+				{
+					trap_Trace(&results[i][j], eyes[i], NULL, NULL, eyes[j], ENTITYNUM_NONE, MASK_SHOT);
+				}
+			}
+		}
+	}
+	msec[0] = trap_Milliseconds() - start;
+
+	if (!(level.syscallExtensions & SYSCALL_EXT_TRACEBATCH))
+	{
+		G_Printf("tracebench: %i rays: %i msec serial, the server has no G_TRACEBATCH\n",
+		         rounds * TRACEBENCH_BOTS * (TRACEBENCH_BOTS - 1), msec[0]);
+		return;
+	}
+
+	// batched, all bots in one call as a server frame would
+	for (i = 0, n = 0; i < TRACEBENCH_BOTS; i++)
+	{
+		for (j = 0; j < TRACEBENCH_BOTS; j++)
+		{
+			if (i == j)
+			{
+				continue;
+			}
+
+			VectorCopy(eyes[i], batch[n].start);
+			VectorCopy(eyes[j], batch[n].end);
+			VectorClear(batch[n].mins);
+			VectorClear(batch[n].maxs);
+			batch[n].passEntityNum = ENTITYNUM_NONE;
+			batch[n].contentmask   = MASK_SHOT;
+			batch[n].flags         = TRACEBATCH_PVS;
+			n++;
+		}
+	}
+
+	start = trap_Milliseconds();
+	for (round = 0; round < rounds; round++)
+	{
+		trap_TraceBatch(batch, n);
+	}
+	msec[1] = trap_Milliseconds() - start;
+
+	for (i = 0, n = 0; i < TRACEBENCH_BOTS; i++)
+	{
+		for (j = 0; j < TRACEBENCH_BOTS; j++)
+		{
+			if (i == j)
+			{
+				continue;
+			}
+
+			tr = batch[n].trace;
+			if (batch[n].inPVS != visible[i][j]
+			    || (visible[i][j] && (tr.fraction != results[i][j].fraction || tr.entityNum != results[i][j].entityNum)))
+			{
+				mismatches++;
+			}
+			n++;
+		}
+	}
+
+	G_Printf("tracebench: %i bots at %i spawn points, %i rays: %i msec serial, %i msec batched, %i mismatches\n",
+	         TRACEBENCH_BOTS, numSpots, rounds * TRACEBENCH_BOTS * (TRACEBENCH_BOTS - 1), msec[0], msec[1], mismatches);
+}
+
 qboolean ConsoleCommand(void)
 {
 	char cmd[MAX_TOKEN_CHARS];
@@ -2000,6 +2140,34 @@ qboolean ConsoleCommand(void)
 		G_LuaStackDump();
 		return qtrue;
 	}
+	if (Q_stricmp(cmd, "lua_profile") == 0)
+	{
+		char arg[MAX_TOKEN_CHARS];
+
+		trap_Argv(1, arg, sizeof(arg));
+		G_LuaProfile(NULL, !Q_stricmp(arg, "reset"));
+		return qtrue;
+	}
+	if (Q_stricmp(cmd, "lua_bench") == 0)
+	{
+		char arg[MAX_TOKEN_CHARS];
+		int  rounds = 1000;
+
+		trap_Argv(1, arg, sizeof(arg));
+		if (arg[0])
+		{
+			rounds = atoi(arg);
+		}
+
+		if (rounds <= 0)
+		{
+			G_Printf("usage: lua_bench [rounds]\n");
+			return qtrue;
+		}
+
+		G_LuaBenchmark(rounds);
+		return qtrue;
+	}
 	// *LUA* API callbacks
 	if (G_LuaHook_ConsoleCommand(cmd))
 	{
@@ -2026,6 +2194,11 @@ qboolean ConsoleCommand(void)
 		Svcmd_GameMem_f();
 		return qtrue;
 	}
+	if (Q_stricmp(cmd, "tracebench") == 0)
+	{
+		Svcmd_TraceBench_f();
+		return qtrue;
+	}
 	if (Q_stricmp(cmd, "addip") == 0)
 	{
 		Svcmd_AddIP_f();
@@ -120,6 +120,11 @@ void trap_Cvar_Update(vmCvar_t *cvar)
 	syscall(G_CVAR_UPDATE, cvar);
 }
 
+int trap_Cvar_Changes(int *sequence, int *handles, int maxHandles)
+{
+	return syscall(G_CVAR_CHANGES, sequence, handles, maxHandles);
+}
+
 void trap_Cvar_Set(const char *var_name, const char *value)
 {
 	syscall(G_CVAR_SET, var_name, value);
@@ -214,6 +219,11 @@ void trap_TraceCapsuleNoEnts(trace_t *results, const vec3_t start, const vec3_t
 	syscall(G_TRACECAPSULE, results, start, mins, maxs, end, -2, contentmask);
 }
 
+int trap_TraceBatch(traceBatch_t *batch, int count)
+{
+	return syscall(G_TRACEBATCH, batch, count);
+}
+
 int trap_PointContents(const vec3_t point, int passEntityNum)
 {
 	return syscall(G_POINT_CONTENTS, point, passEntityNum);
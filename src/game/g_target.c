@@ -66,7 +66,7 @@ void Use_Target_Give(gentity_t *ent, gentity_t *other, gentity_t *activator)
 		Touch_Item(t, activator, &trace);
 
 		// make sure it isn't going to respawn or show any events
-		t->nextthink = 0;
+		G_SetNextThink(t, 0);
 		trap_UnlinkEntity(t);
 	}
 }
@@ -117,7 +117,7 @@ void Think_Target_Delay(gentity_t *ent)
 
 void Use_Target_Delay(gentity_t *ent, gentity_t *other, gentity_t *activator)
 {
-	ent->nextthink = level.time + (ent->wait + ent->random * crandom()) * 1000;
+	G_SetNextThink(ent, level.time + (ent->wait + ent->random * crandom()) * 1000);
 	ent->think     = Think_Target_Delay;
 	ent->activator = activator;
 }
@@ -321,8 +321,8 @@ void SP_target_speaker(gentity_t *ent)
 
 	if (ent->spawnflags & 16)
 	{
-		ent->think     = target_speaker_multiple;
-		ent->nextthink = level.time + 50;
+		ent->think = target_speaker_multiple;
+		G_SetNextThink(ent, level.time + 50);
 	}
 
 	// NO_PVS
@@ -396,7 +396,7 @@ void misc_beam_think(gentity_t *self)
 
 	self->s.effect1Time = self->target_ent->s.effect2Time;
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 
 	if (self->s.pos.trType != TR_STATIONARY || self->s.apos.trType != TR_STATIONARY || !self->accuracy)
 	{
@@ -473,9 +473,9 @@ void misc_beam_start(gentity_t *self)
 		self->enemy = self;
 	}
 
-	self->accuracy  = 0;
-	self->think     = misc_beam_think;
-	self->nextthink = level.time + FRAMETIME;
+	self->accuracy = 0;
+	self->think    = misc_beam_think;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void SP_misc_beam(gentity_t *self)
@@ -498,9 +498,9 @@ void SP_misc_beam(gentity_t *self)
 	G_SpawnVector("color", "1 1 1", self->s.angles2);
 
 	// let everything else get spawned before we start firing
-	self->accuracy  = 0;
-	self->think     = misc_beam_start;
-	self->nextthink = level.time + FRAMETIME;
+	self->accuracy = 0;
+	self->think    = misc_beam_start;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 //==========================================================
@@ -539,7 +539,7 @@ void target_laser_think(gentity_t *self)
 	VectorCopy(tr.endpos, self->s.origin2);
 
 	trap_LinkEntity(self);
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 void target_laser_on(gentity_t *self)
@@ -554,7 +554,7 @@ void target_laser_on(gentity_t *self)
 void target_laser_off(gentity_t *self)
 {
 	trap_UnlinkEntity(self);
-	self->nextthink = 0;
+	G_SetNextThink(self, 0);
 }
 
 void target_laser_use(gentity_t *self, gentity_t *other, gentity_t *activator)
@@ -617,8 +617,8 @@ void SP_target_laser(gentity_t *self)
 	self->s.angles2[2] = 1.f;
 
 	// let everything else get spawned before we start firing
-	self->think     = target_laser_start;
-	self->nextthink = level.time + FRAMETIME;
+	self->think = target_laser_start;
+	G_SetNextThink(self, level.time + FRAMETIME);
 }
 
 //==========================================================
@@ -762,7 +762,7 @@ void G_KillEnts(const char *target, gentity_t *ignore, gentity_t *killer, meansO
 	while ((targ = G_FindByTargetname(targ, target)))
 	{
 		// make sure it isn't going to respawn or show any events
-		targ->nextthink = 0;
+		G_SetNextThink(targ, 0);
 
 		if (targ == ignore)
 		{
@@ -787,7 +787,7 @@ void G_KillEnts(const char *target, gentity_t *ignore, gentity_t *killer, meansO
 		}
 
 		trap_UnlinkEntity(targ);
-		targ->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(targ, level.time + FRAMETIME);
 
 		targ->use   = NULL;
 		targ->touch = NULL;
@@ -983,7 +983,7 @@ shader		= custom shader to use for particles
 
 void smoke_think(gentity_t *ent)
 {
-	ent->nextthink = level.time + ent->s.constantLight;
+	G_SetNextThink(ent, level.time + ent->s.constantLight);
 
 	if (!(ent->spawnflags & 4))
 	{
@@ -995,8 +995,8 @@ void smoke_think(gentity_t *ent)
 		ent->s.dl_intensity--;
 		if (!ent->s.dl_intensity)
 		{
-			ent->think     = G_FreeEntity;
-			ent->nextthink = level.time + FRAMETIME;
+			ent->think = G_FreeEntity;
+			G_SetNextThink(ent, level.time + FRAMETIME);
 		}
 	}
 }
@@ -1020,8 +1020,8 @@ void smoke_init(gentity_t *ent)
 	gentity_t *target;
 	vec3_t    vec;
 
-	ent->think     = smoke_think;
-	ent->nextthink = level.time + FRAMETIME;
+	ent->think = smoke_think;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	if (ent->target)
 	{
@@ -1068,8 +1068,8 @@ void SP_target_smoke(gentity_t *ent)
 
 	ent->use = smoke_toggle;
 
-	ent->think     = smoke_init;
-	ent->nextthink = level.time + FRAMETIME;
+	ent->think = smoke_init;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	G_SetOrigin(ent, ent->s.origin);
 	ent->r.svFlags = 0;
@@ -1269,11 +1269,11 @@ void target_rumble_think(gentity_t *ent)
 			ent->s.loopSound = 0;
 		}
 
-		ent->nextthink = 0;
+		G_SetNextThink(ent, 0);
 	}
 	else
 	{
-		ent->nextthink = level.time + 50;
+		G_SetNextThink(ent, level.time + 50);
 	}
 }
 
@@ -1282,9 +1282,9 @@ void target_rumble_use(gentity_t *ent, gentity_t *other, gentity_t *activator)
 	if (ent->spawnflags & 1)
 	{
 		ent->spawnflags &= ~1;
-		ent->think       = target_rumble_think;
-		ent->count       = 0;
-		ent->nextthink   = level.time + 50;
+		ent->think      = target_rumble_think;
+		ent->count      = 0;
+		G_SetNextThink(ent, level.time + 50);
 	}
 	else
 	{
@@ -980,9 +980,9 @@ void SP_team_WOLF_objective(gentity_t *ent)
 	ent->message = G_Alloc(strlen(desc) + 1);
 	Q_strncpyz(ent->message, desc, strlen(desc) + 1);
 
-	ent->nextthink = level.time + FRAMETIME;
-	ent->think     = objective_Register;
-	ent->s.eType   = ET_WOLF_OBJECTIVE;
+	G_SetNextThink(ent, level.time + FRAMETIME);
+	ent->think   = objective_Register;
+	ent->s.eType = ET_WOLF_OBJECTIVE;
 
 	if (ent->spawnflags & 1)
 	{
@@ -1082,9 +1082,9 @@ void checkpoint_use(gentity_t *ent, gentity_t *other, gentity_t *activator)
 		trap_SendServerCommand(activator - g_entities, va("cp \"Flag will be held in %i seconds!\"", time));
 	}
 
-	ent->count2    = level.time;
-	ent->think     = checkpoint_use_think;
-	ent->nextthink = level.time + 2000;
+	ent->count2 = level.time;
+	ent->think  = checkpoint_use_think;
+	G_SetNextThink(ent, level.time + 2000);
 
 	// reset player disguise on touching flag
 	other->client->ps.powerups[PW_OPS_DISGUISED] = 0;
@@ -1094,7 +1094,7 @@ void checkpoint_spawntouch(gentity_t *self, gentity_t *other, trace_t *trace);
 
 void checkpoint_hold_think(gentity_t *self)
 {
-	self->nextthink = level.time + 5000;
+	G_SetNextThink(self, level.time + 5000);
 }
 
 void checkpoint_think(gentity_t *self)
@@ -1137,7 +1137,7 @@ void checkpoint_think(gentity_t *self)
 	{
 		self->touch = checkpoint_touch;
 	}
-	self->nextthink = 0;
+	G_SetNextThink(self, 0);
 }
 
 void checkpoint_touch(gentity_t *self, gentity_t *other, trace_t *trace)
@@ -1213,8 +1213,8 @@ void checkpoint_touch(gentity_t *self, gentity_t *other, trace_t *trace)
 	// Don't allow touch again until animation is finished
 	self->touch = NULL;
 
-	self->think     = checkpoint_think;
-	self->nextthink = level.time + 1000;
+	self->think = checkpoint_think;
+	G_SetNextThink(self, level.time + 1000);
 }
 
 // if spawn flag is set, use this touch fn instead to turn on/off targeted spawnpoints
@@ -1353,8 +1353,8 @@ void checkpoint_spawntouch(gentity_t *self, gentity_t *other, trace_t *trace)
 	// Don't allow touch again until animation is finished
 	self->touch = NULL;
 
-	self->think     = checkpoint_think;
-	self->nextthink = level.time + 1000;
+	self->think = checkpoint_think;
+	G_SetNextThink(self, level.time + 1000);
 
 	// activate all targets
 	// updated this to allow toggling of initial spawnpoints as well, plus now it only
@@ -1445,7 +1445,7 @@ void SP_team_WOLF_checkpoint(gentity_t *ent)
 	ent->s.teamNum = 1;
 
 	// Used later to set animations (and delay between captures)
-	ent->nextthink = 0;
+	G_SetNextThink(ent, 0);
 
 	// Used to time how long it must be "held" to switch
 	ent->health = -1;
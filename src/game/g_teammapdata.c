@@ -102,16 +102,33 @@ returns next entity in the array
 mapEntityData_t *G_FreeMapEntityData(mapEntityData_Team_t *teamList, mapEntityData_t *mEnt)
 {
 	mapEntityData_t *ret = mEnt->next;
+	mapEntityData_t **link;
 
 	if (!mEnt->prev)
 	{
 		G_Error("G_FreeMapEntityData: not active\n");
 	}
 
+	// the entity lists are per team, an entry of the other team would stay in them
+	if (mEnt < teamList->mapEntityData_Team || mEnt >= teamList->mapEntityData_Team + MAX_GENTITIES)
+	{
+		G_Error("G_FreeMapEntityData: not in this team list\n");
+	}
+
 	// remove from the doubly linked active list
 	mEnt->prev->next = mEnt->next;
 	mEnt->next->prev = mEnt->prev;
 
+	// and from the list of its entity, there are rarely more than a few in it
+	for (link = &teamList->entityMapEntityData[mEnt->entNum]; *link; link = &(*link)->entNext)
+	{
+		if (*link == mEnt)
+		{
+			*link = mEnt->entNext;
+			break;
+		}
+	}
+
 	// the free list is only singly linked
 	mEnt->next                  = teamList->freeMapEntityData;
 	teamList->freeMapEntityData = mEnt;
@@ -124,7 +141,7 @@ mapEntityData_t *G_FreeMapEntityData(mapEntityData_Team_t *teamList, mapEntityDa
 G_AllocMapEntityData
 ===================
 */
-mapEntityData_t *G_AllocMapEntityData(mapEntityData_Team_t *teamList)
+mapEntityData_t *G_AllocMapEntityData(mapEntityData_Team_t *teamList, int entNum)
 {
 	mapEntityData_t *mEnt;
 
@@ -140,6 +157,11 @@ mapEntityData_t *G_AllocMapEntityData(mapEntityData_Team_t *teamList)
 	memset(mEnt, 0, sizeof(*mEnt));
 
 	mEnt->singleClient = -1;
+	mEnt->entNum       = entNum;
+
+	// link into the list of the entity, newest first like the active list
+	mEnt->entNext                         = teamList->entityMapEntityData[entNum];
+	teamList->entityMapEntityData[entNum] = mEnt;
 
 	// link into the active list
 	mEnt->next                               = teamList->activeMapEntityData.next;
@@ -158,13 +180,9 @@ mapEntityData_t *G_FindMapEntityData(mapEntityData_Team_t *teamList, int entNum)
 {
 	mapEntityData_t *mEnt;
 
-	for (mEnt = teamList->activeMapEntityData.next; mEnt && mEnt != &teamList->activeMapEntityData; mEnt = mEnt->next)
+	for (mEnt = teamList->entityMapEntityData[entNum]; mEnt; mEnt = mEnt->entNext)
 	{
-		if (mEnt->singleClient >= 0)
-		{
-			continue;
-		}
-		if (entNum == mEnt->entNum)
+		if (mEnt->singleClient < 0)
 		{
 			return mEnt;
 		}
@@ -185,14 +203,14 @@ mapEntityData_t *G_FindMapEntityDataSingleClient(mapEntityData_Team_t *teamList,
 
 	if (start)
 	{
-		mEnt = start->next;
+		mEnt = start->entNext;
 	}
 	else
 	{
-		mEnt = teamList->activeMapEntityData.next;
+		mEnt = teamList->entityMapEntityData[entNum];
 	}
 
-	for ( ; mEnt && mEnt != &teamList->activeMapEntityData; mEnt = mEnt->next)
+	for ( ; mEnt; mEnt = mEnt->entNext)
 	{
 		if (clientNum == -1)
 		{
@@ -442,8 +460,7 @@ void G_UpdateTeamMapData_Construct(gentity_t *ent)
 		mEnt     = G_FindMapEntityData(teamList, num);
 		if (!mEnt)
 		{
-			mEnt         = G_AllocMapEntityData(teamList);
-			mEnt->entNum = num;
+			mEnt = G_AllocMapEntityData(teamList, num);
 		}
 		VectorCopy(ent->s.pos.trBase, mEnt->org);
 		mEnt->data      = mEnt->entNum; //ent->s.modelindex2;
@@ -472,8 +489,7 @@ void G_UpdateTeamMapData_Construct(gentity_t *ent)
 	mEnt = G_FindMapEntityData(teamList, num);
 	if (!mEnt)
 	{
-		mEnt         = G_AllocMapEntityData(teamList);
-		mEnt->entNum = num;
+		mEnt = G_AllocMapEntityData(teamList, num);
 	}
 	VectorCopy(ent->s.pos.trBase, mEnt->org);
 	mEnt->data      = mEnt->entNum; //ent->s.modelindex2;
@@ -492,8 +508,7 @@ void G_UpdateTeamMapData_Tank(gentity_t *ent)
 
 	if (!mEnt)
 	{
-		mEnt         = G_AllocMapEntityData(teamList);
-		mEnt->entNum = num;
+		mEnt = G_AllocMapEntityData(teamList, num);
 	}
 	VectorCopy(ent->s.pos.trBase, mEnt->org);
 	mEnt->data      = ent->s.modelindex2;
@@ -512,8 +527,7 @@ void G_UpdateTeamMapData_Tank(gentity_t *ent)
 	mEnt     = G_FindMapEntityData(teamList, num);
 	if (!mEnt)
 	{
-		mEnt         = G_AllocMapEntityData(teamList);
-		mEnt->entNum = num;
+		mEnt = G_AllocMapEntityData(teamList, num);
 	}
 	VectorCopy(ent->s.pos.trBase, mEnt->org);
 	mEnt->data      = ent->s.modelindex2;
@@ -541,8 +555,7 @@ void G_UpdateTeamMapData_Destruct(gentity_t *ent)
 		mEnt     = G_FindMapEntityData(teamList, num);
 		if (!mEnt)
 		{
-			mEnt         = G_AllocMapEntityData(teamList);
-			mEnt->entNum = num;
+			mEnt = G_AllocMapEntityData(teamList, num);
 		}
 		VectorCopy(ent->s.pos.trBase, mEnt->org);
 		mEnt->data      = mEnt->entNum; //ent->s.modelindex2;
@@ -560,8 +573,7 @@ void G_UpdateTeamMapData_Destruct(gentity_t *ent)
 				mEnt     = G_FindMapEntityData(teamList, num);
 				if (!mEnt)
 				{
-					mEnt         = G_AllocMapEntityData(teamList);
-					mEnt->entNum = num;
+					mEnt = G_AllocMapEntityData(teamList, num);
 				}
 				VectorCopy(ent->s.pos.trBase, mEnt->org);
 				mEnt->data      = mEnt->entNum; //ent->s.modelindex2;
@@ -578,8 +590,7 @@ void G_UpdateTeamMapData_Destruct(gentity_t *ent)
 		mEnt     = G_FindMapEntityData(teamList, num);
 		if (!mEnt)
 		{
-			mEnt         = G_AllocMapEntityData(teamList);
-			mEnt->entNum = num;
+			mEnt = G_AllocMapEntityData(teamList, num);
 		}
 		VectorCopy(ent->s.pos.trBase, mEnt->org);
 		mEnt->data      = mEnt->entNum; //ent->s.modelindex2;
@@ -597,8 +608,7 @@ void G_UpdateTeamMapData_Destruct(gentity_t *ent)
 				mEnt     = G_FindMapEntityData(teamList, num);
 				if (!mEnt)
 				{
-					mEnt         = G_AllocMapEntityData(teamList);
-					mEnt->entNum = num;
+					mEnt = G_AllocMapEntityData(teamList, num);
 				}
 				VectorCopy(ent->s.pos.trBase, mEnt->org);
 				mEnt->data      = mEnt->entNum; //ent->s.modelindex2;
@@ -641,8 +651,7 @@ void G_UpdateTeamMapData_Player(gentity_t *ent, qboolean forceAllied, qboolean f
 		mEnt     = G_FindMapEntityData(teamList, num);
 		if (!mEnt)
 		{
-			mEnt         = G_AllocMapEntityData(teamList);
-			mEnt->entNum = num;
+			mEnt = G_AllocMapEntityData(teamList, num);
 		}
 		VectorCopy(ent->client->ps.origin, mEnt->org);
 		mEnt->yaw       = ent->client->ps.viewangles[YAW];
@@ -669,8 +678,7 @@ void G_UpdateTeamMapData_Player(gentity_t *ent, qboolean forceAllied, qboolean f
 		mEnt     = G_FindMapEntityData(teamList, num);
 		if (!mEnt)
 		{
-			mEnt         = G_AllocMapEntityData(teamList);
-			mEnt->entNum = num;
+			mEnt = G_AllocMapEntityData(teamList, num);
 		}
 
 		VectorCopy(ent->client->ps.origin, mEnt->org);
@@ -727,8 +735,7 @@ static void G_UpdateTeamMapData_DisguisedPlayer(gentity_t *spotter, gentity_t *e
 		mEnt = G_FindMapEntityDataSingleClient(teamList, NULL, num, spotter->s.clientNum);
 		if (!mEnt)
 		{
-			mEnt               = G_AllocMapEntityData(teamList);
-			mEnt->entNum       = num;
+			mEnt               = G_AllocMapEntityData(teamList, num);
 			mEnt->singleClient = spotter->s.clientNum;
 		}
 		VectorCopy(ent->client->ps.origin, mEnt->org);
@@ -745,8 +752,7 @@ static void G_UpdateTeamMapData_DisguisedPlayer(gentity_t *spotter, gentity_t *e
 		mEnt = G_FindMapEntityDataSingleClient(teamList, NULL, num, spotter->s.clientNum);
 		if (!mEnt)
 		{
-			mEnt               = G_AllocMapEntityData(teamList);
-			mEnt->entNum       = num;
+			mEnt               = G_AllocMapEntityData(teamList, num);
 			mEnt->singleClient = spotter->s.clientNum;
 		}
 		VectorCopy(ent->client->ps.origin, mEnt->org);
@@ -776,8 +782,7 @@ void G_UpdateTeamMapData_LandMine(gentity_t *ent)
 		mEnt     = G_FindMapEntityData(teamList, num);
 		if (!mEnt)
 		{
-			mEnt         = G_AllocMapEntityData(teamList);
-			mEnt->entNum = num;
+			mEnt = G_AllocMapEntityData(teamList, num);
 		}
 		VectorCopy(ent->r.currentOrigin, mEnt->org);
 		mEnt->data      = team;
@@ -790,8 +795,7 @@ void G_UpdateTeamMapData_LandMine(gentity_t *ent)
 	mEnt     = G_FindMapEntityData(teamList, num);
 	if (!mEnt)
 	{
-		mEnt         = G_AllocMapEntityData(teamList);
-		mEnt->entNum = num;
+		mEnt = G_AllocMapEntityData(teamList, num);
 	}
 	VectorCopy(ent->r.currentOrigin, mEnt->org);
 	mEnt->data      = team;
@@ -830,8 +834,7 @@ void G_UpdateTeamMapData_CommandmapMarker(gentity_t *ent)
 		mEnt = G_FindMapEntityData(teamList, num);
 		if (!mEnt)
 		{
-			mEnt         = G_AllocMapEntityData(teamList);
-			mEnt->entNum = num;
+			mEnt = G_AllocMapEntityData(teamList, num);
 		}
 		VectorCopy(ent->s.origin, mEnt->org);
 		mEnt->data      = ent->parent ? ent->parent->s.teamNum : -1;
@@ -1011,10 +1014,185 @@ void G_PopupMessageForMines(gentity_t *player) // int sound
 	//pm->s.loopSound   = sound;
 }
 
+// armed landmines of a team bucketed into grid cells, so a spotter only
+// looks at the mines of the cells inside the binocular frustum
+#define MINEGRID_CELL_SIZE  512
+#define MINEGRID_HASH_SIZE  2048    // power of two, at least twice MAX_GENTITIES
+
+typedef struct
+{
+	int x, y;
+	vec3_t mins, maxs;              // bounds of the mines in the cell
+	gentity_t *mines;               // linked through mineGridNext
+} mineGridCell_t;
+
+typedef struct
+{
+	mineGridCell_t cells[MAX_GENTITIES];
+	int numCells;
+	int cellHash[MINEGRID_HASH_SIZE];   // cell + 1, 0 if empty
+} mineGrid_t;
+
+static mineGrid_t mineGrids[2];     // axis, allies
+static gentity_t  *mineGridNext[MAX_GENTITIES];
+
+/**
+ * @brief Sorts the armed landmines into the grids of their teams
+ *
+ * @note Mines still fall or ride movers while armed, so this is redone for each check.
+ */
+static void G_BuildMineGrids(void)
+{
+	gentity_t      *mine;
+	mineGrid_t     *grid;
+	mineGridCell_t *cell = NULL;
+	int            team, x, y, h;
+
+	for (h = 0; h < 2; h++)
+	{
+		mineGrids[h].numCells = 0;
+		Com_Memset(mineGrids[h].cellHash, 0, sizeof(mineGrids[h].cellHash));
+	}
+
+	for (mine = level.entityGroups[ENTGROUP_LANDMINE]; mine; mine = mine->groupNext)
+	{
+		if (!mine->inuse || mine->s.eType != ET_MISSILE || mine->methodOfDeath != MOD_LANDMINE)
+		{
+			continue;
+		}
+
+		// must be armed
+		if (!(mine->s.teamNum < 4 || mine->s.teamNum >= 8))
+		{
+			continue;
+		}
+
+		team = mine->s.teamNum % 4;
+		if (team != TEAM_AXIS && team != TEAM_ALLIES)
+		{
+			continue;
+		}
+
+		grid = &mineGrids[team == TEAM_AXIS ? 0 : 1];
+		x    = (int)floor(mine->r.currentOrigin[0] / MINEGRID_CELL_SIZE);
+		y    = (int)floor(mine->r.currentOrigin[1] / MINEGRID_CELL_SIZE);
+
+		for (h = (int)(((unsigned)x * 73856093u ^ (unsigned)y * 19349663u) & (MINEGRID_HASH_SIZE - 1)); grid->cellHash[h]; h = (h + 1) & (MINEGRID_HASH_SIZE - 1))
+		{
+			cell = &grid->cells[grid->cellHash[h] - 1];
+			if (cell->x == x && cell->y == y)
+			{
+				break;
+			}
+		}
+
+		if (!grid->cellHash[h])
+		{
+			cell              = &grid->cells[grid->numCells++];
+			grid->cellHash[h] = grid->numCells;
+			cell->x           = x;
+			cell->y           = y;
+			cell->mines       = NULL;
+			ClearBounds(cell->mins, cell->maxs);
+		}
+
+		AddPointToBounds(mine->r.currentOrigin, cell->mins, cell->maxs);
+		mineGridNext[mine - g_entities] = cell->mines;
+		cell->mines                     = mine;
+	}
+}
+
+/**
+ * @brief Checks if a box is at least partially inside the frustum of G_SetupFrustum*
+ * @param[in] mins
+ * @param[in] maxs
+ * @return
+ */
+static qboolean G_FrustumTouchesBox(const vec3_t mins, const vec3_t maxs)
+{
+	vec3_t corner;
+	int    i, j;
+
+	for (i = 0; i < 4; i++)
+	{
+		// the corner furthest inside the plane
+		for (j = 0; j < 3; j++)
+		{
+			corner[j] = frustum[i].normal[j] >= 0 ? maxs[j] : mins[j];
+		}
+
+		if (DotProduct(corner, frustum[i].normal) - frustum[i].dist < 0)
+		{
+			return qfalse;
+		}
+	}
+
+	return qtrue;
+}
+
+/**
+ * @brief Lets a covert ops looking through binoculars spot an enemy landmine
+ * @param[in,out] ent
+ * @param[in,out] mine
+ */
+static void G_SpotLandMine(gentity_t *ent, gentity_t *mine)
+{
+	// as before, we can only detect a mine if we can see it from our binoculars
+	if (!G_VisibleFromBinoculars(ent, mine, mine->r.currentOrigin))
+	{
+		// if we can't see the mine from our binoculars, make sure we clear out the landmineSpotted ptr,
+		// because bots looking for mines are getting confused
+		ent->client->landmineSpotted = NULL;
+		return;
+	}
+
+	G_UpdateTeamMapData_LandMine(mine);
+
+	if (mine->s.modelindex2)
+	{
+		return;
+	}
+
+	ent->client->landmineSpottedTime = level.time;
+	ent->client->landmineSpotted     = mine;
+	mine->s.density                  = ent - g_entities + 1;
+	mine->missionLevel               = level.time;
+
+	mine->count2 += 50; // @sv_fps
+	if (mine->count2 >= 250)
+	{
+		mine->count2 = 250;
+
+		mine->s.modelindex2 = 1;
+
+		// for marker
+		// Landmine flags shouldn't block our view
+		// don't do this if the mine has been triggered.
+		if (!G_LandmineTriggered(mine))
+		{
+			mine->s.frame    = rand() % 20;
+			mine->r.contents = CONTENTS_TRANSLUCENT;
+			trap_LinkEntity(mine);
+		}
+
+		G_PopupMessageForMines(ent);
+
+		trap_SendServerCommand(ent - g_entities, "cp \"Landmine Revealed\n\"");
+
+		AddScore(ent, 1);
+
+		G_AddSkillPoints(ent, SK_MILITARY_INTELLIGENCE_AND_SCOPED_WEAPONS, 3.f);
+		G_DebugAddSkillPoints(ent, SK_MILITARY_INTELLIGENCE_AND_SCOPED_WEAPONS, 3.f, "spotting a landmine");
+	}
+}
+
 void G_CheckSpottedLandMines(void)
 {
-	int       i, j;
-	gentity_t *ent, *ent2;
+	int            i, j;
+	gentity_t      *ent, *mine;
+	mineGrid_t     *grid;
+	mineGridCell_t *cell;
+	qboolean       gridsBuilt = qfalse;
 
 	if (level.time - level.lastMapSpottedMinesUpdate < 500)
 	{
@@ -1047,82 +1225,36 @@ void G_CheckSpottedLandMines(void)
 			continue;
 		}
 
-		if (ent->client->sess.playerType == PC_COVERTOPS && (ent->client->ps.eFlags & EF_ZOOMING))
+		if (ent->client->sess.playerType != PC_COVERTOPS || !(ent->client->ps.eFlags & EF_ZOOMING))
 		{
-			G_SetupFrustum_ForBinoculars(ent);
+			continue;
+		}
 
-			for (j = 0, ent2 = g_entities; j < level.num_entities; j++, ent2++)
-			{
-				if (!ent2->inuse || ent2 == ent)
-				{
-					continue;
-				}
+		if (!gridsBuilt)
+		{
+			G_BuildMineGrids();
+			gridsBuilt = qtrue;
+		}
 
-				if (ent2->s.eType != ET_MISSILE)
-				{
-					continue;
-				}
+		G_SetupFrustum_ForBinoculars(ent);
 
-				if (ent2->methodOfDeath == MOD_LANDMINE)
-				{
-					if ((ent2->s.teamNum < 4 || ent2->s.teamNum >= 8) && (ent2->s.teamNum % 4 != ent->client->sess.sessionTeam))
-					{
-						// as before, we can only detect a mine if we can see it from our binoculars
-						if (G_VisibleFromBinoculars(ent, ent2, ent2->r.currentOrigin))
-						{
-							G_UpdateTeamMapData_LandMine(ent2);
-
-							switch (ent2->s.teamNum % 4)
-							{
-							case TEAM_AXIS:
-							case TEAM_ALLIES:
-								if (!ent2->s.modelindex2)
-								{
-									ent->client->landmineSpottedTime = level.time;
-									ent->client->landmineSpotted     = ent2;
-									ent2->s.density                  = ent - g_entities + 1;
-									ent2->missionLevel               = level.time;
-
-									ent->client->landmineSpotted->count2 += 50; // @sv_fps
-									if (ent->client->landmineSpotted->count2 >= 250)
-									{
-										ent->client->landmineSpotted->count2 = 250;
-
-										ent->client->landmineSpotted->s.modelindex2 = 1;
-
-										// for marker
-										// Landmine flags shouldn't block our view
-										// don't do this if the mine has been triggered.
-										if (!G_LandmineTriggered(ent->client->landmineSpotted))
-										{
-											ent->client->landmineSpotted->s.frame    = rand() % 20;
-											ent->client->landmineSpotted->r.contents = CONTENTS_TRANSLUCENT;
-											trap_LinkEntity(ent->client->landmineSpotted);
-										}
-
-										G_PopupMessageForMines(ent);
-
-										trap_SendServerCommand(ent - g_entities, "cp \"Landmine Revealed\n\"");
-
-										AddScore(ent, 1);
-
-										G_AddSkillPoints(ent, SK_MILITARY_INTELLIGENCE_AND_SCOPED_WEAPONS, 3.f);
-										G_DebugAddSkillPoints(ent, SK_MILITARY_INTELLIGENCE_AND_SCOPED_WEAPONS, 3.f, "spotting a landmine");
-									}
-								}
-								break;
-							default:
-								break;
-							}
-						}
-						else
-						{
-							// if we can't see the mine from our binoculars, make sure we clear out the landmineSpotted ptr,
-							// because bots looking for mines are getting confused
-							ent->client->landmineSpotted = NULL;
-						}
-					}
-				}
+		// enemy mines only
+		grid = &mineGrids[ent->client->sess.sessionTeam == TEAM_AXIS ? 1 : 0];
+
+		for (j = 0; j < grid->numCells; j++)
+		{
+			cell = &grid->cells[j];
+
+			if (!G_FrustumTouchesBox(cell->mins, cell->maxs))
+			{
+				// none of these can be seen
+				ent->client->landmineSpotted = NULL;
+				continue;
+			}
+
+			for (mine = cell->mines; mine; mine = mineGridNext[mine - g_entities])
+			{
+				G_SpotLandMine(ent, mine);
 			}
 		}
 	}
@@ -0,0 +1,338 @@
+/*
+ * Wolfenstein: Enemy Territory GPL Source Code
+ * Copyright (C) 1999-2010 id Software LLC, a ZeniMax Media company.
+ *
+ * ET: Legacy
+ * Copyright (C) 2012 Jan Simek <mail@etlegacy.com>
+ *
+ * This file is part of ET: Legacy - http://www.etlegacy.com
+ *
+ * ET: Legacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ET: Legacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ET: Legacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * In addition, Wolfenstein: Enemy Territory GPL Source Code is also
+ * subject to certain additional terms. You should have received a copy
+ * of these additional terms immediately following the terms and conditions
+ * of the GNU General Public License which accompanied the source code.
+ * If not, please request a copy in writing from id Software at the address below.
+ *
+ * id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+ */
+/**
+ * @file g_think.c
+ * @brief Think scheduling for idle entities
+ *
+ * Entities which only wait for their next think are taken out of
+ * level.activeEntities and parked in a hierarchical timer wheel, so
+ * G_RunFrame doesn't visit them until their think is due. Anything that
+ * changes a parked entity from the outside has to wake it up again,
+ * which G_SetNextThink, G_AddEvent and G_SetOrigin do.
+ */
+
+#include "g_local.h"
+
+// wheel ranges are 64 msec, 4 sec, 4.4 min and 4.6 hours, larger jumps just wake everybody
+#define THINKWHEEL_MAX_STEP (1 << (THINKWHEEL_BITS * 2))
+
+/**
+ * @brief Checks if G_RunEntity would do nothing for this entity but wait for its think
+ * @param[in] ent
+ * @return
+ */
+static qboolean G_EntityIsIdle(gentity_t *ent)
+{
+	if (level.match_pause != PAUSE_NONE)
+	{
+		return qfalse;
+	}
+
+	if (ent - g_entities < MAX_CLIENTS || !ent->inuse || ent->neverFree)
+	{
+		return qfalse;
+	}
+
+	// scripts, tags and path links are evaluated every frame
+	if (ent->scriptEvents || ent->tagParent || (ent->s.eFlags & EF_PATH_LINK))
+	{
+		return qfalse;
+	}
+
+	switch (ent->s.eType)
+	{
+	case ET_MISSILE:
+	case ET_FLAMEBARREL:
+	case ET_FP_PARTS:
+	case ET_FIRE_COLUMN:
+	case ET_FIRE_COLUMN_SMOKE:
+	case ET_EXPLO_PART:
+	case ET_RAMJET:
+	case ET_FLAMETHROWER_CHUNK:
+	case ET_ITEM:
+	case ET_MOVER:
+	case ET_PROP:
+	case ET_PORTAL:
+	case ET_HEALER:
+	case ET_SUPPLIER:
+	case ET_CONSTRUCTIBLE:
+		return qfalse;
+	default:
+		break;
+	}
+
+	if (ent->physicsObject || ent->entstate != STATE_DEFAULT)
+	{
+		return qfalse;
+	}
+
+	// pending events are cleared by G_RunEntity
+	if (ent->s.event || ent->freeAfterEvent || ent->unlinkAfterEvent || level.time - ent->eventTime <= EVENT_VALID_MSEC)
+	{
+		return qfalse;
+	}
+
+	if (!(ent->flags & FL_NODRAW) != !(ent->s.eFlags & EF_NODRAW))
+	{
+		return qfalse;
+	}
+
+	if (!VectorCompare(ent->r.currentOrigin, ent->oldOrigin) || !VectorCompare(ent->instantVelocity, vec3_origin))
+	{
+		return qfalse;
+	}
+
+	return qtrue;
+}
+
+/**
+ * @brief Links a sleeping entity into the wheel slot of its nextthink
+ * @param[in,out] ent
+ */
+static void G_ThinkWheelLink(gentity_t *ent)
+{
+	thinkWheel_t *wheel = &level.thinkWheel;
+	gentity_t    **head = &wheel->overflow;
+	int          i;
+
+	if (ent->sleepThinkTime <= 0)
+	{
+		head = &wheel->idle;
+	}
+	else
+	{
+		// pick the innermost level that shares all higher bits with the wheel time
+		for (i = 0; i < THINKWHEEL_LEVELS; i++)
+		{
+			if (((unsigned)(ent->sleepThinkTime ^ wheel->time) >> (THINKWHEEL_BITS * (i + 1))) == 0)
+			{
+				head = &wheel->slots[i][(ent->sleepThinkTime >> (THINKWHEEL_BITS * i)) & THINKWHEEL_MASK];
+				break;
+			}
+		}
+	}
+
+	ent->sleepNext = *head;
+	if (ent->sleepNext)
+	{
+		ent->sleepNext->sleepLink = &ent->sleepNext;
+	}
+	ent->sleepLink = head;
+	*head          = ent;
+}
+
+/**
+ * @brief Removes an entity from the think wheel without waking it
+ * @param[in,out] ent
+ */
+void G_ThinkWheelUnlink(gentity_t *ent)
+{
+	if (!ent->asleep)
+	{
+		return;
+	}
+
+	*ent->sleepLink = ent->sleepNext;
+	if (ent->sleepNext)
+	{
+		ent->sleepNext->sleepLink = ent->sleepLink;
+	}
+	ent->sleepNext = NULL;
+	ent->sleepLink = NULL;
+	ent->asleep    = qfalse;
+}
+
+/**
+ * @brief Puts a sleeping entity back into level.activeEntities
+ * @param[in,out] ent
+ */
+void G_WakeEntity(gentity_t *ent)
+{
+	if (!ent->asleep)
+	{
+		return;
+	}
+
+	G_ThinkWheelUnlink(ent);
+
+	// not in the runthisframe reset of G_RunFrame while asleep
+	ent->runthisframe = qfalse;
+	G_LinkActiveEntity(ent);
+}
+
+/**
+ * @brief Sets the next think time of an entity, waking it up if needed
+ * @param[in,out] ent
+ * @param[in] time
+ *
+ * @note Use this instead of writing ent->nextthink, a sleeping entity
+ * won't notice the change otherwise.
+ */
+void G_SetNextThink(gentity_t *ent, int time)
+{
+	ent->nextthink = time;
+	G_WakeEntity(ent);
+}
+
+/**
+ * @brief Parks an entity in the think wheel if it has nothing to do until its next think
+ * @param[in,out] ent
+ *
+ * @note Called by G_RunEntity after the entity did think.
+ */
+void G_EntitySleep(gentity_t *ent)
+{
+	int msec = level.time - level.previousTime;
+
+	if (ent->asleep || !G_EntityIsIdle(ent))
+	{
+		return;
+	}
+
+	// don't bother for entities thinking every frame or so
+	if (ent->nextthink > 0 && ent->nextthink - level.time <= 2 * msec)
+	{
+		return;
+	}
+
+	G_UnlinkActiveEntity(ent);
+
+	ent->asleep         = qtrue;
+	ent->sleepThinkTime = ent->nextthink;
+	G_ThinkWheelLink(ent);
+}
+
+/**
+ * @brief Wakes every entity in a wheel list
+ * @param[in,out] head
+ */
+static void G_ThinkWheelWakeList(gentity_t **head)
+{
+	while (*head)
+	{
+		G_WakeEntity(*head);
+	}
+}
+
+/**
+ * @brief Moves the entities of an outer wheel slot one level in
+ * @param[in,out] head
+ */
+static void G_ThinkWheelCascade(gentity_t **head)
+{
+	gentity_t *ent = *head;
+	gentity_t *next;
+
+	*head = NULL;
+
+	for ( ; ent; ent = next)
+	{
+		next = ent->sleepNext;
+		G_ThinkWheelLink(ent);
+	}
+}
+
+/**
+ * @brief Wakes all sleeping entities whose think is due at level.time
+ *
+ * @note Called by G_RunFrame before entities are run.
+ */
+void G_RunThinkWheel(void)
+{
+	thinkWheel_t *wheel = &level.thinkWheel;
+	int          i, j;
+
+	// a paused match pushes nextthink every frame, let G_RunThink handle it
+	if (level.match_pause != PAUSE_NONE || level.time - wheel->time > THINKWHEEL_MAX_STEP || level.time < wheel->time)
+	{
+		for (i = 0; i < THINKWHEEL_LEVELS; i++)
+		{
+			for (j = 0; j < THINKWHEEL_SLOTS; j++)
+			{
+				G_ThinkWheelWakeList(&wheel->slots[i][j]);
+			}
+		}
+		G_ThinkWheelWakeList(&wheel->overflow);
+		G_ThinkWheelWakeList(&wheel->idle);
+
+		wheel->time = level.time;
+		return;
+	}
+
+	while (wheel->time < level.time)
+	{
+		wheel->time++;
+
+		if (!(wheel->time & THINKWHEEL_MASK))
+		{
+			if (!(wheel->time & ((1 << (THINKWHEEL_BITS * THINKWHEEL_LEVELS)) - 1)))
+			{
+				G_ThinkWheelCascade(&wheel->overflow);
+			}
+
+			// outer levels first, so entities can drop down more than one level
+			for (i = THINKWHEEL_LEVELS - 1; i > 0; i--)
+			{
+				if (!(wheel->time & ((1 << (THINKWHEEL_BITS * i)) - 1)))
+				{
+					G_ThinkWheelCascade(&wheel->slots[i][(wheel->time >> (THINKWHEEL_BITS * i)) & THINKWHEEL_MASK]);
+				}
+			}
+		}
+
+		G_ThinkWheelWakeList(&wheel->slots[0][wheel->time & THINKWHEEL_MASK]);
+	}
+}
+
+#ifdef LEGACY_DEBUG
+/**
+ * @brief Wakes sleeping entities which were changed without going through G_SetNextThink and friends
+ */
+void G_ValidateSleepingEntities(void)
+{
+	gentity_t *ent = &g_entities[MAX_CLIENTS];
+	int       i;
+
+	for (i = MAX_CLIENTS; i < level.num_entities; i++, ent++)
+	{
+		if (!ent->asleep)
+		{
+			continue;
+		}
+
+		if (ent->nextthink != ent->sleepThinkTime || !G_EntityIsIdle(ent))
+		{
+			G_Printf(S_COLOR_YELLOW "WARNING G_ValidateSleepingEntities: entity %i (%s) was changed while asleep\n", i, ent->classname);
+			G_WakeEntity(ent);
+		}
+	}
+}
+#endif
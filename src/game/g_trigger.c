@@ -58,7 +58,7 @@ void InitTrigger(gentity_t *self)
 // the wait time has passed, so set back up for another activation
 void multi_wait(gentity_t *ent)
 {
-	ent->nextthink = 0;
+	G_SetNextThink(ent, 0);
 }
 
 // the trigger was just activated
@@ -104,16 +104,16 @@ void multi_trigger(gentity_t *ent, gentity_t *activator)
 
 	if (ent->wait > 0)
 	{
-		ent->think     = multi_wait;
-		ent->nextthink = level.time + (ent->wait + ent->random * crandom()) * 1000;
+		ent->think = multi_wait;
+		G_SetNextThink(ent, level.time + (ent->wait + ent->random * crandom()) * 1000);
 	}
 	else
 	{
 		// we can't just remove (self) here, because this is a touch function
 		// called while looping through area links...
-		ent->touch     = 0;
-		ent->nextthink = level.time + FRAMETIME;
-		ent->think     = G_FreeEntity;
+		ent->touch = 0;
+		G_SetNextThink(ent, level.time + FRAMETIME);
+		ent->think = G_FreeEntity;
 	}
 }
 
@@ -273,8 +273,8 @@ This trigger will always fire.  It is activated by the world.
 void SP_trigger_always(gentity_t *ent)
 {
 	// we must have some delay to make sure our use targets are present
-	ent->nextthink = level.time + 300;
-	ent->think     = trigger_always_think;
+	G_SetNextThink(ent, level.time + 300);
+	ent->think = trigger_always_think;
 }
 
 /*
@@ -390,8 +390,8 @@ void SP_target_push(gentity_t *self)
 	{
 		VectorCopy(self->s.origin, self->r.absmin);
 		VectorCopy(self->s.origin, self->r.absmax);
-		self->think     = AimAtTarget;
-		self->nextthink = level.time + FRAMETIME;
+		self->think = AimAtTarget;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 	self->use = Use_target_push;
 }
@@ -516,7 +516,7 @@ void hurt_touch(gentity_t *self, gentity_t *other, trace_t *trace)
 
 void hurt_think(gentity_t *ent)
 {
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	if (ent->wait < level.time)
 	{
@@ -537,9 +537,9 @@ void hurt_use(gentity_t *self, gentity_t *other, gentity_t *activator)
 
 	if (self->delay)
 	{
-		self->nextthink = level.time + 50;
-		self->think     = hurt_think;
-		self->wait      = level.time + (self->delay * 1000);
+		G_SetNextThink(self, level.time + 50);
+		self->think = hurt_think;
+		self->wait  = level.time + (self->delay * 1000);
 	}
 }
 
@@ -694,8 +694,8 @@ void heal_touch(gentity_t *self, gentity_t *other, trace_t *trace)
 #define HEALTH_REGENTIME 10000
 void trigger_heal_think(gentity_t *self)
 {
-	self->nextthink = level.time + HEALTH_REGENTIME;
-	self->health   += self->damage;
+	G_SetNextThink(self, level.time + HEALTH_REGENTIME);
+	self->health += self->damage;
 
 	if (self->health > self->count)
 	{
@@ -714,8 +714,8 @@ void trigger_heal_setup(gentity_t *self)
 
 	if (TRIGGER_HEAL_CANTHINK(self))
 	{
-		self->think     = trigger_heal_think;
-		self->nextthink = level.time + FRAMETIME;
+		self->think = trigger_heal_think;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 }
 
@@ -773,13 +773,13 @@ void SP_trigger_heal(gentity_t *self)
 	self->target_ent = NULL;
 	if (self->target && *self->target)
 	{
-		self->think     = trigger_heal_setup;
-		self->nextthink = level.time + FRAMETIME;
+		self->think = trigger_heal_setup;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 	else if (TRIGGER_HEAL_CANTHINK(self))
 	{
-		self->think     = trigger_heal_think;
-		self->nextthink = level.time + HEALTH_REGENTIME;
+		self->think = trigger_heal_think;
+		G_SetNextThink(self, level.time + HEALTH_REGENTIME);
 	}
 
 	// healrate specifies the amount of healing per second
@@ -890,8 +890,8 @@ void ammo_touch(gentity_t *self, gentity_t *other, trace_t *trace)
 #define AMMO_REGENTIME 60000
 void trigger_ammo_think(gentity_t *self)
 {
-	self->nextthink = level.time + AMMO_REGENTIME;
-	self->health   += self->damage;
+	G_SetNextThink(self, level.time + AMMO_REGENTIME);
+	self->health += self->damage;
 
 	if (self->health > self->count)
 	{
@@ -910,8 +910,8 @@ void trigger_ammo_setup(gentity_t *self)
 
 	if (TRIGGER_AMMO_CANTHINK(self))
 	{
-		self->think     = trigger_ammo_think;
-		self->nextthink = level.time + FRAMETIME;
+		self->think = trigger_ammo_think;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 }
 
@@ -968,13 +968,13 @@ void SP_trigger_ammo(gentity_t *self)
 	self->target_ent = NULL;
 	if (self->target && *self->target)
 	{
-		self->think     = trigger_ammo_setup;
-		self->nextthink = level.time + FRAMETIME;
+		self->think = trigger_ammo_setup;
+		G_SetNextThink(self, level.time + FRAMETIME);
 	}
 	else if (TRIGGER_AMMO_CANTHINK(self))
 	{
-		self->think     = trigger_ammo_think;
-		self->nextthink = level.time + AMMO_REGENTIME;
+		self->think = trigger_ammo_think;
+		G_SetNextThink(self, level.time + AMMO_REGENTIME);
 	}
 
 	// ammorate specifies the amount of ammo added per second
@@ -1006,7 +1006,7 @@ void func_timer_think(gentity_t *self)
 {
 	G_UseTargets(self, self->activator);
 	// set time before next firing
-	self->nextthink = level.time + 1000 * (self->wait + crandom() * self->random);
+	G_SetNextThink(self, level.time + 1000 * (self->wait + crandom() * self->random));
 }
 
 void func_timer_use(gentity_t *self, gentity_t *other, gentity_t *activator)
@@ -1016,7 +1016,7 @@ void func_timer_use(gentity_t *self, gentity_t *other, gentity_t *activator)
 	// if on, turn it off
 	if (self->nextthink)
 	{
-		self->nextthink = 0;
+		G_SetNextThink(self, 0);
 		return;
 	}
 
@@ -1040,7 +1040,7 @@ void SP_func_timer(gentity_t *self)
 
 	if (self->spawnflags & 1)
 	{
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink(self, level.time + FRAMETIME);
 		self->activator = self;
 	}
 
@@ -1107,9 +1107,9 @@ void Touch_flagonly(gentity_t *ent, gentity_t *other, trace_t *trace)
 		ent->parent = tmp;
 
 		// Removes itself
-		ent->touch     = NULL;
-		ent->nextthink = level.time + FRAMETIME;
-		ent->think     = G_FreeEntity;
+		ent->touch = NULL;
+		G_SetNextThink(ent, level.time + FRAMETIME);
+		ent->think = G_FreeEntity;
 	}
 	else if ((ent->spawnflags & BLUE_FLAG) && other->client->ps.powerups[PW_BLUEFLAG])
 	{
@@ -1135,9 +1135,9 @@ void Touch_flagonly(gentity_t *ent, gentity_t *other, trace_t *trace)
 		ent->parent = tmp;
 
 		// Removes itself
-		ent->touch     = NULL;
-		ent->nextthink = level.time + FRAMETIME;
-		ent->think     = G_FreeEntity;
+		ent->touch = NULL;
+		G_SetNextThink(ent, level.time + FRAMETIME);
+		ent->think = G_FreeEntity;
 	}
 }
 
@@ -1280,7 +1280,7 @@ void explosive_indicator_think(gentity_t *ent)
 	{
 		VectorCopy(ent->parent->r.currentOrigin, ent->s.pos.trBase);
 	}
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	if (parent->s.eType == ET_OID_TRIGGER && parent->target_ent)
 	{
@@ -1345,7 +1345,7 @@ void constructible_indicator_think(gentity_t *ent)
 		VectorCopy(ent->parent->r.currentOrigin, ent->s.pos.trBase);
 	}
 	ent->s.effect1Time = parent->constructibleStats.weaponclass;
-	ent->nextthink     = level.time + FRAMETIME;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 }
 
 void G_SetConfigStringValue(int num, const char *key, const char *value)
@@ -1412,7 +1412,7 @@ void Think_SetupObjectiveInfo(gentity_t *ent)
 			e->s.modelindex2 = ent->s.teamNum;
 			e->r.ownerNum    = ent->s.number;
 			e->think         = explosive_indicator_think;
-			e->nextthink     = level.time + FRAMETIME;
+			G_SetNextThink(e, level.time + FRAMETIME);
 
 			e->s.effect1Time = ent->target_ent->constructibleStats.weaponclass;
 
@@ -1519,7 +1519,7 @@ void Think_SetupObjectiveInfo(gentity_t *ent)
 			e->r.ownerNum    = ent->s.number;
 			ent->count2      = (e - g_entities);
 			e->think         = constructible_indicator_think;
-			e->nextthink     = level.time + FRAMETIME;
+			G_SetNextThink(e, level.time + FRAMETIME);
 
 			e->parent = ent;
 
@@ -1673,8 +1673,8 @@ void SP_trigger_objective_info(gentity_t *ent)
 	else
 	{
 		// finalize spawing on fourth frame to allow for proper linking with targets
-		ent->nextthink = level.time + (3 * FRAMETIME);
-		ent->think     = Think_SetupObjectiveInfo;
+		G_SetNextThink(ent, level.time + (3 * FRAMETIME));
+		ent->think = Think_SetupObjectiveInfo;
 	}
 }
 
@@ -678,6 +678,142 @@ void G_SetMovedir(vec3_t angles, vec3_t movedir)
 	VectorClear(angles);
 }
 
+/**
+ * @brief Links a non-client entity into level.activeEntities
+ *
+ * The list is kept sorted by entity number so G_RunFrame still runs entities
+ * in the same order as a plain index walk over g_entities did.
+ */
+void G_LinkActiveEntity(gentity_t *e)
+{
+	gentity_t *prev;
+
+	if (e->activePrev || level.activeEntities == e)
+	{
+		return;
+	}
+
+	// find the closest linked entity below us, slots are mostly dense
+	for (prev = e - 1; prev >= &g_entities[MAX_CLIENTS]; prev--)
+	{
+		if (prev->activePrev || level.activeEntities == prev)
+		{
+			break;
+		}
+	}
+
+	if (prev < &g_entities[MAX_CLIENTS])
+	{
+		e->activePrev        = NULL;
+		e->activeNext        = level.activeEntities;
+		level.activeEntities = e;
+	}
+	else
+	{
+		e->activePrev    = prev;
+		e->activeNext    = prev->activeNext;
+		prev->activeNext = e;
+	}
+
+	if (e->activeNext)
+	{
+		e->activeNext->activePrev = e;
+	}
+
+	// spawned ahead of the G_RunFrame walk, run it this frame like before
+	if (level.activeIterCur && e > level.activeIterCur && (!level.activeIterNext || e < level.activeIterNext))
+	{
+		level.activeIterNext = e;
+	}
+}
+
+/**
+ * @brief Removes an entity from level.activeEntities
+ */
+void G_UnlinkActiveEntity(gentity_t *e)
+{
+	if (!e->activePrev && level.activeEntities != e)
+	{
+		return;
+	}
+
+	if (level.activeIterNext == e)
+	{
+		level.activeIterNext = e->activeNext;
+	}
+
+	if (e->activePrev)
+	{
+		e->activePrev->activeNext = e->activeNext;
+	}
+	else
+	{
+		level.activeEntities = e->activeNext;
+	}
+	if (e->activeNext)
+	{
+		e->activeNext->activePrev = e->activePrev;
+	}
+	e->activeNext = NULL;
+	e->activePrev = NULL;
+}
+
+/**
+ * @brief Removes an entity from its level.entityGroups list
+ */
+static void G_RemoveEntityFromGroup(gentity_t *e)
+{
+	if (e->entityGroup == ENTGROUP_NONE)
+	{
+		return;
+	}
+
+	if (e->groupPrev)
+	{
+		e->groupPrev->groupNext = e->groupNext;
+	}
+	else
+	{
+		level.entityGroups[e->entityGroup] = e->groupNext;
+	}
+	if (e->groupNext)
+	{
+		e->groupNext->groupPrev = e->groupPrev;
+	}
+	e->groupNext   = NULL;
+	e->groupPrev   = NULL;
+	e->entityGroup = ENTGROUP_NONE;
+}
+
+/**
+ * @brief Puts an in-use entity into one of the level.entityGroups lists
+ * @param[in,out] ent
+ * @param[in] group
+ *
+ * @note The entity leaves the group again when it is freed.
+ */
+void G_AddEntityToGroup(gentity_t *ent, entityGroup_t group)
+{
+	if (ent->entityGroup == group)
+	{
+		return;
+	}
+
+	if (ent->entityGroup != ENTGROUP_NONE)
+	{
+		G_Error("G_AddEntityToGroup: entity %i is already in group %i\n", (int)(ent - g_entities), ent->entityGroup);
+	}
+
+	ent->entityGroup = group;
+	ent->groupPrev   = NULL;
+	ent->groupNext   = level.entityGroups[group];
+	if (ent->groupNext)
+	{
+		ent->groupNext->groupPrev = ent;
+	}
+	level.entityGroups[group] = ent;
+}
+
 void G_InitGentity(gentity_t *e)
 {
 	e->inuse      = qtrue;
@@ -693,6 +829,11 @@ void G_InitGentity(gentity_t *e)
 	// mark the time
 	e->spawnTime = level.time;
 
+	if (e - g_entities >= MAX_CLIENTS)
+	{
+		G_LinkActiveEntity(e);
+	}
+
 #ifdef FEATURE_OMNIBOT
 	// Notify omni-bot
 	Bot_Queue_EntityCreated(e);
@@ -812,6 +953,10 @@ void G_FreeEntity(gentity_t *ed)
 		return;
 	}
 
+	G_ThinkWheelUnlink(ed);
+	G_UnlinkActiveEntity(ed);
+	G_RemoveEntityFromGroup(ed);
+
 	// this tiny hack fixes level.num_entities rapidly reaching MAX_GENTITIES-1
 	// some very often spawned entities don't have to relax (=spawned, immediately freed and not transmitted)
 	// before all game entities did relax - now  ET_TEMPHEAD, ET_TEMPLEGS and ET_EVENTS no longer relax
@@ -969,6 +1114,9 @@ void G_AddEvent(gentity_t *ent, int event, int eventParm)
 	}
 	ent->eventTime   = level.time;
 	ent->r.eventTime = level.time;
+
+	// event has to be cleared by G_RunEntity
+	G_WakeEntity(ent);
 }
 
 /**
@@ -1016,6 +1164,63 @@ void G_AnimScriptSound(int soundIndex, vec3_t org, int client)
 	G_AddEvent(e, EV_GENERAL_SOUND, soundIndex);
 }
 
+/**
+ * @brief Runs a batch of traces in a single syscall
+ * @param[in,out] batch
+ * @param[in] count
+ * @return number of rays which passed the PVS check and were traced
+ *
+ * @note Servers without SYSCALL_EXT_TRACEBATCH don't know G_TRACEBATCH, the rays are
+ * traced one by one there.
+ */
+int G_TraceBatch(traceBatch_t *batch, int count)
+{
+	traceBatch_t *tb;
+	int          i, traced = 0;
+
+	if (level.syscallExtensions & SYSCALL_EXT_TRACEBATCH)
+	{
+		return trap_TraceBatch(batch, count);
+	}
+
+	for (i = 0, tb = batch; i < count; i++, tb++)
+	{
+		if ((tb->flags & TRACEBATCH_PVS) && !trap_InPVS(tb->start, tb->end))
+		{
+			memset(&tb->trace, 0, sizeof(tb->trace));
+			tb->trace.entityNum = ENTITYNUM_NONE;
+			VectorCopy(tb->start, tb->trace.endpos);
+			tb->inPVS = qfalse;
+			continue;
+		}
+
+		tb->inPVS = qtrue;
+
+		if (tb->flags & TRACEBATCH_CAPSULE)
+		{
+			if (tb->flags & TRACEBATCH_NOENTS)
+			{
+				trap_TraceCapsuleNoEnts(&tb->trace, tb->start, tb->mins, tb->maxs, tb->end, tb->passEntityNum, tb->contentmask);
+			}
+			else
+			{
+				trap_TraceCapsule(&tb->trace, tb->start, tb->mins, tb->maxs, tb->end, tb->passEntityNum, tb->contentmask);
+			}
+		}
+		else if (tb->flags & TRACEBATCH_NOENTS)
+		{
+			trap_TraceNoEnts(&tb->trace, tb->start, tb->mins, tb->maxs, tb->end, tb->passEntityNum, tb->contentmask);
+		}
+		else
+		{
+			trap_Trace(&tb->trace, tb->start, tb->mins, tb->maxs, tb->end, tb->passEntityNum, tb->contentmask);
+		}
+		traced++;
+	}
+
+	return traced;
+}
+
 //==============================================================================
 
 /**
@@ -1023,6 +1228,8 @@ void G_AnimScriptSound(int soundIndex, vec3_t org, int client)
  */
 void G_SetOrigin(gentity_t *ent, vec3_t origin)
 {
+	G_WakeEntity(ent);
+
 	VectorCopy(origin, ent->s.pos.trBase);
 	ent->s.pos.trType     = TR_STATIONARY;
 	ent->s.pos.trTime     = 0;
@@ -151,8 +151,8 @@ void MagicSink(gentity_t *self)
 	self->clipmask   = 0;
 	self->r.contents = 0;
 
-	self->nextthink = level.time + 4000;
-	self->think     = G_FreeEntity;
+	G_SetNextThink(self, level.time + 4000);
+	self->think = G_FreeEntity;
 
 	self->s.pos.trType = TR_LINEAR;
 	self->s.pos.trTime = level.time;
@@ -235,9 +235,9 @@ void Weapon_Medic_Ext(gentity_t *ent, vec3_t viewpos, vec3_t tosspos, vec3_t vel
 		SnapVectorTowards(tosspos, viewpos);
 	}
 
-	ent2            = LaunchItem(BG_GetItem(ITEM_HEALTH), tosspos, velocity, ent->s.number);
-	ent2->think     = MagicSink;
-	ent2->nextthink = level.time + 30000;
+	ent2        = LaunchItem(BG_GetItem(ITEM_HEALTH), tosspos, velocity, ent->s.number);
+	ent2->think = MagicSink;
+	G_SetNextThink(ent2, level.time + 30000);
 
 	ent2->parent = ent; // so we can score properly later
 
@@ -321,9 +321,9 @@ void Weapon_MagicAmmo_Ext(gentity_t *ent, vec3_t viewpos, vec3_t tosspos, vec3_t
 		SnapVectorTowards(tosspos, viewpos);
 	}
 
-	ent2            = LaunchItem(BG_GetItem(ent->client->sess.skill[SK_SIGNALS] >= 1 ? ITEM_MEGA_AMMO_PACK : ITEM_AMMO_PACK), tosspos, velocity, ent->s.number);
-	ent2->think     = MagicSink;
-	ent2->nextthink = level.time + 30000;
+	ent2        = LaunchItem(BG_GetItem(ent->client->sess.skill[SK_SIGNALS] >= 1 ? ITEM_MEGA_AMMO_PACK : ITEM_AMMO_PACK), tosspos, velocity, ent->s.number);
+	ent2->think = MagicSink;
+	G_SetNextThink(ent2, level.time + 30000);
 
 	ent2->parent = ent;
 
@@ -1066,8 +1066,8 @@ static qboolean TryConstructing(gentity_t *ent)
 			}
 
 			// setup our think function for decaying
-			constructible->think     = func_constructible_underconstructionthink;
-			constructible->nextthink = level.time + FRAMETIME;
+			constructible->think = func_constructible_underconstructionthink;
+			G_SetNextThink(constructible, level.time + FRAMETIME);
 
 			G_PrintClientSpammyCenterPrint(ent - g_entities, "Constructing...");
 		}
@@ -1155,8 +1155,8 @@ static qboolean TryConstructing(gentity_t *ent)
 		}
 
 		// Stop thinking
-		constructible->think     = NULL;
-		constructible->nextthink = 0;
+		constructible->think = NULL;
+		G_SetNextThink(constructible, 0);
 
 		if (!constructible->count2)
 		{
@@ -1249,7 +1249,7 @@ static qboolean TryConstructing(gentity_t *ent)
 				e->s.modelindex2 = ent->client->touchingTOI->s.teamNum;
 				e->r.ownerNum    = constructible->s.number;
 				e->think         = explosive_indicator_think;
-				e->nextthink     = level.time + FRAMETIME;
+				G_SetNextThink(e, level.time + FRAMETIME);
 
 				e->s.effect1Time = constructible->constructibleStats.weaponclass;
 
@@ -1288,6 +1288,7 @@ static qboolean TryConstructing(gentity_t *ent)
 						if (constructible->parent->tagParent)
 						{
 							check->tagParent = constructible->parent->tagParent;
+							G_WakeEntity(check);
 							Q_strncpyz(check->tagName, constructible->parent->tagName, MAX_QPATH);
 						}
 						else
@@ -1375,8 +1376,8 @@ void AutoBuildConstruction(gentity_t *constructible)
 	}
 
 	// Stop thinking
-	constructible->think     = NULL;
-	constructible->nextthink = 0;
+	constructible->think = NULL;
+	G_SetNextThink(constructible, 0);
 
 	if (!constructible->count2)
 	{
@@ -1467,7 +1468,7 @@ void AutoBuildConstruction(gentity_t *constructible)
 			e->s.modelindex2 = constructible->parent->s.teamNum == TEAM_AXIS ? TEAM_ALLIES : TEAM_AXIS;
 			e->r.ownerNum    = constructible->s.number;
 			e->think         = explosive_indicator_think;
-			e->nextthink     = level.time + FRAMETIME;
+			G_SetNextThink(e, level.time + FRAMETIME);
 
 			e->s.effect1Time = constructible->constructibleStats.weaponclass;
 
@@ -1506,6 +1507,7 @@ void AutoBuildConstruction(gentity_t *constructible)
 					if (constructible->parent->tagParent)
 					{
 						check->tagParent = constructible->parent->tagParent;
+						G_WakeEntity(check);
 						Q_strncpyz(check->tagName, constructible->parent->tagName, MAX_QPATH);
 					}
 					else
@@ -1803,8 +1805,8 @@ void Weapon_Engineer(gentity_t *ent)
 					traceEnt->s.teamNum     = ent->client->sess.sessionTeam;
 					traceEnt->s.modelindex2 = 0;
 
-					traceEnt->nextthink = level.time + 2000;
-					traceEnt->think     = G_LandminePrime;
+					G_SetNextThink(traceEnt, level.time + 2000);
+					traceEnt->think = G_LandminePrime;
 				}
 				else
 				{
@@ -1881,9 +1883,9 @@ evilbanigoto:
 
 			if (traceEnt->health >= 250)
 			{
-				traceEnt->health    = 255;
-				traceEnt->think     = G_FreeEntity;
-				traceEnt->nextthink = level.time + FRAMETIME;
+				traceEnt->health = 255;
+				traceEnt->think  = G_FreeEntity;
+				G_SetNextThink(traceEnt, level.time + FRAMETIME);
 
 				// consistency with dynamite defusing
 				G_PrintClientSpammyCenterPrint(ent - g_entities, "Satchel charge disarmed...");
@@ -2043,8 +2045,8 @@ evilbanigoto:
 				traceEnt->s.effect1Time = level.time;
 
 				// ARM IT!
-				traceEnt->nextthink = level.time + 30000;
-				traceEnt->think     = G_ExplodeMissile;
+				G_SetNextThink(traceEnt, level.time + 30000);
+				traceEnt->think = G_ExplodeMissile;
 
 				// moved down here to prevent two prints when dynamite IS near objective
 				trap_SendServerCommand(ent - g_entities, "cp \"Dynamite is now armed with a 30 second timer!\" 1");
@@ -2257,8 +2259,8 @@ evilbanigoto:
 
 					//Add_Ammo( ent, WP_DYNAMITE, 1, qtrue );
 
-					traceEnt->think     = G_FreeEntity;
-					traceEnt->nextthink = level.time + FRAMETIME;
+					traceEnt->think = G_FreeEntity;
+					G_SetNextThink(traceEnt, level.time + FRAMETIME);
 
 					VectorCopy(traceEnt->r.currentOrigin, origin);
 					SnapVector(origin);
@@ -2478,8 +2480,8 @@ void G_AirStrikeExplode(gentity_t *self)
 	self->r.svFlags &= ~SVF_NOCLIENT;
 	self->r.svFlags |= SVF_BROADCAST;
 
-	self->think     = G_ExplodeMissile;
-	self->nextthink = level.time + 50;
+	self->think = G_ExplodeMissile;
+	G_SetNextThink(self, level.time + 50);
 }
 
 qboolean G_AvailableAirstrikes(gentity_t *ent)
@@ -2565,26 +2567,26 @@ void weapon_checkAirStrikeThink1(gentity_t *ent)
 {
 	if (!weapon_checkAirStrike(ent))
 	{
-		ent->think     = G_ExplodeMissile;
-		ent->nextthink = level.time + 1000;
+		ent->think = G_ExplodeMissile;
+		G_SetNextThink(ent, level.time + 1000);
 		return;
 	}
 
-	ent->think     = weapon_callAirStrike;
-	ent->nextthink = level.time + 1500;
+	ent->think = weapon_callAirStrike;
+	G_SetNextThink(ent, level.time + 1500);
 }
 
 void weapon_checkAirStrikeThink2(gentity_t *ent)
 {
 	if (!weapon_checkAirStrike(ent))
 	{
-		ent->think     = G_ExplodeMissile;
-		ent->nextthink = level.time + 1000;
+		ent->think = G_ExplodeMissile;
+		G_SetNextThink(ent, level.time + 1000);
 		return;
 	}
 
-	ent->think     = weapon_callSecondPlane;
-	ent->nextthink = level.time + 500;
+	ent->think = weapon_callSecondPlane;
+	G_SetNextThink(ent, level.time + 500);
 }
 
 void weapon_callSecondPlane(gentity_t *ent)
@@ -2596,8 +2598,8 @@ void weapon_callSecondPlane(gentity_t *ent)
 	te->s.eventParm = GAMESOUND_WPN_AIRSTRIKE_PLANE;
 	te->r.svFlags  |= SVF_BROADCAST;
 
-	ent->nextthink = level.time + 1000;
-	ent->think     = weapon_callAirStrike;
+	G_SetNextThink(ent, level.time + 1000);
+	ent->think = weapon_callAirStrike;
 }
 
 qboolean weapon_checkAirStrike(gentity_t *ent)
@@ -2617,7 +2619,7 @@ qboolean weapon_checkAirStrike(gentity_t *ent)
 	{
 		ent->splashDamage = 0;  // no damage
 		ent->think        = G_ExplodeMissile;
-		ent->nextthink    = level.time + crandom() * 50;
+		G_SetNextThink(ent, level.time + crandom() * 50);
 
 		ent->active = qfalse;
 		if (ent->s.teamNum == TEAM_AXIS)
@@ -2660,8 +2662,8 @@ void weapon_callAirStrike(gentity_t *ent)
 	bomboffset[2] += 4096.f;
 
 	// turn off smoke grenade
-	ent->think     = G_ExplodeMissile;
-	ent->nextthink = level.time + 950 + NUMBOMBS * 100 + crandom() * 50; // 950 offset is for aircraft flyby
+	ent->think = G_ExplodeMissile;
+	G_SetNextThink(ent, level.time + 950 + NUMBOMBS * 100 + crandom() * 50); // 950 offset is for aircraft flyby
 
 	ent->active = qtrue;
 
@@ -2733,8 +2735,8 @@ void weapon_callAirStrike(gentity_t *ent)
 
 		for (i = 0; i < NUMBOMBS; i++)
 		{
-			bomb               = G_Spawn();
-			bomb->nextthink    = level.time + i * 100 + crandom() * 50 + 1000 + (j * 2000);    // 1000 for aircraft flyby, other term for tumble stagger
+			bomb = G_Spawn();
+			G_SetNextThink(bomb, level.time + i * 100 + crandom() * 50 + 1000 + (j * 2000));    // 1000 for aircraft flyby, other term for tumble stagger
 			bomb->think        = G_AirStrikeExplode;
 			bomb->s.eType      = ET_MISSILE;
 			bomb->r.svFlags    = SVF_NOCLIENT;
@@ -2821,8 +2823,8 @@ void artilleryThink_real(gentity_t *ent)
 
 void artilleryThink(gentity_t *ent)
 {
-	ent->think     = artilleryThink_real;
-	ent->nextthink = level.time + 100;
+	ent->think = artilleryThink_real;
+	G_SetNextThink(ent, level.time + 100);
 
 	ent->r.svFlags = SVF_BROADCAST;
 }
@@ -2841,19 +2843,19 @@ void artillerySpotterThink(gentity_t *ent)
 	vec3_t    tmpdir;
 	int       i;
 
-	ent->think     = G_ExplodeMissile;
-	ent->nextthink = level.time + 1;
+	ent->think = G_ExplodeMissile;
+	G_SetNextThink(ent, level.time + 1);
 	SnapVector(ent->s.pos.trBase);
 
 	for (i = 0; i < 7; i++)
 	{
-		bomb                    = G_Spawn();
-		bomb->s.eType           = ET_MISSILE;
-		bomb->r.svFlags         = 0;
-		bomb->r.ownerNum        = ent->s.number;
-		bomb->parent            = ent;
-		bomb->s.teamNum         = ent->s.teamNum;
-		bomb->nextthink         = level.time + 1000 + random() * 300;
+		bomb             = G_Spawn();
+		bomb->s.eType    = ET_MISSILE;
+		bomb->r.svFlags  = 0;
+		bomb->r.ownerNum = ent->s.number;
+		bomb->parent     = ent;
+		bomb->s.teamNum  = ent->s.teamNum;
+		G_SetNextThink(bomb, level.time + 1000 + random() * 300);
 		bomb->classname         = "WP";         // WP == White Phosphorous, so we can check for bounce noise in grenade bounce routine
 		bomb->damage            = 000;          // maybe should un-hard-code these?
 		bomb->splashDamage      = 000;
@@ -2996,7 +2998,7 @@ void Weapon_Artillery(gentity_t *ent)
 
 		if (i == 0)
 		{
-			bomb->nextthink         = level.time + 5000;
+			G_SetNextThink(bomb, level.time + 5000);
 			bomb->r.svFlags         = SVF_BROADCAST;
 			bomb->classname         = "props_explosion"; // was "air strike"
 			bomb->damage            = 0; // maybe should un-hard-code these?
@@ -3011,7 +3013,7 @@ void Weapon_Artillery(gentity_t *ent)
 		}
 		else
 		{
-			bomb->nextthink = level.time + 8950 + 2000 * i + crandom() * 800;
+			G_SetNextThink(bomb, level.time + 8950 + 2000 * i + crandom() * 800);
 
 			// for explosion type
 			bomb->accuracy     = 2;
@@ -3057,15 +3059,15 @@ void Weapon_Artillery(gentity_t *ent)
 		VectorCopy(bomb->s.pos.trBase, bomb->r.currentOrigin);
 
 		// build arty falling sound effect in front of bomb drop
-		bomb2               = G_Spawn();
-		bomb2->think        = artilleryThink;
-		bomb2->s.eType      = ET_MISSILE;
-		bomb2->r.svFlags    = SVF_NOCLIENT;
-		bomb2->r.ownerNum   = ent->s.number;
-		bomb2->parent       = ent;
-		bomb2->s.teamNum    = ent->s.teamNum;
-		bomb2->damage       = 0;
-		bomb2->nextthink    = bomb->nextthink - 600;
+		bomb2             = G_Spawn();
+		bomb2->think      = artilleryThink;
+		bomb2->s.eType    = ET_MISSILE;
+		bomb2->r.svFlags  = SVF_NOCLIENT;
+		bomb2->r.ownerNum = ent->s.number;
+		bomb2->parent     = ent;
+		bomb2->s.teamNum  = ent->s.teamNum;
+		bomb2->damage     = 0;
+		G_SetNextThink(bomb2, bomb->nextthink - 600);
 		bomb2->classname    = "air strike";
 		bomb2->clipmask     = MASK_MISSILESHOT;
 		bomb2->s.pos.trType = TR_STATIONARY; // was TR_GRAVITY,  might wanna go back to this and drop from height
@@ -3120,8 +3122,8 @@ void weapon_smokeBombExplode(gentity_t *ent)
 		ent->grenadeExplodeTime = level.time;
 	}
 
-	lived          = level.time - ent->grenadeExplodeTime;
-	ent->nextthink = level.time + FRAMETIME;
+	lived = level.time - ent->grenadeExplodeTime;
+	G_SetNextThink(ent, level.time + FRAMETIME);
 
 	if (lived < SMOKEBOMB_GROWTIME)
 	{
@@ -3677,15 +3679,15 @@ gentity_t *weapon_grenadelauncher_fire(gentity_t *ent, int grenType)
 		m->s.teamNum = ent->client->sess.sessionTeam;   // store team so we can generate red or blue smoke
 		if (ent->client->sess.skill[SK_SIGNALS] >= 3)
 		{
-			m->count     = 2;
-			m->nextthink = level.time + 3500;
-			m->think     = weapon_checkAirStrikeThink2;
+			m->count = 2;
+			G_SetNextThink(m, level.time + 3500);
+			m->think = weapon_checkAirStrikeThink2;
 		}
 		else
 		{
-			m->count     = 1;
-			m->nextthink = level.time + 2500;
-			m->think     = weapon_checkAirStrikeThink1;
+			m->count = 1;
+			G_SetNextThink(m, level.time + 2500);
+			m->think = weapon_checkAirStrikeThink1;
 		}
 		break;
 	default:
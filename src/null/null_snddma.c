@@ -57,6 +57,25 @@ void SNDDMA_Submit(void)
 {
 }
 
+qboolean SNDDMA_StartMixThread(void)
+{
+	return qfalse;
+}
+
+void SNDDMA_StopMixThread(void)
+{
+}
+
+int SNDDMA_ExchangeMixFrame(int frame)
+{
+	return frame;
+}
+
+int SNDDMA_PeekMixFrame(void)
+{
+	return 0;
+}
+
 // bk001119 - added boolean flag, match client/snd_public.h
 sfxHandle_t S_RegisterSound(const char *name, qboolean compressed)
 {
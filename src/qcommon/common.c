@@ -2925,6 +2925,7 @@ void Com_Init(char *commandLine)
 	Cmd_AddCommand("wget", Com_Download_f);
 
 	com_version = Cvar_Get("version", FAKE_VERSION, CVAR_ROM | CVAR_SERVERINFO);
+	Cvar_Get(SYSCALL_EXTENSIONS_CVAR, va("%i", SYSCALL_EXT_TRACEBATCH | SYSCALL_EXT_CVAR_CHANGES), CVAR_ROM);
 
 	com_motd       = Cvar_Get("com_motd", "1", 0);
 	com_motdString = Cvar_Get("com_motdString", "", CVAR_ROM);
@@ -44,6 +44,21 @@ int    cvar_modifiedFlags;
 cvar_t cvar_indexes[MAX_CVARS];
 int    cvar_numIndexes;
 
+// ring of recently modified cvars, read by the modules through Cvar_Changes
+#define CVAR_CHANGE_LOG     256
+static int cvar_changeLog[CVAR_CHANGE_LOG];
+static int cvar_changeSequence;
+
+
+/**
+ * @brief Notes a modification of a cvar for Cvar_Changes
+ * @param[in] var
+ */
+static void Cvar_LogChange(cvar_t *var)
+{
+	cvar_changeLog[cvar_changeSequence++ & (CVAR_CHANGE_LOG - 1)] = var - cvar_indexes;
+}
+
 #define FILE_HASH_SIZE      512
 static cvar_t *hashTable[FILE_HASH_SIZE];
 #define generateHashValue(fname) Q_GenerateHashValue(fname, FILE_HASH_SIZE, qtrue, qtrue)
@@ -424,6 +439,7 @@ cvar_t *Cvar_Get(const char *var_name, const char *var_value, int flags)
 	var->string            = CopyString(var_value);
 	var->modified          = qtrue;
 	var->modificationCount = 1;
+	Cvar_LogChange(var);
 	var->value             = atof(var->string);
 	var->integer           = atoi(var->string);
 	var->resetString       = CopyString(var_value);
@@ -581,6 +597,7 @@ cvar_t *Cvar_Set2(const char *var_name, const char *value, qboolean force)
 			var->latchedString = CopyString(value);
 			var->modified      = qtrue;
 			var->modificationCount++;
+			Cvar_LogChange(var);
 			return var;
 		}
 
@@ -612,6 +629,7 @@ cvar_t *Cvar_Set2(const char *var_name, const char *value, qboolean force)
 	}
 	var->modified = qtrue;
 	var->modificationCount++;
+	Cvar_LogChange(var);
 
 	Z_Free(var->string);     // free the old value string
 
@@ -1553,6 +1571,34 @@ void Cvar_Update(vmCvar_t *vmCvar)
 	vmCvar->integer = cv->integer;
 }
 
+/*
+=====================
+Cvar_Changes
+
+Gives the interpreted modules the handles of the cvars modified since
+*sequence, so they don't have to Cvar_Update all their cvars every frame.
+A handle can be listed more than once. Returns -1 if the changes since
+*sequence are no longer known, the caller has to update all cvars then.
+=====================
+*/
+int Cvar_Changes(int *sequence, int *handles, int maxHandles)
+{
+	int count = 0;
+
+	if (*sequence < 0 || (unsigned)(cvar_changeSequence - *sequence) > CVAR_CHANGE_LOG)
+	{
+		*sequence = cvar_changeSequence;
+		return -1;
+	}
+
+	while (*sequence != cvar_changeSequence && count < maxHandles)
+	{
+		handles[count++] = cvar_changeLog[(*sequence)++ & (CVAR_CHANGE_LOG - 1)];
+	}
+
+	return count;
+}
+
 /*
 ==================
 Cvar_CompleteCvarName
@@ -262,6 +262,7 @@ typedef struct
 	int zipFilePos;
 	int zipFileLen;
 	qboolean zipFile;
+	pack_t *zipPak;
 	qboolean streamed;
 	char name[MAX_ZPATH];
 } fileHandleData_t;
@@ -1353,6 +1354,7 @@ long FS_FOpenFileReadDir(const char *filename, searchpath_t *search, fileHandle_
 
 					Q_strncpyz(fsh[*file].name, filename, sizeof(fsh[*file].name));
 					fsh[*file].zipFile = qtrue;
+					fsh[*file].zipPak  = pak;
 
 					// set the file position in the zip file (also sets the current file info)
 					unzSetOffset(fsh[*file].handleFiles.file.z, pakFile->pos);
@@ -2176,6 +2178,330 @@ int FS_FileIsInPAK(const char *filename, int *pChecksum)
 	return -1;
 }
 
+/**
+ * @brief Finds the pk3 a file would be read from
+ * @param[in] filename
+ * @param[out] pak
+ * @param[out] pakFile
+ * @return qfalse if the file doesn't exist or is read from a directory
+ */
+static qboolean FS_FindFileInPak(const char *filename, pack_t **pak, fileInPack_t **pakFile)
+{
+	searchpath_t *search;
+	fileInPack_t *file;
+
+	if (!fs_searchpaths)
+	{
+		Com_Error(ERR_FATAL, "FS_FindFileInPak: Filesystem call made without initialization");
+	}
+
+	// qpaths are not supposed to have a leading slash
+	if (filename[0] == '/' || filename[0] == '\\')
+	{
+		filename++;
+	}
+
+	for (search = fs_searchpaths; search; search = search->next)
+	{
+		if (search->pack)
+		{
+			if (!ALLOW_RAW_FILE_ACCESS && !FS_PakIsPure(search->pack))
+			{
+				continue;
+			}
+
+			for (file = search->pack->hashTable[FS_HashFileName(filename, search->pack->hashSize)]; file; file = file->next)
+			{
+				// case and separator insensitive comparisons
+				if (!FS_FilenameCompare(file->name, filename))
+				{
+					*pak     = search->pack;
+					*pakFile = file;
+					return qtrue;
+				}
+			}
+		}
+		else if (search->dir && FS_FOpenFileReadDir(filename, search, NULL, qfalse, ALLOW_RAW_FILE_ACCESS) > 0)
+		{
+			// only a few file types are read from directories on pure servers
+			if (!ALLOW_RAW_FILE_ACCESS && fs_numServerPaks)
+			{
+				continue;
+			}
+
+			return qfalse;
+		}
+	}
+
+	return qfalse;
+}
+
+/**
+ * @brief Gets the checksum of the pk3 a file would be read from
+ * @param[in] filename
+ * @param[out] pChecksum checksum of the pk3 contents, unlike the pure checksum
+ * it doesn't depend on the checksum feed of the server
+ * @return qfalse if the file doesn't exist or is read from a directory
+ */
+qboolean FS_FilePakChecksum(const char *filename, int *pChecksum)
+{
+	pack_t       *pak;
+	fileInPack_t *pakFile;
+
+	if (!FS_FindFileInPak(filename, &pak, &pakFile))
+	{
+		return qfalse;
+	}
+
+	*pChecksum = pak->checksum;
+	return qtrue;
+}
+
+/*
+======================================================================================
+PRELOADED FILES
+
+Files of pk3s read on another thread before they are needed, see cl_preload.c.
+They are identified by the pk3 file, its checksum and their position in it,
+so they survive the file system restarts of a map change. FS_ReadFile copies
+them instead of inflating the file again when it opens the same pk3 entry.
+======================================================================================
+*/
+
+#define PRELOAD_HASH_SIZE   1024
+
+typedef struct preloadedFile_s
+{
+	fsPakEntry_t entry;
+	void *buffer;                               // allocated with malloc
+	struct preloadedFile_s *next;
+} preloadedFile_t;
+
+static preloadedFile_t *fs_preloadedFiles[PRELOAD_HASH_SIZE];
+static int             fs_numPreloadedFiles;
+
+struct fsPakReader_s
+{
+	char pakFilename[MAX_OSPATH];
+	unzFile handle;
+};
+
+/**
+ * @brief Finds the pk3 entry a file would be read from
+ * @param[in] filename
+ * @param[out] entry
+ * @return qfalse if the file doesn't exist or is read from a directory
+ */
+qboolean FS_FindPakEntry(const char *filename, fsPakEntry_t *entry)
+{
+	pack_t       *pak;
+	fileInPack_t *pakFile;
+
+	if (!FS_FindFileInPak(filename, &pak, &pakFile))
+	{
+		return qfalse;
+	}
+
+	Q_strncpyz(entry->pakFilename, pak->pakFilename, sizeof(entry->pakFilename));
+	entry->checksum = pak->checksum;
+	entry->pos      = pakFile->pos;
+	entry->len      = pakFile->len;
+	return qtrue;
+}
+
+/**
+ * @brief Lists all files of the pk3 of an entry
+ * @param[in] entry
+ * @param[out] numFiles
+ * @return list to free with FS_FreeFileList, NULL if the pk3 isn't loaded
+ */
+char **FS_ListPakEntries(const fsPakEntry_t *entry, int *numFiles)
+{
+	searchpath_t *search;
+	char         **list;
+	int          i;
+
+	*numFiles = 0;
+
+	for (search = fs_searchpaths; search; search = search->next)
+	{
+		if (search->pack && search->pack->checksum == entry->checksum && !strcmp(search->pack->pakFilename, entry->pakFilename))
+		{
+			break;
+		}
+	}
+
+	if (!search)
+	{
+		return NULL;
+	}
+
+	list = Z_Malloc((search->pack->numfiles + 1) * sizeof(*list));
+
+	for (i = 0; i < search->pack->numfiles; i++)
+	{
+		list[i] = CopyString(search->pack->buildBuffer[i].name);
+	}
+	list[i] = NULL;
+
+	*numFiles = search->pack->numfiles;
+	return list;
+}
+
+/**
+ * @brief Reads a pk3 entry without using the file system state
+ * @param[in,out] reader pk3 kept open between calls, close it with FS_ClosePakReader
+ * @param[in] entry
+ * @param[out] buffer at least entry->len bytes
+ * @return qfalse on read errors
+ *
+ * @note Safe to call from other threads than the main thread, it only uses
+ * memory allocated with malloc.
+ */
+qboolean FS_ReadPakEntry(fsPakReader_t **reader, const fsPakEntry_t *entry, void *buffer)
+{
+	int len;
+
+	if (*reader && strcmp((*reader)->pakFilename, entry->pakFilename))
+	{
+		FS_ClosePakReader(reader);
+	}
+
+	if (!*reader)
+	{
+		*reader = malloc(sizeof(**reader));
+		if (!*reader)
+		{
+			return qfalse;
+		}
+
+		Q_strncpyz((*reader)->pakFilename, entry->pakFilename, sizeof((*reader)->pakFilename));
+		(*reader)->handle = unzOpen(entry->pakFilename);
+	}
+
+	if (!(*reader)->handle)
+	{
+		return qfalse;
+	}
+
+	if (unzSetOffset((*reader)->handle, entry->pos) != UNZ_OK || unzOpenCurrentFile((*reader)->handle) != UNZ_OK)
+	{
+		return qfalse;
+	}
+
+	len = unzReadCurrentFile((*reader)->handle, buffer, entry->len);
+	unzCloseCurrentFile((*reader)->handle);
+
+	return len == entry->len;
+}
+
+/**
+ * @brief Closes the pk3 of a reader, see FS_ReadPakEntry
+ * @param[in,out] reader
+ */
+void FS_ClosePakReader(fsPakReader_t **reader)
+{
+	if (!*reader)
+	{
+		return;
+	}
+
+	if ((*reader)->handle)
+	{
+		unzClose((*reader)->handle);
+	}
+
+	free(*reader);
+	*reader = NULL;
+}
+
+/**
+ * @brief Hash of a pk3 entry
+ * @param[in] pakFilename
+ * @param[in] pos
+ * @return
+ */
+static int FS_PreloadHash(const char *pakFilename, unsigned long pos)
+{
+	return (Q_GenerateHashValue(pakFilename, PRELOAD_HASH_SIZE, qfalse, qtrue) + pos) & (PRELOAD_HASH_SIZE - 1);
+}
+
+/**
+ * @brief Keeps a preloaded pk3 entry until FS_ClearPreloadedFiles
+ * @param[in] entry
+ * @param[in] buffer contents of the entry allocated with malloc, owned by the file system now
+ */
+void FS_AddPreloadedFile(const fsPakEntry_t *entry, void *buffer)
+{
+	preloadedFile_t *file;
+	int             hash = FS_PreloadHash(entry->pakFilename, entry->pos);
+
+	file         = Z_Malloc(sizeof(*file));
+	file->entry  = *entry;
+	file->buffer = buffer;
+	file->next   = fs_preloadedFiles[hash];
+
+	fs_preloadedFiles[hash] = file;
+	fs_numPreloadedFiles++;
+}
+
+/**
+ * @brief Frees all preloaded files
+ */
+void FS_ClearPreloadedFiles(void)
+{
+	preloadedFile_t *file, *next;
+	int             i;
+
+	if (!fs_numPreloadedFiles)
+	{
+		return;
+	}
+
+	for (i = 0; i < PRELOAD_HASH_SIZE; i++)
+	{
+		for (file = fs_preloadedFiles[i]; file; file = next)
+		{
+			next = file->next;
+			free(file->buffer);
+			Z_Free(file);
+		}
+		fs_preloadedFiles[i] = NULL;
+	}
+
+	fs_numPreloadedFiles = 0;
+}
+
+/**
+ * @brief Copies an opened pk3 file from the preloaded files
+ * @param[in] f handle opened by FS_FOpenFileRead
+ * @param[out] buffer
+ * @param[in] len
+ * @return qfalse if the file isn't preloaded
+ */
+static qboolean FS_ReadPreloadedFile(fileHandle_t f, void *buffer, int len)
+{
+	preloadedFile_t *file;
+	pack_t          *pak = fsh[f].zipPak;
+
+	if (!fs_numPreloadedFiles || !fsh[f].zipFile || !pak)
+	{
+		return qfalse;
+	}
+
+	for (file = fs_preloadedFiles[FS_PreloadHash(pak->pakFilename, fsh[f].zipFilePos)]; file; file = file->next)
+	{
+		if (file->entry.pos == (unsigned long)fsh[f].zipFilePos && file->entry.len == len && file->entry.checksum == pak->checksum
+		    && !strcmp(file->entry.pakFilename, pak->pakFilename))
+		{
+			Com_Memcpy(buffer, file->buffer, len);
+			return qtrue;
+		}
+	}
+
+	return qfalse;
+}
+
 /**
  * @brief Open a file relative to the ET:L search path.
  * A null buffer will just return the file length without loading.
@@ -2293,7 +2619,10 @@ int FS_ReadFile(const char *qpath, void **buffer)
 	buf     = Hunk_AllocateTempMemory(len + 1);
 	*buffer = buf;
 
-	FS_Read(buf, len, h);
+	if (!FS_ReadPreloadedFile(h, buf, len))
+	{
+		FS_Read(buf, len, h);
+	}
 
 	// guarantee that it will have a trailing 0 for string operations
 	buf[len] = 0;
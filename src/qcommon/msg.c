@@ -35,6 +35,13 @@
 #include "q_shared.h"
 #include "qcommon.h"
 
+#include <stddef.h>
+
+#if idx64 || defined(__SSE2__)
+#include <emmintrin.h>
+#define MSG_SSE2_COMPARE
+#endif
+
 // FIXME: necessary for entityShared_t management to work (since we need the definitions...), which is a very necessary function for server-side demos recording. It would be better if this functionality would be separated in an _ext.c file, but I could not find a way to make it work (because it also needs the definitions in msg.c, and since it's not a header, these are being redefined when included, producing a lot of recursive declarations errors...)
 #include "../game/g_public.h"
 
@@ -436,6 +443,58 @@ void MSG_WriteString(msg_t *sb, const char *s)
 	}
 }
 
+/**
+ * @brief Appends bits written to another bitstream message, e.g. a string
+ * encoded once and sent to many clients
+ * @param[in,out] msg
+ * @param[in] data the encoded message data, starting at bit 0
+ * @param[in] numBits
+ * @param[in] length number of bytes that were encoded, for net debugging
+ *
+ * @note Gives the same result as writing the original bytes to 'msg', the
+ * huffman codes don't depend on the bit position.
+ */
+void MSG_WriteEncoded(msg_t *msg, const byte *data, int numBits, int length)
+{
+	int numBytes = (numBits + 7) >> 3;
+	int out      = msg->bit >> 3;
+	int shift    = msg->bit & 7;
+	int i;
+
+	oldsize         += length * 8;
+	msg->uncompsize += length * 8;
+
+	if (msg->oob)
+	{
+		Com_Error(ERR_DROP, "MSG_WriteEncoded: not a bitstream message");
+	}
+
+	// same margin as MSG_WriteBits
+	if (msg->maxsize - ((msg->bit + numBits) >> 3) - 1 < 32)
+	{
+		msg->overflowed = qtrue;
+		return;
+	}
+
+	// bits past the end of the encoded data are zero, just like past the end of msg
+	if (!shift)
+	{
+		Com_Memcpy(msg->data + out, data, numBytes);
+	}
+	else
+	{
+		msg->data[out] &= (1 << shift) - 1;
+		for (i = 0; i < numBytes; i++)
+		{
+			msg->data[out + i]     |= (byte)(data[i] << shift);
+			msg->data[out + i + 1]  = data[i] >> (8 - shift);
+		}
+	}
+
+	msg->bit    += numBits;
+	msg->cursize = (msg->bit >> 3) + 1;
+}
+
 void MSG_WriteBigString(msg_t *sb, const char *s)
 {
 	if (!s)
@@ -1055,24 +1114,166 @@ void MSG_PrioritiseEntitystateFields(void)
 #define FLOAT_INT_BIAS  (1 << (FLOAT_INT_BITS - 1))
 
 /*
-==================
-MSG_WriteDeltaEntity
+==============================================================================
+            CHANGED FIELD BITMAPS
 
-Writes part of a packetentities message, including the entity number.
-Can delta from either a baseline or a previous packet_entity
-If to is NULL, a remove entity update will be sent
-If force is not set, then nothing at all will be generated if the entity is
-identical, under the assumption that the in-order delta code will catch it.
-==================
+The delta writers compare the two states as arrays of 32 bit words and map
+the changed words onto the field tables, instead of comparing every field
+through its offset. All net fields are single words, so a field changed
+exactly when its word did.
+==============================================================================
 */
-void MSG_WriteDeltaEntity(msg_t *msg, struct entityState_s *from, struct entityState_s *to, qboolean force)
+
+// bitmap sizes in unsigned ints, one spare so MSG_WordRange can read past a word boundary
+#define MSG_WORD_BITMAP(type)   ((sizeof(type) / 4 + 31) / 32 + 1)
+#define MSG_FIELD_BITMAP        4
+
+static int      msgEntityFieldOfWord[sizeof(entityState_t) / 4];
+static int      msgPlayerFieldOfWord[sizeof(playerState_t) / 4];
+static qboolean msgFieldWordsInit = qfalse;
+
+static void MSG_InitFieldWords(void);
+
+/**
+ * @brief Index of the lowest set bit
+ * @param[in] bits must not be 0
+ * @return
+ */
+static ID_INLINE int MSG_LowBit(unsigned int bits)
 {
-	int        i, lc;
-	int        numFields = sizeof(entityStateFields) / sizeof(entityStateFields[0]);
-	netField_t *field;
-	int        trunc;
-	float      fullFloat;
-	int        *fromF, *toF;
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctz(bits);
+#else
+	int i = 0;
+
+	while (!(bits & 1))
+	{
+		bits >>= 1;
+		i++;
+	}
+	return i;
+#endif
+}
+
+/**
+ * @brief Sets a bit for every 32 bit word that differs between two states
+ * @param[in] from
+ * @param[in] to
+ * @param[in] numWords
+ * @param[out] changed bitmap of MSG_WORD_BITMAP size
+ * @return qfalse if the states are identical
+ */
+static qboolean MSG_ChangedWords(const void *from, const void *to, int numWords, unsigned int *changed)
+{
+	const int    *f  = (const int *)from;
+	const int    *t  = (const int *)to;
+	unsigned int any = 0, mask;
+	int          i   = 0;
+
+	Com_Memset(changed, 0, ((numWords + 31) / 32 + 1) * sizeof(*changed));
+
+#ifdef MSG_SSE2_COMPARE
+	for ( ; i + 4 <= numWords; i += 4)
+	{
+		__m128i a = _mm_loadu_si128((const __m128i *)(f + i));
+		__m128i b = _mm_loadu_si128((const __m128i *)(t + i));
+
+		mask = ~(unsigned int)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b))) & 15;
+		if (mask)
+		{
+			// i is a multiple of 4, the 4 bits never straddle two words
+			changed[i >> 5] |= mask << (i & 31);
+			any             |= mask;
+		}
+	}
+#endif
+
+	for ( ; i < numWords; i++)
+	{
+		if (f[i] != t[i])
+		{
+			changed[i >> 5] |= 1u << (i & 31);
+			any              = 1;
+		}
+	}
+
+	return any != 0;
+}
+
+/**
+ * @brief Gets 'count' (max 32) bits of a word bitmap, starting at word 'first'
+ * @param[in] changed
+ * @param[in] first
+ * @param[in] count
+ * @return
+ */
+static ID_INLINE int MSG_WordRange(const unsigned int *changed, int first, int count)
+{
+	uint64_t pair = changed[first >> 5] | ((uint64_t)changed[(first >> 5) + 1] << 32);
+
+	return (int)((pair >> (first & 31)) & ((1ull << count) - 1));
+}
+
+/**
+ * @brief Turns a bitmap of changed words into a bitmap of changed fields
+ * @param[in] changedWords
+ * @param[in] numWords
+ * @param[in] fieldOfWord
+ * @param[in,out] fields usage counters are updated, NULL to leave them alone
+ * @param[out] changed bitmap of MSG_FIELD_BITMAP size
+ * @return number of fields up to the last changed one
+ */
+static int MSG_ChangedFields(const unsigned int *changedWords, int numWords, const int *fieldOfWord, netField_t *fields, unsigned int *changed)
+{
+	unsigned int bits;
+	int          i, field, lc = 0;
+
+	Com_Memset(changed, 0, MSG_FIELD_BITMAP * sizeof(*changed));
+
+	for (i = 0; i < (numWords + 31) / 32; i++)
+	{
+		for (bits = changedWords[i]; bits; bits &= bits - 1)
+		{
+			field = fieldOfWord[(i << 5) + MSG_LowBit(bits)];
+			if (field < 0)
+			{
+				continue;
+			}
+
+			changed[field >> 5] |= 1u << (field & 31);
+			if (fields)
+			{
+				fields[field].used++;
+			}
+
+			if (field >= lc)
+			{
+				lc = field + 1;
+			}
+		}
+	}
+
+	return lc;
+}
+
+/**
+ * @brief Writes a delta entity, see MSG_WriteDeltaEntity
+ * @param[in,out] msg
+ * @param[in] from
+ * @param[in] to
+ * @param[in] force
+ * @param[in] countFields count the changed fields for MSG_PrioritiseEntitystateFields
+ */
+static void MSG_WriteDeltaEntityFields(msg_t *msg, struct entityState_s *from, struct entityState_s *to, qboolean force, qboolean countFields)
+{
+	int          i, lc;
+	int          numFields = sizeof(entityStateFields) / sizeof(entityStateFields[0]);
+	netField_t   *field;
+	int          trunc;
+	float        fullFloat;
+	int          *toF;
+	unsigned int changedWords[MSG_WORD_BITMAP(entityState_t)];
+	unsigned int changed[MSG_FIELD_BITMAP];
 
 	// all fields should be 32 bits to avoid any compiler packing issues
 	// the "number" field is not part of the field list
@@ -1101,18 +1302,16 @@ void MSG_WriteDeltaEntity(msg_t *msg, struct entityState_s *from, struct entityS
 		Com_Error(ERR_FATAL, "MSG_WriteDeltaEntity: Bad entity number: %i", to->number);
 	}
 
-	lc = 0;
-	// build the change vector as bytes so it is endien independent
-	for (i = 0, field = entityStateFields ; i < numFields ; i++, field++)
+	if (!msgFieldWordsInit)
 	{
-		fromF = ( int * )((byte *)from + field->offset);
-		toF   = ( int * )((byte *)to + field->offset);
-		if (*fromF != *toF)
-		{
-			lc = i + 1;
+		MSG_InitFieldWords();
+	}
 
-			field->used++;
-		}
+	lc = 0;
+	// unchanged entities are rejected by the word compare alone
+	if (MSG_ChangedWords(from, to, ARRAY_LEN(msgEntityFieldOfWord), changedWords))
+	{
+		lc = MSG_ChangedFields(changedWords, ARRAY_LEN(msgEntityFieldOfWord), msgEntityFieldOfWord, countFields ? entityStateFields : NULL, changed);
 	}
 
 	if (lc == 0)
@@ -1141,10 +1340,7 @@ void MSG_WriteDeltaEntity(msg_t *msg, struct entityState_s *from, struct entityS
 
 	for (i = 0, field = entityStateFields ; i < lc ; i++, field++)
 	{
-		fromF = ( int * )((byte *)from + field->offset);
-		toF   = ( int * )((byte *)to + field->offset);
-
-		if (*fromF == *toF)
+		if (!(changed[i >> 5] & (1u << (i & 31))))
 		{
 			MSG_WriteBits(msg, 0, 1);   // no change
 
@@ -1153,6 +1349,8 @@ void MSG_WriteDeltaEntity(msg_t *msg, struct entityState_s *from, struct entityS
 			continue;
 		}
 
+		toF = ( int * )((byte *)to + field->offset);
+
 		MSG_WriteBits(msg, 1, 1);   // changed
 
 		if (field->bits == 0)
@@ -1224,6 +1422,35 @@ void MSG_WriteDeltaEntity(msg_t *msg, struct entityState_s *from, struct entityS
 	*/
 }
 
+/*
+==================
+MSG_WriteDeltaEntity
+
+Writes part of a packetentities message, including the entity number.
+Can delta from either a baseline or a previous packet_entity
+If to is NULL, a remove entity update will be sent
+If force is not set, then nothing at all will be generated if the entity is
+identical, under the assumption that the in-order delta code will catch it.
+==================
+*/
+void MSG_WriteDeltaEntity(msg_t *msg, struct entityState_s *from, struct entityState_s *to, qboolean force)
+{
+	MSG_WriteDeltaEntityFields(msg, from, to, force, qtrue);
+}
+
+/**
+ * @brief Writes a delta entity like MSG_WriteDeltaEntity to measure its size,
+ * the fields aren't counted as used since the update isn't sent this way
+ * @param[in,out] msg
+ * @param[in] from
+ * @param[in] to
+ * @param[in] force
+ */
+void MSG_MeasureDeltaEntity(msg_t *msg, struct entityState_s *from, struct entityState_s *to, qboolean force)
+{
+	MSG_WriteDeltaEntityFields(msg, from, to, force, qfalse);
+}
+
 /*
 ==================
 MSG_ReadDeltaEntity
@@ -1743,6 +1970,38 @@ netField_t playerStateFields[] =
 	{ PSF(aiState),              2               },
 };
 
+/**
+ * @brief Maps every word of a state to the field sending it, -1 for words which aren't fields
+ * @param[in] fields
+ * @param[in] numFields
+ * @param[out] fieldOfWord
+ * @param[in] numWords
+ */
+static void MSG_MapFieldWords(const netField_t *fields, int numFields, int *fieldOfWord, int numWords)
+{
+	int i;
+
+	for (i = 0; i < numWords; i++)
+	{
+		fieldOfWord[i] = -1;
+	}
+
+	for (i = 0; i < numFields; i++)
+	{
+		fieldOfWord[fields[i].offset >> 2] = i;
+	}
+}
+
+/**
+ * @brief Builds the word to field maps of the entity and player state tables
+ */
+static void MSG_InitFieldWords(void)
+{
+	MSG_MapFieldWords(entityStateFields, ARRAY_LEN(entityStateFields), msgEntityFieldOfWord, ARRAY_LEN(msgEntityFieldOfWord));
+	MSG_MapFieldWords(playerStateFields, ARRAY_LEN(playerStateFields), msgPlayerFieldOfWord, ARRAY_LEN(msgPlayerFieldOfWord));
+	msgFieldWordsInit = qtrue;
+}
+
 static int QDECL qsort_playerstatefields(const void *a, const void *b)
 {
 	int aa = *((int *)a);
@@ -1798,11 +2057,13 @@ void MSG_WriteDeltaPlayerstate(msg_t *msg, struct playerState_s *from, struct pl
 	int           holdablebits;
 	int           numFields;
 	netField_t    *field;
-	int           *fromF, *toF;
+	int           *toF;
 	float         fullFloat;
 	int           trunc;
 	int           startBit, endBit;
 	int           print;
+	unsigned int  changedWords[MSG_WORD_BITMAP(playerState_t)];
+	unsigned int  changed[MSG_FIELD_BITMAP];
 
 	if (!from)
 	{
@@ -1833,17 +2094,16 @@ void MSG_WriteDeltaPlayerstate(msg_t *msg, struct playerState_s *from, struct pl
 
 	numFields = sizeof(playerStateFields) / sizeof(playerStateFields[0]);
 
-	lc = 0;
-	for (i = 0, field = playerStateFields ; i < numFields ; i++, field++)
+	if (!msgFieldWordsInit)
 	{
-		fromF = ( int * )((byte *)from + field->offset);
-		toF   = ( int * )((byte *)to + field->offset);
-		if (*fromF != *toF)
-		{
-			lc = i + 1;
+		MSG_InitFieldWords();
+	}
 
-			field->used++;
-		}
+	// the word bitmap also covers the stats and ammo arrays sent below
+	lc = 0;
+	if (MSG_ChangedWords(from, to, ARRAY_LEN(msgPlayerFieldOfWord), changedWords))
+	{
+		lc = MSG_ChangedFields(changedWords, ARRAY_LEN(msgPlayerFieldOfWord), msgPlayerFieldOfWord, playerStateFields, changed);
 	}
 
 	MSG_WriteByte(msg, lc);     // # of changes
@@ -1852,10 +2112,7 @@ void MSG_WriteDeltaPlayerstate(msg_t *msg, struct playerState_s *from, struct pl
 
 	for (i = 0, field = playerStateFields ; i < lc ; i++, field++)
 	{
-		fromF = ( int * )((byte *)from + field->offset);
-		toF   = ( int * )((byte *)to + field->offset);
-
-		if (*fromF == *toF)
+		if (!(changed[i >> 5] & (1u << (i & 31))))
 		{
 			wastedbits++;
 
@@ -1863,6 +2120,8 @@ void MSG_WriteDeltaPlayerstate(msg_t *msg, struct playerState_s *from, struct pl
 			continue;
 		}
 
+		toF = ( int * )((byte *)to + field->offset);
+
 		MSG_WriteBits(msg, 1, 1);   // changed
 		//pcount[i]++;
 
@@ -1905,38 +2164,10 @@ void MSG_WriteDeltaPlayerstate(msg_t *msg, struct playerState_s *from, struct pl
 	//
 	// send the arrays
 	//
-	statsbits = 0;
-	for (i = 0 ; i < MAX_STATS ; i++)
-	{
-		if (to->stats[i] != from->stats[i])
-		{
-			statsbits |= 1 << i;
-		}
-	}
-	persistantbits = 0;
-	for (i = 0 ; i < MAX_PERSISTANT ; i++)
-	{
-		if (to->persistant[i] != from->persistant[i])
-		{
-			persistantbits |= 1 << i;
-		}
-	}
-	holdablebits = 0;
-	for (i = 0 ; i < MAX_HOLDABLE ; i++)
-	{
-		if (to->holdable[i] != from->holdable[i])
-		{
-			holdablebits |= 1 << i;
-		}
-	}
-	powerupbits = 0;
-	for (i = 0 ; i < MAX_POWERUPS ; i++)
-	{
-		if (to->powerups[i] != from->powerups[i])
-		{
-			powerupbits |= 1 << i;
-		}
-	}
+	statsbits      = MSG_WordRange(changedWords, offsetof(playerState_t, stats) / 4, MAX_STATS);
+	persistantbits = MSG_WordRange(changedWords, offsetof(playerState_t, persistant) / 4, MAX_PERSISTANT);
+	holdablebits   = MSG_WordRange(changedWords, offsetof(playerState_t, holdable) / 4, MAX_HOLDABLE);
+	powerupbits    = MSG_WordRange(changedWords, offsetof(playerState_t, powerups) / 4, MAX_POWERUPS);
 
 	if (statsbits || persistantbits || holdablebits || powerupbits)
 	{
@@ -2029,14 +2260,7 @@ void MSG_WriteDeltaPlayerstate(msg_t *msg, struct playerState_s *from, struct pl
 	// ammo stored
 	for (j = 0; j < 4; j++)      // modified for 64 weaps
 	{
-		ammobits[j] = 0;
-		for (i = 0 ; i < 16 ; i++)
-		{
-			if (to->ammo[i + (j * 16)] != from->ammo[i + (j * 16)])
-			{
-				ammobits[j] |= 1 << i;
-			}
-		}
+		ammobits[j] = MSG_WordRange(changedWords, offsetof(playerState_t, ammo) / 4 + j * 16, 16);
 	}
 
 	// also encapsulated ammo changes into one check. Clip values will change frequently,
@@ -2072,14 +2296,7 @@ void MSG_WriteDeltaPlayerstate(msg_t *msg, struct playerState_s *from, struct pl
 	// ammo in clip
 	for (j = 0; j < 4; j++)      // modified for 64 weaps
 	{
-		clipbits = 0;
-		for (i = 0 ; i < 16 ; i++)
-		{
-			if (to->ammoclip[i + (j * 16)] != from->ammoclip[i + (j * 16)])
-			{
-				clipbits |= 1 << i;
-			}
-		}
+		clipbits = MSG_WordRange(changedWords, offsetof(playerState_t, ammoclip) / 4 + j * 16, 16);
 		if (clipbits)
 		{
 			MSG_WriteBits(msg, 1, 1);   // changed
@@ -535,37 +535,31 @@ local int32_t codes(struct state *s,
  */
 local int32_t fixed(struct state *s)
 {
-	static int32_t        virgin = 1;
-	static int16_t        lencnt[MAXBITS + 1], lensym[FIXLCODES];
-	static int16_t        distcnt[MAXBITS + 1], distsym[MAXDCODES];
-	static struct huffman lencode  = { lencnt, lensym };
-	static struct huffman distcode = { distcnt, distsym };
-
-	/* build fixed huffman tables if first call (may not be thread safe) */
-	if (virgin)
-	{
-		int32_t symbol;
-		int16_t lengths[FIXLCODES];
-
-		/* literal/length table */
-		for (symbol = 0; symbol < 144; symbol++)
-			lengths[symbol] = 8;
-		for (; symbol < 256; symbol++)
-			lengths[symbol] = 9;
-		for (; symbol < 280; symbol++)
-			lengths[symbol] = 7;
-		for (; symbol < FIXLCODES; symbol++)
-			lengths[symbol] = 8;
-		construct(&lencode, lengths, FIXLCODES);
-
-		/* distance table */
-		for (symbol = 0; symbol < MAXDCODES; symbol++)
-			lengths[symbol] = 5;
-		construct(&distcode, lengths, MAXDCODES);
-
-		/* do this just once */
-		virgin = 0;
-	}
+	int16_t        lencnt[MAXBITS + 1], lensym[FIXLCODES];
+	int16_t        distcnt[MAXBITS + 1], distsym[MAXDCODES];
+	struct huffman lencode  = { lencnt, lensym };
+	struct huffman distcode = { distcnt, distsym };
+	int32_t        symbol;
+	int16_t        lengths[FIXLCODES];
+
+	/* build fixed huffman tables on every call, the renderer inflates
+	   images on several threads at once and the tables are cheap */
+
+	/* literal/length table */
+	for (symbol = 0; symbol < 144; symbol++)
+		lengths[symbol] = 8;
+	for (; symbol < 256; symbol++)
+		lengths[symbol] = 9;
+	for (; symbol < 280; symbol++)
+		lengths[symbol] = 7;
+	for (; symbol < FIXLCODES; symbol++)
+		lengths[symbol] = 8;
+	construct(&lencode, lengths, FIXLCODES);
+
+	/* distance table */
+	for (symbol = 0; symbol < MAXDCODES; symbol++)
+		lengths[symbol] = 5;
+	construct(&distcode, lengths, MAXDCODES);
 
 	/* decode data until end-of-block code */
 	return codes(s, &lencode, &distcode);
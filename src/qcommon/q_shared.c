@@ -2323,6 +2323,55 @@ char *Com_SkipTokens(char *s, int numTokens, char *sep)
 	}
 }
 
+/**
+ * @brief Gets the handles of the module cvars changed since the last call
+ * @param[in] cvarChanges Cvar_Changes syscall of the module, NULL if the engine doesn't have it
+ * @param[in,out] sequence change sequence of the module, -1 to start over
+ * @param[out] handles room for MAX_CVAR_CHANGES handles
+ * @return number of handles, -1 if all cvars have to be checked
+ */
+int Com_GetCvarChanges(cvarChangesFunc_t cvarChanges, int *sequence, int *handles)
+{
+	int count;
+
+	if (!cvarChanges)
+	{
+		return -1;
+	}
+
+	count = cvarChanges(sequence, handles, MAX_CVAR_CHANGES);
+
+	// more changes than asked for, don't bother picking them
+	return count < MAX_CVAR_CHANGES ? count : -1;
+}
+
+/**
+ * @brief Checks if a cvar is in the result of Com_GetCvarChanges
+ * @param[in] vmCvar
+ * @param[in] handles
+ * @param[in] numChanges
+ * @return
+ */
+qboolean Com_CvarChanged(const vmCvar_t *vmCvar, const int *handles, int numChanges)
+{
+	int i;
+
+	if (numChanges < 0)
+	{
+		return qtrue;
+	}
+
+	for (i = 0; i < numChanges; i++)
+	{
+		if (handles[i] == vmCvar->handle)
+		{
+			return qtrue;
+		}
+	}
+
+	return qfalse;
+}
+
 #if defined(_MSC_VER) && (_MSC_VER < 1800)
 float rint(float v)
 {
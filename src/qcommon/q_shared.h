@@ -1197,6 +1197,19 @@ typedef struct
 	char string[MAX_CVAR_VALUE_STRING];
 } vmCvar_t;
 
+#define MAX_CVAR_CHANGES        64          // handles asked for per call
+
+typedef int (*cvarChangesFunc_t)(int *sequence, int *handles, int maxHandles);
+
+int Com_GetCvarChanges(cvarChangesFunc_t cvarChanges, int *sequence, int *handles);
+qboolean Com_CvarChanged(const vmCvar_t *vmCvar, const int *handles, int numChanges);
+
+// syscalls added after the 274 release, which can't be told apart by the
+// version number; the engine lists the ones it has in a read only cvar
+#define SYSCALL_EXTENSIONS_CVAR     "com_syscallExtensions"
+#define SYSCALL_EXT_TRACEBATCH      1       // G_TRACEBATCH
+#define SYSCALL_EXT_CVAR_CHANGES    2       // G_CVAR_CHANGES, CG_CVAR_CHANGES and UI_CVAR_CHANGES
+
 /*
 ==============================================================
 COLLISION DETECTION
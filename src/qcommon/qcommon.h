@@ -90,6 +90,7 @@ void MSG_WriteLong(msg_t *sb, int c);
 void MSG_WriteFloat(msg_t *sb, float f);
 void MSG_WriteString(msg_t *sb, const char *s);
 void MSG_WriteBigString(msg_t *sb, const char *s);
+void MSG_WriteEncoded(msg_t *msg, const byte *data, int numBits, int length);
 void MSG_WriteAngle16(msg_t *sb, float f);
 
 void MSG_BeginReading(msg_t *sb);
@@ -113,6 +114,7 @@ void MSG_WriteDeltaUsercmdKey(msg_t *msg, int key, usercmd_t *from, usercmd_t *t
 void MSG_ReadDeltaUsercmdKey(msg_t *msg, int key, usercmd_t *from, usercmd_t *to);
 
 void MSG_WriteDeltaEntity(msg_t *msg, struct entityState_s *from, struct entityState_s *to, qboolean force);
+void MSG_MeasureDeltaEntity(msg_t *msg, struct entityState_s *from, struct entityState_s *to, qboolean force);
 void MSG_ReadDeltaEntity(msg_t *msg, entityState_t *from, entityState_t *to, int number);
 
 void MSG_WriteDeltaSharedEntity(msg_t *msg, void *from, void *to, qboolean force, int number);
@@ -580,6 +582,9 @@ void Cvar_Register(vmCvar_t *vmCvar, const char *varName, const char *defaultVal
 void Cvar_Update(vmCvar_t *vmCvar);
 // updates an interpreted modules' version of a cvar
 
+int Cvar_Changes(int *sequence, int *handles, int maxHandles);
+// handles of the cvars changed since *sequence, -1 if unknown
+
 void Cvar_Set(const char *var_name, const char *value);
 // will create the variable with no flags if it doesn't exist
 
@@ -750,6 +755,27 @@ long FS_FOpenFileRead_Filtered(const char *qpath, fileHandle_t *file, qboolean u
 int FS_FileIsInPAK(const char *filename, int *pChecksum);
 // returns 1 if a file is in the PAK file, otherwise -1
 
+qboolean FS_FilePakChecksum(const char *filename, int *pChecksum);
+// gets the feed independent checksum of the pk3 a file is read from
+
+// preloading of pk3 entries on other threads, see cl_preload.c
+typedef struct
+{
+	char pakFilename[MAX_OSPATH];
+	int checksum;                   // checksum of the pk3 contents
+	unsigned long pos;              // file info position in the pk3
+	int len;
+} fsPakEntry_t;
+
+typedef struct fsPakReader_s fsPakReader_t;
+
+qboolean FS_FindPakEntry(const char *filename, fsPakEntry_t *entry);
+char **FS_ListPakEntries(const fsPakEntry_t *entry, int *numFiles);
+qboolean FS_ReadPakEntry(fsPakReader_t **reader, const fsPakEntry_t *entry, void *buffer);
+void FS_ClosePakReader(fsPakReader_t **reader);
+void FS_AddPreloadedFile(const fsPakEntry_t *entry, void *buffer);
+void FS_ClearPreloadedFiles(void);
+
 int FS_Delete(char *filename);
 
 int FS_Write(const void *buffer, int len, fileHandle_t f);
@@ -2665,6 +2665,8 @@ void RE_LoadWorldMap(const char *name)
 	// load into heap
 	Ren_UpdateScreen();
 	R_LoadShaders(&header->lumps[LUMP_SHADERS]);
+	// decode the images of the shaders while the rest is loaded
+	R_PrefetchImages(s_worldData.shaders, s_worldData.numShaders, qfalse);
 	Ren_UpdateScreen();
 	R_LoadLightmaps(&header->lumps[LUMP_LIGHTMAPS]);
 	Ren_UpdateScreen();
@@ -2692,6 +2694,8 @@ void RE_LoadWorldMap(const char *name)
 	R_LoadLightGrid(&header->lumps[LUMP_LIGHTGRID]);
 	Ren_UpdateScreen();
 
+	R_FinishImagePrefetch();
+
 	s_worldData.dataSize = (byte *)ri.Hunk_Alloc(0, h_low) - startMarker;
 
 	// only set tr.world now that we know the entire level has loaded properly
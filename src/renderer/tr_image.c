@@ -53,6 +53,9 @@ static image_t *hashTable[FILE_HASH_SIZE];
 int  imageBufferSize[BUFFER_MAX_TYPES] = { 0, 0, 0 };
 void *imageBufferPtr[BUFFER_MAX_TYPES] = { NULL, NULL, NULL };
 
+// work buffers of the textures uploaded on the main thread
+static imageWork_t imageWork;
+
 void *R_GetImageBuffer(int size, bufferMemType_t bufferType, const char *filename)
 {
 	if (imageBufferSize[bufferType] < R_IMAGE_BUFFER_SIZE && size <= imageBufferSize[bufferType])
@@ -85,6 +88,8 @@ void R_FreeImageBuffer(void)
 {
 	int bufferType;
 
+	R_FreeImageWork(&imageWork);
+
 	for (bufferType = 0; bufferType < BUFFER_MAX_TYPES; bufferType++)
 	{
 		if (!imageBufferPtr[bufferType])
@@ -400,11 +405,539 @@ void R_LightScaleTexture(unsigned *in, int inwidth, int inheight, qboolean only_
 ================
 R_MipMap2
 
+Quarters the size of the texture into out
+Proper linear filter
+================
+*/
+static void R_MipMap2(const unsigned *in, int inWidth, int inHeight, unsigned *out)
+{
+	int  i, j, k;
+	byte *outpix;
+	int  inWidthMask  = inWidth - 1;
+	int  inHeightMask = inHeight - 1;
+	int  total;
+	int  outWidth  = inWidth >> 1;
+	int  outHeight = inHeight >> 1;
+
+	// textures one pixel thin are left as they are
+	if (!outWidth || !outHeight)
+	{
+		Com_Memcpy(out, in, (outWidth ? outWidth : 1) * (outHeight ? outHeight : 1) * 4);
+		return;
+	}
+
+	for (i = 0 ; i < outHeight ; i++)
+	{
+		for (j = 0 ; j < outWidth ; j++)
+		{
+			outpix = (byte *) (out + i * outWidth + j);
+			for (k = 0 ; k < 4 ; k++)
+			{
+				total =
+				    1 * ((const byte *)&in[((i * 2 - 1) & inHeightMask) * inWidth + ((j * 2 - 1) & inWidthMask)])[k] +
+				    2 * ((const byte *)&in[((i * 2 - 1) & inHeightMask) * inWidth + ((j * 2) & inWidthMask)])[k] +
+				    2 * ((const byte *)&in[((i * 2 - 1) & inHeightMask) * inWidth + ((j * 2 + 1) & inWidthMask)])[k] +
+				    1 * ((const byte *)&in[((i * 2 - 1) & inHeightMask) * inWidth + ((j * 2 + 2) & inWidthMask)])[k] +
+
+				    2 * ((const byte *)&in[((i * 2) & inHeightMask) * inWidth + ((j * 2 - 1) & inWidthMask)])[k] +
+				    4 * ((const byte *)&in[((i * 2) & inHeightMask) * inWidth + ((j * 2) & inWidthMask)])[k] +
+				    4 * ((const byte *)&in[((i * 2) & inHeightMask) * inWidth + ((j * 2 + 1) & inWidthMask)])[k] +
+				    2 * ((const byte *)&in[((i * 2) & inHeightMask) * inWidth + ((j * 2 + 2) & inWidthMask)])[k] +
+
+				    2 * ((const byte *)&in[((i * 2 + 1) & inHeightMask) * inWidth + ((j * 2 - 1) & inWidthMask)])[k] +
+				    4 * ((const byte *)&in[((i * 2 + 1) & inHeightMask) * inWidth + ((j * 2) & inWidthMask)])[k] +
+				    4 * ((const byte *)&in[((i * 2 + 1) & inHeightMask) * inWidth + ((j * 2 + 1) & inWidthMask)])[k] +
+				    2 * ((const byte *)&in[((i * 2 + 1) & inHeightMask) * inWidth + ((j * 2 + 2) & inWidthMask)])[k] +
+
+				    1 * ((const byte *)&in[((i * 2 + 2) & inHeightMask) * inWidth + ((j * 2 - 1) & inWidthMask)])[k] +
+				    2 * ((const byte *)&in[((i * 2 + 2) & inHeightMask) * inWidth + ((j * 2) & inWidthMask)])[k] +
+				    2 * ((const byte *)&in[((i * 2 + 2) & inHeightMask) * inWidth + ((j * 2 + 1) & inWidthMask)])[k] +
+				    1 * ((const byte *)&in[((i * 2 + 2) & inHeightMask) * inWidth + ((j * 2 + 2) & inWidthMask)])[k];
+				outpix[k] = total / 36;
+			}
+		}
+	}
+}
+
+/*
+================
+R_MipMap
+
+Quarters the size of the texture into out, which must not be in
+================
+*/
+static void R_MipMap(const byte *in, int width, int height, byte *out)
+{
+	int i, j;
+	int row;
+
+	if (!r_simpleMipMaps->integer)
+	{
+		R_MipMap2((const unsigned *)in, width, height, (unsigned *)out);
+		return;
+	}
+
+	if (width == 1 && height == 1)
+	{
+		Com_Memcpy(out, in, 4);
+		return;
+	}
+
+	row      = width * 4;
+	width  >>= 1;
+	height >>= 1;
+
+	if (width == 0 || height == 0)
+	{
+		width += height;    // get largest
+		for (i = 0 ; i < width ; i++, out += 4, in += 8)
+		{
+			out[0] = (in[0] + in[4]) >> 1;
+			out[1] = (in[1] + in[5]) >> 1;
+			out[2] = (in[2] + in[6]) >> 1;
+			out[3] = (in[3] + in[7]) >> 1;
+		}
+		return;
+	}
+
+	for (i = 0 ; i < height ; i++, in += row)
+	{
+		for (j = 0 ; j < width ; j++, out += 4, in += 8)
+		{
+			out[0] = (in[0] + in[4] + in[row + 0] + in[row + 4]) >> 2;
+			out[1] = (in[1] + in[5] + in[row + 1] + in[row + 5]) >> 2;
+			out[2] = (in[2] + in[6] + in[row + 2] + in[row + 6]) >> 2;
+			out[3] = (in[3] + in[7] + in[row + 3] + in[row + 7]) >> 2;
+		}
+	}
+}
+
+/*
+==================
+R_BlendOverTexture
+
+Apply a color blend over a set of pixels
+==================
+*/
+static void R_BlendOverTexture(byte *data, int pixelCount, byte blend[4])
+{
+	int i;
+	int inverseAlpha = 255 - blend[3];
+	int premult[3]   = { blend[0] * blend[3], blend[1] * blend[3], blend[2] * blend[3] };
+
+	for (i = 0 ; i < pixelCount ; i++, data += 4)
+	{
+		data[0] = (data[0] * inverseAlpha + premult[0]) >> 9;
+		data[1] = (data[1] * inverseAlpha + premult[1]) >> 9;
+		data[2] = (data[2] * inverseAlpha + premult[2]) >> 9;
+	}
+}
+
+byte mipBlendColors[16][4] =
+{
+	{ 0,   0,   0,   0   },
+	{ 255, 0,   0,   128 },
+	{ 0,   255, 0,   128 },
+	{ 0,   0,   255, 128 },
+	{ 255, 0,   0,   128 },
+	{ 0,   255, 0,   128 },
+	{ 0,   0,   255, 128 },
+	{ 255, 0,   0,   128 },
+	{ 0,   255, 0,   128 },
+	{ 0,   0,   255, 128 },
+	{ 255, 0,   0,   128 },
+	{ 0,   255, 0,   128 },
+	{ 0,   0,   255, 128 },
+	{ 255, 0,   0,   128 },
+	{ 0,   255, 0,   128 },
+	{ 0,   0,   255, 128 },
+};
+
+/**
+ * @brief Gets a work buffer of at least size bytes
+ * @param[in,out] work
+ * @param[in] buffer
+ * @param[in] size
+ * @return NULL if the buffer can't be allocated
+ */
+static byte *R_GetImageWorkBuffer(imageWork_t *work, imageWorkBuffer_t buffer, int size)
+{
+	if (size > work->sizes[buffer])
+	{
+		free(work->buffers[buffer]);
+
+		work->buffers[buffer] = malloc(size);
+		work->sizes[buffer]   = work->buffers[buffer] ? size : 0;
+	}
+
+	return work->buffers[buffer];
+}
+
+/**
+ * @brief Frees the work buffers of R_BuildImageLevels
+ * @param[in,out] work
+ */
+void R_FreeImageWork(imageWork_t *work)
+{
+	int i;
+
+	for (i = 0; i < IMAGEWORK_MAX_BUFFERS; i++)
+	{
+		free(work->buffers[i]);
+	}
+	Com_Memset(work, 0, sizeof(*work));
+}
+
+/**
+ * @brief Builds the texture levels Upload32 sends to GL
+ * @param[in] data 32 bit picture, left untouched
+ * @param[in] width
+ * @param[in] height
+ * @param[in] mipmap
+ * @param[in] picmip
+ * @param[in] lightMap
+ * @param[in,out] work buffers the levels are built in, they are valid until the work is used again
+ * @param[out] levels
+ * @return qfalse if the work buffers can't be allocated
+ *
+ * @note This doesn't touch GL or any other shared state, so the image prefetch
+ * can call it from its worker threads.
+ */
+qboolean R_BuildImageLevels(const unsigned *data, int width, int height,
+                            qboolean mipmap, qboolean picmip, qboolean lightMap,
+                            imageWork_t *work, imageLevels_t *levels)
+{
+	const byte *src = (const byte *)data;
+	byte       *dst;
+	int        scaled_width, scaled_height;
+	int        c, i, size;
+
+	// convert to exact power of 2 sizes
+	for (scaled_width = 1 ; scaled_width < width ; scaled_width <<= 1)
+		;
+	for (scaled_height = 1 ; scaled_height < height ; scaled_height <<= 1)
+		;
+	if (r_roundImagesDown->integer && scaled_width > width)
+	{
+		scaled_width >>= 1;
+	}
+	if (r_roundImagesDown->integer && scaled_height > height)
+	{
+		scaled_height >>= 1;
+	}
+
+	if (scaled_width != width || scaled_height != height)
+	{
+		dst = R_GetImageWorkBuffer(work, IMAGEWORK_RESAMPLED, scaled_width * scaled_height * 4);
+		if (!dst)
+		{
+			return qfalse;
+		}
+		ResampleTexture((unsigned *)src, width, height, (unsigned *)dst, scaled_width, scaled_height);
+		src    = dst;
+		width  = scaled_width;
+		height = scaled_height;
+	}
+
+	// perform optional picmip operation
+	if (picmip)
+	{
+		scaled_width  >>= r_picmip->integer;
+		scaled_height >>= r_picmip->integer;
+	}
+
+	// clamp to minimum size
+	if (scaled_width < 1)
+	{
+		scaled_width = 1;
+	}
+	if (scaled_height < 1)
+	{
+		scaled_height = 1;
+	}
+
+	// clamp to the current upper OpenGL limit
+	// scale both axis down equally so we don't have to
+	// deal with a half mip resampling
+	// there is no limit yet without a GL context, see R_TestImageLevels
+	while (glConfig.maxTextureSize > 0 &&
+	       (scaled_width > glConfig.maxTextureSize || scaled_height > glConfig.maxTextureSize))
+	{
+		scaled_width  >>= 1;
+		scaled_height >>= 1;
+	}
+
+	// verify if the alpha channel is being used or not
+	levels->samples = 3;
+	if (!lightMap)
+	{
+		c = width * height;
+		for (i = 0; i < c; i++)
+		{
+			if (src[i * 4 + 3] != 255)
+			{
+				levels->samples = 4;
+				break;
+			}
+		}
+	}
+
+	levels->width     = scaled_width;
+	levels->height    = scaled_height;
+	levels->numLevels = 1;
+
+	// uploaded as it is
+	if (scaled_width == width && scaled_height == height && !mipmap)
+	{
+		levels->levels[0] = (byte *)src;
+		return qtrue;
+	}
+
+	// all levels follow each other in one buffer
+	size = scaled_width * scaled_height * 4;
+	if (mipmap)
+	{
+		int w = scaled_width, h = scaled_height;
+
+		while (w > 1 || h > 1)
+		{
+			w     = w > 1 ? w >> 1 : 1;
+			h     = h > 1 ? h >> 1 : 1;
+			size += w * h * 4;
+		}
+	}
+
+	levels->levels[0] = R_GetImageWorkBuffer(work, IMAGEWORK_LEVELS, size);
+	if (!levels->levels[0])
+	{
+		return qfalse;
+	}
+
+	// use the normal mip-mapping function to go down from here
+	while (width > scaled_width || height > scaled_height)
+	{
+		dst = R_GetImageWorkBuffer(work, src == work->buffers[IMAGEWORK_MIP] ? IMAGEWORK_MIP2 : IMAGEWORK_MIP,
+		                           ((width >> 1) ? (width >> 1) : 1) * ((height >> 1) ? (height >> 1) : 1) * 4);
+		if (!dst)
+		{
+			return qfalse;
+		}
+		R_MipMap(src, width, height, dst);
+		src      = dst;
+		width  >>= 1;
+		height >>= 1;
+		if (width < 1)
+		{
+			width = 1;
+		}
+		if (height < 1)
+		{
+			height = 1;
+		}
+	}
+	Com_Memcpy(levels->levels[0], src, width * height * 4);
+
+	R_LightScaleTexture((unsigned *)levels->levels[0], scaled_width, scaled_height, !mipmap);
+
+	if (mipmap)
+	{
+		while (scaled_width > 1 || scaled_height > 1)
+		{
+			dst = levels->levels[levels->numLevels - 1] + scaled_width * scaled_height * 4;
+			R_MipMap(levels->levels[levels->numLevels - 1], scaled_width, scaled_height, dst);
+			scaled_width  >>= 1;
+			scaled_height >>= 1;
+			if (scaled_width < 1)
+			{
+				scaled_width = 1;
+			}
+			if (scaled_height < 1)
+			{
+				scaled_height = 1;
+			}
+
+			if (r_colorMipLevels->integer)
+			{
+				R_BlendOverTexture(dst, scaled_width * scaled_height, mipBlendColors[levels->numLevels]);
+			}
+
+			levels->levels[levels->numLevels++] = dst;
+		}
+	}
+
+	return qtrue;
+}
+
+/**
+ * @brief Selects the GL internal format of a texture
+ * @param[in] samples
+ * @param[in] lightMap
+ * @param[in] noCompress
+ * @return
+ */
+static GLenum R_ImageInternalFormat(int samples, qboolean lightMap, qboolean noCompress)
+{
+	if (lightMap)
+	{
+		return r_greyscale->integer ? GL_LUMINANCE : GL_RGB;
+	}
+
+	if (samples == 3)
+	{
+		if (r_greyscale->integer)
+		{
+			if (r_texturebits->integer == 16)
+			{
+				return GL_LUMINANCE8;
+			}
+			else if (r_texturebits->integer == 32)
+			{
+				return GL_LUMINANCE16;
+			}
+			return GL_LUMINANCE;
+		}
+
+		if (!noCompress && glConfig.textureCompression == TC_S3TC_ARB)
+		{
+			return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+		}
+		else if (!noCompress && glConfig.textureCompression == TC_S3TC)
+		{
+			return GL_RGB4_S3TC;
+		}
+		else if (r_texturebits->integer == 16)
+		{
+			return GL_RGB5;
+		}
+		else if (r_texturebits->integer == 32)
+		{
+			return GL_RGB8;
+		}
+		return GL_RGB;
+	}
+
+	if (r_greyscale->integer)
+	{
+		if (r_texturebits->integer == 16)
+		{
+			return GL_LUMINANCE8_ALPHA8;
+		}
+		else if (r_texturebits->integer == 32)
+		{
+			return GL_LUMINANCE16_ALPHA16;
+		}
+		return GL_LUMINANCE_ALPHA;
+	}
+
+	if (!noCompress && glConfig.textureCompression == TC_S3TC_ARB)
+	{
+		return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+	}
+	else if (r_texturebits->integer == 16)
+	{
+		return GL_RGBA4;
+	}
+	else if (r_texturebits->integer == 32)
+	{
+		return GL_RGBA8;
+	}
+	return GL_RGBA;
+}
+
+/**
+ * @brief Uploads the levels built by R_BuildImageLevels to the bound texture
+ * @param[in] levels
+ * @param[in] mipmap
+ * @param[in] lightMap
+ * @param[out] format
+ * @param[out] pUploadWidth
+ * @param[out] pUploadHeight
+ * @param[in] noCompress
+ */
+static void R_UploadImageLevels(const imageLevels_t *levels,
+                                qboolean mipmap,
+                                qboolean lightMap,
+                                int *format,
+                                int *pUploadWidth, int *pUploadHeight,
+                                qboolean noCompress)
+{
+	GLenum internalFormat = R_ImageInternalFormat(levels->samples, lightMap, noCompress);
+	int    width          = levels->width;
+	int    height         = levels->height;
+	int    i;
+
+	*pUploadWidth  = width;
+	*pUploadHeight = height;
+	*format        = internalFormat;
+
+	for (i = 0; i < levels->numLevels; i++)
+	{
+		qglTexImage2D(GL_TEXTURE_2D, i, internalFormat, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, levels->levels[i]);
+
+		width  = width > 1 ? width >> 1 : 1;
+		height = height > 1 ? height >> 1 : 1;
+	}
+
+	if (mipmap)
+	{
+		if (textureFilterAnisotropic)
+		{
+			qglTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT,
+			                 (GLint)Com_Clamp(1, maxAnisotropy, r_ext_max_anisotropy->integer));
+		}
+
+		qglTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, gl_filter_min);
+		qglTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, gl_filter_max);
+	}
+	else
+	{
+		if (textureFilterAnisotropic)
+		{
+			qglTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, 1);
+		}
+
+		qglTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		qglTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	}
+
+	GL_CheckErrors();
+}
+
+/*
+===============
+Upload32
+===============
+*/
+static void Upload32(unsigned *data,
+                     int width, int height,
+                     qboolean mipmap,
+                     qboolean picmip,
+                     qboolean lightMap,
+                     int *format,
+                     int *pUploadWidth, int *pUploadHeight,
+                     qboolean noCompress)
+{
+	imageLevels_t levels;
+
+	if (!R_BuildImageLevels(data, width, height, mipmap, picmip, lightMap, &imageWork, &levels))
+	{
+		Ren_Drop("Upload32: unable to allocate buffers for image with size: %ix%i\n", width, height);
+	}
+
+	R_UploadImageLevels(&levels, mipmap, lightMap, format, pUploadWidth, pUploadHeight, noCompress);
+}
+
+/*
+================
+R_ReferenceMipMap2
+
 Operates in place, quartering the size of the texture
 Proper linear filter
+
+The R_MipMap2 of the old in place Upload32, see R_BuildReferenceImageLevels
 ================
 */
-static void R_MipMap2(unsigned *in, int inWidth, int inHeight)
+static void R_ReferenceMipMap2(unsigned *in, int inWidth, int inHeight)
 {
 	int      i, j, k;
 	byte     *outpix;
@@ -455,12 +988,14 @@ static void R_MipMap2(unsigned *in, int inWidth, int inHeight)
 
 /*
 ================
-R_MipMap
+R_ReferenceMipMap
 
 Operates in place, quartering the size of the texture
+
+The R_MipMap of the old in place Upload32, see R_BuildReferenceImageLevels
 ================
 */
-static void R_MipMap(byte *in, int width, int height)
+static void R_ReferenceMipMap(byte *in, int width, int height)
 {
 	int  i, j;
 	byte *out;
@@ -468,7 +1003,7 @@ static void R_MipMap(byte *in, int width, int height)
 
 	if (!r_simpleMipMaps->integer)
 	{
-		R_MipMap2((unsigned *)in, width, height);
+		R_ReferenceMipMap2((unsigned *)in, width, height);
 		return;
 	}
 
@@ -507,68 +1042,57 @@ static void R_MipMap(byte *in, int width, int height)
 	}
 }
 
-/*
-==================
-R_BlendOverTexture
-
-Apply a color blend over a set of pixels
-==================
-*/
-static void R_BlendOverTexture(byte *data, int pixelCount, byte blend[4])
+/**
+ * @brief Keeps a level the reference pipeline would upload
+ * @param[in,out] levels
+ * @param[in] data
+ * @param[in] width
+ * @param[in] height
+ */
+static void R_AddReferenceImageLevel(imageLevels_t *levels, const void *data, int width, int height)
 {
-	int i;
-	int inverseAlpha = 255 - blend[3];
-	int premult[3]   = { blend[0] * blend[3], blend[1] * blend[3], blend[2] * blend[3] };
+	byte *level;
 
-	for (i = 0 ; i < pixelCount ; i++, data += 4)
+	if (levels->numLevels >= MAX_IMAGE_LEVELS)
 	{
-		data[0] = (data[0] * inverseAlpha + premult[0]) >> 9;
-		data[1] = (data[1] * inverseAlpha + premult[1]) >> 9;
-		data[2] = (data[2] * inverseAlpha + premult[2]) >> 9;
+		return;
 	}
-}
 
-byte mipBlendColors[16][4] =
-{
-	{ 0,   0,   0,   0   },
-	{ 255, 0,   0,   128 },
-	{ 0,   255, 0,   128 },
-	{ 0,   0,   255, 128 },
-	{ 255, 0,   0,   128 },
-	{ 0,   255, 0,   128 },
-	{ 0,   0,   255, 128 },
-	{ 255, 0,   0,   128 },
-	{ 0,   255, 0,   128 },
-	{ 0,   0,   255, 128 },
-	{ 255, 0,   0,   128 },
-	{ 0,   255, 0,   128 },
-	{ 0,   0,   255, 128 },
-	{ 255, 0,   0,   128 },
-	{ 0,   255, 0,   128 },
-	{ 0,   0,   255, 128 },
-};
+	level = malloc(width * height * 4);
+	if (!level)
+	{
+		Ren_Drop("R_AddReferenceImageLevel: unable to allocate level of size: %ix%i\n", width, height);
+	}
+	Com_Memcpy(level, data, width * height * 4);
 
-/*
-===============
-Upload32
-===============
-*/
-static void Upload32(unsigned *data,
-                     int width, int height,
-                     qboolean mipmap,
-                     qboolean picmip,
-                     qboolean lightMap,
-                     int *format,
-                     int *pUploadWidth, int *pUploadHeight,
-                     qboolean noCompress)
+	levels->levels[levels->numLevels++] = level;
+}
+
+/**
+ * @brief Builds the texture levels with the old in place Upload32, which
+ * R_BuildImageLevels must match
+ * @param[in,out] data 32 bit picture, it is overwritten
+ * @param[in] width
+ * @param[in] height
+ * @param[in] mipmap
+ * @param[in] picmip
+ * @param[in] lightMap
+ * @param[out] levels free them with R_FreeReferenceImageLevels
+ *
+ * @note This is the CPU part of Upload32 before the image prefetch, the levels
+ * are kept instead of being sent to GL, so it runs without a GL context.
+ */
+void R_BuildReferenceImageLevels(unsigned *data, int width, int height,
+                                 qboolean mipmap, qboolean picmip, qboolean lightMap,
+                                 imageLevels_t *levels)
 {
-	int      samples;
 	unsigned *scaledBuffer    = NULL;
 	unsigned *resampledBuffer = NULL;
 	int      scaled_width, scaled_height;
-	int      c;
+	int      c, i;
 	byte     *scan;
-	GLenum   internalFormat = GL_RGB;
+
+	Com_Memset(levels, 0, sizeof(*levels));
 
 	// convert to exact power of 2 sizes
 	for (scaled_width = 1 ; scaled_width < width ; scaled_width <<= 1)
@@ -613,151 +1137,43 @@ static void Upload32(unsigned *data,
 	// clamp to the current upper OpenGL limit
 	// scale both axis down equally so we don't have to
 	// deal with a half mip resampling
-	while (scaled_width > glConfig.maxTextureSize
-	       || scaled_height > glConfig.maxTextureSize)
+	while (glConfig.maxTextureSize > 0 &&
+	       (scaled_width > glConfig.maxTextureSize || scaled_height > glConfig.maxTextureSize))
 	{
 		scaled_width  >>= 1;
 		scaled_height >>= 1;
 	}
 
-	//scaledBuffer = ri.Hunk_AllocateTempMemory( sizeof( unsigned ) * scaled_width * scaled_height );
 	scaledBuffer = R_GetImageBuffer(sizeof(unsigned) * scaled_width * scaled_height, BUFFER_SCALED, "resample");
 
-	// scan the texture for each channel's max values
-	// and verify if the alpha channel is being used or not
-	c       = width * height;
-	scan    = ((byte *)data);
-	samples = 3;
+	// verify if the alpha channel is being used or not
+	c               = width * height;
+	scan            = ((byte *)data);
+	levels->samples = 3;
 
-	if (lightMap)
-	{
-		if (r_greyscale->integer)
-		{
-			internalFormat = GL_LUMINANCE;
-		}
-		else
-		{
-			internalFormat = GL_RGB;
-		}
-	}
-	else
+	if (!lightMap)
 	{
-		float rMax = 0, gMax = 0, bMax = 0;
-		int   i;
-
 		for (i = 0; i < c; i++)
 		{
-			if (scan[i * 4 + 0] > rMax)
-			{
-				rMax = scan[i * 4 + 0];
-			}
-			if (scan[i * 4 + 1] > gMax)
-			{
-				gMax = scan[i * 4 + 1];
-			}
-			if (scan[i * 4 + 2] > bMax)
-			{
-				bMax = scan[i * 4 + 2];
-			}
 			if (scan[i * 4 + 3] != 255)
 			{
-				samples = 4;
+				levels->samples = 4;
 				break;
 			}
 		}
-		// select proper internal format
-		if (samples == 3)
-		{
-			if (r_greyscale->integer)
-			{
-				if (r_texturebits->integer == 16)
-				{
-					internalFormat = GL_LUMINANCE8;
-				}
-				else if (r_texturebits->integer == 32)
-				{
-					internalFormat = GL_LUMINANCE16;
-				}
-				else
-				{
-					internalFormat = GL_LUMINANCE;
-				}
-			}
-			else
-			{
-				if (!noCompress && glConfig.textureCompression == TC_S3TC_ARB)
-				{
-					internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
-				}
-				else if (!noCompress && glConfig.textureCompression == TC_S3TC)
-				{
-					internalFormat = GL_RGB4_S3TC;
-				}
-				else if (r_texturebits->integer == 16)
-				{
-					internalFormat = GL_RGB5;
-				}
-				else if (r_texturebits->integer == 32)
-				{
-					internalFormat = GL_RGB8;
-				}
-				else
-				{
-					internalFormat = GL_RGB;
-				}
-			}
-		}
-		else if (samples == 4)
-		{
-			if (r_greyscale->integer)
-			{
-				if (r_texturebits->integer == 16)
-				{
-					internalFormat = GL_LUMINANCE8_ALPHA8;
-				}
-				else if (r_texturebits->integer == 32)
-				{
-					internalFormat = GL_LUMINANCE16_ALPHA16;
-				}
-				else
-				{
-					internalFormat = GL_LUMINANCE_ALPHA;
-				}
-			}
-			else
-			{
-				if (!noCompress && glConfig.textureCompression == TC_S3TC_ARB)
-				{
-					internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
-				}
-				else if (r_texturebits->integer == 16)
-				{
-					internalFormat = GL_RGBA4;
-				}
-				else if (r_texturebits->integer == 32)
-				{
-					internalFormat = GL_RGBA8;
-				}
-				else
-				{
-					internalFormat = GL_RGBA;
-				}
-			}
-		}
 	}
 
+	levels->width  = scaled_width;
+	levels->height = scaled_height;
+
 	// copy or resample data as appropriate for first MIP level
 	if ((scaled_width == width) &&
 	    (scaled_height == height))
 	{
 		if (!mipmap)
 		{
-			qglTexImage2D(GL_TEXTURE_2D, 0, internalFormat, scaled_width, scaled_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-			*pUploadWidth  = scaled_width;
-			*pUploadHeight = scaled_height;
-			*format        = internalFormat;
-
-			goto done;
+			R_AddReferenceImageLevel(levels, data, scaled_width, scaled_height);
+			return;
 		}
 		Com_Memcpy(scaledBuffer, data, width * height * 4);
 	}
@@ -766,7 +1182,7 @@ static void Upload32(unsigned *data,
 		// use the normal mip-mapping function to go down from here
 		while (width > scaled_width || height > scaled_height)
 		{
-			R_MipMap((byte *)data, width, height);
+			R_ReferenceMipMap((byte *)data, width, height);
 			width  >>= 1;
 			height >>= 1;
 			if (width < 1)
@@ -783,11 +1199,7 @@ static void Upload32(unsigned *data,
 
 	R_LightScaleTexture(scaledBuffer, scaled_width, scaled_height, !mipmap);
 
-	*pUploadWidth  = scaled_width;
-	*pUploadHeight = scaled_height;
-	*format        = internalFormat;
-
-	qglTexImage2D(GL_TEXTURE_2D, 0, internalFormat, scaled_width, scaled_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, scaledBuffer);
+	R_AddReferenceImageLevel(levels, scaledBuffer, scaled_width, scaled_height);
 
 	if (mipmap)
 	{
@@ -795,7 +1207,7 @@ static void Upload32(unsigned *data,
 
 		while (scaled_width > 1 || scaled_height > 1)
 		{
-			R_MipMap((byte *)scaledBuffer, scaled_width, scaled_height);
+			R_ReferenceMipMap((byte *)scaledBuffer, scaled_width, scaled_height);
 			scaled_width  >>= 1;
 			scaled_height >>= 1;
 			if (scaled_width < 1)
@@ -813,45 +1225,143 @@ static void Upload32(unsigned *data,
 				R_BlendOverTexture((byte *)scaledBuffer, scaled_width * scaled_height, mipBlendColors[miplevel]);
 			}
 
-			qglTexImage2D(GL_TEXTURE_2D, miplevel, internalFormat, scaled_width, scaled_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, scaledBuffer);
+			R_AddReferenceImageLevel(levels, scaledBuffer, scaled_width, scaled_height);
 		}
 	}
-done:
+}
 
-	if (mipmap)
+/**
+ * @brief Frees the levels built by R_BuildReferenceImageLevels
+ * @param[in,out] levels
+ */
+void R_FreeReferenceImageLevels(imageLevels_t *levels)
+{
+	int i;
+
+	for (i = 0; i < levels->numLevels; i++)
 	{
-		if (textureFilterAnisotropic)
+		free(levels->levels[i]);
+	}
+	Com_Memset(levels, 0, sizeof(*levels));
+}
+
+/**
+ * @brief Compares the levels of an image with the reference ones
+ * @param[in] name printed if they differ
+ * @param[in] levels
+ * @param[in] reference built by R_BuildReferenceImageLevels
+ * @return qtrue if all levels are the same
+ */
+qboolean R_CompareImageLevels(const char *name, const imageLevels_t *levels, const imageLevels_t *reference)
+{
+	int i, w, h;
+
+	if (levels->width != reference->width || levels->height != reference->height
+	    || levels->samples != reference->samples || levels->numLevels != reference->numLevels)
+	{
+		Ren_Print("^1%s: %ix%i %i levels, reference %ix%i %i levels\n", name,
+		          levels->width, levels->height, levels->numLevels,
+		          reference->width, reference->height, reference->numLevels);
+		return qfalse;
+	}
+
+	for (i = 0, w = levels->width, h = levels->height; i < levels->numLevels; i++)
+	{
+		if (memcmp(levels->levels[i], reference->levels[i], w * h * 4))
 		{
-			qglTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT,
-			                 (GLint)Com_Clamp(1, maxAnisotropy, r_ext_max_anisotropy->integer));
+			Ren_Print("^1%s: level %i differs\n", name, i);
+			return qfalse;
 		}
-
-		qglTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, gl_filter_min);
-		qglTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, gl_filter_max);
+		w = w > 1 ? w >> 1 : 1;
+		h = h > 1 ? h >> 1 : 1;
 	}
-	else
+
+	return qtrue;
+}
+
+/**
+ * @brief Compares R_BuildImageLevels with the old in place Upload32 on random
+ * pictures of odd and even sizes
+ * @param[in] rounds
+ * @return number of pictures whose levels differ
+ *
+ * @note Doesn't need a GL context or any files.
+ */
+int R_TestImageLevels(int rounds)
+{
+	static const int sizes[][2] =
 	{
-		if (textureFilterAnisotropic)
+		{ 256, 256 }, { 512, 128 }, { 1, 256 }, { 256, 1 }, { 1, 1 }, { 300, 200 }, { 64, 64 },
+		{ 4096, 16 }, { 200, 3 },   { 2, 2 },   { 1024, 1024 }, { 3, 3 }, { 100, 1 }
+	};
+	imageWork_t   work;
+	imageLevels_t levels, reference;
+	unsigned      *pic, *copy;
+	int           round, i, width, height, seed = 1, differing = 0;
+	char          name[MAX_QPATH];
+	qboolean      mipmap, picmip, lightMap;
+
+	Com_Memset(&work, 0, sizeof(work));
+
+	for (round = 0; round < rounds; round++)
+	{
+		width    = sizes[round % ARRAY_LEN(sizes)][0];
+		height   = sizes[round % ARRAY_LEN(sizes)][1];
+		mipmap   = (round >> 1) & 1;
+		picmip   = (round >> 2) & 1;
+		lightMap = (round >> 3) & 1;
+
+		pic  = malloc(width * height * 4);
+		copy = malloc(width * height * 4);
+		if (!pic || !copy)
 		{
-			qglTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, 1);
+			Ren_Drop("R_TestImageLevels: unable to allocate picture of size: %ix%i\n", width, height);
 		}
 
-		qglTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		qglTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		// every other picture is opaque
+		for (i = 0; i < width * height; i++)
+		{
+			pic[i] = ((unsigned)Q_rand(&seed) >> 16) | ((unsigned)Q_rand(&seed) & 0xffff0000);
+			if (round & 1)
+			{
+				((byte *)&pic[i])[3] = 255;
+			}
+		}
+		Com_Memcpy(copy, pic, width * height * 4);
+
+		Com_sprintf(name, sizeof(name), "%ix%i%s%s%s", width, height, mipmap ? " mipmap" : "", picmip ? " picmip" : "", lightMap ? " lightmap" : "");
+
+		R_BuildReferenceImageLevels(copy, width, height, mipmap, picmip, lightMap, &reference);
+		if (!R_BuildImageLevels(pic, width, height, mipmap, picmip, lightMap, &work, &levels))
+		{
+			Ren_Print("^1%s: failed to build\n", name);
+			differing++;
+		}
+		else if (!R_CompareImageLevels(name, &levels, &reference))
+		{
+			differing++;
+		}
+
+		R_FreeReferenceImageLevels(&reference);
+		free(pic);
+		free(copy);
 	}
 
-	GL_CheckErrors();
+	R_FreeImageWork(&work);
+
+	return differing;
 }
 
 /*
 ================
-R_CreateImage
+R_CreateImageExt
 
-This is the only way any image_t are created
+This is the only way any image_t are created, either from
+a picture or from levels built by R_BuildImageLevels
 ================
 */
-image_t *R_CreateImage(const char *name, const byte *pic, int width, int height,
-                       qboolean mipmap, qboolean allowPicmip, int glWrapClampMode)
+static image_t *R_CreateImageExt(const char *name, const byte *pic, const imageLevels_t *levels, int width, int height,
+                                 qboolean mipmap, qboolean allowPicmip, int glWrapClampMode)
 {
 	image_t  *image;
 	qboolean isLightmap = qfalse;
@@ -928,14 +1438,25 @@ image_t *R_CreateImage(const char *name, const byte *pic, int width, int height,
 
 	GL_Bind(image);
 
-	Upload32((unsigned *)pic, image->width, image->height,
-	         image->mipmap,
-	         allowPicmip,
-	         isLightmap,
-	         &image->internalFormat,
-	         &image->uploadWidth,
-	         &image->uploadHeight,
-	         noCompress);
+	if (levels)
+	{
+		R_UploadImageLevels(levels, image->mipmap, isLightmap,
+		                    &image->internalFormat,
+		                    &image->uploadWidth,
+		                    &image->uploadHeight,
+		                    noCompress);
+	}
+	else
+	{
+		Upload32((unsigned *)pic, image->width, image->height,
+		         image->mipmap,
+		         allowPicmip,
+		         isLightmap,
+		         &image->internalFormat,
+		         &image->uploadWidth,
+		         &image->uploadHeight,
+		         noCompress);
+	}
 
 	qglTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, glWrapClampMode);
 	qglTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, glWrapClampMode);
@@ -956,24 +1477,53 @@ image_t *R_CreateImage(const char *name, const byte *pic, int width, int height,
 	return image;
 }
 
+/*
+================
+R_CreateImage
+================
+*/
+image_t *R_CreateImage(const char *name, const byte *pic, int width, int height,
+                       qboolean mipmap, qboolean allowPicmip, int glWrapClampMode)
+{
+	return R_CreateImageExt(name, pic, NULL, width, height, mipmap, allowPicmip, glWrapClampMode);
+}
+
+/**
+ * @brief Creates an image from levels built by R_BuildImageLevels
+ * @param[in] name
+ * @param[in] levels
+ * @param[in] width size of the picture the levels were built from
+ * @param[in] height
+ * @param[in] mipmap
+ * @param[in] allowPicmip
+ * @param[in] glWrapClampMode
+ * @return
+ */
+image_t *R_CreateImageFromLevels(const char *name, const imageLevels_t *levels, int width, int height,
+                                 qboolean mipmap, qboolean allowPicmip, int glWrapClampMode)
+{
+	return R_CreateImageExt(name, NULL, levels, width, height, mipmap, allowPicmip, glWrapClampMode);
+}
+
 //===================================================================
 
 typedef struct
 {
 	char *ext;
 	void (*ImageLoader)(const char *, unsigned char **, int *, int *, byte);
+	imageDecoder_t ImageDecoder;    ///< thread safe decoder of the file in memory, NULL if there is none
 } imageExtToLoaderMap_t;
 
 // Note that the ordering indicates the order of preference used
 // when there are multiple images of different formats available
 static imageExtToLoaderMap_t imageLoaders[] =
 {
-	{ "tga",  R_LoadTGA },
-	{ "png",  R_LoadPNG },
-	{ "jpg",  R_LoadJPG },
-	{ "jpeg", R_LoadJPG },
-	{ "pcx",  R_LoadPCX },
-	{ "bmp",  R_LoadBMP }
+	{ "tga",  R_LoadTGA, R_DecodeTGA },
+	{ "png",  R_LoadPNG, R_DecodePNG },
+	{ "jpg",  R_LoadJPG, R_DecodeJPG },
+	{ "jpeg", R_LoadJPG, R_DecodeJPG },
+	{ "pcx",  R_LoadPCX, NULL        },
+	{ "bmp",  R_LoadBMP, NULL        }
 };
 
 static int numImageLoaders = sizeof(imageLoaders) / sizeof(imageLoaders[0]);
@@ -1021,6 +1571,65 @@ void R_LoadImage(const char *name, byte **pic, int *width, int *height)
 	}
 }
 
+/**
+ * @brief Reads the file R_LoadImage would load first for the given image name
+ * so it can be decoded away from the main thread.
+ * @param[in] name
+ * @param[out] file malloc'ed copy of the file, to be freed by the caller
+ * @param[out] length
+ * @return The decoder of the file format, NULL if the file is missing or its
+ * format can only be loaded on the main thread
+ */
+imageDecoder_t R_ReadImageFile(const char *name, byte **file, int *length)
+{
+	int  i;
+	char localName[MAX_QPATH];
+	char *altName;
+	union
+	{
+		byte *b;
+		void *v;
+	} buffer;
+
+	*file   = NULL;
+	*length = 0;
+
+	COM_StripExtension(name, localName, MAX_QPATH);
+
+	for (i = 0; i < numImageLoaders; i++)
+	{
+		altName = va("%s.%s", localName, imageLoaders[i].ext);
+
+		if (!ri.FS_FOpenFileRead(altName, NULL, qfalse))
+		{
+			continue;
+		}
+
+		if (!imageLoaders[i].ImageDecoder)
+		{
+			return NULL;
+		}
+
+		*length = ri.FS_ReadFile(altName, &buffer.v);
+		if (!buffer.b)
+		{
+			return NULL;
+		}
+
+		// the hunk file buffer can't be handed to another thread
+		*file = malloc(*length > 0 ? *length : 1);
+		if (*file)
+		{
+			Com_Memcpy(*file, buffer.b, *length);
+		}
+		ri.FS_FreeFile(buffer.v);
+
+		return *file ? imageLoaders[i].ImageDecoder : NULL;
+	}
+
+	return NULL;
+}
+
 /*
 ===============
 R_FindImageFile
@@ -1087,6 +1696,16 @@ image_t *R_FindImageFile(const char *name, qboolean mipmap, qboolean allowPicmip
 		}
 	}
 
+	// the map image prefetch may have it ready
+	if (!lightmap)
+	{
+		image = R_FindPrefetchedImage(name, mipmap, allowPicmip, glWrapClampMode);
+		if (image != NULL)
+		{
+			return image;
+		}
+	}
+
 	// load the pic from disk
 	R_LoadImage(name, &pic, &width, &height);
 	if (pic == NULL)
@@ -2006,6 +2625,38 @@ qboolean R_TouchImage(image_t *inImage)
 	return qtrue;
 }
 
+/**
+ * @brief Checks if an image is loaded or in the image cache
+ * @param[in] name
+ * @return
+ */
+qboolean R_ImageLoaded(const char *name)
+{
+	image_t *image;
+	long    hash = generateHashValue(name);
+
+	for (image = hashTable[hash]; image; image = image->next)
+	{
+		if (!strcmp(name, image->imgName))
+		{
+			return qtrue;
+		}
+	}
+
+	if (r_cacheShaders->integer)
+	{
+		for (image = backupHashTable[hash]; image; image = image->next)
+		{
+			if (!Q_stricmp(name, image->imgName))
+			{
+				return qtrue;
+			}
+		}
+	}
+
+	return qfalse;
+}
+
 /*
 ===============
 R_PurgeImage
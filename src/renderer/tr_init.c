@@ -174,6 +174,7 @@ cvar_t *r_cacheShaders;
 cvar_t *r_cacheModels;
 
 cvar_t *r_cacheGathering;
+cvar_t *r_prefetchImages;
 
 cvar_t *r_bonesDebug;
 
@@ -1184,6 +1185,7 @@ void R_Register(void)
 
 	r_cacheModels    = ri.Cvar_Get("r_cacheModels", "1", CVAR_LATCH);
 	r_cacheGathering = ri.Cvar_Get("cl_cacheGathering", "0", 0);
+	r_prefetchImages = ri.Cvar_Get("r_prefetchImages", "1", CVAR_ARCHIVE);
 	r_bonesDebug     = ri.Cvar_Get("r_bonesDebug", "0", CVAR_CHEAT);
 
 	r_wolffog = ri.Cvar_Get("r_wolffog", "1", CVAR_ARCHIVE);
@@ -1253,6 +1255,7 @@ void R_Register(void)
 	ri.Cmd_AddCommand("gfxinfo", GfxInfo_f);
 	ri.Cmd_AddCommand("taginfo", R_TagInfo_f);
 	ri.Cmd_AddCommand("minimize", GLimp_Minimize);
+	ri.Cmd_AddCommand("imageprefetchtest", R_ImagePrefetchTest_f);
 }
 
 /*
@@ -1376,6 +1379,9 @@ void RE_Shutdown(qboolean destroyWindow)
 	ri.Cmd_RemoveCommand("gfxinfo");
 	ri.Cmd_RemoveCommand("minimize");
 	ri.Cmd_RemoveCommand("taginfo");
+	ri.Cmd_RemoveCommand("imageprefetchtest");
+
+	R_FinishImagePrefetch();
 
 	// keep a backup of the current images if possible
 	// clean out any remaining unused media from the last backup
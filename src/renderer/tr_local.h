@@ -102,6 +102,39 @@ typedef struct image_s
 	struct image_s *next;
 } image_t;
 
+#define MAX_IMAGE_LEVELS        16  // enough for 32768 x 32768 textures
+
+/**
+ * @struct imageLevels_s
+ * @brief Texture levels ready to be uploaded, see R_BuildImageLevels
+ */
+typedef struct imageLevels_s
+{
+	int width, height;              // size of the first level
+	int samples;                    // 4 if the alpha channel is used
+	int numLevels;
+	byte *levels[MAX_IMAGE_LEVELS];
+} imageLevels_t;
+
+typedef enum
+{
+	IMAGEWORK_RESAMPLED,
+	IMAGEWORK_MIP,
+	IMAGEWORK_MIP2,
+	IMAGEWORK_LEVELS,
+	IMAGEWORK_MAX_BUFFERS
+} imageWorkBuffer_t;
+
+/**
+ * @struct imageWork_s
+ * @brief Buffers R_BuildImageLevels works in, one set per thread
+ */
+typedef struct imageWork_s
+{
+	byte *buffers[IMAGEWORK_MAX_BUFFERS];
+	int sizes[IMAGEWORK_MAX_BUFFERS];
+} imageWork_t;
+
 //===============================================================================
 
 typedef enum
@@ -1344,10 +1377,31 @@ qhandle_t RE_GetShaderFromModel(qhandle_t modelid, int surfnum, int withlightmap
 model_t *R_AllocModel(void);
 
 void R_Init(void);
+void R_LoadImage(const char *name, byte **pic, int *width, int *height);
+imageDecoder_t R_ReadImageFile(const char *name, byte **file, int *length);
 image_t *R_FindImageFile(const char *name, qboolean mipmap, qboolean allowPicmip, int glWrapClampMode, qboolean lightmap);
 
 image_t *R_CreateImage(const char *name, const byte *pic, int width, int height, qboolean mipmap
                        , qboolean allowPicmip, int wrapClampMode);
+qboolean R_BuildImageLevels(const unsigned *data, int width, int height,
+                            qboolean mipmap, qboolean picmip, qboolean lightMap,
+                            imageWork_t *work, imageLevels_t *levels);
+void R_FreeImageWork(imageWork_t *work);
+void R_BuildReferenceImageLevels(unsigned *data, int width, int height,
+                                 qboolean mipmap, qboolean picmip, qboolean lightMap,
+                                 imageLevels_t *levels);
+void R_FreeReferenceImageLevels(imageLevels_t *levels);
+qboolean R_CompareImageLevels(const char *name, const imageLevels_t *levels, const imageLevels_t *reference);
+int R_TestImageLevels(int rounds);
+qboolean R_ImageLoaded(const char *name);
+
+image_t *R_CreateImageFromLevels(const char *name, const imageLevels_t *levels, int width, int height,
+                                 qboolean mipmap, qboolean allowPicmip, int wrapClampMode);
+
+void R_PrefetchImages(const dshader_t *shaders, int numShaders, qboolean loadedImages);
+image_t *R_FindPrefetchedImage(const char *name, qboolean mipmap, qboolean allowPicmip, int glWrapClampMode);
+void R_FinishImagePrefetch(void);
+void R_ImagePrefetchTest_f(void);
 qboolean R_GetModeInfo(int *width, int *height, float *windowAspect, int mode);
 
 void R_SetColorMappings(void);
@@ -1381,6 +1435,7 @@ shader_t *R_FindShader(const char *name, int lightmapIndex, qboolean mipRawImage
 shader_t *R_GetShaderByHandle(qhandle_t hShader);
 shader_t *R_FindShaderByName(const char *name);
 void R_InitShaders(void);
+void R_ListShaderImages(const char *name, void (*addImage)(const char *imageName, qboolean mipmap, qboolean allowPicmip));
 void R_ShaderList_f(void);
 void R_RemapShader(const char *oldShader, const char *newShader, const char *timeOffset);
 
@@ -0,0 +1,624 @@
+/*
+ * Wolfenstein: Enemy Territory GPL Source Code
+ * Copyright (C) 1999-2010 id Software LLC, a ZeniMax Media company.
+ *
+ * ET: Legacy
+ * Copyright (C) 2012 Jan Simek <mail@etlegacy.com>
+ *
+ * This file is part of ET: Legacy - http://www.etlegacy.com
+ *
+ * ET: Legacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ET: Legacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ET: Legacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * In addition, Wolfenstein: Enemy Territory GPL Source Code is also
+ * subject to certain additional terms. You should have received a copy
+ * of these additional terms immediately following the terms and conditions
+ * of the GNU General Public License which accompanied the source code.
+ * If not, please request a copy in writing from id Software at the address below.
+ *
+ * id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+ */
+/**
+ * @file renderer/tr_prefetch.c
+ * @brief Threaded image prefetch for map loads
+ *
+ * RE_LoadWorldMap lists the images of the map shaders before it loads
+ * the surfaces. Their files are read on the main thread, as the file system
+ * isn't thread safe, while worker threads decode them into buffers of their
+ * own, resample them and build their mip levels. R_FindImageFile then only
+ * has to upload the levels when the shader asks for the image.
+ *
+ * Formats without a thread safe decoder (pcx, bmp) are decoded on the main
+ * thread and only their levels are built by the workers.
+ */
+
+#include "tr_local.h"
+#include "../sdl/sdl_defs.h"
+
+#define MAX_PREFETCH_IMAGES     1024
+#define MAX_PREFETCH_THREADS    8
+#define PREFETCH_HASH_SIZE      1024
+#define PREFETCH_MAX_MEMORY     (256 * 1024 * 1024) // pictures and levels prefetched for a map
+
+typedef enum
+{
+	PREFETCH_FAILED,                // not decoded, left to the normal path
+	PREFETCH_PENDING,               // waiting for a worker
+	PREFETCH_BUILDING,
+	PREFETCH_READY,
+	PREFETCH_USED
+} prefetchState_t;
+
+typedef struct prefetchImage_s
+{
+	char name[MAX_QPATH];
+	qboolean mipmap;
+	qboolean allowPicmip;
+	int width, height;              // size of the picture
+
+	byte *file;                     // read on the main thread, decoded by a worker
+	int fileLength;
+	imageDecoder_t decode;
+
+	byte *pic;
+	byte *data;                     // buffer of the levels if they aren't the picture itself
+	imageLevels_t levels;
+
+	SDL_atomic_t state;             // prefetchState_t
+	struct prefetchImage_s *hashNext;
+} prefetchImage_t;
+
+static struct
+{
+	prefetchImage_t images[MAX_PREFETCH_IMAGES];
+	int numImages;
+	prefetchImage_t *hashTable[PREFETCH_HASH_SIZE];
+	qboolean loadedImages;          // list images which are loaded already
+	SDL_atomic_t memory;            // files, pictures and levels, the workers account what they decode
+
+	// images for the workers
+	prefetchImage_t *queue[MAX_PREFETCH_IMAGES];
+	int numQueued;
+	SDL_atomic_t next;
+	SDL_sem *queued;
+
+	SDL_Thread *threads[MAX_PREFETCH_THREADS];
+	int numThreads;
+	SDL_atomic_t quit;
+
+	imageWork_t work;               // for images built on the main thread
+} prefetch;
+
+/**
+ * @brief Finds a listed image
+ * @param[in] name
+ * @return
+ */
+static prefetchImage_t *R_GetPrefetchImage(const char *name)
+{
+	prefetchImage_t *image;
+
+	for (image = prefetch.hashTable[Q_GenerateHashValue(name, PREFETCH_HASH_SIZE, qfalse, qtrue)]; image; image = image->hashNext)
+	{
+		if (!strcmp(name, image->name))
+		{
+			return image;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Adds an image of a map shader to the prefetch, see R_ListShaderImages
+ * @param[in] name
+ * @param[in] mipmap
+ * @param[in] allowPicmip
+ */
+static void R_AddPrefetchImage(const char *name, qboolean mipmap, qboolean allowPicmip)
+{
+	prefetchImage_t *image;
+	long            hash;
+
+	if (prefetch.numImages == MAX_PREFETCH_IMAGES || strlen(name) >= MAX_QPATH)
+	{
+		return;
+	}
+
+	if (R_GetPrefetchImage(name) || (!prefetch.loadedImages && R_ImageLoaded(name)))
+	{
+		return;
+	}
+
+	image = &prefetch.images[prefetch.numImages++];
+	Q_strncpyz(image->name, name, sizeof(image->name));
+	image->mipmap      = mipmap;
+	image->allowPicmip = allowPicmip;
+	SDL_AtomicSet(&image->state, PREFETCH_FAILED);
+
+	hash                     = Q_GenerateHashValue(name, PREFETCH_HASH_SIZE, qfalse, qtrue);
+	image->hashNext          = prefetch.hashTable[hash];
+	prefetch.hashTable[hash] = image;
+}
+
+/**
+ * @brief Queues an image for the workers
+ * @param[in,out] image
+ */
+static void R_QueuePrefetchImage(prefetchImage_t *image)
+{
+	SDL_AtomicSet(&image->state, PREFETCH_PENDING);
+	prefetch.queue[prefetch.numQueued++] = image;
+	if (prefetch.queued)
+	{
+		SDL_SemPost(prefetch.queued);
+	}
+}
+
+/**
+ * @brief Reads the file of an image and queues it for the workers
+ * @param[in,out] image
+ *
+ * @note Formats which can't be decoded by the workers are decoded here.
+ */
+static void R_ReadPrefetchImage(prefetchImage_t *image)
+{
+	byte *pic;
+	int  size;
+
+	if (SDL_AtomicGet(&prefetch.memory) > PREFETCH_MAX_MEMORY)
+	{
+		return;
+	}
+
+	image->decode = R_ReadImageFile(image->name, &image->file, &image->fileLength);
+	if (image->decode)
+	{
+		SDL_AtomicAdd(&prefetch.memory, image->fileLength);
+		R_QueuePrefetchImage(image);
+		return;
+	}
+
+	R_LoadImage(image->name, &pic, &image->width, &image->height);
+	if (!pic)
+	{
+		return;
+	}
+
+	// R_FindImageFile reports it
+	if (((image->width - 1) & image->width) || ((image->height - 1) & image->height))
+	{
+		return;
+	}
+
+	size = image->width * image->height * 4;
+	if (SDL_AtomicGet(&prefetch.memory) + 2 * size > PREFETCH_MAX_MEMORY)
+	{
+		return;
+	}
+
+	// R_LoadImage reuses its buffer for the next image
+	image->pic = malloc(size);
+	if (!image->pic)
+	{
+		return;
+	}
+	Com_Memcpy(image->pic, pic, size);
+	SDL_AtomicAdd(&prefetch.memory, 2 * size);
+
+	R_QueuePrefetchImage(image);
+}
+
+/**
+ * @brief Decodes the file of an image into a picture of its own
+ * @param[in,out] image
+ * @return qfalse if the image is left to the normal path
+ */
+static qboolean R_DecodePrefetchImage(prefetchImage_t *image)
+{
+	imageDecode_t decode;
+	qboolean      decoded;
+	int           size;
+
+	Com_Memset(&decode, 0, sizeof(decode));
+	decode.name      = image->name;
+	decode.buffer    = image->file;
+	decode.length    = image->fileLength;
+	decode.alphaByte = 0xFF;
+	decode.threaded  = qtrue;
+
+	decoded = image->decode(&decode);
+
+	free(image->file);
+	image->file = NULL;
+	SDL_AtomicAdd(&prefetch.memory, -image->fileLength);
+
+	if (!decoded)
+	{
+		free(decode.pic);
+		return qfalse;
+	}
+
+	image->pic    = decode.pic;
+	image->width  = decode.width;
+	image->height = decode.height;
+
+	// R_FindImageFile reports it
+	if (((image->width - 1) & image->width) || ((image->height - 1) & image->height))
+	{
+		return qfalse;
+	}
+
+	size = image->width * image->height * 4;
+	if (SDL_AtomicAdd(&prefetch.memory, 2 * size) + 2 * size > PREFETCH_MAX_MEMORY)
+	{
+		SDL_AtomicAdd(&prefetch.memory, -2 * size);
+		return qfalse;
+	}
+
+	return qtrue;
+}
+
+/**
+ * @brief Builds the levels of an image unless somebody else does
+ * @param[in,out] image
+ * @param[in,out] work
+ */
+static void R_BuildPrefetchImage(prefetchImage_t *image, imageWork_t *work)
+{
+	int i;
+
+	if (!SDL_AtomicCAS(&image->state, PREFETCH_PENDING, PREFETCH_BUILDING))
+	{
+		return;
+	}
+
+	if (image->file && !R_DecodePrefetchImage(image))
+	{
+		free(image->pic);
+		image->pic = NULL;
+		SDL_AtomicSet(&image->state, PREFETCH_FAILED);
+		return;
+	}
+
+	if (!R_BuildImageLevels((unsigned *)image->pic, image->width, image->height, image->mipmap, image->allowPicmip, qfalse, work, &image->levels))
+	{
+		SDL_AtomicSet(&image->state, PREFETCH_FAILED);
+		return;
+	}
+
+	// keep the buffer the levels were built in, the work gets a new one
+	if (image->levels.levels[0] != image->pic)
+	{
+		for (i = 0; i < IMAGEWORK_MAX_BUFFERS; i++)
+		{
+			if (work->buffers[i] == image->levels.levels[0])
+			{
+				image->data       = work->buffers[i];
+				work->buffers[i]  = NULL;
+				work->sizes[i]    = 0;
+				break;
+			}
+		}
+
+		free(image->pic);
+		image->pic = NULL;
+	}
+
+	SDL_AtomicSet(&image->state, PREFETCH_READY);
+}
+
+/**
+ * @brief Waits until the levels of an image are built, building them on this thread if no worker started yet
+ * @param[in,out] image
+ */
+static void R_WaitPrefetchImage(prefetchImage_t *image)
+{
+	R_BuildPrefetchImage(image, &prefetch.work);
+
+	while (SDL_AtomicGet(&image->state) == PREFETCH_BUILDING)
+	{
+		SDL_Delay(1);
+	}
+}
+
+/**
+ * @brief Frees the file, picture and levels of an image
+ * @param[in,out] image
+ */
+static void R_FreePrefetchImage(prefetchImage_t *image)
+{
+	free(image->file);
+	free(image->pic);
+	free(image->data);
+	image->file = NULL;
+	image->pic  = NULL;
+	image->data = NULL;
+}
+
+/**
+ * @brief Worker thread, decodes the images and builds their levels
+ * @param data unused
+ * @return
+ */
+static int R_PrefetchThread(void *data)
+{
+	imageWork_t work;
+
+	Com_Memset(&work, 0, sizeof(work));
+
+	while (1)
+	{
+		SDL_SemWait(prefetch.queued);
+
+		if (SDL_AtomicGet(&prefetch.quit))
+		{
+			break;
+		}
+
+		R_BuildPrefetchImage(prefetch.queue[SDL_AtomicAdd(&prefetch.next, 1)], &work);
+	}
+
+	R_FreeImageWork(&work);
+	return 0;
+}
+
+/**
+ * @brief Starts building the images of the map shaders
+ * @param[in] shaders
+ * @param[in] numShaders
+ * @param[in] loadedImages also prefetch images which are loaded already
+ *
+ * @note Called by RE_LoadWorldMap, R_FinishImagePrefetch must be called
+ * once the map shaders are loaded.
+ */
+void R_PrefetchImages(const dshader_t *shaders, int numShaders, qboolean loadedImages)
+{
+	int i, numThreads;
+
+	R_FinishImagePrefetch();
+
+	if (!r_prefetchImages->integer)
+	{
+		return;
+	}
+
+	prefetch.loadedImages = loadedImages;
+	for (i = 0; i < numShaders; i++)
+	{
+		R_ListShaderImages(shaders[i].shader, R_AddPrefetchImage);
+	}
+
+	if (!prefetch.numImages)
+	{
+		return;
+	}
+
+	// without workers the images are built when they are used
+	numThreads = SDL_GetCPUCount() - 1;
+	numThreads = numThreads < 1 ? 1 : numThreads > MAX_PREFETCH_THREADS ? MAX_PREFETCH_THREADS : numThreads;
+
+	prefetch.queued = SDL_CreateSemaphore(0);
+	if (prefetch.queued)
+	{
+		for (i = 0; i < numThreads; i++)
+		{
+			prefetch.threads[prefetch.numThreads] = SDL_CreateThread(R_PrefetchThread, "prefetch", NULL);
+			if (!prefetch.threads[prefetch.numThreads])
+			{
+				Ren_Developer("R_PrefetchImages: SDL_CreateThread() failed: %s\n", SDL_GetError());
+				break;
+			}
+			prefetch.numThreads++;
+		}
+	}
+
+	for (i = 0; i < prefetch.numImages; i++)
+	{
+		R_ReadPrefetchImage(&prefetch.images[i]);
+	}
+}
+
+/**
+ * @brief Creates an image from its prefetched levels
+ * @param[in] name
+ * @param[in] mipmap
+ * @param[in] allowPicmip
+ * @param[in] glWrapClampMode
+ * @return NULL if the image wasn't prefetched with these parms
+ */
+image_t *R_FindPrefetchedImage(const char *name, qboolean mipmap, qboolean allowPicmip, int glWrapClampMode)
+{
+	prefetchImage_t *image;
+	image_t         *created;
+
+	if (!prefetch.numImages)
+	{
+		return NULL;
+	}
+
+	image = R_GetPrefetchImage(name);
+	if (!image || image->mipmap != mipmap || image->allowPicmip != allowPicmip)
+	{
+		return NULL;
+	}
+
+	R_WaitPrefetchImage(image);
+	if (SDL_AtomicGet(&image->state) != PREFETCH_READY)
+	{
+		return NULL;
+	}
+
+	created = R_CreateImageFromLevels(name, &image->levels, image->width, image->height, mipmap, allowPicmip, glWrapClampMode);
+
+	R_FreePrefetchImage(image);
+	SDL_AtomicSet(&image->state, PREFETCH_USED);
+
+	return created;
+}
+
+/**
+ * @brief Stops the workers and frees the images which weren't used
+ */
+void R_FinishImagePrefetch(void)
+{
+	int i;
+
+	if (prefetch.numThreads)
+	{
+		SDL_AtomicSet(&prefetch.quit, 1);
+		for (i = 0; i < prefetch.numThreads; i++)
+		{
+			SDL_SemPost(prefetch.queued);
+		}
+		for (i = 0; i < prefetch.numThreads; i++)
+		{
+			SDL_WaitThread(prefetch.threads[i], NULL);
+		}
+	}
+
+	if (prefetch.queued)
+	{
+		SDL_DestroySemaphore(prefetch.queued);
+	}
+
+	for (i = 0; i < prefetch.numImages; i++)
+	{
+		R_FreePrefetchImage(&prefetch.images[i]);
+	}
+
+	if (prefetch.numImages)
+	{
+		int numUsed = 0;
+
+		for (i = 0; i < prefetch.numImages; i++)
+		{
+			numUsed += SDL_AtomicGet(&prefetch.images[i].state) == PREFETCH_USED;
+		}
+		Ren_Developer("Image prefetch: %i images, %i queued, %i used, %i threads\n", prefetch.numImages, prefetch.numQueued, numUsed, prefetch.numThreads);
+	}
+
+	R_FreeImageWork(&prefetch.work);
+	Com_Memset(&prefetch, 0, sizeof(prefetch));
+}
+
+#define IMAGELEVELS_TEST_ROUNDS 208    // every picture size with every parm combination
+
+/**
+ * @brief Compares the levels built by R_BuildImageLevels and by the prefetch
+ * with the ones of the old in place Upload32, without touching GL
+ *
+ * @details The random pictures of R_TestImageLevels are always checked, the
+ * images of a map only if one is given or loaded.
+ */
+void R_ImagePrefetchTest_f(void)
+{
+	char            name[MAX_QPATH];
+	union
+	{
+		byte *b;
+		void *v;
+	} buffer;
+	dheader_t       *header;
+	prefetchImage_t *image;
+	imageLevels_t   reference;
+	byte            *pic;
+	int             length, offset, size;
+	int             i, width, height;
+	int             start, prefetchTime, referenceTime = 0, numTested = 0, numDiffering;
+
+	numDiffering = R_TestImageLevels(IMAGELEVELS_TEST_ROUNDS);
+	Ren_Print("%i random pictures, %i differing\n", IMAGELEVELS_TEST_ROUNDS, numDiffering);
+
+	if (ri.Cmd_Argc() > 1)
+	{
+		Com_sprintf(name, sizeof(name), "maps/%s.bsp", ri.Cmd_Argv(1));
+	}
+	else if (tr.world)
+	{
+		Q_strncpyz(name, tr.world->name, sizeof(name));
+	}
+	else
+	{
+		Ren_Print("no map loaded, usage: imageprefetchtest [mapname]\n");
+		return;
+	}
+
+	length = ri.FS_ReadFile(name, &buffer.v);
+	if (!buffer.v)
+	{
+		Ren_Print("imageprefetchtest: %s not found\n", name);
+		return;
+	}
+
+	header = (dheader_t *)buffer.b;
+	offset = LittleLong(header->lumps[LUMP_SHADERS].fileofs);
+	size   = LittleLong(header->lumps[LUMP_SHADERS].filelen);
+	if (length < (int)sizeof(dheader_t) || LittleLong(header->version) != BSP_VERSION || offset < 0 || size < 0 || offset + size > length)
+	{
+		Ren_Print("imageprefetchtest: %s is not a valid map\n", name);
+		ri.FS_FreeFile(buffer.v);
+		return;
+	}
+
+	if (!r_prefetchImages->integer)
+	{
+		Ren_Print("imageprefetchtest: r_prefetchImages is off\n");
+		ri.FS_FreeFile(buffer.v);
+		return;
+	}
+
+	start = ri.Milliseconds();
+	R_PrefetchImages((dshader_t *)(buffer.b + offset), size / sizeof(dshader_t), qtrue);
+	for (i = 0; i < prefetch.numImages; i++)
+	{
+		R_WaitPrefetchImage(&prefetch.images[i]);
+	}
+	prefetchTime = ri.Milliseconds() - start;
+
+	numDiffering = 0;
+	for (i = 0; i < prefetch.numImages; i++)
+	{
+		image = &prefetch.images[i];
+		if (SDL_AtomicGet(&image->state) != PREFETCH_READY)
+		{
+			continue;
+		}
+
+		// the reference works in place on the shared buffer of the loaders
+		start = ri.Milliseconds();
+		R_LoadImage(image->name, &pic, &width, &height);
+		if (!pic)
+		{
+			Ren_Print("^1%s: failed to load on the main thread\n", image->name);
+			numDiffering++;
+			continue;
+		}
+		R_BuildReferenceImageLevels((unsigned *)pic, width, height, image->mipmap, image->allowPicmip, qfalse, &reference);
+		referenceTime += ri.Milliseconds() - start;
+		numTested++;
+
+		if (!R_CompareImageLevels(image->name, &image->levels, &reference))
+		{
+			numDiffering++;
+		}
+
+		R_FreeReferenceImageLevels(&reference);
+	}
+
+	Ren_Print("%i images, %i tested, %i differing\n", prefetch.numImages, numTested, numDiffering);
+	Ren_Print("old Upload32 %i msec on the main thread, prefetch %i msec with %i threads\n", referenceTime, prefetchTime, prefetch.numThreads);
+
+	R_FinishImagePrefetch();
+	ri.FS_FreeFile(buffer.v);
+}
@@ -1402,12 +1402,13 @@ ParseSkyParms
 skyParms <outerbox> <cloudheight> <innerbox>
 ===============
 */
+static char *skySuffixes[6] = { "rt", "bk", "lf", "ft", "up", "dn" };
+
 static void ParseSkyParms(char **text)
 {
-	char        *token;
-	static char *suf[6] = { "rt", "bk", "lf", "ft", "up", "dn" };
-	char        pathname[MAX_QPATH];
-	int         i;
+	char *token;
+	char pathname[MAX_QPATH];
+	int  i;
 
 	// outerbox
 	token = COM_ParseExt(text, qfalse);
@@ -1421,7 +1422,7 @@ static void ParseSkyParms(char **text)
 		for (i = 0 ; i < 6 ; i++)
 		{
 			Com_sprintf(pathname, sizeof(pathname), "%s_%s.tga"
-			            , token, suf[i]);
+			            , token, skySuffixes[i]);
 			shader.sky.outerbox[i] = R_FindImageFile(( char * ) pathname, qtrue, qtrue, GL_CLAMP_TO_EDGE, qfalse);
 			if (!shader.sky.outerbox[i])
 			{
@@ -1456,7 +1457,7 @@ static void ParseSkyParms(char **text)
 		for (i = 0 ; i < 6 ; i++)
 		{
 			Com_sprintf(pathname, sizeof(pathname), "%s_%s.tga"
-			            , token, suf[i]);
+			            , token, skySuffixes[i]);
 			shader.sky.innerbox[i] = R_FindImageFile(( char * ) pathname, qtrue, qtrue, GL_REPEAT, qfalse);
 			if (!shader.sky.innerbox[i])
 			{
@@ -3172,6 +3173,121 @@ static char *FindShaderInShaderText(const char *shadername)
 	return NULL;
 }
 
+/**
+ * @brief Lists the images R_FindShader loads for a world shader
+ * @param[in] name
+ * @param[in] addImage called with the parms R_FindImageFile gets for each image
+ *
+ * @note This only scans the shader text for the image keywords, it's used to
+ * prefetch the images of a map so it doesn't have to be exact.
+ */
+void R_ListShaderImages(const char *name, void (*addImage)(const char *imageName, qboolean mipmap, qboolean allowPicmip))
+{
+	char     strippedName[MAX_QPATH];
+	char     imageName[MAX_QPATH];
+	char     *text, *token;
+	qboolean noMipMaps = qfalse, noPicMip = qfalse;
+	int      depth     = 0, i, j;
+
+	COM_StripExtension(name, strippedName, sizeof(strippedName));
+	COM_FixPath(strippedName);
+
+	text = FindShaderInShaderText(strippedName);
+	if (!text)
+	{
+		// implicit shader, the image is named like the shader
+		Q_strncpyz(imageName, name, sizeof(imageName));
+		COM_DefaultExtension(imageName, sizeof(imageName), ".tga");
+		addImage(imageName, qtrue, qtrue);
+		return;
+	}
+
+	while (1)
+	{
+		token = COM_ParseExt(&text, qtrue);
+		if (!token[0])
+		{
+			break;
+		}
+
+		if (token[0] == '{')
+		{
+			depth++;
+		}
+		else if (token[0] == '}')
+		{
+			if (--depth <= 0)
+			{
+				break;
+			}
+		}
+		else if (!Q_stricmp(token, "nomipmaps") || !Q_stricmp(token, "nomipmap"))
+		{
+			noMipMaps = qtrue;
+			noPicMip  = qtrue;
+		}
+		else if (!Q_stricmp(token, "nopicmip"))
+		{
+			noPicMip = qtrue;
+		}
+		else if (!Q_stricmp(token, "map") || !Q_stricmp(token, "clampmap"))
+		{
+			token = COM_ParseExt(&text, qfalse);
+			if (token[0] && token[0] != '$' && token[0] != '*')
+			{
+				addImage(token, !noMipMaps, !noPicMip);
+			}
+		}
+		else if (!Q_stricmp(token, "animMap"))
+		{
+			// skip the frequency
+			COM_ParseExt(&text, qfalse);
+
+			for (i = 0; i < MAX_IMAGE_ANIMATIONS; i++)
+			{
+				token = COM_ParseExt(&text, qfalse);
+				if (!token[0])
+				{
+					break;
+				}
+				addImage(token, !noMipMaps, !noPicMip);
+			}
+		}
+		else if (!Q_stricmp(token, "skyParms"))
+		{
+			// outerbox, cloudheight and innerbox
+			for (i = 0; i < 3; i++)
+			{
+				token = COM_ParseExt(&text, qfalse);
+				if (i == 1 || !token[0] || !strcmp(token, "-"))
+				{
+					continue;
+				}
+
+				for (j = 0; j < 6; j++)
+				{
+					Com_sprintf(imageName, sizeof(imageName), "%s_%s.tga", token, skySuffixes[j]);
+					addImage(imageName, qtrue, qtrue);
+				}
+			}
+		}
+		else if (!Q_stricmpn(token, "implicit", 8) && depth == 1)
+		{
+			token = COM_ParseExt(&text, qfalse);
+			if (!token[0] || !strcmp(token, "-"))
+			{
+				Q_strncpyz(imageName, name, sizeof(imageName));
+			}
+			else
+			{
+				Q_strncpyz(imageName, token, sizeof(imageName));
+			}
+			COM_DefaultExtension(imageName, sizeof(imageName), ".tga");
+			addImage(imageName, !noMipMaps, !noPicMip);
+		}
+	}
+}
+
 /*
 ==================
 R_FindShaderByName
@@ -3728,21 +3844,54 @@ void R_ShaderList_f(void)
 
 #define MAX_SHADER_STRING_POINTERS  100000
 shaderStringPointer_t shaderStringPointerList[MAX_SHADER_STRING_POINTERS];
+static int            numShaderStringPointers;
 
-/*
-====================
-BuildShaderChecksumLookup
-====================
-*/
-static void BuildShaderChecksumLookup(void)
+// combined text and shader name offsets of the scripts, see tr_shadercache.c
+#define SHADER_TEXT_CACHE   "cache/shadertext.bin"
+#define MAX_SHADER_ENTRIES  (FILE_HASH_SIZE + MAX_SHADER_STRING_POINTERS)
+
+/**
+ * @brief Adds a shader found in the scripts to the checksum lookup
+ * @param[in] pStr position of the shader name in the text
+ * @param[in] checksum
+ */
+static void AddShaderChecksumLookup(char *pStr, unsigned short int checksum)
+{
+	shaderStringPointer_t *newStrPtr;
+
+	// if it's not currently used
+	if (!shaderChecksumLookup[checksum].pStr)
+	{
+		shaderChecksumLookup[checksum].pStr = pStr;
+		return;
+	}
+
+	// create a new list item
+	if (numShaderStringPointers >= MAX_SHADER_STRING_POINTERS)
+	{
+		Ren_Drop("MAX_SHADER_STRING_POINTERS exceeded, too many shaders");
+	}
+
+	newStrPtr                           = &shaderStringPointerList[numShaderStringPointers++]; //ri.Hunk_Alloc( sizeof( shaderStringPointer_t ), h_low );
+	newStrPtr->pStr                     = pStr;
+	newStrPtr->next                     = shaderChecksumLookup[checksum].next;
+	shaderChecksumLookup[checksum].next = newStrPtr;
+}
+
+/**
+ * @brief Builds the checksum lookup of all shaders in the scripts
+ * @param[out] entries shaders found, in text order, may be NULL
+ * @param[out] numEntries
+ */
+static void BuildShaderChecksumLookup(shaderTextEntry_t *entries, int *numEntries)
 {
 	char               *p = s_shaderText, *pOld;
 	char               *token;
 	unsigned short int checksum;
-	int                numShaderStringPointers = 0;
 
 	// initialize the checksums
 	memset(shaderChecksumLookup, 0, sizeof(shaderChecksumLookup));
+	numShaderStringPointers = 0;
 
 	if (!p)
 	{
@@ -3765,30 +3914,60 @@ static void BuildShaderChecksumLookup(void)
 
 		//Ren_Print("Shader Found: %s\n", token );
 
-		// if it's not currently used
-		if (!shaderChecksumLookup[checksum].pStr)
+		AddShaderChecksumLookup(pOld, checksum);
+
+		if (entries)
 		{
-			shaderChecksumLookup[checksum].pStr = pOld;
+			entries[*numEntries].hash   = checksum;
+			entries[*numEntries].offset = pOld - s_shaderText;
+			(*numEntries)++;
 		}
-		else
-		{
-			// create a new list item
-			shaderStringPointer_t *newStrPtr;
 
-			if (numShaderStringPointers >= MAX_SHADER_STRING_POINTERS)
-			{
-				Ren_Drop("MAX_SHADER_STRING_POINTERS exceeded, too many shaders");
-			}
+		// skip the actual shader section
+		SkipBracedSection(&p);
+	}
+}
+
+/**
+ * @brief Loads the shader text and its checksum lookup from the cache
+ * @param[in] shaderFiles
+ * @param[in] numShaders
+ * @return qfalse if the cache is out of date
+ */
+static qboolean LoadShaderTextCache(char **shaderFiles, int numShaders)
+{
+	shaderTextCache_t cache;
+	int               i;
 
-			newStrPtr                           = &shaderStringPointerList[numShaderStringPointers++]; //ri.Hunk_Alloc( sizeof( shaderStringPointer_t ), h_low );
-			newStrPtr->pStr                     = pOld;
-			newStrPtr->next                     = shaderChecksumLookup[checksum].next;
-			shaderChecksumLookup[checksum].next = newStrPtr;
+	if (!R_LoadShaderTextCache(SHADER_TEXT_CACHE, shaderFiles, numShaders, &cache))
+	{
+		return qfalse;
+	}
+
+	for (i = 0; i < cache.numEntries; i++)
+	{
+		if (cache.entries[i].hash < 0 || cache.entries[i].hash >= FILE_HASH_SIZE)
+		{
+			R_FreeShaderTextCache(&cache);
+			return qfalse;
 		}
+	}
 
-		// skip the actual shader section
-		SkipBracedSection(&p);
+	s_shaderText = ri.Hunk_Alloc(cache.textSize, h_low);
+	Com_Memcpy(s_shaderText, cache.text, cache.textSize);
+
+	memset(shaderChecksumLookup, 0, sizeof(shaderChecksumLookup));
+	numShaderStringPointers = 0;
+
+	for (i = 0; i < cache.numEntries; i++)
+	{
+		AddShaderChecksumLookup(s_shaderText + cache.entries[i].offset, cache.entries[i].hash);
 	}
+
+	Ren_Developer("...loaded %i shaders from %s\n", cache.numEntries, SHADER_TEXT_CACHE);
+
+	R_FreeShaderTextCache(&cache);
+	return qtrue;
 }
 
 /**
@@ -3798,14 +3977,16 @@ static void BuildShaderChecksumLookup(void)
 #define MAX_SHADER_FILES    4096
 static void ScanAndLoadShaderFiles(void)
 {
-	char filename[MAX_QPATH];
-	char **shaderFiles;
-	char *buffers[MAX_SHADER_FILES];
-	int  buffersize[MAX_SHADER_FILES];
-	char *p;
-	int  numShaders;
-	int  i;
-	long sum = 0;
+	char              filename[MAX_QPATH];
+	char              **shaderFiles;
+	char              *buffers[MAX_SHADER_FILES];
+	int               buffersize[MAX_SHADER_FILES];
+	char              *p;
+	int               numShaders;
+	int               i;
+	long              sum = 0;
+	shaderTextEntry_t *entries;
+	int               numEntries = 0;
 
 	// scan for shader files
 	shaderFiles = ri.FS_ListFiles("scripts", ".shader", &numShaders);
@@ -3822,6 +4003,13 @@ static void ScanAndLoadShaderFiles(void)
 		Ren_Warning("ScanAndLoadShaderFiles WARNING: MAX_SHADER_FILES reached\n");
 	}
 
+	// the text and lookup don't change as long as the pk3s with the scripts don't
+	if (r_cacheShaders->integer && LoadShaderTextCache(shaderFiles, numShaders))
+	{
+		ri.FS_FreeFileList(shaderFiles);
+		return;
+	}
+
 	// load and parse shader files
 	for (i = 0; i < numShaders; i++)
 	{
@@ -3853,14 +4041,19 @@ static void ScanAndLoadShaderFiles(void)
 	// unixify all shaders
 	COM_FixPath(s_shaderText);
 
-	// free up memory
-	ri.FS_FreeFileList(shaderFiles);
-
 	// optimized shader loading (18ms on a P3-500 for sfm1.bsp)
 	if (r_cacheShaders->integer)
 	{
-		BuildShaderChecksumLookup();
+		entries = ri.Hunk_AllocateTempMemory(MAX_SHADER_ENTRIES * sizeof(shaderTextEntry_t));
+
+		BuildShaderChecksumLookup(entries, &numEntries);
+		R_SaveShaderTextCache(SHADER_TEXT_CACHE, shaderFiles, numShaders, s_shaderText, entries, numEntries);
+
+		ri.Hunk_FreeTempMemory(entries);
 	}
+
+	// free up memory
+	ri.FS_FreeFileList(shaderFiles);
 }
 
 /*
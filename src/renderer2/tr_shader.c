@@ -6412,6 +6412,198 @@ static void ScanAndLoadGuideFiles(void)
 	ri.FS_FreeFileList(guideFiles);
 }
 
+/**
+ * @brief Parses a shader table and generates it if it doesn't exist yet
+ * @param[in,out] text position after the "table" keyword, moved past the table
+ */
+static void ParseShaderTable(char **text)
+{
+	char          *p = *text;
+	char          *token;
+	int           hash;
+	int           depth;
+	float         values[FUNCTABLE_SIZE];
+	int           numValues;
+	shaderTable_t *tb;
+	qboolean      alreadyCreated;
+
+	Com_Memset(&table, 0, sizeof(table));
+
+	token = COM_ParseExt2(&p, qtrue);
+
+	Q_strncpyz(table.name, token, sizeof(table.name));
+
+	// check if already created
+	alreadyCreated = qfalse;
+	hash           = generateHashValue(table.name, MAX_SHADERTABLE_HASH);
+	for (tb = shaderTableHashTable[hash]; tb; tb = tb->next)
+	{
+		if (Q_stricmp(tb->name, table.name) == 0)
+		{
+			// match found
+			alreadyCreated = qtrue;
+			break;
+		}
+	}
+
+	depth     = 0;
+	numValues = 0;
+	do
+	{
+		token = COM_ParseExt2(&p, qtrue);
+
+		if (!Q_stricmp(token, "snap"))
+		{
+			table.snap = qtrue;
+		}
+		else if (!Q_stricmp(token, "clamp"))
+		{
+			table.clamp = qtrue;
+		}
+		else if (token[0] == '{')
+		{
+			depth++;
+		}
+		else if (token[0] == '}')
+		{
+			depth--;
+		}
+		else if (token[0] == ',')
+		{
+			continue;
+		}
+		else
+		{
+			if (numValues == FUNCTABLE_SIZE)
+			{
+				Ren_Warning("WARNING: FUNCTABLE_SIZE hit\n");
+				break;
+			}
+			values[numValues++] = atof(token);
+		}
+	}
+	while (depth && p);
+
+	if (!alreadyCreated)
+	{
+		Ren_Developer("...generating '%s'\n", table.name);
+		GeneratePermanentShaderTable(values, numValues);
+	}
+
+	*text = p;
+}
+
+// combined text and shader name offsets of the scripts, see tr_shadercache.c
+#define SHADER_TEXT_CACHE   "cache/shadertext2.bin"
+
+/**
+ * @brief Sets up the shader text hash table for the given number of shaders per hash value
+ * @param[in] shaderTextHashTableSizes
+ * @param[in] size total number of shaders
+ */
+static void AllocShaderTextHashTable(const int *shaderTextHashTableSizes, int size)
+{
+	char *hashMem;
+	int  i;
+
+	size += MAX_SHADERTEXT_HASH;
+
+	hashMem = (char *)ri.Hunk_Alloc(size * sizeof(char *), h_low);
+
+	for (i = 0; i < MAX_SHADERTEXT_HASH; i++)
+	{
+		shaderTextHashTable[i] = (char **)hashMem;
+		hashMem                = ((char *)hashMem) + ((shaderTextHashTableSizes[i] + 1) * sizeof(char *));
+	}
+}
+
+/**
+ * @brief Remembers a shader or table of the text for the cache
+ * @param[out] entries
+ * @param[in,out] numEntries
+ * @param[in] maxEntries
+ * @param[in] hash hash of the shader name, -1 for tables
+ * @param[in] pos position of the shader name in s_shaderText
+ */
+static void AddShaderTextEntry(shaderTextEntry_t *entries, int *numEntries, int maxEntries, int hash, const char *pos)
+{
+	if (!pos || *numEntries >= maxEntries)
+	{
+		return;
+	}
+
+	entries[*numEntries].hash   = hash;
+	entries[*numEntries].offset = pos - s_shaderText;
+	(*numEntries)++;
+}
+
+/**
+ * @brief Loads the shader text and its hash table from the cache
+ * @param[in] shaderFiles
+ * @param[in] numShaderFiles
+ * @return qfalse if the cache is out of date
+ *
+ * @note Shader tables are generated again from the cached text.
+ */
+static qboolean LoadShaderTextCache(char **shaderFiles, int numShaderFiles)
+{
+	shaderTextCache_t cache;
+	int               shaderTextHashTableSizes[MAX_SHADERTEXT_HASH];
+	int               i, hash, size = 0;
+	char              *p;
+
+	if (!R_LoadShaderTextCache(SHADER_TEXT_CACHE, shaderFiles, numShaderFiles, &cache))
+	{
+		return qfalse;
+	}
+
+	Com_Memset(shaderTextHashTableSizes, 0, sizeof(shaderTextHashTableSizes));
+
+	for (i = 0; i < cache.numEntries; i++)
+	{
+		hash = cache.entries[i].hash;
+
+		if (hash < -1 || hash >= MAX_SHADERTEXT_HASH)
+		{
+			R_FreeShaderTextCache(&cache);
+			return qfalse;
+		}
+
+		if (hash >= 0)
+		{
+			shaderTextHashTableSizes[hash]++;
+			size++;
+		}
+	}
+
+	s_shaderText = (char *)ri.Hunk_Alloc(cache.textSize, h_low);
+	Com_Memcpy(s_shaderText, cache.text, cache.textSize);
+
+	AllocShaderTextHashTable(shaderTextHashTableSizes, size);
+
+	Com_Memset(shaderTextHashTableSizes, 0, sizeof(shaderTextHashTableSizes));
+
+	for (i = 0; i < cache.numEntries; i++)
+	{
+		hash = cache.entries[i].hash;
+		p    = s_shaderText + cache.entries[i].offset;
+
+		if (hash < 0)
+		{
+			ParseShaderTable(&p);
+		}
+		else
+		{
+			shaderTextHashTable[hash][shaderTextHashTableSizes[hash]++] = p;
+		}
+	}
+
+	Ren_Developer("...loaded %i shaders from %s\n", size, SHADER_TEXT_CACHE);
+
+	R_FreeShaderTextCache(&cache);
+	return qtrue;
+}
+
 /*
 ====================
 ScanAndLoadShaderFiles
@@ -6423,15 +6615,17 @@ a single large text block that can be scanned for shader names
 #define MAX_SHADER_FILES    4096
 static void ScanAndLoadShaderFiles(void)
 {
-	char **shaderFiles;
-	char *buffers[MAX_SHADER_FILES];
-	char *p;
-	int  numShaderFiles;
-	int  i;
-	char *oldp, *token, *hashMem, *textEnd;
-	int  shaderTextHashTableSizes[MAX_SHADERTEXT_HASH], hash, size;
-	char filename[MAX_QPATH];
-	long sum = 0, summand;
+	char              **shaderFiles;
+	char              *buffers[MAX_SHADER_FILES];
+	char              *p;
+	int               numShaderFiles;
+	int               i;
+	char              *oldp, *token, *textEnd;
+	int               shaderTextHashTableSizes[MAX_SHADERTEXT_HASH], hash, size, numTables;
+	char              filename[MAX_QPATH];
+	long              sum = 0, summand;
+	shaderTextEntry_t *entries;
+	int               numEntries = 0, maxEntries;
 
 	Ren_Print("----- ScanAndLoadShaderFiles -----\n");
 
@@ -6444,6 +6638,18 @@ static void ScanAndLoadShaderFiles(void)
 		return;
 	}
 
+	if (numShaderFiles > MAX_SHADER_FILES)
+	{
+		numShaderFiles = MAX_SHADER_FILES;
+	}
+
+	// the text and its index don't change as long as the pk3s with the scripts don't
+	if (LoadShaderTextCache(shaderFiles, numShaderFiles))
+	{
+		ri.FS_FreeFileList(shaderFiles);
+		return;
+	}
+
 	// build single large buffer
 	for (i = 0; i < numShaderFiles; i++)
 	{
@@ -6452,11 +6658,6 @@ static void ScanAndLoadShaderFiles(void)
 	}
 	s_shaderText = (char *)ri.Hunk_Alloc(sum + numShaderFiles * 2, h_low);
 
-	if (numShaderFiles > MAX_SHADER_FILES)
-	{
-		numShaderFiles = MAX_SHADER_FILES;
-	}
-
 	// load and parse shader files
 	for (i = 0; i < numShaderFiles; i++)
 	{
@@ -6533,11 +6734,9 @@ static void ScanAndLoadShaderFiles(void)
 
 	COM_Compress(s_shaderText);
 
-	// free up memory
-	ri.FS_FreeFileList(shaderFiles);
-
 	Com_Memset(shaderTextHashTableSizes, 0, sizeof(shaderTextHashTableSizes));
-	size = 0;
+	size      = 0;
+	numTables = 0;
 
 	p = s_shaderText;
 	// look for shader names
@@ -6556,6 +6755,7 @@ static void ScanAndLoadShaderFiles(void)
 			(void) COM_ParseExt2(&p, qtrue);
 
 			SkipBracedSection(&p);
+			numTables++;
 		}
 		// support shader templates
 		else if (!Q_stricmp(token, "guide"))
@@ -6611,15 +6811,11 @@ static void ScanAndLoadShaderFiles(void)
 		}
 	}
 
-	size += MAX_SHADERTEXT_HASH;
+	// remember the shaders and tables for the cache, in text order
+	maxEntries = size + numTables;
+	entries    = ri.Hunk_AllocateTempMemory(maxEntries * sizeof(shaderTextEntry_t));
 
-	hashMem = (char *)ri.Hunk_Alloc(size * sizeof(char *), h_low);
-
-	for (i = 0; i < MAX_SHADERTEXT_HASH; i++)
-	{
-		shaderTextHashTable[i] = (char **)hashMem;
-		hashMem                = ((char *)hashMem) + ((shaderTextHashTableSizes[i] + 1) * sizeof(char *));
-	}
+	AllocShaderTextHashTable(shaderTextHashTableSizes, size);
 
 	Com_Memset(shaderTextHashTableSizes, 0, sizeof(shaderTextHashTableSizes));
 
@@ -6638,74 +6834,8 @@ static void ScanAndLoadShaderFiles(void)
 		// parse shader tables
 		if (!Q_stricmp(token, "table"))
 		{
-			int           depth;
-			float         values[FUNCTABLE_SIZE];
-			int           numValues;
-			shaderTable_t *tb;
-			qboolean      alreadyCreated;
-
-			Com_Memset(&table, 0, sizeof(table));
-
-			token = COM_ParseExt2(&p, qtrue);
-
-			Q_strncpyz(table.name, token, sizeof(table.name));
-
-			// check if already created
-			alreadyCreated = qfalse;
-			hash           = generateHashValue(table.name, MAX_SHADERTABLE_HASH);
-			for (tb = shaderTableHashTable[hash]; tb; tb = tb->next)
-			{
-				if (Q_stricmp(tb->name, table.name) == 0)
-				{
-					// match found
-					alreadyCreated = qtrue;
-					break;
-				}
-			}
-
-			depth     = 0;
-			numValues = 0;
-			do
-			{
-				token = COM_ParseExt2(&p, qtrue);
-
-				if (!Q_stricmp(token, "snap"))
-				{
-					table.snap = qtrue;
-				}
-				else if (!Q_stricmp(token, "clamp"))
-				{
-					table.clamp = qtrue;
-				}
-				else if (token[0] == '{')
-				{
-					depth++;
-				}
-				else if (token[0] == '}')
-				{
-					depth--;
-				}
-				else if (token[0] == ',')
-				{
-					continue;
-				}
-				else
-				{
-					if (numValues == FUNCTABLE_SIZE)
-					{
-						Ren_Warning("WARNING: FUNCTABLE_SIZE hit\n");
-						break;
-					}
-					values[numValues++] = atof(token);
-				}
-			}
-			while (depth && p);
-
-			if (!alreadyCreated)
-			{
-				Ren_Developer("...generating '%s'\n", table.name);
-				GeneratePermanentShaderTable(values, numValues);
-			}
+			AddShaderTextEntry(entries, &numEntries, maxEntries, -1, p);
+			ParseShaderTable(&p);
 		}
 		// support shader templates
 		else if (!Q_stricmp(token, "guide"))
@@ -6718,6 +6848,7 @@ static void ScanAndLoadShaderFiles(void)
 
 			hash                                                        = generateHashValue(token, MAX_SHADERTEXT_HASH);
 			shaderTextHashTable[hash][shaderTextHashTableSizes[hash]++] = oldp;
+			AddShaderTextEntry(entries, &numEntries, maxEntries, hash, oldp);
 
 			// skip guide name
 			token = COM_ParseExt2(&p, qtrue);
@@ -6757,10 +6888,18 @@ static void ScanAndLoadShaderFiles(void)
 		{
 			hash                                                        = generateHashValue(token, MAX_SHADERTEXT_HASH);
 			shaderTextHashTable[hash][shaderTextHashTableSizes[hash]++] = oldp;
+			AddShaderTextEntry(entries, &numEntries, maxEntries, hash, oldp);
 
 			SkipBracedSection(&p);
 		}
 	}
+
+	R_SaveShaderTextCache(SHADER_TEXT_CACHE, shaderFiles, numShaderFiles, s_shaderText, entries, numEntries);
+
+	ri.Hunk_FreeTempMemory(entries);
+
+	// free up memory
+	ri.FS_FreeFileList(shaderFiles);
 }
 
 /*
@@ -127,6 +127,74 @@ void R_ModeList_f(void)
 	Ren_Print("\n");
 }
 
+/**
+ * @brief Gets the buffer for a decoded picture, see imageDecode_t
+ * @param[in,out] image
+ * @param[in] size
+ * @return NULL if a threaded decode is out of memory
+ */
+byte *R_DecodeBuffer(imageDecode_t *image, int size)
+{
+	if (image->threaded)
+	{
+		image->pic = malloc(size);
+	}
+	else
+	{
+		image->pic = R_GetImageBuffer(size, BUFFER_IMAGE, image->name);
+	}
+
+	return image->pic;
+}
+
+/**
+ * @brief Drops on an invalid image file, unless decoding on another thread
+ * @param[in] image
+ * @param[in] fmt
+ * @return qfalse
+ */
+qboolean QDECL R_DecodeDrop(imageDecode_t *image, const char *fmt, ...)
+{
+	va_list argptr;
+	char    text[1024];
+
+	if (image->threaded)
+	{
+		return qfalse;
+	}
+
+	va_start(argptr, fmt);
+	Q_vsnprintf(text, sizeof(text), fmt, argptr);
+	va_end(argptr);
+
+	Ren_Drop("%s", text);
+	return qfalse;
+}
+
+/**
+ * @brief Prints why an image file wasn't decoded, unless decoding on another thread
+ * @param[in] image
+ * @param[in] fmt
+ * @return qfalse
+ */
+qboolean QDECL R_DecodeWarning(imageDecode_t *image, const char *fmt, ...)
+{
+	va_list argptr;
+	char    text[1024];
+
+	if (image->threaded)
+	{
+		return qfalse;
+	}
+
+	va_start(argptr, fmt);
+	Q_vsnprintf(text, sizeof(text), fmt, argptr);
+	va_end(argptr);
+
+	Ren_Print("%s", text);
+	return qfalse;
+}
+
 #ifdef USE_RENDERER_DLOPEN
 void QDECL Com_Printf(const char *msg, ...)
 {
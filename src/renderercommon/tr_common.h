@@ -62,6 +62,37 @@ typedef enum
 void *R_GetImageBuffer(int size, bufferMemType_t bufferType, const char *filename);
 void R_FreeImageBuffer(void);
 
+/**
+ * @struct imageDecode_t
+ * @brief An image file in memory for R_DecodeTGA, R_DecodePNG and R_DecodeJPG
+ *
+ * On the main thread the picture goes to the shared image buffer and errors are
+ * reported like the R_Load* loaders do. With threaded set the picture gets a
+ * buffer of its own, which the caller frees even if decoding failed, and
+ * nothing is reported: the main thread loads the image again for that.
+ */
+typedef struct
+{
+	const char *name;
+	const byte *buffer;             // the file
+	int length;
+	byte alphaByte;
+	qboolean threaded;
+
+	byte *pic;
+	int width, height;
+} imageDecode_t;
+
+typedef qboolean (*imageDecoder_t)(imageDecode_t *image);
+
+qboolean R_DecodeTGA(imageDecode_t *image);
+qboolean R_DecodePNG(imageDecode_t *image);
+qboolean R_DecodeJPG(imageDecode_t *image);
+
+byte *R_DecodeBuffer(imageDecode_t *image, int size);
+qboolean QDECL R_DecodeDrop(imageDecode_t *image, const char *fmt, ...) __attribute__ ((format(printf, 2, 3)));
+qboolean QDECL R_DecodeWarning(imageDecode_t *image, const char *fmt, ...) __attribute__ ((format(printf, 2, 3)));
+
 /*
 ====================================================================
 IMPLEMENTATION SPECIFIC GLIMP FUNCTIONS
@@ -104,6 +135,26 @@ void GLimp_SetGamma(unsigned char red[256], unsigned char green[256], unsigned c
 qboolean R_GetModeInfo(int *width, int *height, float *windowAspect, int mode);
 void R_ModeList_f(void);
 
+// shader script cache
+typedef struct
+{
+	int hash;                       // hash of the shader name, the renderer decides the meaning
+	int offset;                     // offset of the entry in the text
+} shaderTextEntry_t;
+
+typedef struct
+{
+	void *buffer;                   // file buffer, the text and entries point into it
+	char *text;
+	int textSize;                   // size of the text including the terminating 0 and padding
+	shaderTextEntry_t *entries;
+	int numEntries;
+} shaderTextCache_t;
+
+qboolean R_LoadShaderTextCache(const char *cacheName, char **shaderFiles, int numShaderFiles, shaderTextCache_t *cache);
+void R_FreeShaderTextCache(shaderTextCache_t *cache);
+void R_SaveShaderTextCache(const char *cacheName, char **shaderFiles, int numShaderFiles, const char *text, const shaderTextEntry_t *entries, int numEntries);
+
 // font stuff
 void R_InitFreeType(void);
 void R_DoneFreeType(void);
@@ -252,6 +303,7 @@ extern cvar_t *r_cacheShaders;    // FIXME: move out -> renderer1 only
 extern cvar_t *r_cacheModels;     // FIXME: move out -> renderer1 only
 
 extern cvar_t *r_cacheGathering;  // FIXME: move out -> renderer1 only
+extern cvar_t *r_prefetchImages;  // FIXME: move out -> renderer1 only
 
 extern cvar_t *r_bonesDebug;      // FIXME: move out -> renderer1 only
 
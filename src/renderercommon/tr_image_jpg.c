@@ -54,6 +54,7 @@ typedef struct
 {
 	struct jpeg_error_mgr pub;
 	jmp_buf jmpbuf;
+	imageDecode_t *image;
 } my_jpeg_error_mgr;
 
 static void R_JPGErrorExit(j_common_ptr cinfo)
@@ -62,7 +63,7 @@ static void R_JPGErrorExit(j_common_ptr cinfo)
 	my_jpeg_error_mgr *mgr = (my_jpeg_error_mgr *)cinfo->err;
 
 	(*cinfo->err->format_message)(cinfo, buffer);
-	Ren_Print(S_COLOR_YELLOW "WARNING: (libjpeg) %s\n", buffer);
+	R_DecodeWarning(mgr->image, S_COLOR_YELLOW "WARNING: (libjpeg) %s\n", buffer);
 
 	/* Let the memory manager delete any temp files before we die */
 	jpeg_destroy(cinfo);
@@ -73,16 +74,25 @@ static void R_JPGErrorExit(j_common_ptr cinfo)
 
 static void R_JPGOutputMessage(j_common_ptr cinfo)
 {
-	char buffer[JMSG_LENGTH_MAX];
+	char              buffer[JMSG_LENGTH_MAX];
+	my_jpeg_error_mgr *mgr = (my_jpeg_error_mgr *)cinfo->err;
 
 	/* Create the message */
 	(*cinfo->err->format_message)(cinfo, buffer);
 
 	/* Send it to stderr, adding a newline */
-	Ren_Print("%s\n", buffer);
+	R_DecodeWarning(mgr->image, "%s\n", buffer);
 }
 
-void R_LoadJPG(const char *filename, unsigned char **pic, int *width, int *height, byte alphaByte)
+/**
+ * @brief Decodes a JPG file
+ * @param[in,out] image
+ * @return
+ *
+ * @note A threaded decode fails on libjpeg warnings too, so the main thread
+ * prints them when it loads the image again.
+ */
+qboolean R_DecodeJPG(imageDecode_t *image)
 {
 	/* This struct contains the JPEG decompression parameters and pointers to
 	 * working space (which is allocated as needed by the JPEG library).
@@ -101,25 +111,11 @@ void R_LoadJPG(const char *filename, unsigned char **pic, int *width, int *heigh
 	unsigned int pixelcount, memcount;
 	unsigned int sindex, dindex;
 	byte         *out;
-	int          len;
-	union
-	{
-		byte *b;
-		void *v;
-	} fbuffer;
-	byte *buf;
+	byte         *buf;
 
-	/* In this example we want to open the input file before doing anything else,
-	 * so that the setjmp() error recovery below can assume the file is open.
-	 * VERY IMPORTANT: use "b" option to fopen() if you are on a machine that
-	 * requires it in order to read binary files.
-	 */
-
-	len = ri.FS_ReadFile(( char * ) filename, &fbuffer.v);
-	if (!fbuffer.b || len < 0)
-	{
-		return;
-	}
+	image->pic    = NULL;
+	image->width  = 0;
+	image->height = 0;
 
 	/* Step 1: allocate and initialize JPEG decompression object */
 
@@ -131,6 +127,7 @@ void R_LoadJPG(const char *filename, unsigned char **pic, int *width, int *heigh
 	cinfo.err                 = jpeg_std_error(&jerr.pub);
 	cinfo.err->error_exit     = R_JPGErrorExit;
 	cinfo.err->output_message = R_JPGOutputMessage;
+	jerr.image                = image;
 
 	/* Now we can initialize the JPEG decompression object. */
 	jpeg_create_decompress(&cinfo);
@@ -139,12 +136,12 @@ void R_LoadJPG(const char *filename, unsigned char **pic, int *width, int *heigh
 	if (setjmp(jerr.jmpbuf))
 	{
 		// There was an error in jpeg decompression. Abort.
-		return;
+		return qfalse;
 	}
 
 	/* Step 2: specify data source (eg, a file) */
 
-	jpeg_mem_src(&cinfo, fbuffer.b, len);
+	jpeg_mem_src(&cinfo, (unsigned char *)image->buffer, image->length);
 
 	/* Step 3: read file parameters with jpeg_read_header() */
 
@@ -189,20 +186,21 @@ void R_LoadJPG(const char *filename, unsigned char **pic, int *width, int *heigh
 	    )
 	{
 		// Free the memory to make sure we don't leak memory
-		ri.FS_FreeFile(fbuffer.v);
 		jpeg_destroy_decompress(&cinfo);
 
-		Ren_Drop("LoadJPG: %s has an invalid image format: %dx%d*4=%d, components: %d", filename,
-		         cinfo.output_width, cinfo.output_height, pixelcount * 4, cinfo.output_components);
+		return R_DecodeDrop(image, "LoadJPG: %s has an invalid image format: %dx%d*4=%d, components: %d", image->name,
+		                    cinfo.output_width, cinfo.output_height, pixelcount * 4, cinfo.output_components);
 	}
 
 	memcount   = pixelcount * 4;
 	row_stride = cinfo.output_width * cinfo.output_components;
 
-	out = R_GetImageBuffer(memcount, BUFFER_IMAGE, filename);
-
-	*width  = cinfo.output_width;
-	*height = cinfo.output_height;
+	out = R_DecodeBuffer(image, memcount);
+	if (!out)
+	{
+		jpeg_destroy_decompress(&cinfo);
+		return qfalse;
+	}
 
 	/* Step 6: while (scan lines remain to be read) */
 	/*           jpeg_read_scanlines(...); */
@@ -237,7 +235,8 @@ void R_LoadJPG(const char *filename, unsigned char **pic, int *width, int *heigh
 	}
 	while (sindex);
 
-	*pic = out;
+	image->width  = cinfo.output_width;
+	image->height = cinfo.output_height;
 
 	/* Step 7: Finish decompression */
 
@@ -251,18 +250,47 @@ void R_LoadJPG(const char *filename, unsigned char **pic, int *width, int *heigh
 	/* This is an important step since it will release a good deal of memory. */
 	jpeg_destroy_decompress(&cinfo);
 
-	/* After finish_decompress, we can close the input file.
-	 * Here we postpone it until after no more JPEG errors are possible,
-	 * so as to simplify the setjmp error logic above.  (Actually, I don't
-	 * think that jpeg_destroy can do an error exit, but why assume anything...)
-	 */
-	ri.FS_FreeFile(fbuffer.v);
-
 	/* At this point you may want to check to see whether any corrupt-data
 	 * warnings occurred (test whether jerr.pub.num_warnings is nonzero).
 	 */
+	if (image->threaded && jerr.pub.num_warnings)
+	{
+		return qfalse;
+	}
 
 	/* And we're done! */
+	return qtrue;
+}
+
+void R_LoadJPG(const char *filename, unsigned char **pic, int *width, int *height, byte alphaByte)
+{
+	imageDecode_t image;
+	union
+	{
+		byte *b;
+		void *v;
+	} fbuffer;
+
+	*pic = NULL;
+
+	Com_Memset(&image, 0, sizeof(image));
+	image.name      = filename;
+	image.alphaByte = alphaByte;
+	image.length    = ri.FS_ReadFile(( char * ) filename, &fbuffer.v);
+	image.buffer    = fbuffer.b;
+	if (!fbuffer.b || image.length < 0)
+	{
+		return;
+	}
+
+	if (R_DecodeJPG(&image))
+	{
+		*pic    = image.pic;
+		*width  = image.width;
+		*height = image.height;
+	}
+
+	ri.FS_FreeFile(fbuffer.v);
 }
 
 
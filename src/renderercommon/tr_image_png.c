@@ -203,70 +203,14 @@ struct BufferedFile
 };
 
 /*
- *  Read a file into a buffer.
+ *  Set up a buffered file for a file in memory.
  */
-static struct BufferedFile *ReadBufferedFile(const char *name)
+static void InitBufferedFile(struct BufferedFile *BF, const byte *buffer, int length)
 {
-	struct BufferedFile *BF;
-	union
-	{
-		byte *b;
-		void *v;
-	} buffer;
-
-	//  input verification
-	if (!name)
-	{
-		return NULL;
-	}
-
-	//  Allocate control struct.
-	BF = ri.Z_Malloc(sizeof(struct BufferedFile));
-	if (!BF)
-	{
-		return NULL;
-	}
-
-	//  Initialize the structs components.
-	BF->Length    = 0;
-	BF->Buffer    = NULL;
-	BF->Ptr       = NULL;
-	BF->BytesLeft = 0;
-
-	// Read the file.
-	BF->Length = ri.FS_ReadFile((char *) name, &buffer.v);
-	BF->Buffer = buffer.b;
-
-
-	//  Did we get it? Is it big enough?
-	if (!(BF->Buffer && (BF->Length > 0)))
-	{
-		ri.Free(BF);
-
-		return NULL;
-	}
-
-	// Set the pointers and counters.
+	BF->Buffer    = (byte *)buffer;
+	BF->Length    = length;
 	BF->Ptr       = BF->Buffer;
 	BF->BytesLeft = BF->Length;
-
-	return(BF);
-}
-
-/*
- *  Close a buffered file.
- */
-static void CloseBufferedFile(struct BufferedFile *BF)
-{
-	if (BF)
-	{
-		if (BF->Buffer)
-		{
-			ri.FS_FreeFile(BF->Buffer);
-		}
-
-		ri.Free(BF);
-	}
 }
 
 /*
@@ -507,7 +451,7 @@ static uint32_t DecompressIDATs(struct BufferedFile *BF, uint8_t **Buffer)
 
 	BufferedFileRewind(BF, BytesToRewind);
 
-	CompressedData = ri.Z_Malloc(CompressedDataLength);
+	CompressedData = malloc(CompressedDataLength);
 	if (!CompressedData)
 	{
 		return(-1);
@@ -522,7 +466,7 @@ static uint32_t DecompressIDATs(struct BufferedFile *BF, uint8_t **Buffer)
 		CH = BufferedFileRead(BF, PNG_ChunkHeader_Size);
 		if (!CH)
 		{
-			ri.Free(CompressedData);
+			free(CompressedData);
 
 			return(-1);
 		}
@@ -547,14 +491,14 @@ static uint32_t DecompressIDATs(struct BufferedFile *BF, uint8_t **Buffer)
 			OrigCompressedData = BufferedFileRead(BF, Length);
 			if (!OrigCompressedData)
 			{
-				ri.Free(CompressedData);
+				free(CompressedData);
 
 				return(-1);
 			}
 
 			if (!BufferedFileSkip(BF, PNG_ChunkCRC_Size))
 			{
-				ri.Free(CompressedData);
+				free(CompressedData);
 
 				return(-1);
 			}
@@ -576,16 +520,16 @@ static uint32_t DecompressIDATs(struct BufferedFile *BF, uint8_t **Buffer)
 	puffResult = puff(puffDest, &puffDestLen, puffSrc, &puffSrcLen);
 	if (!((puffResult == 0) && (puffDestLen > 0)))
 	{
-		ri.Free(CompressedData);
+		free(CompressedData);
 
 		return(-1);
 	}
 
 	// Allocate the buffer for the uncompressed data.
-	DecompressedData = ri.Z_Malloc(puffDestLen);
+	DecompressedData = malloc(puffDestLen);
 	if (!DecompressedData)
 	{
-		ri.Free(CompressedData);
+		free(CompressedData);
 
 		return(-1);
 	}
@@ -599,12 +543,12 @@ static uint32_t DecompressIDATs(struct BufferedFile *BF, uint8_t **Buffer)
 	puffResult = puff(puffDest, &puffDestLen, puffSrc, &puffSrcLen);
 
 	// The compressed data is not needed anymore.
-	ri.Free(CompressedData);
+	free(CompressedData);
 
 	// Check if the last puff() was successfull.
 	if (!((puffResult == 0) && (puffDestLen > 0)))
 	{
-		ri.Free(DecompressedData);
+		free(DecompressedData);
 
 		return(-1);
 	}
@@ -1584,13 +1528,18 @@ static qboolean DecodeImageInterlaced(struct PNG_Chunk_IHDR *IHDR,
 	return qtrue;
 }
 
-/*
- *  The PNG loader
- *	alphaByte is not yet implemented
+/**
+ * @brief Decodes a PNG file
+ * @param[in,out] image
+ * @return
+ *
+ * @note alphaByte is not yet implemented
  */
-void R_LoadPNG(const char *name, byte **pic, int *width, int *height, byte alphaByte)
+qboolean R_DecodePNG(imageDecode_t *image)
 {
-	struct BufferedFile    *ThePNG;
+	struct BufferedFile    BF;
+	struct BufferedFile    *ThePNG = &BF;
+	const char             *name   = image->name;
 	byte                   *OutBuffer;
 	uint8_t                *Signature;
 	struct PNG_ChunkHeader *CH;
@@ -1612,56 +1561,36 @@ void R_LoadPNG(const char *name, byte **pic, int *width, int *height, byte alpha
 	qboolean HasTransparentColour = qfalse;
 	uint8_t  TransparentColour[6] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
 
-	// input verification
-	if (!(name && pic))
-	{
-		return;
-	}
-
 	// Zero out return values.
-	*pic = NULL;
-
-	if (width)
-	{
-		*width = 0;
-	}
+	image->pic    = NULL;
+	image->width  = 0;
+	image->height = 0;
 
-	if (height)
+	if (image->length <= 0)
 	{
-		*height = 0;
+		return qfalse;
 	}
 
-	// Read the file.
-	ThePNG = ReadBufferedFile(name);
-	if (!ThePNG)
-	{
-		return;
-	}
+	InitBufferedFile(ThePNG, image->buffer, image->length);
 
 	// Read the siganture of the file.
 	Signature = BufferedFileRead(ThePNG, PNG_Signature_Size);
 	if (!Signature)
 	{
-		CloseBufferedFile(ThePNG);
-
-		return;
+		return qfalse;
 	}
 
 	// Is it a PNG?
 	if (memcmp(Signature, PNG_Signature, PNG_Signature_Size))
 	{
-		CloseBufferedFile(ThePNG);
-
-		return;
+		return qfalse;
 	}
 
 	// Read the first chunk-header.
 	CH = BufferedFileRead(ThePNG, PNG_ChunkHeader_Size);
 	if (!CH)
 	{
-		CloseBufferedFile(ThePNG);
-
-		return;
+		return qfalse;
 	}
 
 	// PNG multi-byte types are in Big Endian
@@ -1671,27 +1600,21 @@ void R_LoadPNG(const char *name, byte **pic, int *width, int *height, byte alpha
 	// Check if the first chunk is an IHDR.
 	if (!((ChunkHeaderType == PNG_ChunkType_IHDR) && (ChunkHeaderLength == PNG_Chunk_IHDR_Size)))
 	{
-		CloseBufferedFile(ThePNG);
-
-		return;
+		return qfalse;
 	}
 
 	// Read the IHDR.
 	IHDR = BufferedFileRead(ThePNG, PNG_Chunk_IHDR_Size);
 	if (!IHDR)
 	{
-		CloseBufferedFile(ThePNG);
-
-		return;
+		return qfalse;
 	}
 
 	// Read the CRC for IHDR
 	CRC = BufferedFileRead(ThePNG, PNG_ChunkCRC_Size);
 	if (!CRC)
 	{
-		CloseBufferedFile(ThePNG);
-
-		return;
+		return qfalse;
 	}
 
 	// Here we could check the CRC if we wanted to.
@@ -1704,11 +1627,7 @@ void R_LoadPNG(const char *name, byte **pic, int *width, int *height, byte alpha
 	if (!((IHDR_Width > 0) && (IHDR_Height > 0))
 	    || IHDR_Width > INT_MAX / Q3IMAGE_BYTESPERPIXEL / IHDR_Height)
 	{
-		CloseBufferedFile(ThePNG);
-
-		Ren_Print(S_COLOR_YELLOW "%s: invalid image size\n", name);
-
-		return;
+		return R_DecodeWarning(image, S_COLOR_YELLOW "%s: invalid image size\n", name);
 	}
 
 	// Do we need to check if the dimensions of the image are valid for Quake3?
@@ -1716,17 +1635,13 @@ void R_LoadPNG(const char *name, byte **pic, int *width, int *height, byte alpha
 	// Check if CompressionMethod and FilterMethod are valid.
 	if (!((IHDR->CompressionMethod == PNG_CompressionMethod_0) && (IHDR->FilterMethod == PNG_FilterMethod_0)))
 	{
-		CloseBufferedFile(ThePNG);
-
-		return;
+		return qfalse;
 	}
 
 	// Check if InterlaceMethod is valid.
 	if (!((IHDR->InterlaceMethod == PNG_InterlaceMethod_NonInterlaced)  || (IHDR->InterlaceMethod == PNG_InterlaceMethod_Interlaced)))
 	{
-		CloseBufferedFile(ThePNG);
-
-		return;
+		return qfalse;
 	}
 
 	// Read palette for an indexed image.
@@ -1735,18 +1650,14 @@ void R_LoadPNG(const char *name, byte **pic, int *width, int *height, byte alpha
 		// We need the palette first.
 		if (!FindChunk(ThePNG, PNG_ChunkType_PLTE))
 		{
-			CloseBufferedFile(ThePNG);
-
-			return;
+			return qfalse;
 		}
 
 		// Read the chunk-header.
 		CH = BufferedFileRead(ThePNG, PNG_ChunkHeader_Size);
 		if (!CH)
 		{
-			CloseBufferedFile(ThePNG);
-
-			return;
+			return qfalse;
 		}
 
 		// PNG multi-byte types are in Big Endian
@@ -1756,35 +1667,27 @@ void R_LoadPNG(const char *name, byte **pic, int *width, int *height, byte alpha
 		// Check if the chunk is an PLTE.
 		if (!(ChunkHeaderType == PNG_ChunkType_PLTE))
 		{
-			CloseBufferedFile(ThePNG);
-
-			return;
+			return qfalse;
 		}
 
 		// Check if Length is divisible by 3
 		if (ChunkHeaderLength % 3)
 		{
-			CloseBufferedFile(ThePNG);
-
-			return;
+			return qfalse;
 		}
 
 		// Read the raw palette data
 		InPal = BufferedFileRead(ThePNG, ChunkHeaderLength);
 		if (!InPal)
 		{
-			CloseBufferedFile(ThePNG);
-
-			return;
+			return qfalse;
 		}
 
 		// Read the CRC for the palette
 		CRC = BufferedFileRead(ThePNG, PNG_ChunkCRC_Size);
 		if (!CRC)
 		{
-			CloseBufferedFile(ThePNG);
-
-			return;
+			return qfalse;
 		}
 
 		// Set some default values.
@@ -1817,9 +1720,7 @@ void R_LoadPNG(const char *name, byte **pic, int *width, int *height, byte alpha
 		CH = BufferedFileRead(ThePNG, PNG_ChunkHeader_Size);
 		if (!CH)
 		{
-			CloseBufferedFile(ThePNG);
-
-			return;
+			return qfalse;
 		}
 
 		//  PNG multi-byte types are in Big Endian
@@ -1829,27 +1730,21 @@ void R_LoadPNG(const char *name, byte **pic, int *width, int *height, byte alpha
 		// Check if the chunk is an tRNS.
 		if (!(ChunkHeaderType == PNG_ChunkType_tRNS))
 		{
-			CloseBufferedFile(ThePNG);
-
-			return;
+			return qfalse;
 		}
 
 		//  Read the transparency information.
 		Trans = BufferedFileRead(ThePNG, ChunkHeaderLength);
 		if (!Trans)
 		{
-			CloseBufferedFile(ThePNG);
-
-			return;
+			return qfalse;
 		}
 
 		//  Read the CRC.
 		CRC = BufferedFileRead(ThePNG, PNG_ChunkCRC_Size);
 		if (!CRC)
 		{
-			CloseBufferedFile(ThePNG);
-
-			return;
+			return qfalse;
 		}
 
 		// Only for Grey, True and Indexed ColourType should tRNS exist.
@@ -1859,9 +1754,7 @@ void R_LoadPNG(const char *name, byte **pic, int *width, int *height, byte alpha
 		{
 			if (ChunkHeaderLength != 2)
 			{
-				CloseBufferedFile(ThePNG);
-
-				return;
+				return qfalse;
 			}
 
 			HasTransparentColour = qtrue;
@@ -1878,9 +1771,7 @@ void R_LoadPNG(const char *name, byte **pic, int *width, int *height, byte alpha
 		{
 			if (ChunkHeaderLength != 6)
 			{
-				CloseBufferedFile(ThePNG);
-
-				return;
+				return qfalse;
 			}
 
 			HasTransparentColour = qtrue;
@@ -1904,9 +1795,7 @@ void R_LoadPNG(const char *name, byte **pic, int *width, int *height, byte alpha
 			// Maximum of 256 one byte transparency entries.
 			if (ChunkHeaderLength > 256)
 			{
-				CloseBufferedFile(ThePNG);
-
-				return;
+				return qfalse;
 			}
 
 			HasTransparentColour = qtrue;
@@ -1923,9 +1812,7 @@ void R_LoadPNG(const char *name, byte **pic, int *width, int *height, byte alpha
 		//  All other ColourTypes should not have tRNS chunks
 		default:
 		{
-			CloseBufferedFile(ThePNG);
-
-			return;
+			return qfalse;
 		}
 		}
 	}
@@ -1933,36 +1820,29 @@ void R_LoadPNG(const char *name, byte **pic, int *width, int *height, byte alpha
 	// Rewind to the start of the file.
 	if (!BufferedFileRewind(ThePNG, -1))
 	{
-		CloseBufferedFile(ThePNG);
-
-		return;
+		return qfalse;
 	}
 
 	//  Skip the signature
 	if (!BufferedFileSkip(ThePNG, PNG_Signature_Size))
 	{
-		CloseBufferedFile(ThePNG);
-
-		return;
+		return qfalse;
 	}
 
 	//  Decompress all IDAT chunks
 	DecompressedDataLength = DecompressIDATs(ThePNG, &DecompressedData);
 	if (!(DecompressedDataLength && DecompressedData))
 	{
-		CloseBufferedFile(ThePNG);
-
-		return;
+		return qfalse;
 	}
 
 	//  Allocate output buffer.
-	OutBuffer = R_GetImageBuffer(IHDR_Width * IHDR_Height * Q3IMAGE_BYTESPERPIXEL, BUFFER_IMAGE, name);
+	OutBuffer = R_DecodeBuffer(image, IHDR_Width * IHDR_Height * Q3IMAGE_BYTESPERPIXEL);
 	if (!OutBuffer)
 	{
-		ri.Free(DecompressedData);
-		CloseBufferedFile(ThePNG);
+		free(DecompressedData);
 
-		return;
+		return qfalse;
 	}
 
 	// Interlaced and Non-interlaced images need to be handled differently.
@@ -1972,11 +1852,9 @@ void R_LoadPNG(const char *name, byte **pic, int *width, int *height, byte alpha
 	{
 		if (!DecodeImageNonInterlaced(IHDR, OutBuffer, DecompressedData, DecompressedDataLength, HasTransparentColour, TransparentColour, OutPal))
 		{
-			ri.Free(OutBuffer);
-			ri.Free(DecompressedData);
-			CloseBufferedFile(ThePNG);
+			free(DecompressedData);
 
-			return;
+			return qfalse;
 		}
 
 		break;
@@ -1986,11 +1864,9 @@ void R_LoadPNG(const char *name, byte **pic, int *width, int *height, byte alpha
 	{
 		if (!DecodeImageInterlaced(IHDR, OutBuffer, DecompressedData, DecompressedDataLength, HasTransparentColour, TransparentColour, OutPal))
 		{
-			ri.Free(OutBuffer);
-			ri.Free(DecompressedData);
-			CloseBufferedFile(ThePNG);
+			free(DecompressedData);
 
-			return;
+			return qfalse;
 		}
 
 		break;
@@ -1998,31 +1874,79 @@ void R_LoadPNG(const char *name, byte **pic, int *width, int *height, byte alpha
 
 	default:
 	{
-		ri.Free(OutBuffer);
-		ri.Free(DecompressedData);
-		CloseBufferedFile(ThePNG);
+		free(DecompressedData);
 
-		return;
+		return qfalse;
 	}
 	}
 
-	//  update the pointer to the image data
-	*pic = OutBuffer;
-
 	//  Fill width and height.
+	image->width  = IHDR_Width;
+	image->height = IHDR_Height;
+
+	//  DecompressedData is not needed anymore.
+	free(DecompressedData);
+
+	return qtrue;
+}
+
+/*
+ *  The PNG loader
+ *	alphaByte is not yet implemented
+ */
+void R_LoadPNG(const char *name, byte **pic, int *width, int *height, byte alphaByte)
+{
+	imageDecode_t image;
+	union
+	{
+		byte *b;
+		void *v;
+	} buffer;
+
+	// input verification
+	if (!(name && pic))
+	{
+		return;
+	}
+
+	// Zero out return values.
+	*pic = NULL;
+
 	if (width)
 	{
-		*width = IHDR_Width;
+		*width = 0;
 	}
 
 	if (height)
 	{
-		*height = IHDR_Height;
+		*height = 0;
 	}
 
-	//  DecompressedData is not needed anymore.
-	ri.Free(DecompressedData);
+	// Read the file.
+	Com_Memset(&image, 0, sizeof(image));
+	image.name      = name;
+	image.alphaByte = alphaByte;
+	image.length    = ri.FS_ReadFile((char *) name, &buffer.v);
+	image.buffer    = buffer.b;
+	if (!buffer.b)
+	{
+		return;
+	}
+
+	if (R_DecodePNG(&image))
+	{
+		*pic = image.pic;
+
+		if (width)
+		{
+			*width = image.width;
+		}
+
+		if (height)
+		{
+			*height = image.height;
+		}
+	}
 
-	//  We have all data, so close the file.
-	CloseBufferedFile(ThePNG);
+	ri.FS_FreeFile(buffer.v);
 }
@@ -51,49 +51,34 @@ typedef struct _TargaHeader
 	unsigned char pixel_size, attributes;
 } TargaHeader;
 
-void R_LoadTGA(const char *name, byte **pic, int *width, int *height, byte alphaByte)
+/**
+ * @brief Decodes a TGA file
+ * @param[in,out] image
+ * @return
+ */
+qboolean R_DecodeTGA(imageDecode_t *image)
 {
-	unsigned columns, rows, numPixels;
-	byte     *pixbuf;
-	int      row, column;
-	byte     *buf_p;
-	byte     *end;
-	union
-	{
-		byte *b;
-		void *v;
-	} buffer;
+	unsigned    columns, rows, numPixels;
+	byte        *pixbuf;
+	int         row, column;
+	const byte  *buf_p;
+	const byte  *end;
 	TargaHeader targa_header;
 	byte        *targa_rgba;
-	int         length;
-
-	*pic = NULL;
-
-	if (width)
-	{
-		*width = 0;
-	}
-	if (height)
-	{
-		*height = 0;
-	}
+	byte        alphaByte = image->alphaByte;
+	const char  *name     = image->name;
 
-	//
-	// load the file
-	//
-	length = ri.FS_ReadFile(( char * ) name, &buffer.v);
-	if (!buffer.b || length < 0)
-	{
-		return;
-	}
+	image->pic    = NULL;
+	image->width  = 0;
+	image->height = 0;
 
-	if (length < 18)
+	if (image->length < 18)
 	{
-		Ren_Drop("LoadTGA: header too short (%s)\n", name);
+		return R_DecodeDrop(image, "LoadTGA: header too short (%s)\n", name);
 	}
 
-	buf_p = buffer.b;
-	end   = buffer.b + length;
+	buf_p = image->buffer;
+	end   = image->buffer + image->length;
 
 	targa_header.id_length     = buf_p[0];
 	targa_header.colormap_type = buf_p[1];
@@ -122,20 +107,17 @@ void R_LoadTGA(const char *name, byte **pic, int *width, int *height, byte alpha
 	    && targa_header.image_type != 10
 	    && targa_header.image_type != 3)
 	{
-		ri.FS_FreeFile(buffer.v);
-		Ren_Drop("LoadTGA: Only type 2 (RGB), 3 (gray), and 10 (RGB) TGA images supported\n");
+		return R_DecodeDrop(image, "LoadTGA: Only type 2 (RGB), 3 (gray), and 10 (RGB) TGA images supported\n");
 	}
 
 	if (targa_header.colormap_type != 0)
 	{
-		ri.FS_FreeFile(buffer.v);
-		Ren_Drop("LoadTGA: colormaps not supported\n");
+		return R_DecodeDrop(image, "LoadTGA: colormaps not supported\n");
 	}
 
 	if ((targa_header.pixel_size != 32 && targa_header.pixel_size != 24) && targa_header.image_type != 3)
 	{
-		ri.FS_FreeFile(buffer.v);
-		Ren_Drop("LoadTGA: Only 32 or 24 bit images supported (no colormaps)\n");
+		return R_DecodeDrop(image, "LoadTGA: Only 32 or 24 bit images supported (no colormaps)\n");
 	}
 
 	columns   = targa_header.width;
@@ -144,17 +126,20 @@ void R_LoadTGA(const char *name, byte **pic, int *width, int *height, byte alpha
 
 	if (!columns || !rows || numPixels > 0x7FFFFFFF || numPixels / columns / 4 != rows)
 	{
-		ri.FS_FreeFile(buffer.v);
-		Ren_Drop("LoadTGA: %s has an invalid image size\n", name);
+		return R_DecodeDrop(image, "LoadTGA: %s has an invalid image size\n", name);
 	}
 
-	targa_rgba = R_GetImageBuffer(numPixels, BUFFER_IMAGE, name);
+	targa_rgba = R_DecodeBuffer(image, numPixels);
+	if (!targa_rgba)
+	{
+		return qfalse;
+	}
 
 	if (targa_header.id_length != 0)
 	{
 		if (buf_p + targa_header.id_length > end)
 		{
-			Ren_Drop("LoadTGA: header too short (%s)\n", name);
+			return R_DecodeDrop(image, "LoadTGA: header too short (%s)\n", name);
 		}
 
 		buf_p += targa_header.id_length;  // skip TARGA image comment
@@ -164,7 +149,7 @@ void R_LoadTGA(const char *name, byte **pic, int *width, int *height, byte alpha
 	{
 		if (buf_p + columns * rows * targa_header.pixel_size / 8 > end)
 		{
-			Ren_Drop("LoadTGA: file truncated (%s)\n", name);
+			return R_DecodeDrop(image, "LoadTGA: file truncated (%s)\n", name);
 		}
 
 		// Uncompressed RGB or gray scale image
@@ -207,10 +192,7 @@ void R_LoadTGA(const char *name, byte **pic, int *width, int *height, byte alpha
 					*pixbuf++ = alpha;
 					break;
 				default:
-					ri.Free(targa_rgba);
-					ri.FS_FreeFile(buffer.v);
-					Ren_Drop("LoadTGA: illegal pixel_size '%d' in file '%s'\n", targa_header.pixel_size, name);
-					break;
+					return R_DecodeDrop(image, "LoadTGA: illegal pixel_size '%d' in file '%s'\n", targa_header.pixel_size, name);
 				}
 			}
 		}
@@ -231,7 +213,7 @@ void R_LoadTGA(const char *name, byte **pic, int *width, int *height, byte alpha
 			{
 				if (buf_p + 1 > end)
 				{
-					Ren_Drop("LoadTGA: file truncated (%s)\n", name);
+					return R_DecodeDrop(image, "LoadTGA: file truncated (%s)\n", name);
 				}
 				packetHeader = *buf_p++;
 				packetSize   = 1 + (packetHeader & 0x7f);
@@ -239,7 +221,7 @@ void R_LoadTGA(const char *name, byte **pic, int *width, int *height, byte alpha
 				{
 					if (buf_p + targa_header.pixel_size / 8 > end)
 					{
-						Ren_Drop("LoadTGA: file truncated (%s)\n", name);
+						return R_DecodeDrop(image, "LoadTGA: file truncated (%s)\n", name);
 					}
 					switch (targa_header.pixel_size)
 					{
@@ -256,10 +238,7 @@ void R_LoadTGA(const char *name, byte **pic, int *width, int *height, byte alpha
 						alpha = *buf_p++;
 						break;
 					default:
-						ri.Free(targa_rgba);
-						ri.FS_FreeFile(buffer.v);
-						Ren_Drop("LoadTGA: illegal pixel_size '%d' in file '%s'\n", targa_header.pixel_size, name);
-						break;
+						return R_DecodeDrop(image, "LoadTGA: illegal pixel_size '%d' in file '%s'\n", targa_header.pixel_size, name);
 					}
 
 					for (j = 0; j < packetSize; j++)
@@ -288,9 +267,7 @@ void R_LoadTGA(const char *name, byte **pic, int *width, int *height, byte alpha
 				{
 					if (buf_p + targa_header.pixel_size / 8 * packetSize > end)
 					{
-						ri.Free(targa_rgba);
-						ri.FS_FreeFile(buffer.v);
-						Ren_Drop("LoadTGA: file truncated (%s)\n", name);
+						return R_DecodeDrop(image, "LoadTGA: file truncated (%s)\n", name);
 					}
 					for (j = 0; j < packetSize; j++)
 					{
@@ -316,10 +293,7 @@ void R_LoadTGA(const char *name, byte **pic, int *width, int *height, byte alpha
 							*pixbuf++ = alpha;
 							break;
 						default:
-							ri.Free(targa_rgba);
-							ri.FS_FreeFile(buffer.v);
-							Ren_Drop("LoadTGA: illegal pixel_size '%d' in file '%s'\n", targa_header.pixel_size, name);
-							break;
+							return R_DecodeDrop(image, "LoadTGA: illegal pixel_size '%d' in file '%s'\n", targa_header.pixel_size, name);
 						}
 						column++;
 						if (column == columns)   // pixel packet run spans across rows
@@ -354,6 +328,10 @@ breakOut:;
 		//Ren_Warning( "WARNING: '%s' TGA file header declares top-down image, flipping\n", name);
 
 		flip = (unsigned char *)malloc(columns * 4);
+		if (!flip)
+		{
+			return qfalse;
+		}
 		for (row = 0; row < rows / 2; row++)
 		{
 			src = targa_rgba + row * 4 * columns;
@@ -373,16 +351,57 @@ breakOut:;
 	}
 #endif
 
+	image->width  = columns;
+	image->height = rows;
+
+	return qtrue;
+}
+
+void R_LoadTGA(const char *name, byte **pic, int *width, int *height, byte alphaByte)
+{
+	imageDecode_t image;
+	union
+	{
+		byte *b;
+		void *v;
+	} buffer;
+
+	*pic = NULL;
+
 	if (width)
 	{
-		*width = columns;
+		*width = 0;
 	}
 	if (height)
 	{
-		*height = rows;
+		*height = 0;
 	}
 
-	*pic = targa_rgba;
+	//
+	// load the file
+	//
+	Com_Memset(&image, 0, sizeof(image));
+	image.name      = name;
+	image.alphaByte = alphaByte;
+	image.length    = ri.FS_ReadFile(( char * ) name, &buffer.v);
+	image.buffer    = buffer.b;
+	if (!buffer.b || image.length < 0)
+	{
+		return;
+	}
+
+	if (R_DecodeTGA(&image))
+	{
+		*pic = image.pic;
+		if (width)
+		{
+			*width = image.width;
+		}
+		if (height)
+		{
+			*height = image.height;
+		}
+	}
 
 	ri.FS_FreeFile(buffer.v);
 }
@@ -37,7 +37,7 @@
 
 #include "tr_types.h"
 
-#define REF_API_VERSION     10
+#define REF_API_VERSION     11
 
 // these are the functions exported by the refresh module
 typedef struct
@@ -219,6 +219,7 @@ typedef struct
 	void (*FS_FreeFileList)(char **filelist);
 	void (*FS_WriteFile)(const char *qpath, const void *buffer, int size);
 	qboolean (*FS_FileExists)(const char *file);
+	qboolean (*FS_FilePakChecksum)(const char *name, int *pChecksum);
 
 	long (*FS_FOpenFileRead)(const char *filename, fileHandle_t *file, qboolean uniqueFILE);
 	int (*FS_Read)(void *buffer, int len, fileHandle_t f);
@@ -0,0 +1,225 @@
+/*
+ * Wolfenstein: Enemy Territory GPL Source Code
+ * Copyright (C) 1999-2010 id Software LLC, a ZeniMax Media company.
+ *
+ * ET: Legacy
+ * Copyright (C) 2012 Jan Simek <mail@etlegacy.com>
+ *
+ * This file is part of ET: Legacy - http://www.etlegacy.com
+ *
+ * ET: Legacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ET: Legacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ET: Legacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * In addition, Wolfenstein: Enemy Territory GPL Source Code is also
+ * subject to certain additional terms. You should have received a copy
+ * of these additional terms immediately following the terms and conditions
+ * of the GNU General Public License which accompanied the source code.
+ * If not, please request a copy in writing from id Software at the address below.
+ *
+ * id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+ */
+/**
+ * @file tr_shadercache.c
+ * @brief Persistent cache of the shader script text and its index
+ *
+ * Tokenizing every .shader file to find the shader names is a large part
+ * of the renderer start on installs with many pk3s. The combined script
+ * text and the offsets of the shader names are written to a cache file,
+ * keyed by the shader file names and the checksums of the pk3s they are
+ * read from, so the next start can skip reading and tokenizing the scripts.
+ *
+ * Parsed stages reference images and GL state, they are still parsed on
+ * demand from the cached text.
+ */
+
+#include "tr_common.h"
+#include "../qcommon/qcommon.h"
+
+#define SHADERCACHE_IDENT   (('C' << 24) + ('S' << 16) + ('T' << 8) + 'E')
+#define SHADERCACHE_VERSION 1
+
+typedef struct
+{
+	int ident;
+	int version;
+	unsigned int key;               // checksum of the shader file names and their pk3s
+	int numFiles;
+	int textSize;                   // size of the text including padding
+	int numEntries;
+} shaderTextCacheHeader_t;
+
+/**
+ * @brief Builds the key of the cache from the shader files and the pk3s they are read from
+ * @param[in] shaderFiles names of the files in the scripts directory
+ * @param[in] numShaderFiles
+ * @param[out] key
+ * @return qfalse if a file isn't read from a pk3, the cache can't tell if it changed
+ */
+static qboolean R_ShaderTextCacheKey(char **shaderFiles, int numShaderFiles, unsigned int *key)
+{
+	char filename[MAX_QPATH];
+	byte *buffer, *p;
+	int  i, size = 0, checksum;
+
+	for (i = 0; i < numShaderFiles; i++)
+	{
+		size += strlen(shaderFiles[i]) + 1 + sizeof(int);
+	}
+
+	p = buffer = ri.Hunk_AllocateTempMemory(size);
+
+	for (i = 0; i < numShaderFiles; i++)
+	{
+		Com_sprintf(filename, sizeof(filename), "scripts/%s", shaderFiles[i]);
+
+		if (!ri.FS_FilePakChecksum(filename, &checksum))
+		{
+			Ren_Developer("R_ShaderTextCacheKey: '%s' isn't in a pk3, not using the cache\n", filename);
+			ri.Hunk_FreeTempMemory(buffer);
+			return qfalse;
+		}
+
+		size = strlen(shaderFiles[i]) + 1;
+		Com_Memcpy(p, shaderFiles[i], size);
+		p += size;
+		Com_Memcpy(p, &checksum, sizeof(int));
+		p += sizeof(int);
+	}
+
+	*key = Com_BlockChecksum(buffer, p - buffer);
+
+	ri.Hunk_FreeTempMemory(buffer);
+	return qtrue;
+}
+
+/**
+ * @brief Loads the cached shader text if it was built from the same shader files
+ * @param[in] cacheName
+ * @param[in] shaderFiles names of the files in the scripts directory
+ * @param[in] numShaderFiles
+ * @param[out] cache text and index, the caller checks the hash values of the
+ * entries and frees it with R_FreeShaderTextCache
+ * @return qfalse if there is no valid cache
+ */
+qboolean R_LoadShaderTextCache(const char *cacheName, char **shaderFiles, int numShaderFiles, shaderTextCache_t *cache)
+{
+	shaderTextCacheHeader_t *header;
+	unsigned int            key;
+	int                     i, len;
+
+	Com_Memset(cache, 0, sizeof(*cache));
+
+	if (!R_ShaderTextCacheKey(shaderFiles, numShaderFiles, &key))
+	{
+		return qfalse;
+	}
+
+	len = ri.FS_ReadFile(cacheName, &cache->buffer);
+	if (len <= 0)
+	{
+		return qfalse;
+	}
+
+	header = (shaderTextCacheHeader_t *)cache->buffer;
+
+	if (len < (int)sizeof(*header) || header->ident != SHADERCACHE_IDENT || header->version != SHADERCACHE_VERSION
+	    || header->key != key || header->numFiles != numShaderFiles
+	    || header->textSize <= 0 || (header->textSize & 3) || header->numEntries < 0
+	    || len != (int)(sizeof(*header) + header->textSize + header->numEntries * sizeof(shaderTextEntry_t)))
+	{
+		Ren_Developer("R_LoadShaderTextCache: '%s' is out of date\n", cacheName);
+		R_FreeShaderTextCache(cache);
+		return qfalse;
+	}
+
+	cache->text       = (char *)(header + 1);
+	cache->textSize   = header->textSize;
+	cache->entries    = (shaderTextEntry_t *)(cache->text + cache->textSize);
+	cache->numEntries = header->numEntries;
+
+	if (cache->text[cache->textSize - 1])
+	{
+		R_FreeShaderTextCache(cache);
+		return qfalse;
+	}
+
+	for (i = 0; i < cache->numEntries; i++)
+	{
+		if (cache->entries[i].offset < 0 || cache->entries[i].offset >= cache->textSize)
+		{
+			R_FreeShaderTextCache(cache);
+			return qfalse;
+		}
+	}
+
+	return qtrue;
+}
+
+/**
+ * @brief Frees a cache loaded by R_LoadShaderTextCache
+ * @param[in,out] cache
+ */
+void R_FreeShaderTextCache(shaderTextCache_t *cache)
+{
+	if (cache->buffer)
+	{
+		ri.FS_FreeFile(cache->buffer);
+	}
+
+	Com_Memset(cache, 0, sizeof(*cache));
+}
+
+/**
+ * @brief Writes the shader text and its index to the cache
+ * @param[in] cacheName
+ * @param[in] shaderFiles names of the files in the scripts directory the text was built from
+ * @param[in] numShaderFiles
+ * @param[in] text
+ * @param[in] entries
+ * @param[in] numEntries
+ */
+void R_SaveShaderTextCache(const char *cacheName, char **shaderFiles, int numShaderFiles, const char *text, const shaderTextEntry_t *entries, int numEntries)
+{
+	shaderTextCacheHeader_t *header;
+	byte                    *buffer;
+	unsigned int            key;
+	int                     textLen, textSize, size;
+
+	if (!text || !R_ShaderTextCacheKey(shaderFiles, numShaderFiles, &key))
+	{
+		return;
+	}
+
+	// keep the entries aligned
+	textLen  = strlen(text) + 1;
+	textSize = (textLen + 3) & ~3;
+	size     = sizeof(*header) + textSize + numEntries * sizeof(shaderTextEntry_t);
+
+	buffer = ri.Hunk_AllocateTempMemory(size);
+	Com_Memset(buffer, 0, size);
+
+	header             = (shaderTextCacheHeader_t *)buffer;
+	header->ident      = SHADERCACHE_IDENT;
+	header->version    = SHADERCACHE_VERSION;
+	header->key        = key;
+	header->numFiles   = numShaderFiles;
+	header->textSize   = textSize;
+	header->numEntries = numEntries;
+
+	Com_Memcpy(buffer + sizeof(*header), text, textLen);
+	Com_Memcpy(buffer + sizeof(*header) + textSize, entries, numEntries * sizeof(shaderTextEntry_t));
+
+	ri.FS_WriteFile(cacheName, buffer, size);
+
+	ri.Hunk_FreeTempMemory(buffer);
+}
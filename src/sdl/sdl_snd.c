@@ -54,6 +54,13 @@ cvar_t *s_sdlMixSamps;
 static int dmapos  = 0;
 static int dmasize = 0;
 static SDL_AudioDeviceID device_id = 0;
+static int callbackSamples = 0;
+
+// mixer thread
+static SDL_Thread   *mixThread = NULL;
+static SDL_atomic_t mixThreadQuit;
+static SDL_atomic_t mixFrame;
+static int          mixThreadMsec;
 /*
 ===============
 SNDDMA_AudioCallback
@@ -333,6 +340,7 @@ qboolean SNDDMA_Init(void)
 	}
 
 	dmapos               = 0;
+	callbackSamples      = obtained.samples;
 	dma.samplebits       = obtained.format & 0xFF; // first byte of format is bits.
 	dma.channels         = obtained.channels;
 	dma.samples          = tmp;
@@ -407,3 +415,95 @@ void SNDDMA_BeginPainting(void)
 {
 	SDL_LockAudioDevice(device_id);
 }
+
+/*
+===============
+SNDDMA_MixThread
+
+Mixes ahead of the callback on its own cadence, independent from the client frames
+===============
+*/
+static int SNDDMA_MixThread(void *data)
+{
+	while (!SDL_AtomicGet(&mixThreadQuit))
+	{
+		S_MixThreadUpdate();
+		SDL_Delay(mixThreadMsec);
+	}
+
+	return 0;
+}
+
+/*
+===============
+SNDDMA_StartMixThread
+===============
+*/
+qboolean SNDDMA_StartMixThread(void)
+{
+	if (!snd_inited || mixThread)
+	{
+		return qfalse;
+	}
+
+	// wake up a few times per callback, so the callback never catches up with the mixing
+	mixThreadMsec = (callbackSamples * 1000) / (dma.speed * 4);
+	if (mixThreadMsec < 1)
+	{
+		mixThreadMsec = 1;
+	}
+	else if (mixThreadMsec > 10)
+	{
+		mixThreadMsec = 10;
+	}
+
+	SDL_AtomicSet(&mixThreadQuit, 0);
+	SDL_AtomicSet(&mixFrame, 1);
+
+	mixThread = SDL_CreateThread(SNDDMA_MixThread, "mixer", NULL);
+	if (!mixThread)
+	{
+		Com_Printf("SDL_CreateThread() failed: %s\n", SDL_GetError());
+		return qfalse;
+	}
+
+	Com_Printf("Started sound mixer thread, mixing every %i msec.\n", mixThreadMsec);
+	return qtrue;
+}
+
+/*
+===============
+SNDDMA_StopMixThread
+===============
+*/
+void SNDDMA_StopMixThread(void)
+{
+	if (!mixThread)
+	{
+		return;
+	}
+
+	SDL_AtomicSet(&mixThreadQuit, 1);
+	SDL_WaitThread(mixThread, NULL);
+	mixThread = NULL;
+}
+
+/*
+===============
+SNDDMA_ExchangeMixFrame
+===============
+*/
+int SNDDMA_ExchangeMixFrame(int frame)
+{
+	return SDL_AtomicSet(&mixFrame, frame);
+}
+
+/*
+===============
+SNDDMA_PeekMixFrame
+===============
+*/
+int SNDDMA_PeekMixFrame(void)
+{
+	return SDL_AtomicGet(&mixFrame);
+}
@@ -58,8 +58,7 @@
 
 typedef struct svEntity_s
 {
-	struct worldSector_s *worldSector;
-	struct svEntity_s *nextEntityInWorldSector;
+	int worldNode;                  // leaf in the world tree, 0 if not linked
 
 	entityState_t baseline;         // for delta compression of initial sighting
 	int numClusters;                // if -1, use headnode instead
@@ -166,6 +165,19 @@ typedef struct netchan_buffer_s
 	struct netchan_buffer_s *next;
 } netchan_buffer_t;
 
+// file shared by all clients downloading it, see sv_download.c
+typedef struct downloadSource_s downloadSource_t;
+
+// entity updates of a client's snapshots, see SV_PrioritizeSnapshotEntities
+typedef struct
+{
+	int sent;                           // entity updates sent
+	int held;                           // entity updates held back for a later snapshot
+	int late;                           // updates sent after being held back
+	int lateTime;                       // msec the late updates were held, summed
+	int maxLateTime;
+} snapshotStats_t;
+
 typedef struct client_s
 {
 	clientState_t state;
@@ -173,6 +185,7 @@ typedef struct client_s
 	char userinfobuffer[MAX_INFO_STRING];   // used for buffering of user info
 
 	char reliableCommands[MAX_RELIABLE_COMMANDS][MAX_STRING_CHARS];
+	int reliableBroadcasts[MAX_RELIABLE_COMMANDS];  // id of the shared encoding of broadcast commands, 0 for others
 	int reliableSequence;                   // last added reliable message, not necesarily sent or acknowledged yet
 	int reliableAcknowledge;                // last acknowledged reliable message
 	int reliableSent;                       // last sent reliable message, not necesarily acknowledged yet
@@ -194,15 +207,17 @@ typedef struct client_s
 
 	// downloading
 	char downloadName[MAX_QPATH];       // if not empty string, we are downloading
-	fileHandle_t download;              // file being downloaded
+	downloadSource_t *download;         // file being downloaded, shared with other clients
 	int downloadSize;                   // total bytes (can't use EOF because of paks)
-	int downloadCount;                  // bytes sent
 	int downloadClientBlock;            // last block we sent to the client, awaiting ack
-	int downloadCurrentBlock;           // current block number
+	int downloadCurrentBlock;           // end of the current window
 	int downloadXmitBlock;              // last block we xmited
-	unsigned char *downloadBlocks[MAX_DOWNLOAD_WINDOW];     // the buffers for the download blocks
-	int downloadBlockSize[MAX_DOWNLOAD_WINDOW];
-	qboolean downloadEOF;               // We have sent the EOF block
+	int downloadMaxXmitBlock;           // first block we never xmited
+	int downloadBlockTime[MAX_DOWNLOAD_WINDOW];     // time a block was first sent, 0 once resent
+	int downloadWindow;                 // blocks in flight, adapted to the acks
+	int downloadWindowThreshold;        // window size where the window stops doubling
+	int downloadWindowAcks;             // acks since the window last grew
+	int downloadRTT;                    // smoothed time until a block gets acked
 	int downloadSendTime;               // time we last sent a package
 	int downloadAckTime;                // time we last got an ack from the client
 
@@ -227,6 +242,8 @@ typedef struct client_s
 	int ping;
 	int rate;                           // bytes / second
 	int snapshotMsec;                   // requests a snapshot every snapshotMsec unless rate choked
+	int snapshotHeldTime[MAX_GENTITIES];    // svs.time the update of an entity was first held back, 0 if none
+	snapshotStats_t snapshotStats;
 	int pureAuthentic;
 	qboolean gotCP;                     // additional flag to distinguish between a bad pure checksum, and no cp command at all
 	netchan_t netchan;
@@ -379,6 +396,7 @@ extern cvar_t *sv_pure;
 extern cvar_t *sv_floodProtect;
 extern cvar_t *sv_lanForceRate;
 extern cvar_t *sv_onlyVisibleClients;
+extern cvar_t *sv_snapshotPriority;
 
 extern cvar_t *sv_showAverageBPS;           // net debugging
 
@@ -508,6 +526,12 @@ int SV_SendDownloadMessages(void);
 int SV_SendQueuedMessages(void);
 void SV_UpdateUserinfo_f(client_t *cl);
 
+// sv_download.c
+downloadSource_t *SV_OpenDownloadSource(const char *name);
+void SV_CloseDownloadSource(downloadSource_t *src);
+int SV_DownloadSourceSize(const downloadSource_t *src);
+const byte *SV_DownloadSourceBlock(downloadSource_t *src, int block, int *size);
+
 // sv_ccmds.c
 void SV_Heartbeat_f(void);
 qboolean SV_TempBanIsBanned(netadr_t address);
@@ -516,6 +540,7 @@ void SV_UptimeReset(void);
 
 // sv_snapshot.c
 void SV_AddServerCommand(client_t *client, const char *cmd);
+qboolean SV_WriteBroadcastCommand(msg_t *msg, int id);
 void SV_UpdateServerCommandsToClient(client_t *client, msg_t *msg);
 void SV_WriteFrameToClient(client_t *client, msg_t *msg);
 void SV_SendMessageToClient(msg_t *msg, client_t *client);
@@ -577,6 +602,7 @@ void SV_LinkEntity(sharedEntity_t *ent);
 clipHandle_t SV_ClipHandleForEntity(const sharedEntity_t *ent);
 
 void SV_SectorList_f(void);
+void SV_AreaBenchmark_f(void);
 
 int SV_AreaEntities(const vec3_t mins, const vec3_t maxs, int *entityList, int maxcount);
 // fills in a table of entity numbers with entities that have bounding boxes
@@ -591,6 +617,10 @@ int SV_PointContents(const vec3_t p, int passEntityNum);
 void SV_Trace(trace_t *results, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int passEntityNum, int contentmask, int capsule);
 // mins and maxs are relative
 
+int SV_TraceBatch(traceBatch_t *batch, int count);
+// runs count traces, optionally rejecting rays that leave the PVS before tracing
+// returns the number of rays that were traced
+
 // if the entire move stays in a solid volume, trace.allsolid will be set,
 // trace.startsolid will be set, and trace.fraction will be 0
 
@@ -719,6 +719,47 @@ void SV_Uptime_f(void)
 	}
 }
 
+/**
+ * @brief Prints how many entity updates sv_snapshotPriority held back and how late they were sent
+ */
+static void SV_SnapshotStats_f(void)
+{
+	client_t *cl;
+	int      i;
+
+	if (!com_sv_running->integer)
+	{
+		Com_Printf("Server is not running.\n");
+		return;
+	}
+
+	if (Cmd_Argc() == 2 && !Q_stricmp(Cmd_Argv(1), "reset"))
+	{
+		for (i = 0, cl = svs.clients ; i < sv_maxclients->integer ; i++, cl++)
+		{
+			Com_Memset(&cl->snapshotStats, 0, sizeof(cl->snapshotStats));
+		}
+		return;
+	}
+
+	Com_Printf("num name             rate  sent    held    late    avg ms max ms\n"
+	           "--- ---------------- ----- ------- ------- ------- ------ ------\n");
+
+	for (i = 0, cl = svs.clients ; i < sv_maxclients->integer ; i++, cl++)
+	{
+		snapshotStats_t *stats = &cl->snapshotStats;
+
+		if (cl->state < CS_ACTIVE || cl->demoClient || (cl->gentity && (cl->gentity->r.svFlags & SVF_BOT)))
+		{
+			continue;
+		}
+
+		Com_Printf("%3i %-16.16s %5i %7i %7i %7i %6i %6i\n", i, cl->name, cl->rate,
+		           stats->sent, stats->held, stats->late,
+		           stats->late ? stats->lateTime / stats->late : 0, stats->maxLateTime);
+	}
+}
+
 //===========================================================
 
 /*
@@ -744,6 +785,7 @@ void SV_AddOperatorCommands(void)
 	Cmd_AddCommand("map_restart", SV_MapRestart_f);
 	Cmd_AddCommand("fieldinfo", SV_FieldInfo_f);
 	Cmd_AddCommand("sectorlist", SV_SectorList_f);
+	Cmd_AddCommand("areabench", SV_AreaBenchmark_f);
 	Cmd_AddCommand("gameCompleteStatus", SV_GameCompleteStatus_f);
 
 	Cmd_AddCommand("map", SV_Map_f);
@@ -758,6 +800,7 @@ void SV_AddOperatorCommands(void)
 	}
 
 	Cmd_AddCommand("uptime", SV_Uptime_f);
+	Cmd_AddCommand("snapshotstats", SV_SnapshotStats_f);
 
 	SV_DemoInit();
 }
@@ -781,6 +824,7 @@ void SV_RemoveOperatorCommands(void)
 	Cmd_RemoveCommand("dumpuser");
 	Cmd_RemoveCommand("map_restart");
 	Cmd_RemoveCommand("sectorlist");
+	Cmd_RemoveCommand("areabench");
 	Cmd_RemoveCommand("say");
 #endif
 }
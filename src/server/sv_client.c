@@ -39,6 +39,12 @@
 #include "sv_tracker.h"
 #endif
 
+// the download window adapts to the acks, MAX_DOWNLOAD_WINDOW is the limit of the protocol
+#define DOWNLOAD_WINDOW_START   16
+#define DOWNLOAD_WINDOW_MIN     4
+#define DOWNLOAD_TIMEOUT_MIN    250
+#define DOWNLOAD_TIMEOUT_MAX    1000
+
 static void SV_CloseDownload(client_t *cl);
 
 /**
@@ -480,8 +486,8 @@ void SV_DropClient(client_t *drop, const char *reason)
 
 	if (drop->download)
 	{
-		FS_FCloseFile(drop->download);
-		drop->download = 0;
+		SV_CloseDownloadSource(drop->download);
+		drop->download = NULL;
 	}
 
 	// call the prog function for removing a client
@@ -651,27 +657,73 @@ CLIENT COMMAND EXECUTION
  */
 static void SV_CloseDownload(client_t *cl)
 {
-	int i;
-
 	// EOF
 	if (cl->download)
 	{
-		FS_FCloseFile(cl->download);
+		SV_CloseDownloadSource(cl->download);
 	}
-	cl->download      = 0;
+	cl->download      = NULL;
 	*cl->downloadName = 0;
+}
+
+/**
+ * @brief Updates the ack time and opens the download window after an ack
+ * @param[in,out] cl
+ * @param[in] block
+ */
+static void SV_DownloadAcked(client_t *cl, int block)
+{
+	int sendTime = cl->downloadBlockTime[block % MAX_DOWNLOAD_WINDOW];
+
+	if (sendTime)
+	{
+		if (cl->downloadRTT)
+		{
+			cl->downloadRTT += (svs.time - sendTime - cl->downloadRTT) / 8;
+		}
+		else
+		{
+			cl->downloadRTT = svs.time - sendTime;
+		}
+	}
 
-	// Free the temporary buffer space
-	for (i = 0; i < MAX_DOWNLOAD_WINDOW; i++)
+	// double the window each round trip until the threshold, grow slowly afterwards
+	if (cl->downloadWindow < cl->downloadWindowThreshold || ++cl->downloadWindowAcks >= cl->downloadWindow)
 	{
-		if (cl->downloadBlocks[i])
+		cl->downloadWindowAcks = 0;
+		if (cl->downloadWindow < MAX_DOWNLOAD_WINDOW)
 		{
-			Z_Free(cl->downloadBlocks[i]);
-			cl->downloadBlocks[i] = NULL;
+			cl->downloadWindow++;
 		}
 	}
 }
 
+/**
+ * @brief Time to wait for acks before resending the download window
+ * @param[in] cl
+ * @return
+ */
+static int SV_DownloadTimeout(client_t *cl)
+{
+	if (!cl->downloadRTT)
+	{
+		return DOWNLOAD_TIMEOUT_MAX;
+	}
+
+	return (int)Com_Clamp(DOWNLOAD_TIMEOUT_MIN, DOWNLOAD_TIMEOUT_MAX, 2 * cl->downloadRTT + 100);
+}
+
+/**
+ * @brief Shrinks the download window when blocks have to be resent
+ * @param[in,out] cl
+ */
+static void SV_DownloadTimedOut(client_t *cl)
+{
+	cl->downloadWindowThreshold = MAX(cl->downloadWindow / 2, DOWNLOAD_WINDOW_MIN);
+	cl->downloadWindow          = cl->downloadWindowThreshold;
+	cl->downloadWindowAcks      = 0;
+}
+
 /**
  * @brief Abort a download if in progress
  */
@@ -714,13 +766,15 @@ void SV_NextDownload_f(client_t *cl)
 		Com_DPrintf("clientDownload: %d : client acknowledge of block %d\n", (int) (cl - svs.clients), block);
 
 		// Find out if we are done.  A zero-length block indicates EOF
-		if (cl->downloadBlockSize[cl->downloadClientBlock % MAX_DOWNLOAD_WINDOW] == 0)
+		if (block * MAX_DOWNLOAD_BLKSIZE >= cl->downloadSize)
 		{
 			Com_Printf("clientDownload: %d : file \"%s\" completed\n", (int) (cl - svs.clients), cl->downloadName);
 			SV_CloseDownload(cl);
 			return;
 		}
 
+		SV_DownloadAcked(cl, block);
+
 		cl->downloadAckTime = svs.time;
 		cl->downloadClientBlock++;
 		return;
@@ -895,9 +949,9 @@ static qboolean SV_CheckDownloadAllowed(client_t *cl, msg_t *msg)
 // We open the file here
 static qboolean SV_SetupDownloadFile(client_t *cl, msg_t *msg)
 {
-	int          download_flag;
-	fileHandle_t downloadFileHandle = 0;
-	int          downloadSize       = 0;
+	int              download_flag;
+	downloadSource_t *downloadSource;
+	int              downloadSize;
 
 	// prevent duplicate download notifications
 	if (cl->downloadnotify & DLNOTIFY_BEGIN)
@@ -913,14 +967,15 @@ static qboolean SV_SetupDownloadFile(client_t *cl, msg_t *msg)
 		return qtrue;
 	}
 
-	downloadSize = FS_SV_FOpenFileRead(cl->downloadName, &downloadFileHandle);
-	if (downloadSize <= 0)
+	downloadSource = SV_OpenDownloadSource(cl->downloadName);
+	if (!downloadSource)
 	{
 		Com_Printf("clientDownload: %d : \"%s\" file not found on server\n", (int)(cl - svs.clients), cl->downloadName);
 		SV_BadDownload(cl, msg);
 		SV_DropClient(cl, va("File \"%s\" not found on server for autodownloading.\n", cl->downloadName));
 		return qtrue;
 	}
+	downloadSize = SV_DownloadSourceSize(downloadSource);
 
 	// www download redirect protocol
 	// NOTE: this is called repeatedly while a client connects. Maybe we should sort of cache the message or something
@@ -932,7 +987,7 @@ static qboolean SV_SetupDownloadFile(client_t *cl, msg_t *msg)
 		{
 			if (!cl->bFallback)
 			{
-				FS_FCloseFile(downloadFileHandle);   // don't keep open, we only care about the size
+				SV_CloseDownloadSource(downloadSource);   // don't keep open, we only care about the size
 
 				Q_strncpyz(cl->downloadURL, va("%s/%s", sv_wwwBaseURL->string, cl->downloadName), sizeof(cl->downloadURL));
 
@@ -982,13 +1037,17 @@ static qboolean SV_SetupDownloadFile(client_t *cl, msg_t *msg)
 	}
 
 	cl->bWWWDl       = qfalse;
-	cl->download     = downloadFileHandle;
+	cl->download     = downloadSource;
 	cl->downloadSize = downloadSize;
 
 	// is valid source, init
 	cl->downloadCurrentBlock = cl->downloadClientBlock = cl->downloadXmitBlock = 0;
-	cl->downloadCount        = 0;
-	cl->downloadEOF          = qfalse;
+	cl->downloadMaxXmitBlock = 0;
+
+	cl->downloadWindow          = DOWNLOAD_WINDOW_START;
+	cl->downloadWindowThreshold = MAX_DOWNLOAD_WINDOW;
+	cl->downloadWindowAcks      = 0;
+	cl->downloadRTT             = 0;
 
 	// We reset the ack time to current when we start
 	cl->downloadAckTime = svs.time;
@@ -1001,7 +1060,8 @@ static qboolean SV_SetupDownloadFile(client_t *cl, msg_t *msg)
  */
 static qboolean SV_WriteDownloadToClient(client_t *cl, msg_t *msg)
 {
-	int curindex;
+	const byte *data = NULL;
+	int        size;
 
 	if (!*cl->downloadName)
 	{
@@ -1026,40 +1086,11 @@ static qboolean SV_WriteDownloadToClient(client_t *cl, msg_t *msg)
 		return qtrue;
 	}
 
-	// Perform any reads that we need to
-	while (cl->downloadCurrentBlock - cl->downloadClientBlock < MAX_DOWNLOAD_WINDOW && cl->downloadSize != cl->downloadCount)
+	// Open the window, the EOF block is the one past the last data block
+	cl->downloadCurrentBlock = cl->downloadClientBlock + cl->downloadWindow;
+	if (cl->downloadCurrentBlock > (cl->downloadSize + MAX_DOWNLOAD_BLKSIZE - 1) / MAX_DOWNLOAD_BLKSIZE + 1)
 	{
-		curindex = (cl->downloadCurrentBlock % MAX_DOWNLOAD_WINDOW);
-
-		if (!cl->downloadBlocks[curindex])
-		{
-			cl->downloadBlocks[curindex] = Z_Malloc(MAX_DOWNLOAD_BLKSIZE);
-		}
-
-		cl->downloadBlockSize[curindex] = FS_Read(cl->downloadBlocks[curindex], MAX_DOWNLOAD_BLKSIZE, cl->download);
-
-		if (cl->downloadBlockSize[curindex] < 0)
-		{
-			// EOF right now
-			cl->downloadCount = cl->downloadSize;
-			break;
-		}
-
-		cl->downloadCount += cl->downloadBlockSize[curindex];
-
-		// Load in next block
-		cl->downloadCurrentBlock++;
-	}
-
-	// Check to see if we have eof condition and add the EOF block
-	if (cl->downloadCount == cl->downloadSize && !cl->downloadEOF &&
-	    cl->downloadCurrentBlock - cl->downloadClientBlock < MAX_DOWNLOAD_WINDOW)
-	{
-
-		cl->downloadBlockSize[cl->downloadCurrentBlock % MAX_DOWNLOAD_WINDOW] = 0;
-		cl->downloadCurrentBlock++;
-
-		cl->downloadEOF = qtrue;  // We have added the EOF block
+		cl->downloadCurrentBlock = (cl->downloadSize + MAX_DOWNLOAD_BLKSIZE - 1) / MAX_DOWNLOAD_BLKSIZE + 1;
 	}
 
 	if (cl->downloadClientBlock == cl->downloadCurrentBlock)
@@ -1069,11 +1100,12 @@ static qboolean SV_WriteDownloadToClient(client_t *cl, msg_t *msg)
 
 	// Write out the next section of the file, if we have already reached our window,
 	// automatically start retransmitting
-	if (cl->downloadXmitBlock == cl->downloadCurrentBlock)
+	if (cl->downloadXmitBlock >= cl->downloadCurrentBlock)
 	{
 		// We have transmitted the complete window, should we start resending?
-		if (svs.time - cl->downloadSendTime > 1000)
+		if (svs.time - cl->downloadSendTime > SV_DownloadTimeout(cl))
 		{
+			SV_DownloadTimedOut(cl);
 			cl->downloadXmitBlock = cl->downloadClientBlock;
 		}
 		else
@@ -1083,7 +1115,20 @@ static qboolean SV_WriteDownloadToClient(client_t *cl, msg_t *msg)
 	}
 
 	// Send current block
-	curindex = (cl->downloadXmitBlock % MAX_DOWNLOAD_WINDOW);
+	if (cl->downloadXmitBlock * MAX_DOWNLOAD_BLKSIZE < cl->downloadSize)
+	{
+		data = SV_DownloadSourceBlock(cl->download, cl->downloadXmitBlock, &size);
+		if (!data)
+		{
+			SV_CloseDownload(cl);
+			SV_DropClient(cl, "Download failed");
+			return qfalse;
+		}
+	}
+	else
+	{
+		size = 0;
+	}
 
 	MSG_WriteByte(msg, svc_download);
 	MSG_WriteShort(msg, cl->downloadXmitBlock);
@@ -1094,12 +1139,23 @@ static qboolean SV_WriteDownloadToClient(client_t *cl, msg_t *msg)
 		MSG_WriteLong(msg, cl->downloadSize);
 	}
 
-	MSG_WriteShort(msg, cl->downloadBlockSize[curindex]);
+	MSG_WriteShort(msg, size);
 
 	// Write the block
-	if (cl->downloadBlockSize[curindex])
+	if (size)
+	{
+		MSG_WriteData(msg, data, size);
+	}
+
+	// only blocks sent once give a usable ack time
+	if (cl->downloadXmitBlock >= cl->downloadMaxXmitBlock)
+	{
+		cl->downloadBlockTime[cl->downloadXmitBlock % MAX_DOWNLOAD_WINDOW] = svs.time;
+		cl->downloadMaxXmitBlock                                           = cl->downloadXmitBlock + 1;
+	}
+	else
 	{
-		MSG_WriteData(msg, cl->downloadBlocks[curindex], cl->downloadBlockSize[curindex]);
+		cl->downloadBlockTime[cl->downloadXmitBlock % MAX_DOWNLOAD_WINDOW] = 0;
 	}
 
 	Com_DPrintf("clientDownload: %d : writing block %d\n", (int)(cl - svs.clients), cl->downloadXmitBlock);
@@ -0,0 +1,258 @@
+/*
+ * Wolfenstein: Enemy Territory GPL Source Code
+ * Copyright (C) 1999-2010 id Software LLC, a ZeniMax Media company.
+ *
+ * ET: Legacy
+ * Copyright (C) 2012 Jan Simek <mail@etlegacy.com>
+ *
+ * This file is part of ET: Legacy - http://www.etlegacy.com
+ *
+ * ET: Legacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ET: Legacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ET: Legacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * In addition, Wolfenstein: Enemy Territory GPL Source Code is also
+ * subject to certain additional terms. You should have received a copy
+ * of these additional terms immediately following the terms and conditions
+ * of the GNU General Public License which accompanied the source code.
+ * If not, please request a copy in writing from id Software at the address below.
+ *
+ * id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+ */
+/**
+ * @file sv_download.c
+ * @brief Shared file sources for in-game downloads
+ *
+ * All clients downloading the same file share one file handle and a small
+ * cache of file pages, so a file is read from disk once for everybody
+ * fetching it at roughly the same position instead of once per client.
+ * Clients only keep their position in the file.
+ */
+
+#include "server.h"
+
+#define DOWNLOAD_PAGE_BLOCKS    32
+#define DOWNLOAD_PAGE_SIZE      (DOWNLOAD_PAGE_BLOCKS * MAX_DOWNLOAD_BLKSIZE)
+#define DOWNLOAD_MIN_PAGES      4
+// two pages cover the window of a client
+#define DOWNLOAD_MAX_PAGES      (2 * MAX_CLIENTS + DOWNLOAD_MIN_PAGES)
+
+typedef struct
+{
+	int page;                           // page number in the file
+	int size;                           // bytes read, 0 if unused
+	int lastUsed;
+	byte *data;
+} downloadPage_t;
+
+struct downloadSource_s
+{
+	char name[MAX_QPATH];
+	fileHandle_t file;
+	int size;
+	int filePos;                        // position of the file handle
+	int refCount;
+
+	downloadPage_t pages[DOWNLOAD_MAX_PAGES];
+
+	struct downloadSource_s *next;
+};
+
+static downloadSource_t *sv_downloadSources;
+static int              sv_downloadPageClock;
+
+/**
+ * @brief Gets the shared source of a file, opening it if nobody downloads it yet
+ * @param[in] name
+ * @return NULL if the file can't be found
+ */
+downloadSource_t *SV_OpenDownloadSource(const char *name)
+{
+	downloadSource_t *src;
+	fileHandle_t     file = 0;
+	int              size;
+
+	for (src = sv_downloadSources; src; src = src->next)
+	{
+		if (!strcmp(src->name, name))
+		{
+			src->refCount++;
+			return src;
+		}
+	}
+
+	size = FS_SV_FOpenFileRead(name, &file);
+	if (size <= 0)
+	{
+		if (file)
+		{
+			FS_FCloseFile(file);
+		}
+		return NULL;
+	}
+
+	src = Z_Malloc(sizeof(downloadSource_t));
+	Q_strncpyz(src->name, name, sizeof(src->name));
+	src->file     = file;
+	src->size     = size;
+	src->refCount = 1;
+
+	src->next          = sv_downloadSources;
+	sv_downloadSources = src;
+
+	return src;
+}
+
+/**
+ * @brief Releases a source, the file is closed when the last client is done with it
+ * @param[in,out] src
+ */
+void SV_CloseDownloadSource(downloadSource_t *src)
+{
+	downloadSource_t **prev;
+	int              i;
+
+	if (--src->refCount > 0)
+	{
+		return;
+	}
+
+	for (prev = &sv_downloadSources; *prev; prev = &(*prev)->next)
+	{
+		if (*prev == src)
+		{
+			*prev = src->next;
+			break;
+		}
+	}
+
+	for (i = 0; i < DOWNLOAD_MAX_PAGES; i++)
+	{
+		if (src->pages[i].data)
+		{
+			Z_Free(src->pages[i].data);
+		}
+	}
+
+	FS_FCloseFile(src->file);
+	Z_Free(src);
+}
+
+/**
+ * @brief Size of the file of a source
+ * @param[in] src
+ * @return
+ */
+int SV_DownloadSourceSize(const downloadSource_t *src)
+{
+	return src->size;
+}
+
+/**
+ * @brief Gets a page of the file, reading it if it isn't cached
+ * @param[in,out] src
+ * @param[in] page
+ * @return NULL on read errors
+ */
+static downloadPage_t *SV_GetDownloadPage(downloadSource_t *src, int page)
+{
+	downloadPage_t *p, *victim = NULL;
+	int            i, maxPages, offset, len;
+
+	// keep more pages around the more clients are spread over the file
+	maxPages = 2 * src->refCount + DOWNLOAD_MIN_PAGES;
+	if (maxPages > DOWNLOAD_MAX_PAGES)
+	{
+		maxPages = DOWNLOAD_MAX_PAGES;
+	}
+
+	for (i = 0; i < maxPages; i++)
+	{
+		p = &src->pages[i];
+
+		if (p->size && p->page == page)
+		{
+			p->lastUsed = ++sv_downloadPageClock;
+			return p;
+		}
+
+		if (!victim || !p->size || (victim->size && p->lastUsed < victim->lastUsed))
+		{
+			victim = p;
+		}
+	}
+
+	offset = page * DOWNLOAD_PAGE_SIZE;
+	len    = src->size - offset;
+	if (len > DOWNLOAD_PAGE_SIZE)
+	{
+		len = DOWNLOAD_PAGE_SIZE;
+	}
+
+	if (!victim->data)
+	{
+		victim->data = Z_Malloc(DOWNLOAD_PAGE_SIZE);
+	}
+
+	if (src->filePos != offset)
+	{
+		FS_Seek(src->file, offset, FS_SEEK_SET);
+	}
+
+	victim->size = FS_Read(victim->data, len, src->file);
+	if (victim->size != len)
+	{
+		Com_Printf("WARNING: SV_GetDownloadPage: read error in \"%s\" at %i\n", src->name, offset);
+		victim->size = 0;
+		src->filePos = -1;
+		return NULL;
+	}
+
+	src->filePos     = offset + len;
+	victim->page     = page;
+	victim->lastUsed = ++sv_downloadPageClock;
+
+	return victim;
+}
+
+/**
+ * @brief Gets a download block of a file
+ * @param[in,out] src
+ * @param[in] block
+ * @param[out] size size of the block, 0 past the end of the file
+ * @return pointer to the block data, valid until the next call, NULL on read errors
+ * or past the end of the file
+ */
+const byte *SV_DownloadSourceBlock(downloadSource_t *src, int block, int *size)
+{
+	downloadPage_t *page;
+	int            offset = block * MAX_DOWNLOAD_BLKSIZE;
+
+	*size = src->size - offset;
+	if (*size <= 0)
+	{
+		*size = 0;
+		return NULL;
+	}
+	if (*size > MAX_DOWNLOAD_BLKSIZE)
+	{
+		*size = MAX_DOWNLOAD_BLKSIZE;
+	}
+
+	page = SV_GetDownloadPage(src, block / DOWNLOAD_PAGE_BLOCKS);
+	if (!page)
+	{
+		return NULL;
+	}
+
+	return page->data + (block % DOWNLOAD_PAGE_BLOCKS) * MAX_DOWNLOAD_BLKSIZE;
+}
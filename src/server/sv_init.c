@@ -1091,6 +1091,7 @@ void SV_Init(void)
 	sv_lanForceRate = Cvar_Get("sv_lanForceRate", "1", CVAR_ARCHIVE);
 
 	sv_onlyVisibleClients = Cvar_Get("sv_onlyVisibleClients", "0", 0);
+	sv_snapshotPriority   = Cvar_Get("sv_snapshotPriority", "0", CVAR_ARCHIVE);
 
 	sv_showAverageBPS = Cvar_Get("sv_showAverageBPS", "0", 0); // net debugging
 
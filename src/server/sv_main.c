@@ -70,6 +70,7 @@ cvar_t *sv_pure;
 cvar_t *sv_floodProtect;
 cvar_t *sv_lanForceRate;        // dedicated 1 (LAN) server forces local client rates to 99999 (bug #491)
 cvar_t *sv_onlyVisibleClients;
+cvar_t *sv_snapshotPriority;    // fill snapshots of rate limited clients by entity priority
 cvar_t *sv_friendlyFire;
 cvar_t *sv_maxlives;
 cvar_t *sv_needpass;
@@ -160,11 +161,89 @@ static char *SV_ExpandNewlines(char *in)
 	return string;
 }
 
+// Broadcast commands are encoded once and the encoded bits are copied into
+// the messages of every client. A client can only have MAX_RELIABLE_COMMANDS
+// commands pending, so the encodings of older broadcasts are never needed.
+#define MAX_BROADCAST_COMMANDS  (MAX_RELIABLE_COMMANDS * 2)
+
+typedef struct
+{
+	int id;                             // matches client_t->reliableBroadcasts
+	qboolean legacyMod;                 // IS_LEGACY_MOD when encoded, it changes the encoding
+	int length;                         // bytes of the command string, including the terminator
+	int numBits;
+	byte *data;
+} broadcastCommand_t;
+
+static broadcastCommand_t sv_broadcastCommands[MAX_BROADCAST_COMMANDS];
+static int                sv_broadcastCount;
+
 /**
- * @brief The given command will be transmitted to the client, and is guaranteed
- * to not have future snapshot_t executed before it is executed
+ * @brief Encodes a broadcast command for all clients
+ * @param[in] cmd
+ * @return id of the encoding, 0 if it can't be shared
  */
-void SV_AddServerCommand(client_t *client, const char *cmd)
+static int SV_EncodeBroadcastCommand(const char *cmd)
+{
+	static byte        buffer[MAX_MSGLEN];
+	broadcastCommand_t *bc;
+	msg_t              msg;
+
+	MSG_Init(&msg, buffer, sizeof(buffer));
+	MSG_WriteString(&msg, cmd);
+	if (msg.overflowed)
+	{
+		return 0;
+	}
+
+	// 0 is for no encoding
+	if (++sv_broadcastCount <= 0)
+	{
+		sv_broadcastCount = 1;
+	}
+
+	bc = &sv_broadcastCommands[sv_broadcastCount % MAX_BROADCAST_COMMANDS];
+	if (bc->data)
+	{
+		Z_Free(bc->data);
+	}
+
+	bc->id        = sv_broadcastCount;
+	bc->legacyMod = IS_LEGACY_MOD;
+	bc->length    = strlen(cmd) + 1;
+	bc->numBits   = msg.bit;
+	bc->data      = Z_Malloc((msg.bit + 7) >> 3);
+	Com_Memcpy(bc->data, buffer, (msg.bit + 7) >> 3);
+
+	return bc->id;
+}
+
+/**
+ * @brief Writes the shared encoding of a broadcast command
+ * @param[in,out] msg
+ * @param[in] id
+ * @return qfalse if the encoding is gone and the command has to be written as string
+ */
+qboolean SV_WriteBroadcastCommand(msg_t *msg, int id)
+{
+	broadcastCommand_t *bc = &sv_broadcastCommands[id % MAX_BROADCAST_COMMANDS];
+
+	if (!id || bc->id != id || bc->legacyMod != IS_LEGACY_MOD || msg->oob)
+	{
+		return qfalse;
+	}
+
+	MSG_WriteEncoded(msg, bc->data, bc->numBits, bc->length);
+	return qtrue;
+}
+
+/**
+ * @brief Adds a command to the reliable commands of a client
+ * @param[in,out] client
+ * @param[in] cmd
+ * @param[in] broadcast id of the shared encoding of the command, 0 if none
+ */
+static void SV_AddReliableCommand(client_t *client, const char *cmd, int broadcast)
 {
 	int index;
 
@@ -190,6 +269,16 @@ void SV_AddServerCommand(client_t *client, const char *cmd)
 
 	index = client->reliableSequence & (MAX_RELIABLE_COMMANDS - 1);
 	Q_strncpyz(client->reliableCommands[index], cmd, sizeof(client->reliableCommands[index]));
+	client->reliableBroadcasts[index] = broadcast;
+}
+
+/**
+ * @brief The given command will be transmitted to the client, and is guaranteed
+ * to not have future snapshot_t executed before it is executed
+ */
+void SV_AddServerCommand(client_t *client, const char *cmd)
+{
+	SV_AddReliableCommand(client, cmd, 0);
 }
 
 /**
@@ -203,7 +292,7 @@ void QDECL SV_SendServerCommand(client_t *cl, const char *fmt, ...)
 	va_list  argptr;
 	byte     message[MAX_MSGLEN];
 	client_t *client;
-	int      j;
+	int      j, broadcast;
 
 	va_start(argptr, fmt);
 	Q_vsnprintf((char *)message, sizeof(message), fmt, argptr);
@@ -237,6 +326,8 @@ void QDECL SV_SendServerCommand(client_t *cl, const char *fmt, ...)
 		SV_DemoWriteServerCommand((char *)message);
 	}
 
+	broadcast = SV_EncodeBroadcastCommand((char *)message);
+
 	// send the data to all relevant clients
 	for (j = 0, client = svs.clients; j < sv_maxclients->integer ; j++, client++)
 	{
@@ -250,7 +341,7 @@ void QDECL SV_SendServerCommand(client_t *cl, const char *fmt, ...)
 			continue;
 		}
 
-		SV_AddServerCommand(client, (char *)message);
+		SV_AddReliableCommand(client, (char *)message, broadcast);
 	}
 }
 
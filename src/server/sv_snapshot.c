@@ -140,47 +140,66 @@ static void SV_EmitPacketEntities(clientSnapshot_t *from, clientSnapshot_t *to,
 
 /*
 ==================
-SV_WriteSnapshotToClient
+SV_DeltaFrame
+
+Returns the frame the next snapshot of a client is delta compressed from,
+NULL if it has to be sent in full
 ==================
 */
-static void SV_WriteSnapshotToClient(client_t *client, msg_t *msg)
+static clientSnapshot_t *SV_DeltaFrame(client_t *client, qboolean print)
 {
-	clientSnapshot_t *frame, *oldframe;
-	int              lastframe;
-	int              snapFlags;
+	clientSnapshot_t *oldframe;
 
-	// this is the snapshot we are creating
-	frame = &client->frames[client->netchan.outgoingSequence & PACKET_MASK];
-
-	// try to use a previous frame as the source for delta compressing the snapshot
 	if (client->deltaMessage <= 0 || client->state != CS_ACTIVE)
 	{
 		// client is asking for a retransmit
-		oldframe  = NULL;
-		lastframe = 0;
+		return NULL;
 	}
-	else if (client->netchan.outgoingSequence - client->deltaMessage >= (PACKET_BACKUP - 3))
+
+	if (client->netchan.outgoingSequence - client->deltaMessage >= (PACKET_BACKUP - 3))
 	{
 		// client hasn't gotten a good message through in a long time
-		Com_DPrintf("%s: Delta request from out of date packet.\n", client->name);
-		oldframe  = NULL;
-		lastframe = 0;
+		if (print)
+		{
+			Com_DPrintf("%s: Delta request from out of date packet.\n", client->name);
+		}
+		return NULL;
 	}
-	else
-	{
-		// we have a valid snapshot to delta from
-		oldframe  = &client->frames[client->deltaMessage & PACKET_MASK];
-		lastframe = client->netchan.outgoingSequence - client->deltaMessage;
 
-		// the snapshot's entities may still have rolled off the buffer, though
-		if (oldframe->first_entity <= svs.nextSnapshotEntities - svs.numSnapshotEntities)
+	// we have a valid snapshot to delta from
+	oldframe = &client->frames[client->deltaMessage & PACKET_MASK];
+
+	// the snapshot's entities may still have rolled off the buffer, though
+	if (oldframe->first_entity <= svs.nextSnapshotEntities - svs.numSnapshotEntities)
+	{
+		if (print)
 		{
 			Com_DPrintf("%s: Delta request from out of date entities.\n", client->name);
-			oldframe  = NULL;
-			lastframe = 0;
 		}
+		return NULL;
 	}
 
+	return oldframe;
+}
+
+/*
+==================
+SV_WriteSnapshotToClient
+==================
+*/
+static void SV_WriteSnapshotToClient(client_t *client, msg_t *msg)
+{
+	clientSnapshot_t *frame, *oldframe;
+	int              lastframe;
+	int              snapFlags;
+
+	// this is the snapshot we are creating
+	frame = &client->frames[client->netchan.outgoingSequence & PACKET_MASK];
+
+	// try to use a previous frame as the source for delta compressing the snapshot
+	oldframe  = SV_DeltaFrame(client, qtrue);
+	lastframe = oldframe ? client->netchan.outgoingSequence - client->deltaMessage : 0;
+
 	MSG_WriteByte(msg, svc_snapshot);
 
 	// NOTE, MRE: now sent at the start of every message from server to client
@@ -251,14 +270,21 @@ SV_UpdateServerCommandsToClient
 */
 void SV_UpdateServerCommandsToClient(client_t *client, msg_t *msg)
 {
-	int i;
+	int i, index;
 
 	// write any unacknowledged serverCommands
 	for (i = client->reliableAcknowledge + 1 ; i <= client->reliableSequence ; i++)
 	{
+		index = i & (MAX_RELIABLE_COMMANDS - 1);
+
 		MSG_WriteByte(msg, svc_serverCommand);
 		MSG_WriteLong(msg, i);
-		MSG_WriteString(msg, client->reliableCommands[i & (MAX_RELIABLE_COMMANDS - 1)]);
+
+		// broadcasts are encoded once for everybody
+		if (!SV_WriteBroadcastCommand(msg, client->reliableBroadcasts[index]))
+		{
+			MSG_WriteString(msg, client->reliableCommands[index]);
+		}
 	}
 
 	client->reliableSent = client->reliableSequence;
@@ -622,6 +648,308 @@ static void SV_AddEntitiesVisibleFromPoint(vec3_t origin, clientSnapshot_t *fram
 	}
 }
 
+/*
+=============
+SV_ClientRate
+
+Rate of a client in bytes per second, clamped to sv_minRate and sv_maxRate
+=============
+*/
+static int SV_ClientRate(client_t *client)
+{
+	int rate = client->rate;
+
+	if (sv_maxRate->integer)
+	{
+		if (sv_maxRate->integer < 1000)
+		{
+			Cvar_Set("sv_MaxRate", "1000");
+		}
+		if (sv_maxRate->integer < rate)
+		{
+			rate = sv_maxRate->integer;
+		}
+	}
+
+	if (sv_minRate->integer)
+	{
+		if (sv_minRate->integer < 1000)
+		{
+			Cvar_Set("sv_minRate", "1000");
+		}
+		if (sv_minRate->integer > rate)
+		{
+			rate = sv_minRate->integer;
+		}
+	}
+
+	return rate;
+}
+
+/*
+=============
+SV_ClientRateLimited
+
+LAN and loopback clients aren't rate limited
+=============
+*/
+static qboolean SV_ClientRateLimited(client_t *client)
+{
+	return !(client->netchan.remoteAddress.type == NA_LOOPBACK ||
+	         (sv_lanForceRate->integer && Sys_IsLANAddress(client->netchan.remoteAddress)));
+}
+
+// bytes of a snapshot which aren't entities: headers, areabits and playerstate
+#define SNAPSHOT_OVERHEAD   160
+#define SNAPSHOT_MIN_BUDGET (64 * 8)    // bits for entities even when the rate is used up otherwise
+#define SNAPSHOT_MAX_HELD   500         // msec an update can be held back
+#define SNAPSHOT_MUST_SEND  1e9f
+
+typedef struct
+{
+	entityState_t *state;               // in the new frame
+	entityState_t *oldState;            // in the delta frame, NULL for entities the client doesn't have
+	int bits;                           // size of the update
+	float priority;
+} snapshotUpdate_t;
+
+static int QDECL SV_QsortSnapshotUpdates(const void *a, const void *b)
+{
+	float pa = ((const snapshotUpdate_t *)a)->priority;
+	float pb = ((const snapshotUpdate_t *)b)->priority;
+
+	if (pa > pb)
+	{
+		return -1;
+	}
+	if (pa < pb)
+	{
+		return 1;
+	}
+	return 0;
+}
+
+/*
+=============
+SV_SnapshotEntityPriority
+
+Players beat missiles beat everything else, closer entities beat distant
+ones, and updates that were held back gain priority every snapshot they wait.
+=============
+*/
+static float SV_SnapshotEntityPriority(client_t *client, const entityState_t *state, const vec3_t org)
+{
+	sharedEntity_t *ent = SV_GentityNum(state->number);
+	vec3_t         center, delta;
+	float          weight;
+	int            heldTime = client->snapshotHeldTime[state->number];
+
+	switch (state->eType)
+	{
+	case ET_PLAYER:
+		weight = 4.f;
+		break;
+	case ET_MISSILE:
+	case ET_CORPSE:
+		weight = 2.f;
+		break;
+	default:
+		weight = 1.f;
+		break;
+	}
+
+	if (heldTime)
+	{
+		weight *= 1.f + (svs.time - heldTime) / (float)(client->snapshotMsec > 0 ? client->snapshotMsec : 50);
+	}
+
+	// brush models have their origin at 0 0 0, use the bounds
+	VectorAdd(ent->r.absmin, ent->r.absmax, center);
+	VectorScale(center, 0.5f, center);
+	VectorSubtract(center, org, delta);
+
+	return weight / (1.f + VectorLength(delta) / 512.f);
+}
+
+/*
+=============
+SV_PrioritizeSnapshotEntities
+
+Fits the entity updates of a rate limited client into the bytes its rate
+allows per snapshot. If everything doesn't fit, the most important updates
+are sent and the others are held back: an entity the client already has
+keeps the state of the delta frame, which costs nothing to send, and a new
+entity is left out. Held back updates gain priority until they are sent.
+Events, the most important update and updates held back for SNAPSHOT_MAX_HELD
+msec are always sent, so a client whose rate barely covers the overhead of a
+snapshot still gets all updates eventually.
+=============
+*/
+static void SV_PrioritizeSnapshotEntities(client_t *client, clientSnapshot_t *frame, const vec3_t org)
+{
+	static snapshotUpdate_t updates[MAX_SNAPSHOT_ENTITIES];
+	static byte             scratch[MAX_MSGLEN];
+	snapshotUpdate_t        *update;
+	clientSnapshot_t        *oldframe;
+	entityState_t           *state, *oldState;
+	msg_t                   msg;
+	int                     i, oldindex = 0, numUpdates = 0, total = 0, budget, removed;
+
+	if (client->snapshotMsec <= 0 || client->state != CS_ACTIVE || (client->gentity && (client->gentity->r.svFlags & SVF_BOT)))
+	{
+		return;
+	}
+
+	// forget held updates of entities which went out of view
+	for (i = 0, numUpdates = 0 ; i < MAX_GENTITIES ; i++)
+	{
+		if (numUpdates < frame->num_entities && svs.snapshotEntities[(frame->first_entity + numUpdates) % svs.numSnapshotEntities].number == i)
+		{
+			numUpdates++;
+			continue;
+		}
+		client->snapshotHeldTime[i] = 0;
+	}
+	numUpdates = 0;
+
+	oldframe = SV_DeltaFrame(client, qfalse);
+
+	budget = (SV_ClientRate(client) * client->snapshotMsec / 1000 - SNAPSHOT_OVERHEAD) * 8;
+	for (i = client->reliableAcknowledge + 1 ; i <= client->reliableSequence ; i++)
+	{
+		budget -= (strlen(client->reliableCommands[i & (MAX_RELIABLE_COMMANDS - 1)]) + 6) * 8;
+	}
+	if (budget < SNAPSHOT_MIN_BUDGET)
+	{
+		budget = SNAPSHOT_MIN_BUDGET;
+	}
+
+	MSG_Init(&msg, scratch, sizeof(scratch));
+
+	// measure the update of every entity
+	for (i = 0 ; i < frame->num_entities ; i++)
+	{
+		state    = &svs.snapshotEntities[(frame->first_entity + i) % svs.numSnapshotEntities];
+		oldState = NULL;
+
+		for ( ; oldframe && oldindex < oldframe->num_entities ; oldindex++)
+		{
+			entityState_t *old = &svs.snapshotEntities[(oldframe->first_entity + oldindex) % svs.numSnapshotEntities];
+
+			if (old->number >= state->number)
+			{
+				if (old->number == state->number)
+				{
+					oldState = old;
+				}
+				break;
+			}
+		}
+
+		MSG_Clear(&msg);
+		if (oldState)
+		{
+			MSG_MeasureDeltaEntity(&msg, oldState, state, qfalse);
+		}
+		else
+		{
+			MSG_MeasureDeltaEntity(&msg, &sv.svEntities[state->number].baseline, state, qtrue);
+		}
+
+		if (!msg.bit)
+		{
+			// up to date
+			client->snapshotHeldTime[state->number] = 0;
+			continue;
+		}
+
+		update           = &updates[numUpdates++];
+		update->state    = state;
+		update->oldState = oldState;
+		update->bits     = msg.bit;
+		update->priority = SV_SnapshotEntityPriority(client, state, org);
+		total           += msg.bit;
+
+		// events can't wait, and nothing waits forever
+		if (state->eType >= ET_EVENTS || (oldState && (state->eventSequence != oldState->eventSequence || state->event != oldState->event)) ||
+		    (client->snapshotHeldTime[state->number] && svs.time - client->snapshotHeldTime[state->number] >= SNAPSHOT_MAX_HELD))
+		{
+			update->priority = SNAPSHOT_MUST_SEND;
+		}
+	}
+
+	// send the most important updates that fit
+	if (total > budget)
+	{
+		qsort(updates, numUpdates, sizeof(updates[0]), SV_QsortSnapshotUpdates);
+	}
+
+	removed = 0;
+	for (i = 0, update = updates ; i < numUpdates ; i++, update++)
+	{
+		int *heldTime = &client->snapshotHeldTime[update->state->number];
+
+		if (total <= budget || update->bits <= budget || update->priority >= SNAPSHOT_MUST_SEND || i == 0)
+		{
+			budget -= update->bits;
+
+			client->snapshotStats.sent++;
+			if (*heldTime)
+			{
+				client->snapshotStats.late++;
+				client->snapshotStats.lateTime += svs.time - *heldTime;
+				if (svs.time - *heldTime > client->snapshotStats.maxLateTime)
+				{
+					client->snapshotStats.maxLateTime = svs.time - *heldTime;
+				}
+				*heldTime = 0;
+			}
+			continue;
+		}
+
+		client->snapshotStats.held++;
+		if (!*heldTime)
+		{
+			*heldTime = svs.time;
+		}
+
+		if (update->oldState)
+		{
+			*update->state = *update->oldState;
+		}
+		else
+		{
+			// not in the frame, removed below
+			update->state->number = -1;
+			removed++;
+		}
+	}
+
+	if (!removed)
+	{
+		return;
+	}
+
+	// compact the frame, it is the last one in svs.snapshotEntities
+	for (i = 0, oldindex = 0 ; i < frame->num_entities ; i++)
+	{
+		state = &svs.snapshotEntities[(frame->first_entity + i) % svs.numSnapshotEntities];
+		if (state->number < 0)
+		{
+			continue;
+		}
+
+		if (i != oldindex)
+		{
+			svs.snapshotEntities[(frame->first_entity + oldindex) % svs.numSnapshotEntities] = *state;
+		}
+		oldindex++;
+	}
+
+	frame->num_entities       = oldindex;
+	svs.nextSnapshotEntities -= removed;
+}
+
 /*
 =============
 SV_BuildClientSnapshot
@@ -753,6 +1081,11 @@ static void SV_BuildClientSnapshot(client_t *client)
 
 		frame->num_entities++;
 	}
+
+	if (sv_snapshotPriority->integer && SV_ClientRateLimited(client))
+	{
+		SV_PrioritizeSnapshotEntities(client, frame, org);
+	}
 }
 
 /*
@@ -773,31 +1106,7 @@ int SV_RateMsec(client_t *client)
 	int messageSize;
 
 	messageSize = client->netchan.lastSentSize;
-	rate        = client->rate;
-
-	if (sv_maxRate->integer)
-	{
-		if (sv_maxRate->integer < 1000)
-		{
-			Cvar_Set("sv_MaxRate", "1000");
-		}
-		if (sv_maxRate->integer < rate)
-		{
-			rate = sv_maxRate->integer;
-		}
-	}
-
-	if (sv_minRate->integer)
-	{
-		if (sv_minRate->integer < 1000)
-		{
-			Cvar_Set("sv_minRate", "1000");
-		}
-		if (sv_minRate->integer > rate)
-		{
-			rate = sv_minRate->integer;
-		}
-	}
+	rate        = SV_ClientRate(client);
 
 	if (client->netchan.remoteAddress.type == NA_IP6)
 	{
@@ -1006,8 +1315,7 @@ void SV_SendClientMessages(void)
 			continue;       // Drop this snapshot if the packet queue is still full or delta compression will break
 		}
 
-		if (!(c->netchan.remoteAddress.type == NA_LOOPBACK ||
-		      (sv_lanForceRate->integer && Sys_IsLANAddress(c->netchan.remoteAddress))))
+		if (SV_ClientRateLimited(c))
 		{
 			// rate control for clients not on LAN
 			if (svs.time - c->lastSnapshotTime < c->snapshotMsec * com_timescale->value)
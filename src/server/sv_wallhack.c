@@ -19,8 +19,6 @@
 
 //======================================================================
 
-static vec3_t       pred_ppos, pred_opos;
-static trajectory_t traject;
 static vec3_t       old_origin[MAX_CLIENTS];
 static int          origin_changed[MAX_CLIENTS];
 static float        delta_sign[8][3] =
@@ -40,6 +38,37 @@ static vec3_t delta[8];
 static int bbox_horz;
 static int bbox_vert;
 
+#define PREDICT_TIME      0.1
+#define VOFS              6
+
+// boxes touching more leafs can't be rejected by the PVS check
+#define MAX_BOX_LEAFS     16
+
+// what a bounding box touches of the vis data
+typedef struct
+{
+	int numLeafs;                       // -1 if there were too many
+	int clusters[MAX_BOX_LEAFS];
+	int areas[MAX_BOX_LEAFS];
+} box_leafs_t;
+
+#define WH_CURRENT        1
+#define WH_PREDICTED      2
+
+// per client data shared by all pairs checked during a server frame
+typedef struct
+{
+	int time;                           // svs.time the data was collected
+	int valid;                          // WH_* bits
+	vec3_t trBase;                      // trajectory the data is valid for
+	vec3_t trDelta;
+	vec3_t predicted;                   // position after PREDICT_TIME
+	box_leafs_t current;                // leafs of the bounding box at trBase
+	box_leafs_t future;                 // leafs of the bounding box at predicted
+} wh_client_t;
+
+static wh_client_t wh_clients[MAX_CLIENTS];
+
 //======================================================================
 // local functions
 //======================================================================
@@ -335,7 +364,7 @@ static void calc_viewpoint(playerState_t *ps, vec3_t org, vec3_t vp)
 		VectorCopy(ps->viewangles, v3ViewAngles);
 		v3ViewAngles[2] += ps->leanf / 2.0f;
 		AngleVectors(v3ViewAngles, NULL, right, NULL);
-		VectorMA(org, ps->leanf, right, org);
+		VectorMA(vp, ps->leanf, right, vp);
 	}
 
 	if (ps->pm_flags & PMF_DUCKED)
@@ -417,12 +446,188 @@ static int is_visible(vec3_t start, vec3_t end)
 
 //======================================================================
 
+/**
+ * @brief Collects the clusters and areas touched by the bounding box
+ * the traces of SV_CanSee go to, when placed at 'org'.
+ */
+static void get_box_leafs(vec3_t org, box_leafs_t *bl)
+{
+	vec3_t mins, maxs;
+	int    leafs[MAX_BOX_LEAFS];
+	int    i, j, lastLeaf;
+
+	VectorCopy(org, mins);
+	VectorCopy(org, maxs);
+
+	for (i = 0; i < 8; i++)
+	{
+		for (j = 0; j < 3; j++)
+		{
+			if (delta[i][j] < mins[j] - org[j])
+			{
+				mins[j] = org[j] + delta[i][j];
+			}
+			if (delta[i][j] > maxs[j] - org[j])
+			{
+				maxs[j] = org[j] + delta[i][j];
+			}
+		}
+	}
+
+	// the corners are on the sides of the box, make sure their leafs are in
+	for (j = 0; j < 3; j++)
+	{
+		mins[j] -= 1;
+		maxs[j] += 1;
+	}
+	mins[2] += VOFS;
+	maxs[2] += VOFS;
+
+	bl->numLeafs = CM_BoxLeafnums(mins, maxs, leafs, MAX_BOX_LEAFS, &lastLeaf);
+	if (bl->numLeafs >= MAX_BOX_LEAFS)
+	{
+		bl->numLeafs = -1;
+		return;
+	}
+
+	for (i = 0; i < bl->numLeafs; i++)
+	{
+		bl->clusters[i] = CM_LeafCluster(leafs[i]);
+		bl->areas[i]    = CM_LeafArea(leafs[i]);
+	}
+}
+
+//======================================================================
+
+/**
+ * @brief Checks if any leaf of a bounding box is in the PVS of the
+ * viewpoint and in an area connected to it. If not, all traces to
+ * the box would end in solid, so they can be skipped.
+ */
+static int box_in_pvs(vec3_t viewpoint, box_leafs_t *bl)
+{
+	byte *pvs;
+	int  leaf, cluster, area, i;
+
+	if (bl->numLeafs < 0)
+	{
+		return 1;
+	}
+
+	leaf    = CM_PointLeafnum(viewpoint);
+	cluster = CM_LeafCluster(leaf);
+	area    = CM_LeafArea(leaf);
+
+	// viewpoint in a wall, let the traces decide
+	if (cluster < 0)
+	{
+		return 1;
+	}
+
+	pvs = CM_ClusterPVS(cluster);
+
+	for (i = 0; i < bl->numLeafs; i++)
+	{
+		// solid leaf
+		if (bl->clusters[i] < 0)
+		{
+			continue;
+		}
+
+		if (!(pvs[bl->clusters[i] >> 3] & (1 << (bl->clusters[i] & 7))))
+		{
+			continue;
+		}
+
+		if (CM_AreasConnected(area, bl->areas[i]))
+		{
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+//======================================================================
+
+/**
+ * @brief Gets the per frame data of a client, collecting the parts
+ * asked for by 'need' (WH_* bits) if they aren't known yet.
+ *
+ * The data stays valid until the server frame ends or the client
+ * moves, so every client is predicted once per frame instead of once
+ * for each player checking it.
+ */
+static wh_client_t *get_client(int num, int need)
+{
+	sharedEntity_t *ent = SV_GentityNum(num);
+	wh_client_t    *wc  = &wh_clients[num];
+	trajectory_t   tr;
+
+	if (wc->time != svs.time || !VectorCompare(wc->trBase, ent->s.pos.trBase) || !VectorCompare(wc->trDelta, ent->s.pos.trDelta))
+	{
+		wc->time  = svs.time;
+		wc->valid = 0;
+		VectorCopy(ent->s.pos.trBase, wc->trBase);
+		VectorCopy(ent->s.pos.trDelta, wc->trDelta);
+	}
+
+	need &= ~wc->valid;
+
+	if (need & WH_CURRENT)
+	{
+		get_box_leafs(wc->trBase, &wc->current);
+	}
+
+	if (need & WH_PREDICTED)
+	{
+		copy_trajectory(&ent->s.pos, &tr);
+		predict_move(ent, PREDICT_TIME, &tr, wc->predicted);
+		get_box_leafs(wc->predicted, &wc->future);
+	}
+
+	wc->valid |= need;
+
+	return wc;
+}
+
+//======================================================================
+
+/**
+ * @brief Traces from 'viewpoint' to the corners of the bounding box at 'org'.
+ */
+static int bbox_visible(vec3_t viewpoint, vec3_t org)
+{
+	vec3_t tmp;
+	int    i;
+
+	for (i = 0; i < 8; i++)
+	{
+		VectorCopy(org, tmp);
+		tmp[0] += delta[i][0];
+		tmp[1] += delta[i][1];
+		tmp[2] += delta[i][2] + VOFS;
+
+		if (is_visible(viewpoint, tmp))
+		{
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+//======================================================================
+
 static void init_horz_delta(void)
 {
 	int i;
 
 	bbox_horz = sv_wh_bbox_horz->integer;
 
+	// the cached box leafs are for the old size
+	Com_Memset(wh_clients, 0, sizeof(wh_clients));
+
 	for (i = 0; i < 8; i++)
 	{
 		delta[i][0] = ((float) bbox_horz * delta_sign[i][0]) / 2.0;
@@ -438,6 +643,8 @@ static void init_vert_delta(void)
 
 	bbox_vert = sv_wh_bbox_vert->integer;
 
+	Com_Memset(wh_clients, 0, sizeof(wh_clients));
+
 	for (i = 0; i < 8; i++)
 	{
 		delta[i][2] = ((float) bbox_vert * delta_sign[i][2]) / 2.0;
@@ -469,17 +676,19 @@ void SV_InitWallhack(void)
   tests are carried out again. The result is reported by returning non-zero
   (expected to become visible) or zero (not expected to become visible
   in the next frame).
-*/
 
-#define PREDICT_TIME      0.1
-#define VOFS              6
+  Before tracing, the bounding box is checked against the PVS and the
+  area connectivity of the viewpoint. Boxes which can't be seen from the
+  viewpoint's cluster need no traces at all. The predicted positions
+  are computed once per client and frame, see get_client.
+*/
 
 int SV_CanSee(int player, int other)
 {
 	sharedEntity_t *pent, *oent;
 	playerState_t  *ps;
-	vec3_t         viewpoint, tmp;
-	int            i;
+	wh_client_t    *pwc, *owc;
+	vec3_t         viewpoint;
 
 	// check if bounding box has been changed
 	if (sv_wh_bbox_horz->integer != bbox_horz)
@@ -508,25 +717,16 @@ int SV_CanSee(int player, int other)
 	// check if visible in this frame
 	calc_viewpoint(ps, pent->s.pos.trBase, viewpoint);
 
-	for (i = 0; i < 8; i++)
-	{
-		VectorCopy(oent->s.pos.trBase, tmp);
-		tmp[0] += delta[i][0];
-		tmp[1] += delta[i][1];
-		tmp[2] += delta[i][2] + VOFS;
+	owc = get_client(other, WH_CURRENT);
 
-		if (is_visible(viewpoint, tmp))
-		{
-			return 1;
-		}
+	if (box_in_pvs(viewpoint, &owc->current) && bbox_visible(viewpoint, oent->s.pos.trBase))
+	{
+		return 1;
 	}
 
 	// predict player positions
-	copy_trajectory(&pent->s.pos, &traject);
-	predict_move(pent, PREDICT_TIME, &traject, pred_ppos);
-
-	copy_trajectory(&oent->s.pos, &traject);
-	predict_move(oent, PREDICT_TIME, &traject, pred_opos);
+	pwc = get_client(player, WH_PREDICTED);
+	owc = get_client(other, WH_PREDICTED);
 
 	// Check again if 'other' is in the maximum fov allowed.
 	// FIXME: We use the original viewangle that may have
@@ -534,29 +734,21 @@ int SV_CanSee(int player, int other)
 	// errors.
 	if (sv_wh_check_fov->integer > 0)
 	{
-		if (!player_in_fov(pent->s.apos.trBase, pred_ppos, pred_opos))
+		if (!player_in_fov(pent->s.apos.trBase, pwc->predicted, owc->predicted))
 		{
 			return 0;
 		}
 	}
 
 	// check if expected to be visible in the next frame
-	calc_viewpoint(ps, pred_ppos, viewpoint);
+	calc_viewpoint(ps, pwc->predicted, viewpoint);
 
-	for (i = 0; i < 8; i++)
+	if (!box_in_pvs(viewpoint, &owc->future))
 	{
-		VectorCopy(pred_opos, tmp);
-		tmp[0] += delta[i][0];
-		tmp[1] += delta[i][1];
-		tmp[2] += delta[i][2] + VOFS;
-
-		if (is_visible(viewpoint, tmp))
-		{
-			return 1;
-		}
+		return 0;
 	}
 
-	return 0;
+	return bbox_visible(viewpoint, owc->predicted);
 }
 
 //======================================================================
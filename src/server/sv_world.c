@@ -66,25 +66,38 @@ clipHandle_t SV_ClipHandleForEntity(const sharedEntity_t *ent)
 ENTITY CHECKING
 
 To avoid linearly searching through lists of entities during environment testing,
-the world is carved up with an evenly spaced, axially aligned bsp tree.  Entities
-are kept in chains either at the final leafs, or at the first node that splits
-them, which prevents having to deal with multiple fragments of a single entity.
+linked entities are kept in a dynamic bounding volume tree. Every entity is a
+leaf with a slightly enlarged box, so small moves don't touch the tree at all,
+and the tree is rebalanced with rotations as leafs are inserted and removed.
+The exact entity boxes are kept in a separate array indexed by entity number,
+queries only look at the gentities which actually overlap.
 ===============================================================================
 */
 
-typedef struct worldSector_s
+typedef struct worldNode_s
 {
-	int axis;                         // -1 = leaf node
-	float dist;
-	struct     worldSector_s *children[2];
-	svEntity_t *entities;
-} worldSector_t;
+	vec3_t mins, maxs;                  // enlarged by WORLD_LEAF_MARGIN for leafs
+	int parent;                         // next free node if unused
+	int children[2];
+	int height;                         // 0 = leaf node
+	int entityNum;                      // leafs only
+} worldNode_t;
 
-#define AREA_DEPTH  4
-#define AREA_NODES  64
+typedef struct
+{
+	vec3_t absmin, absmax;
+} worldBounds_t;
+
+#define WORLD_NODE_NULL     0           // node 0 is never used, so a cleared svEntity_t is not linked
+#define WORLD_MAX_NODES     (2 * MAX_GENTITIES)
+#define WORLD_LEAF_MARGIN   16          // about a frame of running
+#define WORLD_STACK_SIZE    256
 
-worldSector_t sv_worldSectors[AREA_NODES];
-int           sv_numworldSectors;
+static worldNode_t   sv_worldNodes[WORLD_MAX_NODES];
+static worldBounds_t sv_worldBounds[MAX_GENTITIES];
+static int           sv_worldRoot;
+static int           sv_worldFreeNodes;
+static int           sv_numWorldNodes;
 
 /*
 ===============
@@ -93,68 +106,295 @@ SV_SectorList_f
 */
 void SV_SectorList_f(void)
 {
-	int           i, c;
-	worldSector_t *sec;
-	svEntity_t    *ent;
+	int         i, leafs = 0;
+	worldNode_t *node;
 
-	for (i = 0 ; i < AREA_NODES ; i++)
+	for (i = 1 ; i < WORLD_MAX_NODES ; i++)
 	{
-		sec = &sv_worldSectors[i];
-
-		c = 0;
-		for (ent = sec->entities ; ent ; ent = ent->nextEntityInWorldSector)
+		node = &sv_worldNodes[i];
+		if (node->height == 0)
 		{
-			c++;
+			leafs++;
 		}
+	}
+
+	Com_Printf("%i world nodes, %i entities, tree height %i\n", sv_numWorldNodes, leafs,
+	           sv_worldRoot != WORLD_NODE_NULL ? sv_worldNodes[sv_worldRoot].height : 0);
+}
 
-		Com_Printf("sector %i: %i entities\n", i, c);
+/**
+ * @brief Surface area of a box, used as cost when picking where to insert a leaf
+ */
+static float SV_WorldBoxCost(const vec3_t mins, const vec3_t maxs)
+{
+	float dx = maxs[0] - mins[0];
+	float dy = maxs[1] - mins[1];
+	float dz = maxs[2] - mins[2];
+
+	return dx * dy + dy * dz + dz * dx;
+}
+
+/**
+ * @brief Sets the box of a node to the union of two boxes
+ */
+static void SV_WorldUnionBounds(worldNode_t *node, const worldNode_t *a, const worldNode_t *b)
+{
+	int i;
+
+	for (i = 0 ; i < 3 ; i++)
+	{
+		node->mins[i] = a->mins[i] < b->mins[i] ? a->mins[i] : b->mins[i];
+		node->maxs[i] = a->maxs[i] > b->maxs[i] ? a->maxs[i] : b->maxs[i];
 	}
 }
 
-/*
-===============
-SV_CreateworldSector
+/**
+ * @brief Cost of putting box under node, inherited costs of the parents excluded
+ */
+static float SV_WorldInsertCost(const worldNode_t *node, const worldNode_t *box)
+{
+	worldNode_t combined;
+	float       cost;
 
-Builds a uniformly subdivided tree for the given world size
-===============
-*/
-worldSector_t *SV_CreateworldSector(int depth, vec3_t mins, vec3_t maxs)
+	SV_WorldUnionBounds(&combined, node, box);
+	cost = SV_WorldBoxCost(combined.mins, combined.maxs);
+
+	if (node->height)
+	{
+		cost -= SV_WorldBoxCost(node->mins, node->maxs);
+	}
+
+	return cost;
+}
+
+/**
+ * @brief Takes a node from the free list
+ */
+static int SV_WorldAllocNode(void)
 {
-	worldSector_t *anode = &sv_worldSectors[sv_numworldSectors];
-	vec3_t        size;
-	vec3_t        mins1, maxs1, mins2, maxs2;
+	int index = sv_worldFreeNodes;
+
+	if (index == WORLD_NODE_NULL)
+	{
+		Com_Error(ERR_DROP, "SV_WorldAllocNode: no free world nodes");
+	}
+
+	sv_worldFreeNodes = sv_worldNodes[index].parent;
+	sv_numWorldNodes++;
+
+	memset(&sv_worldNodes[index], 0, sizeof(worldNode_t));
+	sv_worldNodes[index].entityNum = -1;
+
+	return index;
+}
 
-	sv_numworldSectors++;
+/**
+ * @brief Puts a node back on the free list
+ */
+static void SV_WorldFreeNode(int index)
+{
+	sv_worldNodes[index].parent = sv_worldFreeNodes;
+	sv_worldNodes[index].height = -1;
+	sv_worldFreeNodes           = index;
+	sv_numWorldNodes--;
+}
+
+/**
+ * @brief Rotates the taller child of a node up if the node is unbalanced
+ * @param[in] index
+ * @return index of the node now at this position of the tree
+ */
+static int SV_WorldBalance(int index)
+{
+	worldNode_t *a = &sv_worldNodes[index];
+	worldNode_t *x, *tall, *shrt;
+	int         side, ix, iTall, iShort;
 
-	if (depth == AREA_DEPTH)
+	if (a->height < 2)
 	{
-		anode->axis        = -1;
-		anode->children[0] = anode->children[1] = NULL;
-		return anode;
+		return index;
 	}
 
-	VectorSubtract(maxs, mins, size);
-	if (size[0] > size[1])
+	side = sv_worldNodes[a->children[1]].height - sv_worldNodes[a->children[0]].height;
+	if (side > 1)
 	{
-		anode->axis = 0;
+		side = 1;
+	}
+	else if (side < -1)
+	{
+		side = 0;
+	}
+	else
+	{
+		return index;
+	}
+
+	ix = a->children[side];
+	x  = &sv_worldNodes[ix];
+
+	iTall  = x->children[0];
+	iShort = x->children[1];
+	if (sv_worldNodes[iTall].height < sv_worldNodes[iShort].height)
+	{
+		iTall  = x->children[1];
+		iShort = x->children[0];
+	}
+	tall = &sv_worldNodes[iTall];
+	shrt = &sv_worldNodes[iShort];
+
+	// x takes the place of a, a keeps the short grandchild
+	x->parent = a->parent;
+	if (x->parent != WORLD_NODE_NULL)
+	{
+		worldNode_t *parent = &sv_worldNodes[x->parent];
+
+		parent->children[parent->children[0] == index ? 0 : 1] = ix;
 	}
 	else
 	{
-		anode->axis = 1;
+		sv_worldRoot = ix;
 	}
 
-	anode->dist = 0.5 * (maxs[anode->axis] + mins[anode->axis]);
-	VectorCopy(mins, mins1);
-	VectorCopy(mins, mins2);
-	VectorCopy(maxs, maxs1);
-	VectorCopy(maxs, maxs2);
+	x->children[0]    = index;
+	x->children[1]    = iTall;
+	a->parent         = ix;
+	a->children[side] = iShort;
+	shrt->parent      = index;
 
-	maxs1[anode->axis] = mins2[anode->axis] = anode->dist;
+	SV_WorldUnionBounds(a, &sv_worldNodes[a->children[0]], &sv_worldNodes[a->children[1]]);
+	a->height = 1 + MAX(sv_worldNodes[a->children[0]].height, sv_worldNodes[a->children[1]].height);
 
-	anode->children[0] = SV_CreateworldSector(depth + 1, mins2, maxs2);
-	anode->children[1] = SV_CreateworldSector(depth + 1, mins1, maxs1);
+	SV_WorldUnionBounds(x, a, tall);
+	x->height = 1 + MAX(a->height, tall->height);
 
-	return anode;
+	return ix;
+}
+
+/**
+ * @brief Fixes boxes and heights from a node up to the root
+ */
+static void SV_WorldRefit(int index)
+{
+	worldNode_t *node;
+
+	while (index != WORLD_NODE_NULL)
+	{
+		index = SV_WorldBalance(index);
+		node  = &sv_worldNodes[index];
+
+		SV_WorldUnionBounds(node, &sv_worldNodes[node->children[0]], &sv_worldNodes[node->children[1]]);
+		node->height = 1 + MAX(sv_worldNodes[node->children[0]].height, sv_worldNodes[node->children[1]].height);
+
+		index = node->parent;
+	}
+}
+
+/**
+ * @brief Inserts a leaf next to the sibling that grows the tree the least
+ */
+static void SV_WorldInsertLeaf(int leaf)
+{
+	worldNode_t *box = &sv_worldNodes[leaf];
+	worldNode_t *node, *parent;
+	worldNode_t combined;
+	int         index, sibling, oldParent, newParent;
+	float       area, cost, inherited, cost0, cost1;
+
+	if (sv_worldRoot == WORLD_NODE_NULL)
+	{
+		sv_worldRoot = leaf;
+		box->parent  = WORLD_NODE_NULL;
+		return;
+	}
+
+	index = sv_worldRoot;
+	while (sv_worldNodes[index].height)
+	{
+		node = &sv_worldNodes[index];
+
+		SV_WorldUnionBounds(&combined, node, box);
+		area = SV_WorldBoxCost(combined.mins, combined.maxs);
+
+		// cost of a new parent for this node and the leaf
+		cost = 2 * area;
+
+		// minimum cost of pushing the leaf further down
+		inherited = 2 * (area - SV_WorldBoxCost(node->mins, node->maxs));
+		cost0     = SV_WorldInsertCost(&sv_worldNodes[node->children[0]], box) + inherited;
+		cost1     = SV_WorldInsertCost(&sv_worldNodes[node->children[1]], box) + inherited;
+
+		if (cost < cost0 && cost < cost1)
+		{
+			break;
+		}
+
+		index = cost0 < cost1 ? node->children[0] : node->children[1];
+	}
+	sibling = index;
+
+	oldParent = sv_worldNodes[sibling].parent;
+	newParent = SV_WorldAllocNode();
+	parent    = &sv_worldNodes[newParent];
+
+	parent->parent      = oldParent;
+	parent->children[0] = sibling;
+	parent->children[1] = leaf;
+	parent->height      = sv_worldNodes[sibling].height + 1;
+	SV_WorldUnionBounds(parent, &sv_worldNodes[sibling], box);
+
+	if (oldParent != WORLD_NODE_NULL)
+	{
+		node = &sv_worldNodes[oldParent];
+
+		node->children[node->children[0] == sibling ? 0 : 1] = newParent;
+	}
+	else
+	{
+		sv_worldRoot = newParent;
+	}
+
+	sv_worldNodes[sibling].parent = newParent;
+	box->parent                   = newParent;
+
+	SV_WorldRefit(newParent);
+}
+
+/**
+ * @brief Takes a leaf out of the tree, the node itself is kept
+ */
+static void SV_WorldRemoveLeaf(int leaf)
+{
+	worldNode_t *node;
+	int         parent, grandParent, sibling;
+
+	if (leaf == sv_worldRoot)
+	{
+		sv_worldRoot = WORLD_NODE_NULL;
+		return;
+	}
+
+	parent      = sv_worldNodes[leaf].parent;
+	grandParent = sv_worldNodes[parent].parent;
+	node        = &sv_worldNodes[parent];
+	sibling     = node->children[node->children[0] == leaf ? 1 : 0];
+
+	// the sibling takes the place of the parent
+	if (grandParent != WORLD_NODE_NULL)
+	{
+		node = &sv_worldNodes[grandParent];
+
+		node->children[node->children[0] == parent ? 0 : 1] = sibling;
+		sv_worldNodes[sibling].parent                        = grandParent;
+		SV_WorldFreeNode(parent);
+
+		SV_WorldRefit(grandParent);
+	}
+	else
+	{
+		sv_worldRoot                  = sibling;
+		sv_worldNodes[sibling].parent = WORLD_NODE_NULL;
+		SV_WorldFreeNode(parent);
+	}
 }
 
 /*
@@ -164,16 +404,24 @@ SV_ClearWorld
 */
 void SV_ClearWorld(void)
 {
-	clipHandle_t h;
-	vec3_t       mins, maxs;
+	int i;
+
+	memset(sv_worldNodes, 0, sizeof(sv_worldNodes));
+	memset(sv_worldBounds, 0, sizeof(sv_worldBounds));
 
-	memset(sv_worldSectors, 0, sizeof(sv_worldSectors));
-	sv_numworldSectors = 0;
+	// chain all nodes but the null node into the free list
+	sv_worldFreeNodes = WORLD_NODE_NULL;
+	for (i = WORLD_MAX_NODES - 1 ; i > WORLD_NODE_NULL ; i--)
+	{
+		SV_WorldFreeNode(i);
+	}
+	sv_numWorldNodes = 0;
+	sv_worldRoot     = WORLD_NODE_NULL;
 
-	// get world map bounds
-	h = CM_InlineModel(0);
-	CM_ModelBounds(h, mins, maxs);
-	SV_CreateworldSector(0, mins, maxs);
+	for (i = 0 ; i < MAX_GENTITIES ; i++)
+	{
+		sv.svEntities[i].worldNode = WORLD_NODE_NULL;
+	}
 }
 
 /*
@@ -183,37 +431,20 @@ SV_UnlinkEntity
 */
 void SV_UnlinkEntity(sharedEntity_t *gEnt)
 {
-	svEntity_t    *ent;
-	svEntity_t    *scan;
-	worldSector_t *ws;
+	svEntity_t *ent;
 
 	ent = SV_SvEntityForGentity(gEnt);
 
 	gEnt->r.linked = qfalse;
 
-	ws = ent->worldSector;
-	if (!ws)
+	if (ent->worldNode == WORLD_NODE_NULL)
 	{
 		return;     // not linked in anywhere
 	}
-	ent->worldSector = NULL;
-
-	if (ws->entities == ent)
-	{
-		ws->entities = ent->nextEntityInWorldSector;
-		return;
-	}
 
-	for (scan = ws->entities ; scan ; scan = scan->nextEntityInWorldSector)
-	{
-		if (scan->nextEntityInWorldSector == ent)
-		{
-			scan->nextEntityInWorldSector = ent->nextEntityInWorldSector;
-			return;
-		}
-	}
-
-	Com_Printf("WARNING: SV_UnlinkEntity: not found in worldSector\n");
+	SV_WorldRemoveLeaf(ent->worldNode);
+	SV_WorldFreeNode(ent->worldNode);
+	ent->worldNode = WORLD_NODE_NULL;
 }
 
 /*
@@ -225,13 +456,14 @@ SV_LinkEntity
 
 void SV_LinkEntity(sharedEntity_t *gEnt)
 {
-	worldSector_t *node;
+	worldNode_t   *node;
 	int           leafs[MAX_TOTAL_ENT_LEAFS];
 	int           cluster;
 	int           num_leafs;
 	int           i, j, k;
 	int           area;
 	int           lastLeaf;
+	int           num;
 	float         *origin, *angles;
 	svEntity_t    *ent;
 
@@ -246,10 +478,8 @@ void SV_LinkEntity(sharedEntity_t *gEnt)
 		Com_DPrintf("WARNING: BBOX entity %i (type: %i) is being linked at world origin, this is probably a bug - see /entitylist cmd\n", gEnt->s.number, gEnt->s.eType);
 	}
 
-	if (ent->worldSector)
-	{
-		SV_UnlinkEntity(gEnt);      // unlink from old position
-	}
+	// the tree leaf is kept if the entity doesn't move out of it
+	gEnt->r.linked = qfalse;
 
 	// encode the size into the entityState_t for client prediction
 	if (gEnt->r.bmodel)
@@ -348,6 +578,7 @@ void SV_LinkEntity(sharedEntity_t *gEnt)
 	// entity is outside the world and can be considered unlinked
 	if (!num_leafs)
 	{
+		SV_UnlinkEntity(gEnt);
 		return;
 	}
 
@@ -400,32 +631,35 @@ void SV_LinkEntity(sharedEntity_t *gEnt)
 
 	gEnt->r.linkcount++;
 
-	// find the first world sector node that the ent's box crosses
-	node = sv_worldSectors;
-	while (1)
+	// update the world tree
+	num = gEnt->s.number;
+	VectorCopy(gEnt->r.absmin, sv_worldBounds[num].absmin);
+	VectorCopy(gEnt->r.absmax, sv_worldBounds[num].absmax);
+
+	node = ent->worldNode != WORLD_NODE_NULL ? &sv_worldNodes[ent->worldNode] : NULL;
+	if (!node
+	    || gEnt->r.absmin[0] < node->mins[0] || gEnt->r.absmin[1] < node->mins[1] || gEnt->r.absmin[2] < node->mins[2]
+	    || gEnt->r.absmax[0] > node->maxs[0] || gEnt->r.absmax[1] > node->maxs[1] || gEnt->r.absmax[2] > node->maxs[2])
 	{
-		if (node->axis == -1)
-		{
-			break;
-		}
-		if (gEnt->r.absmin[node->axis] > node->dist)
+		if (node)
 		{
-			node = node->children[0];
+			SV_WorldRemoveLeaf(ent->worldNode);
 		}
-		else if (gEnt->r.absmax[node->axis] < node->dist)
+		else
 		{
-			node = node->children[1];
+			ent->worldNode = SV_WorldAllocNode();
+			node           = &sv_worldNodes[ent->worldNode];
 		}
-		else
+
+		node->entityNum = num;
+		for (i = 0 ; i < 3 ; i++)
 		{
-			break;      // crosses the node
+			node->mins[i] = gEnt->r.absmin[i] - WORLD_LEAF_MARGIN;
+			node->maxs[i] = gEnt->r.absmax[i] + WORLD_LEAF_MARGIN;
 		}
-	}
 
-	// link it in
-	ent->worldSector             = node;
-	ent->nextEntityInWorldSector = node->entities;
-	node->entities               = ent;
+		SV_WorldInsertLeaf(ent->worldNode);
+	}
 
 	gEnt->r.linked = qtrue;
 }
@@ -439,89 +673,212 @@ bounds.  This does NOT mean that they actually touch in the case of bmodels.
 ============================================================================
 */
 
-typedef struct
+/**
+ * @brief qsort callback for SV_AreaEntities
+ */
+static int SV_CompareEntityNums(const void *a, const void *b)
 {
-	const float *mins;
-	const float *maxs;
-	int *list;
-	int count, maxcount;
-} areaParms_t;
+	return *(const int *)a - *(const int *)b;
+}
 
-/*
-====================
-SV_AreaEntities_r
-====================
-*/
-void SV_AreaEntities_r(worldSector_t *node, areaParms_t *ap)
+/**
+ * @brief Lists the linked entities whose bounds overlap a box
+ * @param[in] mins
+ * @param[in] maxs
+ * @param[out] entityList
+ * @param[in] maxcount
+ * @return number of listed entities
+ *
+ * @note The entities are listed by ascending entity number. The order the
+ * tree is walked in depends on the link history, callers stopping at the
+ * first hit get the same result no matter how the tree is shaped.
+ */
+int SV_AreaEntities(const vec3_t mins, const vec3_t maxs, int *entityList, int maxcount)
 {
-	svEntity_t     *check, *next;
-	sharedEntity_t *gcheck;
+	int           stack[WORLD_STACK_SIZE];
+	int           sp = 0, count = 0;
+	worldNode_t   *node;
+	worldBounds_t *bounds;
 
-	for (check = node->entities  ; check ; check = next)
+	if (sv_worldRoot != WORLD_NODE_NULL)
 	{
-		next = check->nextEntityInWorldSector;
+		stack[sp++] = sv_worldRoot;
+	}
 
-		gcheck = SV_GEntityForSvEntity(check);
+	while (sp)
+	{
+		node = &sv_worldNodes[stack[--sp]];
+
+		if (node->mins[0] > maxs[0]
+		    || node->mins[1] > maxs[1]
+		    || node->mins[2] > maxs[2]
+		    || node->maxs[0] < mins[0]
+		    || node->maxs[1] < mins[1]
+		    || node->maxs[2] < mins[2])
+		{
+			continue;
+		}
 
-		if (!gcheck->r.linked)
+		if (node->height)
 		{
+			if (sp + 2 > WORLD_STACK_SIZE)
+			{
+				Com_Error(ERR_DROP, "SV_AreaEntities: world tree too deep");
+			}
+			stack[sp++] = node->children[0];
+			stack[sp++] = node->children[1];
 			continue;
 		}
 
-		if (gcheck->r.absmin[0] > ap->maxs[0]
-		    || gcheck->r.absmin[1] > ap->maxs[1]
-		    || gcheck->r.absmin[2] > ap->maxs[2]
-		    || gcheck->r.absmax[0] < ap->mins[0]
-		    || gcheck->r.absmax[1] < ap->mins[1]
-		    || gcheck->r.absmax[2] < ap->mins[2])
+		bounds = &sv_worldBounds[node->entityNum];
+
+		if (bounds->absmin[0] > maxs[0]
+		    || bounds->absmin[1] > maxs[1]
+		    || bounds->absmin[2] > maxs[2]
+		    || bounds->absmax[0] < mins[0]
+		    || bounds->absmax[1] < mins[1]
+		    || bounds->absmax[2] < mins[2])
 		{
 			continue;
 		}
 
-		if (ap->count == ap->maxcount)
+		if (!SV_GentityNum(node->entityNum)->r.linked)
+		{
+			continue;
+		}
+
+		if (count == maxcount)
 		{
 			Com_Printf("SV_AreaEntities: MAXCOUNT\n");
-			return;
+			break;
 		}
 
-		ap->list[ap->count] = check - sv.svEntities;
-		ap->count++;
+		entityList[count++] = node->entityNum;
 	}
 
-	if (node->axis == -1)
+	if (count > 1)
 	{
-		return;     // terminal node
+		qsort(entityList, count, sizeof(*entityList), SV_CompareEntityNums);
 	}
 
-	// recurse down both sides
-	if (ap->maxs[node->axis] > node->dist)
+	return count;
+}
+
+#define AREABENCH_QUERIES   1024
+
+/**
+ * @brief Compares SV_AreaEntities against a linear scan of all entities
+ *
+ * @details The query boxes are the moves of player sized boxes from random
+ * linked entities, roughly what traces and trigger checks ask for.
+ */
+void SV_AreaBenchmark_f(void)
+{
+	static vec3_t  mins[AREABENCH_QUERIES], maxs[AREABENCH_QUERIES];
+	static int     list[MAX_GENTITIES], linearList[MAX_GENTITIES];
+	sharedEntity_t *ent;
+	int            rounds = 100, round, i, j, e, count, linearCount, start, msec[2], mismatches = 0, listed = 0;
+	int            linked[MAX_GENTITIES], numLinked = 0;
+
+	if (!com_sv_running->integer)
 	{
-		SV_AreaEntities_r(node->children[0], ap);
+		Com_Printf("Server is not running.\n");
+		return;
 	}
-	if (ap->mins[node->axis] < node->dist)
+
+	if (Cmd_Argc() > 1)
 	{
-		SV_AreaEntities_r(node->children[1], ap);
+		rounds = atoi(Cmd_Argv(1));
 	}
-}
 
-/*
-================
-SV_AreaEntities
-================
-*/
-int SV_AreaEntities(const vec3_t mins, const vec3_t maxs, int *entityList, int maxcount)
-{
-	areaParms_t ap;
+	if (rounds <= 0)
+	{
+		Com_Printf("usage: areabench [rounds]\n");
+		return;
+	}
 
-	ap.mins     = mins;
-	ap.maxs     = maxs;
-	ap.list     = entityList;
-	ap.count    = 0;
-	ap.maxcount = maxcount;
+	for (e = 0 ; e < sv.num_entities ; e++)
+	{
+		if (SV_GentityNum(e)->r.linked)
+		{
+			linked[numLinked++] = e;
+		}
+	}
 
-	SV_AreaEntities_r(sv_worldSectors, &ap);
+	if (!numLinked)
+	{
+		Com_Printf("areabench: no linked entities\n");
+		return;
+	}
 
-	return ap.count;
+	for (i = 0 ; i < AREABENCH_QUERIES ; i++)
+	{
+		ent = SV_GentityNum(linked[rand() % numLinked]);
+
+		for (j = 0 ; j < 3 ; j++)
+		{
+			mins[i][j] = (ent->r.absmin[j] + ent->r.absmax[j]) * 0.5f + crandom() * 256;
+			maxs[i][j] = mins[i][j];
+		}
+		mins[i][0] -= 18 + random() * 128;
+		mins[i][1] -= 18 + random() * 128;
+		mins[i][2] -= 24;
+		maxs[i][0] += 18 + random() * 128;
+		maxs[i][1] += 18 + random() * 128;
+		maxs[i][2] += 48;
+	}
+
+	start = Sys_Milliseconds();
+	for (round = 0 ; round < rounds ; round++)
+	{
+		for (i = 0 ; i < AREABENCH_QUERIES ; i++)
+		{
+			count = SV_AreaEntities(mins[i], maxs[i], list, MAX_GENTITIES);
+			if (!round)
+			{
+				listed += count;
+			}
+		}
+	}
+	msec[0] = Sys_Milliseconds() - start;
+
+	start = Sys_Milliseconds();
+	for (round = 0 ; round < rounds ; round++)
+	{
+		for (i = 0 ; i < AREABENCH_QUERIES ; i++)
+		{
+			linearCount = 0;
+			for (e = 0 ; e < numLinked ; e++)
+			{
+				ent = SV_GentityNum(linked[e]);
+
+				if (ent->r.absmin[0] > maxs[i][0]
+				    || ent->r.absmin[1] > maxs[i][1]
+				    || ent->r.absmin[2] > maxs[i][2]
+				    || ent->r.absmax[0] < mins[i][0]
+				    || ent->r.absmax[1] < mins[i][1]
+				    || ent->r.absmax[2] < mins[i][2])
+				{
+					continue;
+				}
+
+				linearList[linearCount++] = linked[e];
+			}
+
+			if (!round)
+			{
+				count = SV_AreaEntities(mins[i], maxs[i], list, MAX_GENTITIES);
+				if (count != linearCount || memcmp(list, linearList, count * sizeof(*list)))
+				{
+					mismatches++;
+				}
+			}
+		}
+	}
+	msec[1] = Sys_Milliseconds() - start;
+
+	Com_Printf("areabench: %i linked entities, %i queries listing %i entities: %i msec tree, %i msec linear, %i mismatches\n",
+	           numLinked, rounds * AREABENCH_QUERIES, listed, msec[0], msec[1], mismatches);
 }
 
 //===========================================================================
@@ -771,6 +1128,72 @@ void SV_Trace(trace_t *results, const vec3_t start, const vec3_t mins, const vec
 	*results = clip.trace;
 }
 
+/**
+ * @brief Runs a batch of traces for the game module
+ *
+ * @details The PVS checks of the batch are done first, all together: rays
+ * from the same start (a bot looking at everyone else) share the start leaf,
+ * area and PVS row instead of looking them up for each ray like SV_inPVS.
+ * The rays left are traced after that.
+ *
+ * @param[in,out] batch
+ * @param[in] count
+ * @return number of rays which passed the PVS check and were traced
+ */
+int SV_TraceBatch(traceBatch_t *batch, int count)
+{
+	traceBatch_t *tb, *last = NULL;
+	int          i, leafnum, cluster, area = 0, traced = 0;
+	byte         *mask = NULL;
+
+	// reject the rays out of the PVS
+	for (i = 0, tb = batch; i < count; i++, tb++)
+	{
+		tb->inPVS = qtrue;
+
+		if (!(tb->flags & TRACEBATCH_PVS))
+		{
+			continue;
+		}
+
+		if (!last || !VectorCompare(tb->start, last->start))
+		{
+			leafnum = CM_PointLeafnum(tb->start);
+			area    = CM_LeafArea(leafnum);
+			mask    = CM_ClusterPVS(CM_LeafCluster(leafnum));
+			last    = tb;
+		}
+
+		leafnum = CM_PointLeafnum(tb->end);
+		cluster = CM_LeafCluster(leafnum);
+
+		// a door blocks sight too
+		if ((mask && !(mask[cluster >> 3] & (1 << (cluster & 7))))
+		    || !CM_AreasConnected(area, CM_LeafArea(leafnum)))
+		{
+			memset(&tb->trace, 0, sizeof(tb->trace));
+			tb->trace.entityNum = ENTITYNUM_NONE;
+			VectorCopy(tb->start, tb->trace.endpos);
+			tb->inPVS = qfalse;
+		}
+	}
+
+	for (i = 0, tb = batch; i < count; i++, tb++)
+	{
+		if (!tb->inPVS)
+		{
+			continue;
+		}
+
+		SV_Trace(&tb->trace, tb->start, tb->mins, tb->maxs, tb->end,
+		         (tb->flags & TRACEBATCH_NOENTS) ? -2 : tb->passEntityNum, tb->contentmask,
+		         (tb->flags & TRACEBATCH_CAPSULE) ? qtrue : qfalse);
+		traced++;
+	}
+
+	return traced;
+}
+
 /*
 =============
 SV_PointContents
@@ -486,6 +486,7 @@ typedef struct
 	qboolean soundHighScore; // FIXME: remove
 
 	int legacyClient;
+	int syscallExtensions;          // SYSCALL_EXT_* the client has
 
 	int characterCount;
 	characterInfo characterList[MAX_HEADS];
@@ -654,6 +655,7 @@ void trap_Error(const char *string) __attribute__((noreturn));
 int trap_Milliseconds(void);
 void trap_Cvar_Register(vmCvar_t *vmCvar, const char *varName, const char *defaultValue, int flags);
 void trap_Cvar_Update(vmCvar_t *vmCvar);
+int trap_Cvar_Changes(int *sequence, int *handles, int maxHandles);
 void trap_Cvar_Set(const char *var_name, const char *value);
 float trap_Cvar_VariableValue(const char *var_name);
 void trap_Cvar_VariableStringBuffer(const char *var_name, char *buffer, int bufsize);
@@ -7458,6 +7458,7 @@ void _UI_Init(int legacyClient, int clientVersion)
 	}
 
 	MOD_CHECK_LEGACY(legacyClient, clientVersion, uiInfo.legacyClient);
+	uiInfo.syscallExtensions = (int)trap_Cvar_VariableValue(SYSCALL_EXTENSIONS_CVAR);
 
 	//UI_Load();
 	uiInfo.uiDC.registerShaderNoMip  = &trap_R_RegisterShaderNoMip;
@@ -8185,7 +8186,8 @@ cvarTable_t cvarTable[] =
 	{ NULL,                             "cg_locations",                        "3",                          CVAR_ARCHIVE                   },
 };
 
-int cvarTableSize = sizeof(cvarTable) / sizeof(cvarTable[0]);
+int        cvarTableSize = sizeof(cvarTable) / sizeof(cvarTable[0]);
+static int cvarSequence  = -1;      // for trap_Cvar_Changes
 
 void UI_RegisterCvars(void)
 {
@@ -8194,6 +8196,9 @@ void UI_RegisterCvars(void)
 
 	Com_Printf("%d UI cvars in use.\n", cvarTableSize);
 
+	// check all cvars on the next update
+	cvarSequence = -1;
+
 	for (i = 0, cv = cvarTable ; i < cvarTableSize ; i++, cv++)
 	{
 		trap_Cvar_Register(cv->vmCvar, cv->cvarName, cv->defaultString, cv->cvarFlags);
@@ -8213,10 +8218,18 @@ void UI_UpdateCvars(void)
 {
 	int         i;
 	cvarTable_t *cv;
+	int         handles[MAX_CVAR_CHANGES];
+	int         numChanges;
+
+	numChanges = Com_GetCvarChanges((uiInfo.syscallExtensions & SYSCALL_EXT_CVAR_CHANGES) ? trap_Cvar_Changes : NULL, &cvarSequence, handles);
+	if (!numChanges)
+	{
+		return;
+	}
 
 	for (i = 0, cv = cvarTable ; i < cvarTableSize ; i++, cv++)
 	{
-		if (cv->vmCvar)
+		if (cv->vmCvar && Com_CvarChanged(cv->vmCvar, handles, numChanges))
 		{
 			trap_Cvar_Update(cv->vmCvar);
 			if (cv->modificationCount != cv->vmCvar->modificationCount)
@@ -173,7 +173,9 @@ typedef enum
 	UI_SQRT,
 	UI_FLOOR,
 	UI_CEIL,
-	UI_GETHUNKDATA
+	UI_GETHUNKDATA,
+
+	UI_CVAR_CHANGES     // ( int *sequence, int *handles, int maxHandles ); added after 274 release
 
 } uiImport_t;
 
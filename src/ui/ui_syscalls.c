@@ -76,6 +76,11 @@ void trap_Cvar_Update(vmCvar_t *cvar)
 	syscall(UI_CVAR_UPDATE, cvar);
 }
 
+int trap_Cvar_Changes(int *sequence, int *handles, int maxHandles)
+{
+	return syscall(UI_CVAR_CHANGES, sequence, handles, maxHandles);
+}
+
 void trap_Cvar_Set(const char *var_name, const char *value)
 {
 	syscall(UI_CVAR_SET, var_name, value);